@@ -0,0 +1,90 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+
+#include "benchmarkhelpers.hpp"
+
+//! Total number of heap allocations made by the process so far.
+static std::size_t sAllocationCount = 0;
+
+//! Number of bytes currently allocated on the heap.
+static std::size_t sAllocatedBytes = 0;
+
+//! Highest value sAllocatedBytes has reached since it was last reset.
+static std::size_t sPeakAllocatedBytes = 0;
+
+//! Space reserved in front of every allocation to remember its size, large enough to keep the allocation aligned.
+static const std::size_t sHeaderSize = alignof(std::max_align_t);
+
+void* operator new(std::size_t size)
+{
+    ++sAllocationCount;
+
+    char* block = static_cast<char*>(std::malloc(size + sHeaderSize));
+    if (!block)
+    {
+        throw std::bad_alloc();
+    }
+
+    *reinterpret_cast<std::size_t*>(block) = size;
+    sAllocatedBytes += size;
+    if (sAllocatedBytes > sPeakAllocatedBytes)
+    {
+        sPeakAllocatedBytes = sAllocatedBytes;
+    }
+    return block + sHeaderSize;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (!pointer)
+    {
+        return;
+    }
+
+    char* block = static_cast<char*>(pointer) - sHeaderSize;
+    sAllocatedBytes -= *reinterpret_cast<std::size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t size) noexcept
+{
+    operator delete(pointer);
+}
+
+namespace TribalScript
+{
+    std::size_t getAllocationCount()
+    {
+        return sAllocationCount;
+    }
+
+    std::size_t getAllocatedBytes()
+    {
+        return sAllocatedBytes;
+    }
+
+    std::size_t getPeakAllocatedBytes()
+    {
+        return sPeakAllocatedBytes;
+    }
+
+    void resetPeakAllocatedBytes()
+    {
+        sPeakAllocatedBytes = sAllocatedBytes;
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include <tribalscript/platformcontext.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Platform context that discards all log output so that console I/O does not dominate measurements.
+     */
+    class SilentPlatformContext : public PlatformContext
+    {
+        public:
+            virtual void logEcho(const std::string& message) override
+            {
+
+            }
+
+            virtual void logError(const std::string& message) override
+            {
+
+            }
+
+            virtual void logWarning(const std::string& message) override
+            {
+
+            }
+
+            virtual void logDebug(const std::string& message) override
+            {
+
+            }
+    };
+
+    /**
+     *  @brief Retrieves the total number of heap allocations made by the process so far. This is counted by the
+     *  global operator new replaced in allocationcounter.cpp.
+     */
+    std::size_t getAllocationCount();
+
+    /**
+     *  @brief Retrieves the number of bytes currently allocated on the heap through the global operator new.
+     */
+    std::size_t getAllocatedBytes();
+
+    /**
+     *  @brief Retrieves the highest number of bytes allocated on the heap at once since resetPeakAllocatedBytes
+     *  was last called.
+     */
+    std::size_t getPeakAllocatedBytes();
+
+    /**
+     *  @brief Resets the peak reported by getPeakAllocatedBytes to the number of bytes currently allocated.
+     */
+    void resetPeakAllocatedBytes();
+
+    /**
+     *  @brief Reads the entire contents of a file into memory.
+     *  @param path The path of the file to read.
+     *  @return The contents of the file. If the file could not be read, an empty string is returned.
+     */
+    static std::string readBenchmarkFile(const std::string& path)
+    {
+        std::ifstream input(path);
+        std::ostringstream buffer;
+        buffer << input.rdbuf();
+        return buffer.str();
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/nativefunction.hpp>
+#include <tribalscript/executionstate.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+#include "benchmarkhelpers.hpp"
+
+//! Number of function calls made per benchmark iteration.
+static const int sCallCount = 1000;
+
+static TribalScript::StoredValue SumNative(TribalScript::ConsoleObject* thisObject, TribalScript::ExecutionState* state, const TribalScript::StoredValueSpan& parameters)
+{
+    int result = 0;
+    for (const TribalScript::StoredValue& parameter : parameters)
+    {
+        result += parameter.toInteger();
+    }
+    return TribalScript::StoredValue(result);
+}
+
+/**
+ *  @brief Runs a loop calling the named function with three arguments, reporting how many heap allocations each
+ *  call costs.
+ *  @param setup Script run once before measuring, used to declare functions and objects.
+ *  @param calledFunction The function to call, optionally qualified by an object.
+ */
+static void BenchmarkCalls(benchmark::State& state, const std::string& setup, const std::string& calledFunction)
+{
+    TribalScript::InterpreterConfiguration config(new TribalScript::SilentPlatformContext());
+    TribalScript::Interpreter interpreter(config);
+    TribalScript::registerAllLibraries(&interpreter);
+    interpreter.addFunction(std::shared_ptr<TribalScript::Function>(new TribalScript::NativeFunction(SumNative, PACKAGE_EMPTY, NAMESPACE_EMPTY, "sumNative")));
+
+    interpreter.evaluate(setup);
+
+    const std::string source = "for (%i = 0; %i < " + std::to_string(sCallCount) + "; %i++) { " + calledFunction + "(%i, 1, 2); }";
+    TribalScript::CodeBlock* compiled = interpreter.compile(source);
+    if (!compiled)
+    {
+        state.SkipWithError("Failed to compile script");
+        return;
+    }
+
+    const std::size_t allocationsBefore = TribalScript::getAllocationCount();
+    for (auto _ : state)
+    {
+        TribalScript::ExecutionState executionState(&interpreter);
+        compiled->execute(&executionState);
+    }
+    const std::size_t allocations = TribalScript::getAllocationCount() - allocationsBefore;
+
+    state.counters["allocationsPerCall"] = static_cast<double>(allocations) / (static_cast<double>(state.iterations()) * sCallCount);
+    state.SetItemsProcessed(state.iterations() * sCallCount);
+    delete compiled;
+}
+
+static void BenchmarkScriptFunctionCalls(benchmark::State& state)
+{
+    BenchmarkCalls(state, "function add3(%a, %b, %c) { %sum = %a + %b; %sum = %sum + %c; return %sum; }", "add3");
+}
+BENCHMARK(BenchmarkScriptFunctionCalls);
+
+static void BenchmarkNativeFunctionCalls(benchmark::State& state)
+{
+    BenchmarkCalls(state, "", "sumNative");
+}
+BENCHMARK(BenchmarkNativeFunctionCalls);
+
+static void BenchmarkBoundFunctionCalls(benchmark::State& state)
+{
+    BenchmarkCalls(state, "function ScriptObject::add3(%this, %a, %b, %c) { %sum = %a + %b; %sum = %sum + %c; return %sum; }"
+                          "new ScriptObject(Target);", "Target.add3");
+}
+BENCHMARK(BenchmarkBoundFunctionCalls);
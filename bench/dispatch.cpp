@@ -0,0 +1,77 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/executionstate.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+#include "benchmarkhelpers.hpp"
+
+/**
+ *  @brief Measures raw execution throughput of a precompiled test case script. Compilation happens once up
+ *  front so only the dispatch loop and the runtime it calls into are measured.
+ */
+static void BenchmarkCaseScript(benchmark::State& state, const std::string& name)
+{
+    TribalScript::InterpreterConfiguration config(new TribalScript::SilentPlatformContext());
+    TribalScript::Interpreter interpreter(config);
+    TribalScript::registerAllLibraries(&interpreter);
+
+    const std::string source = TribalScript::readBenchmarkFile(std::string(TRIBALSCRIPT_BENCH_CASES_DIRECTORY) + "/" + name + ".cs");
+    TribalScript::CodeBlock* compiled = interpreter.compile(source);
+    if (!compiled)
+    {
+        state.SkipWithError("Failed to compile script");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        TribalScript::ExecutionState executionState(&interpreter);
+        compiled->execute(&executionState);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    delete compiled;
+}
+
+static const char* sCaseScripts[] = {
+    "array", "breakFor", "breakWhile", "caseSensitive", "chaining", "combined", "continueFor", "continueWhile",
+    "for", "function", "if", "memoryReference", "nestedBreakFor", "nestedBreakWhile", "nestedContinueFor",
+    "nestedContinueWhile", "opOrder", "package", "scriptObject", "simGroup", "switch", "treeInitialization",
+    "variables", "while"
+};
+
+int main(int argc, char** argv)
+{
+    for (const char* name : sCaseScripts)
+    {
+        benchmark::RegisterBenchmark((std::string("Dispatch/") + name).c_str(), BenchmarkCaseScript, std::string(name));
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include <Tribes2Lexer.h>
+#include <Tribes2Parser.h>
+
+#include "benchmarkhelpers.hpp"
+
+static const char* sParseScripts[] = {
+    "array", "boundCallCache", "breakFor", "breakWhile", "bytecodeCache", "callSiteCache", "caseFolding",
+    "caseSensitive", "chaining", "chains", "combined", "continueFor", "continueWhile", "controlFlow", "for",
+    "function", "if", "localSlots", "memoryReference", "nestedBreakFor", "nestedBreakWhile", "nestedContinueFor",
+    "nestedContinueWhile", "opOrder", "package", "profiler", "scriptObject", "shortCircuit", "simGroup", "switch",
+    "treeInitialization", "variables", "while"
+};
+
+/**
+ *  @brief Measures parsing every test case script, either with full LL prediction alone or with SLL prediction
+ *  first and full LL prediction only as a fallback, as the compiler does. The DFA cache shared by all parsers is
+ *  warm after the first iteration in both cases.
+ */
+static void BenchmarkParseCorpus(benchmark::State& state, const bool sllFirst)
+{
+    std::vector<std::string> sources;
+    std::size_t sourceBytes = 0;
+    for (const char* name : sParseScripts)
+    {
+        sources.push_back(TribalScript::readBenchmarkFile(std::string(TRIBALSCRIPT_BENCH_CASES_DIRECTORY) + "/" + name + ".cs"));
+        sourceBytes += sources.back().size();
+    }
+
+    std::size_t fallbacks = 0;
+    for (auto _ : state)
+    {
+        for (const std::string& source : sources)
+        {
+            std::istringstream input(source);
+            antlr4::ANTLRInputStream antlrStream(input);
+            Tribes2Lexer lexer(&antlrStream);
+            lexer.removeErrorListeners();
+
+            antlr4::CommonTokenStream stream(&lexer);
+            Tribes2Parser parser(&stream);
+            parser.removeErrorListeners();
+
+            if (!sllFirst)
+            {
+                parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::LL);
+                benchmark::DoNotOptimize(parser.program());
+                continue;
+            }
+
+            parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+            parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+            try
+            {
+                benchmark::DoNotOptimize(parser.program());
+            }
+            catch (antlr4::ParseCancellationException&)
+            {
+                ++fallbacks;
+                parser.reset();
+                parser.setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+                parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::LL);
+                benchmark::DoNotOptimize(parser.program());
+            }
+        }
+    }
+
+    if (sllFirst)
+    {
+        state.counters["fallbacksPerCorpus"] = static_cast<double>(fallbacks) / state.iterations();
+    }
+    state.SetItemsProcessed(state.iterations() * sources.size());
+    state.SetBytesProcessed(state.iterations() * sourceBytes);
+}
+
+static void BenchmarkParseCorpusLL(benchmark::State& state)
+{
+    BenchmarkParseCorpus(state, false);
+}
+BENCHMARK(BenchmarkParseCorpusLL)->Unit(benchmark::kMillisecond);
+
+static void BenchmarkParseCorpusSLLFirst(benchmark::State& state)
+{
+    BenchmarkParseCorpus(state, true);
+}
+BENCHMARK(BenchmarkParseCorpusSLLFirst)->Unit(benchmark::kMillisecond);
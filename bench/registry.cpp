@@ -0,0 +1,118 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <tribalscript/standardconsoleobjectregistry.hpp>
+
+class RegistryBenchmarkObject : public TribalScript::ConsoleObject
+{
+    public:
+        RegistryBenchmarkObject() : TribalScript::ConsoleObject(nullptr)
+        {
+
+        }
+
+        std::string getClassName() override
+        {
+            return "RegistryBenchmarkObject";
+        }
+};
+
+/**
+ *  @brief Objects and names shared by the registry benchmarks. The argument of each benchmark is the object count.
+ */
+struct RegistryBenchmarkObjects
+{
+    explicit RegistryBenchmarkObjects(const std::size_t count) : mObjects(count)
+    {
+        mNames.reserve(count);
+        for (std::size_t iteration = 0; iteration < count; ++iteration)
+        {
+            mNames.push_back("Object" + std::to_string(iteration));
+        }
+    }
+
+    void registerAll(TribalScript::StandardConsoleObjectRegistry& registry)
+    {
+        // Mirrors Interpreter::initializeConsoleObjectTree
+        for (std::size_t iteration = 0; iteration < mObjects.size(); ++iteration)
+        {
+            registry.addConsoleObject(nullptr, &mObjects[iteration]);
+            registry.setConsoleObject(nullptr, mNames[iteration], &mObjects[iteration]);
+        }
+    }
+
+    std::vector<RegistryBenchmarkObject> mObjects;
+    std::vector<std::string> mNames;
+};
+
+static void BenchmarkRegistryCreate(benchmark::State& state)
+{
+    RegistryBenchmarkObjects objects(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        TribalScript::StandardConsoleObjectRegistry registry;
+        objects.registerAll(registry);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BenchmarkRegistryCreate)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BenchmarkRegistryLookup(benchmark::State& state)
+{
+    RegistryBenchmarkObjects objects(static_cast<std::size_t>(state.range(0)));
+    TribalScript::StandardConsoleObjectRegistry registry;
+    objects.registerAll(registry);
+
+    for (auto _ : state)
+    {
+        for (RegistryBenchmarkObject& object : objects.mObjects)
+        {
+            const unsigned int id = registry.getConsoleObjectID(nullptr, &object);
+            benchmark::DoNotOptimize(registry.getConsoleObject(nullptr, id));
+            benchmark::DoNotOptimize(registry.getConsoleObjectName(nullptr, &object));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BenchmarkRegistryLookup)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BenchmarkRegistryDelete(benchmark::State& state)
+{
+    RegistryBenchmarkObjects objects(static_cast<std::size_t>(state.range(0)));
+    TribalScript::StandardConsoleObjectRegistry registry;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        registry = TribalScript::StandardConsoleObjectRegistry();
+        objects.registerAll(registry);
+        state.ResumeTiming();
+
+        for (RegistryBenchmarkObject& object : objects.mObjects)
+        {
+            registry.removeConsoleObject(nullptr, &object);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BenchmarkRegistryDelete)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
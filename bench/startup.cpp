@@ -0,0 +1,293 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include <Tribes2Lexer.h>
+#include <Tribes2Parser.h>
+
+#include <tribalscript/lexer.hpp>
+#include <tribalscript/parser.hpp>
+#include <tribalscript/astarena.hpp>
+#include <tribalscript/astbuilder.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+#include "benchmarkhelpers.hpp"
+
+//! Number of scripts in the generated corpus.
+static const int sCorpusScriptCount = 200;
+
+//! Number of functions declared by each script in the corpus.
+static const int sCorpusFunctionCount = 25;
+
+//! Number of lines in the script compiled by the compile throughput benchmark.
+static const int sCompileLineCount = 50000;
+
+/**
+ *  @brief Writes a corpus of scripts resembling typical game scripts to TRIBALSCRIPT_BENCH_CORPUS_DIRECTORY.
+ *  @return The paths of all scripts in the corpus.
+ */
+static const std::vector<std::string>& getCorpus()
+{
+    static std::vector<std::string> sCorpus;
+    if (!sCorpus.empty())
+    {
+        return sCorpus;
+    }
+
+    for (int scriptIteration = 0; scriptIteration < sCorpusScriptCount; ++scriptIteration)
+    {
+        const std::string prefix = "Corpus" + std::to_string(scriptIteration);
+
+        std::ostringstream script;
+        for (int functionIteration = 0; functionIteration < sCorpusFunctionCount; ++functionIteration)
+        {
+            script << "function " << prefix << "::method" << functionIteration << "(%this, %count, %label)\n"
+                   << "{\n"
+                   << "    %total = 0;\n"
+                   << "    for (%i = 0; %i < %count; %i++)\n"
+                   << "    {\n"
+                   << "        if (%i % 2 == 0 && %this.enabled)\n"
+                   << "            %total = %total + %i * " << functionIteration << ";\n"
+                   << "        else\n"
+                   << "            %total = %total - 1;\n"
+                   << "    }\n"
+                   << "    $" << prefix << "::lastLabel[%this, " << functionIteration << "] = %label @ \": \" @ %total;\n"
+                   << "    switch (%total)\n"
+                   << "    {\n"
+                   << "        case 0: echo(\"None\");\n"
+                   << "        case 1 or 2: echo(\"Few\");\n"
+                   << "        default: %this.method" << (functionIteration + 1) % sCorpusFunctionCount << "(%count - 1, \"nested\");\n"
+                   << "    }\n"
+                   << "    return %total;\n"
+                   << "}\n\n";
+        }
+
+        script << "$" << prefix << "::loaded = true;\n";
+
+        const std::string path = std::string(TRIBALSCRIPT_BENCH_CORPUS_DIRECTORY) + "/" + prefix + ".cs";
+        std::ofstream output(path);
+        output << script.str();
+        sCorpus.push_back(path);
+    }
+    return sCorpus;
+}
+
+/**
+ *  @brief Measures booting an interpreter by executing every script in the corpus, as a server does on startup.
+ */
+static void BenchmarkStartup(benchmark::State& state, const bool cacheBytecode)
+{
+    const std::vector<std::string>& corpus = getCorpus();
+
+    TribalScript::InterpreterConfiguration config(new TribalScript::SilentPlatformContext());
+    config.mCacheBytecode = cacheBytecode;
+
+    // Populate the caches before measuring
+    if (cacheBytecode)
+    {
+        TribalScript::Interpreter interpreter(config);
+        for (const std::string& path : corpus)
+        {
+            interpreter.execute(path, nullptr);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        TribalScript::Interpreter interpreter(config);
+        TribalScript::registerAllLibraries(&interpreter);
+
+        for (const std::string& path : corpus)
+        {
+            interpreter.execute(path, nullptr);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+
+static void BenchmarkStartupCompiled(benchmark::State& state)
+{
+    BenchmarkStartup(state, false);
+}
+BENCHMARK(BenchmarkStartupCompiled)->Unit(benchmark::kMillisecond);
+
+static void BenchmarkStartupCached(benchmark::State& state)
+{
+    BenchmarkStartup(state, true);
+}
+BENCHMARK(BenchmarkStartupCached)->Unit(benchmark::kMillisecond);
+
+/**
+ *  @brief Generates a single large script of roughly sCompileLineCount lines with nested control flow in every function.
+ */
+static std::string getCompileScript()
+{
+    std::ostringstream script;
+    int lineCount = 0;
+    for (int functionIteration = 0; lineCount < sCompileLineCount; ++functionIteration)
+    {
+        script << "function Compile::method" << functionIteration << "(%this, %count)\n"
+               << "{\n"
+               << "    %total = 0;\n"
+               << "    for (%i = 0; %i < %count; %i++)\n"
+               << "    {\n"
+               << "        while (%total < %i * 2 && %this.enabled)\n"
+               << "        {\n"
+               << "            if (%total % 3 == 0)\n"
+               << "                continue;\n"
+               << "            else if (%total > 100 || %total < -100)\n"
+               << "                break;\n"
+               << "            %total = %total + (%i > 5 ? %i * 2 : %i - 1);\n"
+               << "        }\n"
+               << "    }\n"
+               << "    switch (%total)\n"
+               << "    {\n"
+               << "        case 0: echo(\"None\");\n"
+               << "        case 1 or 2: echo(\"Few\" SPC %total);\n"
+               << "        default: $Compile::last[" << functionIteration << "] = %this.method" << functionIteration + 1 << "(%count - 1);\n"
+               << "    }\n"
+               << "    return %total;\n"
+               << "}\n";
+        lineCount += 22;
+    }
+    return script.str();
+}
+
+/**
+ *  @brief Measures compiling one large script from source to bytecode with the given frontend, reported in lines
+ *  compiled per second.
+ */
+static void BenchmarkCompileThroughput(benchmark::State& state, const TribalScript::ParserFrontend frontend)
+{
+    const std::string source = getCompileScript();
+
+    TribalScript::InterpreterConfiguration config(new TribalScript::SilentPlatformContext());
+    config.mFrontend = frontend;
+    TribalScript::Interpreter interpreter(config);
+
+    for (auto _ : state)
+    {
+        TribalScript::CodeBlock* compiled = interpreter.compile(source);
+        if (!compiled)
+        {
+            state.SkipWithError("Failed to compile script");
+            break;
+        }
+        delete compiled;
+    }
+    state.SetItemsProcessed(state.iterations() * std::count(source.begin(), source.end(), '\n'));
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+static void BenchmarkCompileThroughputANTLR(benchmark::State& state)
+{
+    BenchmarkCompileThroughput(state, TribalScript::ParserFrontend::ANTLR);
+}
+BENCHMARK(BenchmarkCompileThroughputANTLR)->Unit(benchmark::kMillisecond);
+
+static void BenchmarkCompileThroughputHandWritten(benchmark::State& state)
+{
+    BenchmarkCompileThroughput(state, TribalScript::ParserFrontend::HandWritten);
+}
+BENCHMARK(BenchmarkCompileThroughputHandWritten)->Unit(benchmark::kMillisecond);
+
+/**
+ *  @brief Measures parsing the compile benchmark script and building its AST with the given frontend, without
+ *  generating any code. Heap allocations made while parsing and while building the AST are reported separately,
+ *  per line of source, along with the peak heap usage of the whole process.
+ *  @details With the ANTLR frontend parsing produces the parse tree and building converts it to the AST. The hand
+ *  written frontend has no parse tree, so lexing is counted as parsing and parsing as building.
+ */
+static void BenchmarkParseAndBuild(benchmark::State& state, const TribalScript::ParserFrontend frontend)
+{
+    const std::string source = getCompileScript();
+    const std::size_t lineCount = std::count(source.begin(), source.end(), '\n');
+
+    TribalScript::StringTable stringTable;
+
+    std::size_t parseAllocations = 0;
+    std::size_t buildAllocations = 0;
+    std::size_t peakBytes = 0;
+    std::size_t arenaBytes = 0;
+    std::size_t arenaBlocks = 0;
+    for (auto _ : state)
+    {
+        const std::size_t bytesBefore = TribalScript::getAllocatedBytes();
+        TribalScript::resetPeakAllocatedBytes();
+
+        // The whole tree is released in one shot with the arena at the end of the iteration
+        TribalScript::AST::ASTArena arena;
+        std::size_t allocationsBeforeParse = TribalScript::getAllocationCount();
+        std::size_t allocationsBeforeBuild = 0;
+
+        if (frontend == TribalScript::ParserFrontend::HandWritten)
+        {
+            TribalScript::Lexer lexer(arena.createString(source));
+            const std::vector<TribalScript::Token> tokens = lexer.tokenize();
+
+            allocationsBeforeBuild = TribalScript::getAllocationCount();
+            TribalScript::Parser parser(tokens, &arena);
+            benchmark::DoNotOptimize(parser.parseProgram());
+        }
+        else
+        {
+            std::istringstream input(source);
+            antlr4::ANTLRInputStream antlrStream(input);
+            Tribes2Lexer lexer(&antlrStream);
+            antlr4::CommonTokenStream stream(&lexer);
+            Tribes2Parser parser(&stream);
+            Tribes2Parser::ProgramContext* program = parser.program();
+
+            allocationsBeforeBuild = TribalScript::getAllocationCount();
+            TribalScript::AST::ASTBuilder builder(&stringTable, &arena);
+            benchmark::DoNotOptimize(builder.visitProgram(program).as<TribalScript::AST::ProgramNode*>());
+        }
+
+        parseAllocations += allocationsBeforeBuild - allocationsBeforeParse;
+        buildAllocations += TribalScript::getAllocationCount() - allocationsBeforeBuild;
+        peakBytes = TribalScript::getPeakAllocatedBytes() - bytesBefore;
+        arenaBytes = arena.getBytesAllocated();
+        arenaBlocks = arena.getBlockCount();
+    }
+
+    const double processedLines = static_cast<double>(state.iterations()) * lineCount;
+    state.counters["parseAllocationsPerLine"] = static_cast<double>(parseAllocations) / processedLines;
+    state.counters["buildAllocationsPerLine"] = static_cast<double>(buildAllocations) / processedLines;
+    state.counters["peakBytes"] = static_cast<double>(peakBytes);
+    state.counters["arenaBytes"] = static_cast<double>(arenaBytes);
+    state.counters["arenaBlocks"] = static_cast<double>(arenaBlocks);
+    state.SetItemsProcessed(state.iterations() * lineCount);
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+static void BenchmarkParseAndBuildANTLR(benchmark::State& state)
+{
+    BenchmarkParseAndBuild(state, TribalScript::ParserFrontend::ANTLR);
+}
+BENCHMARK(BenchmarkParseAndBuildANTLR)->Unit(benchmark::kMillisecond);
+
+static void BenchmarkParseAndBuildHandWritten(benchmark::State& state)
+{
+    BenchmarkParseAndBuild(state, TribalScript::ParserFrontend::HandWritten);
+}
+BENCHMARK(BenchmarkParseAndBuildHandWritten)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,199 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/storedvaluestack.hpp>
+
+//! Number of values pushed and then popped per benchmark iteration.
+static const int sStackDepth = 64;
+
+static void reportFootprint(benchmark::State& state)
+{
+    state.counters["bytesPerValue"] = sizeof(TribalScript::StoredValue);
+    state.SetItemsProcessed(state.iterations() * sStackDepth * 2);
+}
+
+static void BenchmarkPushPopInteger(benchmark::State& state)
+{
+    TribalScript::StoredValueStack stack;
+    stack.reserve(sStackDepth);
+
+    for (auto _ : state)
+    {
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            stack.emplace_back(iteration);
+        }
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            benchmark::DoNotOptimize(stack.popInteger(nullptr));
+        }
+    }
+    reportFootprint(state);
+}
+BENCHMARK(BenchmarkPushPopInteger);
+
+static void BenchmarkPushPopFloat(benchmark::State& state)
+{
+    TribalScript::StoredValueStack stack;
+    stack.reserve(sStackDepth);
+
+    for (auto _ : state)
+    {
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            stack.emplace_back(static_cast<float>(iteration) * 0.5f);
+        }
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            benchmark::DoNotOptimize(stack.popFloat(nullptr));
+        }
+    }
+    reportFootprint(state);
+}
+BENCHMARK(BenchmarkPushPopFloat);
+
+/**
+ *  @brief Pushes copies of a string value, as happens when string literals and variables are loaded, then
+ *  discards them. The argument is the length of the string.
+ */
+static void BenchmarkPushPopStringCopy(benchmark::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'a');
+    const TribalScript::StoredValue source(text.c_str(), text.size());
+
+    TribalScript::StoredValueStack stack;
+    stack.reserve(sStackDepth);
+
+    for (auto _ : state)
+    {
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            stack.push_back(source);
+        }
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            stack.pop_back();
+        }
+        benchmark::ClobberMemory();
+    }
+    reportFootprint(state);
+}
+BENCHMARK(BenchmarkPushPopStringCopy)->Arg(8)->Arg(64);
+
+/**
+ *  @brief Pushes freshly constructed string values, as happens for the results of concatenations.
+ */
+static void BenchmarkPushPopStringConstruct(benchmark::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'a');
+
+    TribalScript::StoredValueStack stack;
+    stack.reserve(sStackDepth);
+
+    for (auto _ : state)
+    {
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            stack.emplace_back(text.c_str(), text.size());
+        }
+        for (int iteration = 0; iteration < sStackDepth; ++iteration)
+        {
+            stack.pop_back();
+        }
+        benchmark::ClobberMemory();
+    }
+    reportFootprint(state);
+}
+BENCHMARK(BenchmarkPushPopStringConstruct)->Arg(8)->Arg(64);
+
+//! Strings converted to numbers by the string-to-number benchmarks: numbers as typically written in scripts,
+//! object names that are compared numerically and empty strings.
+static const char* sNumericStrings[] = {
+    "42", "-7", "3.14159", "0.5", "100", "1e3", "Stepper", "", "12abc", "  8", "65535", "-0.25"
+};
+
+static void BenchmarkStringToFloat(benchmark::State& state)
+{
+    std::vector<TribalScript::StoredValue> values;
+    for (const char* string : sNumericStrings)
+    {
+        values.emplace_back(string);
+    }
+
+    for (auto _ : state)
+    {
+        for (const TribalScript::StoredValue& value : values)
+        {
+            benchmark::DoNotOptimize(value.toFloat());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BenchmarkStringToFloat);
+
+static void BenchmarkStringToInteger(benchmark::State& state)
+{
+    std::vector<TribalScript::StoredValue> values;
+    for (const char* string : sNumericStrings)
+    {
+        values.emplace_back(string);
+    }
+
+    for (auto _ : state)
+    {
+        for (const TribalScript::StoredValue& value : values)
+        {
+            benchmark::DoNotOptimize(value.toInteger());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BenchmarkStringToInteger);
+
+/**
+ *  @brief Converts floats to strings, as happens for every concatenation, echo and array name involving them.
+ *  Each value is freshly constructed as the results of arithmetic are.
+ */
+static void BenchmarkFloatToString(benchmark::State& state)
+{
+    const float values[] = { 0.5f, 3.0f, -12.25f, 1024.0f, 6.28f, 0.001f, 100000.0f, 7.75f };
+
+    for (auto _ : state)
+    {
+        for (const float value : values)
+        {
+            benchmark::DoNotOptimize(TribalScript::StoredValue(value).toString());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (sizeof(values) / sizeof(values[0])));
+}
+BENCHMARK(BenchmarkFloatToString);
+
+//! Converts the same float to a string repeatedly, as happens when a variable is concatenated in a loop.
+static void BenchmarkRepeatedFloatToString(benchmark::State& state)
+{
+    const TribalScript::StoredValue value(6.28f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(value.toString());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BenchmarkRepeatedFloatToString);
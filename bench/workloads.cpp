@@ -0,0 +1,204 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/executionstate.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+#include "benchmarkhelpers.hpp"
+
+/**
+ *  @brief Measures a scripted workload, reporting the time and heap allocations per operation.
+ *  @param setup Script run once before measuring, used to declare functions and objects.
+ *  @param workload Script run once per benchmark iteration.
+ *  @param operationCount The number of operations workload performs, used to report per operation figures.
+ */
+static void BenchmarkWorkload(benchmark::State& state, const std::string& setup, const std::string& workload, const int operationCount)
+{
+    TribalScript::InterpreterConfiguration config(new TribalScript::SilentPlatformContext());
+    TribalScript::Interpreter interpreter(config);
+    TribalScript::registerAllLibraries(&interpreter);
+
+    interpreter.evaluate(setup);
+
+    TribalScript::CodeBlock* compiled = interpreter.compile(workload);
+    if (!compiled)
+    {
+        state.SkipWithError("Failed to compile script");
+        return;
+    }
+
+    const std::size_t allocationsBefore = TribalScript::getAllocationCount();
+    for (auto _ : state)
+    {
+        TribalScript::ExecutionState executionState(&interpreter);
+        compiled->execute(&executionState);
+    }
+    const std::size_t allocations = TribalScript::getAllocationCount() - allocationsBefore;
+
+    state.counters["timePerOperation"] = benchmark::Counter(operationCount, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["allocationsPerOperation"] = static_cast<double>(allocations) / (static_cast<double>(state.iterations()) * operationCount);
+    state.SetItemsProcessed(state.iterations() * operationCount);
+    delete compiled;
+}
+
+//! One loop iteration of integer and float arithmetic on locals.
+static void BenchmarkArithmeticLoop(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "function arithmetic(%count) { %x = 0; for (%i = 0; %i < %count; %i++) { %x = %x * 3 + %i % 7 - 1.5; } return %x; }",
+                      "arithmetic(1000);", 1000);
+}
+BENCHMARK(BenchmarkArithmeticLoop);
+
+//! One loop iteration of integer arithmetic on counters and loop indices.
+static void BenchmarkIntegerCounters(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "function counters(%count) { %total = 0; %step = 0; for (%i = 0; %i < %count; %i++) { %total = %total + %i * 2 - %step; %step = %step + 1; } return %total; }",
+                      "counters(1000);", 1000);
+}
+BENCHMARK(BenchmarkIntegerCounters);
+
+//! One call of a naively recursive fibonacci function. fib(15) makes 1973 calls.
+static void BenchmarkRecursiveFib(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "function fib(%n) { if (%n < 2) return %n; return fib(%n - 1) + fib(%n - 2); }",
+                      "fib(15);", 1973);
+}
+BENCHMARK(BenchmarkRecursiveFib);
+
+//! One method call on a ScriptObject.
+static void BenchmarkScriptObjectMethodCalls(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "function ScriptObject::step(%this, %value) { return %value + 1; } new ScriptObject(Stepper);",
+                      "for (%i = 0; %i < 1000; %i++) { Stepper.step(%i); }", 1000);
+}
+BENCHMARK(BenchmarkScriptObjectMethodCalls);
+
+//! One read and one write of a tagged field.
+static void BenchmarkFieldAccess(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "new ScriptObject(Counter) { value = 0; };",
+                      "for (%i = 0; %i < 1000; %i++) { Counter.value = Counter.value + 1; }", 1000);
+}
+BENCHMARK(BenchmarkFieldAccess);
+
+//! One append to a growing string.
+static void BenchmarkStringConcatenation(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "",
+                      "%result = \"\"; for (%i = 0; %i < 200; %i++) { %result = %result @ \"word\" SPC %i; }", 200);
+}
+BENCHMARK(BenchmarkStringConcatenation);
+
+//! Appending one element to a space separated list that grows to 10000 elements.
+static void BenchmarkLongStringBuild(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "",
+                      "%result = \"\"; for (%i = 0; %i < 10000; %i++) { %result = %result @ \"word\" SPC %i; }", 10000);
+}
+BENCHMARK(BenchmarkLongStringBuild);
+
+//! Formatting one line out of several values with a chain of concatenations.
+static void BenchmarkConcatenationChain(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "",
+                      "%name = \"player\"; %team = 2; for (%i = 0; %i < 200; %i++) { %line = %name @ \": \" @ %i SPC %team TAB \"score\" SPC %i * 2; }", 200);
+}
+BENCHMARK(BenchmarkConcatenationChain);
+
+//! Two conditions guarding a method call, one ruling it out most of the time and one that rarely needs it.
+static void BenchmarkShortCircuitGuards(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "function ScriptObject::isReady(%this) { return %this.ready; } new ScriptObject(Target) { ready = 1; };",
+                      "%hits = 0; for (%i = 0; %i < 1000; %i++) { if (((%i % 4) == 0) && Target.isReady()) { %hits++; } if ((%i > 100) || Target.isReady()) { %hits++; } }", 1000);
+}
+BENCHMARK(BenchmarkShortCircuitGuards);
+
+//! One read and one write of a tagged field, naming the object and field in a different case than they were declared with.
+static void BenchmarkMixedCaseLookup(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "new ScriptObject(PlayerRecord) { Health = 100; TeamName = \"red\"; };",
+                      "for (%i = 0; %i < 1000; %i++) { %health = playerRecord.HEALTH; PLAYERRECORD.teamname = %health; }", 1000);
+}
+BENCHMARK(BenchmarkMixedCaseLookup);
+
+//! Visiting one member of a SimSet.
+static void BenchmarkSimSetIteration(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "new SimSet(Members); for (%i = 0; %i < 100; %i++) { Members.add(new ScriptObject()); }",
+                      "%total = 0; %count = Members.getCount(); for (%i = 0; %i < %count; %i++) { %total = %total + Members.getObject(%i).getID(); }", 100);
+}
+BENCHMARK(BenchmarkSimSetIteration);
+
+//! Extracting one word from a space separated list.
+static void BenchmarkGetWord(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "$words = \"the quick brown fox jumps over the lazy dog and keeps running through the field until dusk falls again\";",
+                      "for (%i = 0; %i < 20; %i++) { %word = getWord($words, %i); }", 20);
+}
+BENCHMARK(BenchmarkGetWord);
+
+//! Visiting one word of a 1000 word list by index, the way scripts iterate over lists.
+static void BenchmarkWordIteration(benchmark::State& state)
+{
+    BenchmarkWorkload(state, "$list = \"\"; for ($i = 0; $i < 1000; $i++) { $list = $list SPC \"item\" @ $i; }",
+                      "%count = getWordCount($list); for (%i = 0; %i < %count; %i++) { %word = getWord($list, %i); }", 1000);
+}
+BENCHMARK(BenchmarkWordIteration);
+
+//! Instantiating one object of a nested new ... { } tree, including its fields.
+static void BenchmarkObjectTree(benchmark::State& state)
+{
+    std::string tree = "%root = new SimGroup() {";
+    for (int groupIteration = 0; groupIteration < 10; ++groupIteration)
+    {
+        tree += " new SimGroup() {";
+        for (int objectIteration = 0; objectIteration < 10; ++objectIteration)
+        {
+            tree += " new ScriptObject() { health = 100; team = " + std::to_string(groupIteration) + "; };";
+        }
+        tree += " };";
+    }
+    tree += " }; %root.delete();";
+
+    BenchmarkWorkload(state, "", tree, 111);
+}
+BENCHMARK(BenchmarkObjectTree);
+
+//! Compiling one script of the test corpus.
+static void BenchmarkCompile(benchmark::State& state)
+{
+    TribalScript::InterpreterConfiguration config(new TribalScript::SilentPlatformContext());
+    TribalScript::Interpreter interpreter(config);
+
+    const std::string source = TribalScript::readBenchmarkFile(std::string(TRIBALSCRIPT_BENCH_CASES_DIRECTORY) + "/combined.cs");
+
+    const std::size_t allocationsBefore = TribalScript::getAllocationCount();
+    for (auto _ : state)
+    {
+        TribalScript::CodeBlock* compiled = interpreter.compile(source);
+        benchmark::DoNotOptimize(compiled);
+        delete compiled;
+    }
+    const std::size_t allocations = TribalScript::getAllocationCount() - allocationsBefore;
+
+    state.counters["allocationsPerOperation"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BenchmarkCompile);
@@ -20,6 +20,7 @@
 #include <memory>
 #include <map>
 
+#include <tribalscript/astarena.hpp>
 #include <tribalscript/astvisitor.hpp>
 #include <tribalscript/stringtable.hpp>
 #include <tribalscript/instructionsequence.hpp>
@@ -31,6 +32,7 @@ namespace TribalScript
         /**
          *  @brief Base AST node class. All AST nodes should derive from this
          *  class.
+         *  @note Nodes are created in an ASTArena and released with it, never individually.
          */
         class ASTNode
         {
@@ -43,85 +45,61 @@ namespace TribalScript
         class ProgramNode
         {
             public:
-                explicit ProgramNode(std::vector<ASTNode*> nodes) : mNodes(std::move(nodes))
+                explicit ProgramNode(ArenaList<ASTNode*> nodes) : mNodes(nodes)
                 {
 
                 }
 
-                virtual ~ProgramNode()
-                {
-                    for (ASTNode* node : mNodes)
-                    {
-                        delete node;
-                    }
-                }
-
                 virtual antlrcpp::Any accept(ASTVisitor* visitor)
                 {
                     return visitor->visitProgramNode(this);
                 }
 
-                std::vector<ASTNode*> mNodes;
+                ArenaList<ASTNode*> mNodes;
         };
 
         class FunctionDeclarationNode : public ASTNode
         {
             public:
-                FunctionDeclarationNode(std::string space, std::string name, std::vector<std::string> parameterNames, std::vector<ASTNode*> body) :
-                                        mNameSpace(std::move(space)), mName(std::move(name)), mParameterNames(std::move(parameterNames)), mBody(std::move(body))
+                FunctionDeclarationNode(StringView space, StringView name, ArenaList<StringView> parameterNames, ArenaList<ASTNode*> body) :
+                                        mNameSpace(space), mName(name), mParameterNames(parameterNames), mBody(body)
                 {
 
                 }
 
-                ~FunctionDeclarationNode() override
-                {
-                    for (ASTNode* node : mBody)
-                    {
-                        delete node;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitFunctionDeclarationNode(this);
                 }
 
-                std::string mNameSpace;
-                std::string mName;
-                std::vector<std::string> mParameterNames;
-                std::vector<ASTNode*> mBody;
+                StringView mNameSpace;
+                StringView mName;
+                ArenaList<StringView> mParameterNames;
+                ArenaList<ASTNode*> mBody;
         };
 
         class PackageDeclarationNode : public ASTNode
         {
             public:
-                PackageDeclarationNode(std::string name, std::vector<ASTNode*> functions) : mName(std::move(name)), mFunctions(std::move(functions))
+                PackageDeclarationNode(StringView name, ArenaList<ASTNode*> functions) : mName(name), mFunctions(functions)
                 {
 
                 }
 
-                ~PackageDeclarationNode() override
-                {
-                    for (ASTNode* function : mFunctions)
-                    {
-                        delete function;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitPackageDeclarationNode(this);
                 }
 
-                std::string mName;
-                std::vector<ASTNode*> mFunctions;
+                StringView mName;
+                ArenaList<ASTNode*> mFunctions;
         };
 
         class FieldAssignNode : public ASTNode
         {
             public:
-                FieldAssignNode(std::string fieldBaseName, std::vector<ASTNode*> fieldExpressions, ASTNode* right) :
-                                mFieldBaseName(std::move(fieldBaseName)), mFieldExpressions(std::move(fieldExpressions)), mRight(right)
+                FieldAssignNode(StringView fieldBaseName, ArenaList<ASTNode*> fieldExpressions, ASTNode* right) :
+                                mFieldBaseName(fieldBaseName), mFieldExpressions(fieldExpressions), mRight(right)
                 {
 
                 }
@@ -131,16 +109,16 @@ namespace TribalScript
                     return visitor->visitFieldAssignNode(this);
                 }
 
-                std::string mFieldBaseName;
-                std::vector<ASTNode*> mFieldExpressions;
+                StringView mFieldBaseName;
+                ArenaList<ASTNode*> mFieldExpressions;
                 ASTNode* mRight;
         };
 
         class ObjectDeclarationNode : public ASTNode
         {
             public:
-                ObjectDeclarationNode(ASTNode* name, ASTNode* type, std::vector<ObjectDeclarationNode*> children, std::vector<ASTNode*> fields) :
-                                      mName(name), mType(type), mChildren(std::move(children)), mFields(std::move(fields))
+                ObjectDeclarationNode(ASTNode* name, ASTNode* type, ArenaList<ObjectDeclarationNode*> children, ArenaList<ASTNode*> fields) :
+                                      mName(name), mType(type), mChildren(children), mFields(fields)
                 {
                 }
 
@@ -152,15 +130,15 @@ namespace TribalScript
                 ASTNode* mName;
                 ASTNode* mType;
 
-                std::vector<ObjectDeclarationNode*> mChildren;
-                std::vector<ASTNode*> mFields;
+                ArenaList<ObjectDeclarationNode*> mChildren;
+                ArenaList<ASTNode*> mFields;
         };
 
         class DatablockDeclarationNode : public ASTNode
         {
             public:
-                DatablockDeclarationNode(std::string name, std::string type, std::string parentName, std::vector<ASTNode*> fields) :
-                                        mName(std::move(name)), mType(std::move(type)), mParentName(std::move(parentName)), mFields(std::move(fields))
+                DatablockDeclarationNode(StringView name, StringView type, StringView parentName, ArenaList<ASTNode*> fields) :
+                                        mName(name), mType(type), mParentName(parentName), mFields(fields)
                 {
                 }
 
@@ -169,64 +147,48 @@ namespace TribalScript
                     return visitor->visitDatablockDeclarationNode(this);
                 }
 
-                std::string mName;
-                std::string mType;
-                std::string mParentName;
+                StringView mName;
+                StringView mType;
+                StringView mParentName;
 
-                std::vector<ASTNode*> mFields;
+                ArenaList<ASTNode*> mFields;
         };
 
         class FunctionCallNode : public ASTNode
         {
             public:
-                FunctionCallNode(std::string space, std::string name, std::vector<ASTNode*> parameters) :
-                                mNameSpace(std::move(space)), mName(std::move(name)), mParameters(std::move(parameters))
+                FunctionCallNode(StringView space, StringView name, ArenaList<ASTNode*> parameters) :
+                                mNameSpace(space), mName(name), mParameters(parameters)
                 {
 
                 }
 
-                ~FunctionCallNode() override
-                {
-                    for (ASTNode* parameter : mParameters)
-                    {
-                        delete parameter;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitFunctionCallNode(this);
                 }
 
-                std::string mNameSpace;
-                std::string mName;
-                std::vector<ASTNode*> mParameters;
+                StringView mNameSpace;
+                StringView mName;
+                ArenaList<ASTNode*> mParameters;
         };
 
         class SubFunctionCallNode : public ASTNode
         {
             public:
-                SubFunctionCallNode(std::string name, std::vector<ASTNode*> parameters) :
-                                    mName(std::move(name)), mParameters(std::move(parameters))
+                SubFunctionCallNode(StringView name, ArenaList<ASTNode*> parameters) :
+                                    mName(name), mParameters(parameters)
                 {
 
                 }
 
-                ~SubFunctionCallNode() override
-                {
-                    for (ASTNode* parameter : mParameters)
-                    {
-                        delete parameter;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitSubFunctionCallNode(this);
                 }
 
-                std::string mName;
-                std::vector<ASTNode*> mParameters;
+                StringView mName;
+                ArenaList<ASTNode*> mParameters;
         };
 
         class SubreferenceNode : public ASTNode
@@ -250,7 +212,7 @@ namespace TribalScript
         class SubFieldNode : public ASTNode
         {
             public:
-                SubFieldNode(std::string name, std::vector<ASTNode*> indices) : mName(std::move(name)), mIndices(std::move(indices))
+                SubFieldNode(StringView name, ArenaList<ASTNode*> indices) : mName(name), mIndices(indices)
                 {
 
                 }
@@ -260,8 +222,8 @@ namespace TribalScript
                     return visitor->visitSubFieldNode(this);
                 }
 
-                std::string mName;
-                std::vector<ASTNode*> mIndices;
+                StringView mName;
+                ArenaList<ASTNode*> mIndices;
         };
 
         class InfixExpressionNode : public ASTNode
@@ -272,12 +234,6 @@ namespace TribalScript
 
                 }
 
-                ~InfixExpressionNode() override
-                {
-                    delete mLeft;
-                    delete mRight;
-                }
-
 
                 ASTNode* mLeft;
                 ASTNode* mRight;
@@ -412,7 +368,7 @@ namespace TribalScript
         class ConcatNode : public InfixExpressionNode
         {
             public:
-                ConcatNode(ASTNode* left, ASTNode* right, std::string seperator) : InfixExpressionNode(left, right), mSeperator(std::move(seperator))
+                ConcatNode(ASTNode* left, ASTNode* right, StringView seperator) : InfixExpressionNode(left, right), mSeperator(seperator)
                 {
 
                 }
@@ -422,7 +378,7 @@ namespace TribalScript
                     return visitor->visitConcatNode(this);
                 }
 
-                std::string mSeperator;
+                StringView mSeperator;
         };
 
         class EqualsNode : public InfixExpressionNode
@@ -545,11 +501,6 @@ namespace TribalScript
 
                 }
 
-                ~UnaryNode() override
-                {
-                    delete mInner;
-                }
-
                 ASTNode* mInner;
         };
 
@@ -649,7 +600,7 @@ namespace TribalScript
         class StringNode : public ValueNode
         {
             public:
-                explicit StringNode(std::string value) : mValue(std::move(value))
+                explicit StringNode(StringView value) : mValue(value)
                 {
 
                 }
@@ -659,13 +610,13 @@ namespace TribalScript
                     return visitor->visitStringNode(this);
                 }
 
-                std::string mValue;
+                StringView mValue;
         };
 
         class TaggedStringNode : public ValueNode
         {
             public:
-                explicit TaggedStringNode(std::string value) : mValue(std::move(value))
+                explicit TaggedStringNode(StringView value) : mValue(value)
                 {
 
                 }
@@ -675,13 +626,13 @@ namespace TribalScript
                     return visitor->visitTaggedStringNode(this);
                 }
 
-                std::string mValue;
+                StringView mValue;
         };
 
         class LocalVariableNode : public ValueNode
         {
             public:
-                explicit LocalVariableNode(std::vector<std::string> name) : mName(std::move(name))
+                explicit LocalVariableNode(ArenaList<StringView> name) : mName(name)
                 {
 
                 }
@@ -689,16 +640,13 @@ namespace TribalScript
                 std::string getName()
                 {
                     std::string result;
-                    for (const std::string& component : mName)
+                    for (const StringView& component : mName)
                     {
-                        if (result.empty())
-                        {
-                            result = component;
-                        }
-                        else
+                        if (!result.empty())
                         {
-                            result += "::" + component;
+                            result += "::";
                         }
+                        result.append(component.data(), component.size());
                     }
                     return result;
                 }
@@ -708,13 +656,13 @@ namespace TribalScript
                     return visitor->visitLocalVariableNode(this);
                 }
 
-                std::vector<std::string> mName;
+                ArenaList<StringView> mName;
         };
 
         class GlobalVariableNode : public ValueNode
         {
             public:
-                explicit GlobalVariableNode(std::vector<std::string> name) : mName(std::move(name))
+                explicit GlobalVariableNode(ArenaList<StringView> name) : mName(name)
                 {
 
                 }
@@ -722,16 +670,13 @@ namespace TribalScript
                 std::string getName()
                 {
                     std::string result;
-                    for (const std::string& component : mName)
+                    for (const StringView& component : mName)
                     {
-                        if (result.empty())
+                        if (!result.empty())
                         {
-                            result = component;
-                        }
-                        else
-                        {
-                            result += "::" + component;
+                            result += "::";
                         }
+                        result.append(component.data(), component.size());
                     }
                     return result;
                 }
@@ -741,26 +686,16 @@ namespace TribalScript
                     return visitor->visitGlobalVariableNode(this);
                 }
 
-                std::vector<std::string> mName;
+                ArenaList<StringView> mName;
         };
 
         class ArrayNode : public ASTNode
         {
             public:
-                ArrayNode(ASTNode* target, std::vector<ASTNode*> indices) :
-                         mTarget(target), mIndices(std::move(indices))
-                {
-
-                }
-
-                ~ArrayNode() override
+                ArrayNode(ASTNode* target, ArenaList<ASTNode*> indices) :
+                         mTarget(target), mIndices(indices)
                 {
-                    delete mTarget;
 
-                    for (ASTNode* index : mIndices)
-                    {
-                        delete index;
-                    }
                 }
 
                 antlrcpp::Any accept(ASTVisitor* visitor) override
@@ -769,25 +704,15 @@ namespace TribalScript
                 }
 
                 ASTNode* mTarget;
-                std::vector<ASTNode*> mIndices;
+                ArenaList<ASTNode*> mIndices;
         };
 
         class WhileNode : public ASTNode
         {
             public:
-                WhileNode(ASTNode* expression, std::vector<ASTNode*> body) : mExpression(expression), mBody(std::move(body))
-                {
-
-                }
-
-                ~WhileNode() override
+                WhileNode(ASTNode* expression, ArenaList<ASTNode*> body) : mExpression(expression), mBody(body)
                 {
-                    delete mExpression;
 
-                    for (ASTNode* node : mBody)
-                    {
-                        delete node;
-                    }
                 }
 
                 antlrcpp::Any accept(ASTVisitor* visitor) override
@@ -796,30 +721,18 @@ namespace TribalScript
                 }
 
                 ASTNode* mExpression;
-                std::vector<ASTNode*> mBody;
+                ArenaList<ASTNode*> mBody;
         };
 
         class ForNode : public ASTNode
         {
             public:
-                ForNode(ASTNode* initializer, ASTNode* expression, ASTNode* advance, std::vector<ASTNode*> body) :
-                        mInitializer(initializer), mExpression(expression), mAdvance(advance), mBody(std::move(body))
+                ForNode(ASTNode* initializer, ASTNode* expression, ASTNode* advance, ArenaList<ASTNode*> body) :
+                        mInitializer(initializer), mExpression(expression), mAdvance(advance), mBody(body)
                 {
 
                 }
 
-                ~ForNode() override
-                {
-                    delete mInitializer;
-                    delete mExpression;
-                    delete mAdvance;
-
-                    for (ASTNode* node : mBody)
-                    {
-                        delete node;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitForNode(this);
@@ -828,7 +741,7 @@ namespace TribalScript
                 ASTNode* mInitializer;
                 ASTNode* mExpression;
                 ASTNode* mAdvance;
-                std::vector<ASTNode*> mBody;
+                ArenaList<ASTNode*> mBody;
         };
 
         class ReturnNode : public ASTNode
@@ -839,11 +752,6 @@ namespace TribalScript
 
                 }
 
-                ~ReturnNode() override
-                {
-                    delete mExpression;
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitReturnNode(this);
@@ -883,13 +791,6 @@ namespace TribalScript
 
                 }
 
-                ~TernaryNode() override
-                {
-                    delete mExpression;
-                    delete mTrueValue;
-                    delete mFalseValue;
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitTernaryNode(this);
@@ -903,7 +804,7 @@ namespace TribalScript
         class SwitchCaseNode : public ASTNode
         {
             public:
-                SwitchCaseNode(std::vector<ASTNode*> cases, std::vector<ASTNode*> body) : mCases(std::move(cases)), mBody(std::move(body))
+                SwitchCaseNode(ArenaList<ASTNode*> cases, ArenaList<ASTNode*> body) : mCases(cases), mBody(body)
                 {
 
                 }
@@ -913,109 +814,64 @@ namespace TribalScript
                     return visitor->visitSwitchCaseNode(this);
                 }
 
-                std::vector<ASTNode*> mCases;
-                std::vector<ASTNode*> mBody;
+                ArenaList<ASTNode*> mCases;
+                ArenaList<ASTNode*> mBody;
         };
 
         class SwitchNode : public ASTNode
         {
             public:
-                SwitchNode(ASTNode* expression, std::vector<SwitchCaseNode*> cases, std::vector<ASTNode*> defaultBody) :
-                          mExpression(expression), mCases(std::move(cases)), mDefaultBody(std::move(defaultBody))
+                SwitchNode(ASTNode* expression, ArenaList<SwitchCaseNode*> cases, ArenaList<ASTNode*> defaultBody) :
+                          mExpression(expression), mCases(cases), mDefaultBody(defaultBody)
                 {
 
                 }
 
-                ~SwitchNode() override
-                {
-                    delete mExpression;
-
-                    for (SwitchCaseNode* switchCase : mCases)
-                    {
-                        delete switchCase;
-                    }
-
-                    for (ASTNode* node : mDefaultBody)
-                    {
-                        delete node;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitSwitchNode(this);
                 }
 
                 ASTNode* mExpression;
-                std::vector<SwitchCaseNode*> mCases;
-                std::vector<ASTNode*> mDefaultBody;
+                ArenaList<SwitchCaseNode*> mCases;
+                ArenaList<ASTNode*> mDefaultBody;
         };
 
         class ElseIfNode : public ASTNode
         {
             public:
-                ElseIfNode(ASTNode* expression, std::vector<ASTNode*> body) : mExpression(expression), mBody(std::move(body))
+                ElseIfNode(ASTNode* expression, ArenaList<ASTNode*> body) : mExpression(expression), mBody(body)
                 {
 
                 }
 
-                ~ElseIfNode() override
-                {
-                    delete mExpression;
-
-                    for (ASTNode* node : mBody)
-                    {
-                        delete node;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitElseIfNode(this);
                 }
 
                 ASTNode* mExpression;
-                std::vector<ASTNode*> mBody;
+                ArenaList<ASTNode*> mBody;
         };
 
         class IfNode : public ASTNode
         {
             public:
-                IfNode(ASTNode* expression, std::vector<ASTNode*> body, std::vector<ElseIfNode*> elseIfs, std::vector<ASTNode*> elseBody) :
-                      mExpression(expression), mBody(std::move(body)), mElseIfs(std::move(elseIfs)), mElseBody(std::move(elseBody))
+                IfNode(ASTNode* expression, ArenaList<ASTNode*> body, ArenaList<ElseIfNode*> elseIfs, ArenaList<ASTNode*> elseBody) :
+                      mExpression(expression), mBody(body), mElseIfs(elseIfs), mElseBody(elseBody)
                 {
 
                 }
 
-                ~IfNode() override
-                {
-                    delete mExpression;
-
-                    for (ASTNode* node : mBody)
-                    {
-                        delete node;
-                    }
-
-                    for (ElseIfNode* elseIf : mElseIfs)
-                    {
-                        delete elseIf;
-                    }
-
-                    for (ASTNode* node : mElseBody)
-                    {
-                        delete node;
-                    }
-                }
-
                 antlrcpp::Any accept(ASTVisitor* visitor) override
                 {
                     return visitor->visitIfNode(this);
                 }
 
                 ASTNode* mExpression;
-                std::vector<ASTNode*> mBody;
-                std::vector<ElseIfNode*> mElseIfs;
-                std::vector<ASTNode*> mElseBody;
+                ArenaList<ASTNode*> mBody;
+                ArenaList<ElseIfNode*> mElseIfs;
+                ArenaList<ASTNode*> mElseBody;
         };
     }
 }
@@ -0,0 +1,278 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+namespace TribalScript
+{
+    namespace AST
+    {
+        /**
+         *  @brief A non owning view over text stored in an ASTArena, a source buffer or in static storage.
+         *  @warning The viewed text is only valid for as long as the storage it views.
+         */
+        class StringView
+        {
+            public:
+                StringView() : mData(""), mSize(0)
+                {
+
+                }
+
+                StringView(const char* data) : mData(data), mSize(std::strlen(data))
+                {
+
+                }
+
+                StringView(const char* data, const std::size_t size) : mData(data), mSize(size)
+                {
+
+                }
+
+                const char* data() const
+                {
+                    return mData;
+                }
+
+                std::size_t size() const
+                {
+                    return mSize;
+                }
+
+                bool empty() const
+                {
+                    return mSize == 0;
+                }
+
+                const char* begin() const
+                {
+                    return mData;
+                }
+
+                const char* end() const
+                {
+                    return mData + mSize;
+                }
+
+                char operator[](const std::size_t index) const
+                {
+                    assert(index < mSize);
+                    return mData[index];
+                }
+
+                /**
+                 *  @brief Views part of this text. Like std::string::substr, the length is clamped to the end of the text.
+                 *  @param position The first character to view.
+                 *  @param length The maximum number of characters to view.
+                 */
+                StringView substr(const std::size_t position, const std::size_t length = static_cast<std::size_t>(-1)) const
+                {
+                    assert(position <= mSize);
+                    return StringView(mData + position, length < mSize - position ? length : mSize - position);
+                }
+
+                /**
+                 *  @brief Checks whether the text at the given position starts with the given characters.
+                 */
+                bool matches(const std::size_t position, const char* text, const std::size_t length) const
+                {
+                    return position <= mSize && length <= mSize - position && std::memcmp(mData + position, text, length) == 0;
+                }
+
+                std::string toString() const
+                {
+                    return std::string(mData, mSize);
+                }
+
+            private:
+                //! The first character of the text.
+                const char* mData;
+
+                //! The number of characters in the text.
+                std::size_t mSize;
+        };
+
+        /**
+         *  @brief A non owning, fixed size list of elements stored in an ASTArena. Child lists of AST nodes are
+         *  stored this way so that nodes own no memory of their own.
+         */
+        template<typename ElementType>
+        class ArenaList
+        {
+            public:
+                typedef std::reverse_iterator<ElementType*> reverse_iterator;
+
+                ArenaList() : mData(nullptr), mSize(0)
+                {
+
+                }
+
+                ArenaList(ElementType* data, const std::size_t size) : mData(data), mSize(size)
+                {
+
+                }
+
+                std::size_t size() const
+                {
+                    return mSize;
+                }
+
+                bool empty() const
+                {
+                    return mSize == 0;
+                }
+
+                ElementType& operator[](const std::size_t index) const
+                {
+                    assert(index < mSize);
+                    return mData[index];
+                }
+
+                ElementType& front() const
+                {
+                    assert(mSize != 0);
+                    return mData[0];
+                }
+
+                ElementType& back() const
+                {
+                    assert(mSize != 0);
+                    return mData[mSize - 1];
+                }
+
+                ElementType* begin() const
+                {
+                    return mData;
+                }
+
+                ElementType* end() const
+                {
+                    return mData + mSize;
+                }
+
+                reverse_iterator rbegin() const
+                {
+                    return reverse_iterator(this->end());
+                }
+
+                reverse_iterator rend() const
+                {
+                    return reverse_iterator(this->begin());
+                }
+
+            private:
+                //! The first element in the list.
+                ElementType* mData;
+
+                //! The number of elements in the list.
+                std::size_t mSize;
+        };
+
+        /**
+         *  @brief Bump allocator the AST of a single compilation is built in. Nodes, their child lists and their text
+         *  are carved out of large blocks and released all at once when the arena is destroyed, without visiting the tree.
+         *  @warning Destructors of objects created in the arena are never run, so they must not own any memory.
+         */
+        class ASTArena
+        {
+            public:
+                ASTArena();
+                ~ASTArena();
+
+                /**
+                 *  @brief Allocates uninitialized memory from the arena.
+                 *  @param size The number of bytes to allocate.
+                 *  @param alignment The alignment of the allocation. This must be a power of two.
+                 */
+                void* allocate(const std::size_t size, const std::size_t alignment);
+
+                /**
+                 *  @brief Constructs an object in the arena.
+                 */
+                template<typename ObjectType, typename... ArgumentTypes>
+                ObjectType* create(ArgumentTypes&&... arguments)
+                {
+                    void* memory = this->allocate(sizeof(ObjectType), alignof(ObjectType));
+                    return new (memory) ObjectType(std::forward<ArgumentTypes>(arguments)...);
+                }
+
+                /**
+                 *  @brief Copies the given elements into a list stored in the arena.
+                 */
+                template<typename ElementType>
+                ArenaList<ElementType> createList(const std::vector<ElementType>& elements)
+                {
+                    static_assert(std::is_trivially_destructible<ElementType>::value, "Arena list elements are never destroyed");
+
+                    if (elements.empty())
+                    {
+                        return ArenaList<ElementType>();
+                    }
+
+                    ElementType* data = static_cast<ElementType*>(this->allocate(sizeof(ElementType) * elements.size(), alignof(ElementType)));
+                    for (std::size_t iteration = 0; iteration < elements.size(); ++iteration)
+                    {
+                        new (&data[iteration]) ElementType(elements[iteration]);
+                    }
+                    return ArenaList<ElementType>(data, elements.size());
+                }
+
+                /**
+                 *  @brief Copies the given text into the arena.
+                 */
+                StringView createString(const char* data, const std::size_t size);
+
+                /**
+                 *  @brief Copies the given text into the arena.
+                 */
+                StringView createString(const std::string& string);
+
+                /**
+                 *  @brief Retrieves the total number of bytes handed out by the arena so far.
+                 */
+                std::size_t getBytesAllocated() const;
+
+                /**
+                 *  @brief Retrieves the number of blocks the arena has allocated from the heap.
+                 */
+                std::size_t getBlockCount() const;
+
+            private:
+                ASTArena(const ASTArena&) = delete;
+                ASTArena& operator=(const ASTArena&) = delete;
+
+                //! All blocks allocated by the arena.
+                std::vector<char*> mBlocks;
+
+                //! The next free byte in the current block.
+                char* mCurrent;
+
+                //! The end of the current block.
+                char* mEnd;
+
+                //! The total number of bytes handed out by the arena.
+                std::size_t mBytesAllocated;
+        };
+    }
+}
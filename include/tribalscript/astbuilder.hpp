@@ -23,6 +23,7 @@
 #include <tribalscript/stringtable.hpp>
 #include <tribalscript/instructions.hpp>
 #include <tribalscript/ast.hpp>
+#include <tribalscript/astarena.hpp>
 #include <tribalscript/instructionsequence.hpp>
 
 namespace TribalScript
@@ -34,7 +35,7 @@ namespace TribalScript
         class ASTBuilder : public Tribes2BaseVisitor
         {
             public:
-                ASTBuilder(StringTable* stringTable);
+                ASTBuilder(StringTable* stringTable, ASTArena* arena);
 
                 virtual antlrcpp::Any defaultResult() override;
 
@@ -83,6 +84,9 @@ namespace TribalScript
 
             private:
                 StringTable* mStringTable;
+
+                //! The arena all nodes, child lists and text of the tree are allocated from.
+                ASTArena* mArena;
         };
     }
 }
@@ -0,0 +1,351 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+
+#include <tribalscript/stringtable.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/instructionsequence.hpp>
+
+// Computed goto dispatch is a GCC extension also supported by Clang
+#if defined(__GNUC__) && !defined(TRIBALSCRIPT_NO_COMPUTED_GOTO)
+    #define TRIBALSCRIPT_COMPUTED_GOTO
+#endif
+
+namespace TribalScript
+{
+    class ExecutionState;
+    class Interpreter;
+    class Function;
+    class ConsoleObjectDescriptor;
+    class Bytecode;
+
+    /**
+     *  @brief All opcodes understood by Bytecode::execute. Each opcode occupies a single BytecodeWord in the
+     *  code stream and is followed directly by its operands.
+     */
+    enum class OpCode : std::uint8_t
+    {
+        PushFloat,              //!< float value
+        PushInteger,            //!< int value
+        PushString,             //!< string constant index
+        PushLocalReference,     //!< string table entry
+        PushLocalSlot,          //!< frame slot index
+        PushGlobalReference,    //!< string table entry
+        AddAssignment,
+        Assignment,
+        Concat,                 //!< separator string index
+        ConcatList,             //!< value count, separator string index for each pair of adjacent values
+        Negate,
+        Not,
+        CallFunction,           //!< namespace string index, name string index, argc, call site cache index
+        Add,
+        Minus,
+        Modulus,
+        LessThan,
+        GreaterThan,
+        GreaterThanOrEqual,
+        Equals,
+        NotEquals,
+        StringEquals,
+        StringNotEqual,
+        BitwiseAnd,
+        BitwiseOr,
+        Multiply,
+        Divide,
+        Pop,
+        Jump,                   //!< absolute target
+        JumpTrue,               //!< absolute target
+        JumpFalse,              //!< absolute target
+        JumpTrueOrPop,          //!< absolute target
+        JumpFalseOrPop,         //!< absolute target
+        NOP,
+        FunctionDeclaration,    //!< function prototype index
+        SubReference,           //!< string table entry, argc
+        Return,
+        Break,
+        Continue,
+        AccessArray,            //!< base name string index, argc, global flag
+        CallBoundFunction,      //!< name string index, argc, bound call site cache index
+        PushObjectInstantiation,
+        PushObjectField,        //!< field component count
+        PopObjectInstantiation, //!< children count
+
+        // Superinstructions formed by the InstructionOptimizer from common opcode sequences
+        IncrementLocalSlot,         //!< frame slot index, int amount
+        CompareLocalSlotJumpFalse,  //!< frame slot index, comparison opcode, float value, absolute target
+        PushLocalSlotField,         //!< frame slot index, string table entry
+
+        Halt,
+
+        OpCodeCount
+    };
+
+    /**
+     *  @brief Retrieves the name of an opcode for use in diagnostics.
+     *  @param op The opcode to look up.
+     *  @return The name of the opcode as spelled in OpCode.
+     */
+    const char* getOpCodeName(const OpCode op);
+
+    //! A single unit of encoded bytecode. Opcodes and all operands are stored as whole words.
+    typedef std::uint32_t BytecodeWord;
+
+    /**
+     *  @brief A function declared within a piece of Bytecode. The body is lowered once at assembly time and shared
+     *  by every Function instance that is registered from it.
+     */
+    struct FunctionPrototype
+    {
+        //! The package this function is defined in.
+        std::string mPackageName;
+
+        //! The namespace this function is defined in.
+        std::string mNameSpace;
+
+        //! The name of this function.
+        std::string mName;
+
+        //! The names of all parameters this function is expecting.
+        std::vector<std::string> mParameterNames;
+
+        //! The names of all locals resolved to frame slots, indexed by slot.
+        std::vector<StringTableEntry> mLocalSlotNames;
+
+        //! The lowered body of this function.
+        std::shared_ptr<Bytecode> mBody;
+    };
+
+    /**
+     *  @brief The function a CallFunction site resolved to the last time it was executed. The cached function is valid
+     *  for as long as the interpreter's function generation has not changed since it was resolved.
+     */
+    struct CallSiteCache
+    {
+        explicit CallSiteCache(const bool parentCall) : mParentCall(parentCall), mInterpreter(nullptr), mGeneration(0), mCaller(nullptr), mFunction(nullptr)
+        {
+
+        }
+
+        //! Whether this site calls parent::, in which case the result also depends on the calling function.
+        bool mParentCall;
+
+        //! The interpreter the function was resolved in.
+        Interpreter* mInterpreter;
+
+        //! The function generation of mInterpreter at the time the function was resolved.
+        std::size_t mGeneration;
+
+        //! For parent:: calls, the function the call was made from.
+        Function* mCaller;
+
+        //! The resolved function. This may be nullptr if no function was found.
+        Function* mFunction;
+    };
+
+    /**
+     *  @brief Polymorphic inline cache for a CallBoundFunction site, mapping the descriptors of the objects the site was
+     *  called on to the function each resolved to. All entries are dropped when the interpreter's function generation
+     *  changes.
+     */
+    struct BoundCallSiteCache
+    {
+        //! The number of receiver types each call site remembers.
+        static const std::size_t MaximumEntries = 4;
+
+        struct Entry
+        {
+            //! The descriptor of the object the call was made on.
+            ConsoleObjectDescriptor* mDescriptor;
+
+            //! The resolved function. This may be nullptr if no function was found.
+            Function* mFunction;
+        };
+
+        BoundCallSiteCache() : mInterpreter(nullptr), mGeneration(0), mUsedEntries(0), mNextReplacedEntry(0)
+        {
+
+        }
+
+        //! The interpreter all entries were resolved in.
+        Interpreter* mInterpreter;
+
+        //! The function generation of mInterpreter at the time all entries were resolved.
+        std::size_t mGeneration;
+
+        //! All cached receiver types.
+        Entry mEntries[MaximumEntries];
+
+        //! The number of entries in use.
+        std::size_t mUsedEntries;
+
+        //! Once all entries are in use, the entry to replace next.
+        std::size_t mNextReplacedEntry;
+    };
+
+    /**
+     *  @brief A flat, contiguous encoding of an InstructionSequence. Each instruction is stored as an opcode word
+     *  followed by its inline operands; strings and function declarations are referenced by index into pools owned
+     *  by the Bytecode. Every Bytecode is terminated by OpCode::Halt so the dispatch loop never has to bounds check.
+     */
+    class Bytecode
+    {
+        public:
+            /**
+             *  @brief Runs this bytecode against the current frame of the provided execution state.
+             *  @param state The execution state to act upon.
+             */
+            void execute(ExecutionState* state);
+
+            /**
+             *  @brief Checks that the instruction stream can be executed safely. Every opcode must be known, every
+             *  instruction must fit within the code, every operand indexing a pool, cache or frame slot must be in
+             *  range, every jump must target the start of an instruction and the last instruction must be Halt.
+             *  Bytecode produced by BytecodeAssembler always passes, so this is only needed for untrusted input.
+             *  @param localSlotCount The number of frame slots available when this bytecode is executed.
+             *  @return True if the bytecode is well formed.
+             */
+            bool validate(const std::size_t localSlotCount) const;
+
+            //! The encoded instruction stream.
+            std::vector<BytecodeWord> mCode;
+
+            //! Word offsets of every string table entry operand in mCode. String table entries are only meaningful
+            //! to the interpreter that assigned them, so these are remapped when bytecode is loaded from a cache.
+            std::vector<std::size_t> mStringTableEntryOperands;
+
+            //! Strings such as names and separators referenced by index from mCode.
+            std::vector<std::string> mStrings;
+
+            //! String literals, prebuilt so pushing them only has to copy a StoredValue.
+            std::vector<StoredValue> mStringConstants;
+
+            //! Functions declared by index from mCode.
+            std::vector<FunctionPrototype> mFunctions;
+
+            //! Resolution caches for each CallFunction site, referenced by index from mCode.
+            std::vector<CallSiteCache> mCallSiteCaches;
+
+            //! Resolution caches for each CallBoundFunction site, referenced by index from mCode.
+            std::vector<BoundCallSiteCache> mBoundCallSiteCaches;
+
+        private:
+            void callFunction(ExecutionState* state, const BytecodeWord* operands);
+            void callBoundFunction(ExecutionState* state, const BytecodeWord* operands);
+            void concat(ExecutionState* state, const std::size_t count, const BytecodeWord* separators);
+            void subReference(ExecutionState* state, const BytecodeWord* operands);
+            void pushLocalSlotField(ExecutionState* state, StoredValue* locals, const BytecodeWord* operands);
+            void accessArray(ExecutionState* state, const BytecodeWord* operands);
+            void pushObjectField(ExecutionState* state, const BytecodeWord* operands);
+            void popObjectInstantiation(ExecutionState* state, const BytecodeWord* operands);
+    };
+
+    /**
+     *  @brief Lowers an InstructionSequence into Bytecode. Instructions encode themselves through the emit
+     *  functions here while jump offsets, which are relative instruction counts in an InstructionSequence, are
+     *  recorded and patched to absolute word offsets once the whole sequence has been emitted.
+     */
+    class BytecodeAssembler
+    {
+        public:
+            /**
+             *  @brief Lowers the provided instructions into a new Bytecode instance.
+             *  @param instructions The instructions to lower.
+             *  @return The resulting bytecode.
+             */
+            static std::shared_ptr<Bytecode> assemble(const InstructionSequence& instructions);
+
+            void emitOpCode(const OpCode op);
+            void emitWord(const BytecodeWord word);
+            void emitInteger(const int value);
+            void emitFloat(const float value);
+
+            /**
+             *  @brief Emits a string table entry, recording its location so it can be remapped.
+             */
+            void emitStringTableEntry(const StringTableEntry entry);
+
+            /**
+             *  @brief Emits the index of a string, adding it to the string pool if necessary.
+             */
+            void emitString(const std::string& value);
+
+            /**
+             *  @brief Emits the index of a string literal, adding it to the string constant pool if necessary.
+             */
+            void emitStringConstant(const std::string& value);
+
+            /**
+             *  @brief Emits a jump opcode targeting an instruction relative to the one currently being encoded.
+             *  @param op The jump opcode to emit.
+             *  @param offset The relative instruction offset to jump to.
+             */
+            void emitJump(const OpCode op, const AddressOffsetType offset);
+
+            /**
+             *  @brief Emits the target operand of a jump, for opcodes whose target does not directly follow the opcode.
+             *  @param offset The relative instruction offset to jump to.
+             */
+            void emitJumpTarget(const AddressOffsetType offset);
+
+            /**
+             *  @brief Emits the index of a new function prototype.
+             */
+            void emitFunction(const FunctionPrototype& prototype);
+
+            /**
+             *  @brief Emits the index of a new call site cache.
+             *  @param parentCall Whether the call site calls parent::.
+             */
+            void emitCallSiteCache(const bool parentCall);
+
+            /**
+             *  @brief Emits the index of a new bound call site cache.
+             */
+            void emitBoundCallSiteCache();
+
+        private:
+            BytecodeAssembler();
+
+            struct JumpFixup
+            {
+                //! Word offset of the operand to patch.
+                std::size_t mOperand;
+
+                //! Instruction index to jump to.
+                AddressOffsetType mTarget;
+            };
+
+            //! The bytecode being generated.
+            std::shared_ptr<Bytecode> mBytecode;
+
+            //! Index of the instruction currently being encoded.
+            std::size_t mInstructionIndex;
+
+            //! All jumps awaiting their final address.
+            std::vector<JumpFixup> mJumpFixups;
+
+            //! Indices of all strings already in the string pool.
+            std::unordered_map<std::string, BytecodeWord> mStringIndices;
+
+            //! Indices of all strings already in the string constant pool.
+            std::unordered_map<std::string, BytecodeWord> mStringConstantIndices;
+    };
+}
@@ -0,0 +1,70 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include <tribalscript/stringtable.hpp>
+
+namespace TribalScript
+{
+    class Bytecode;
+    struct InterpreterConfiguration;
+
+    /**
+     *  @brief Converts Bytecode to and from a binary form so compiled scripts can be cached on disk. The header
+     *  records a format version, every compile option that affects the generated code and a hash of the source the
+     *  bytecode was compiled from, and loading fails if any of them does not match. String table entries are stored as strings and assigned again when loaded.
+     */
+    class BytecodeSerializer
+    {
+        public:
+            //! Incremented whenever the binary format, the meaning of any opcode or the way constants folded into
+            //! the bytecode are formatted changes.
+            static const std::uint32_t FormatVersion = 7;
+
+            /**
+             *  @brief Computes the hash of script source recorded in serialized bytecode.
+             *  @param source The script source.
+             *  @return The hash of source.
+             */
+            static std::uint64_t hashSource(const std::string& source);
+
+            /**
+             *  @brief Converts bytecode to its binary form.
+             *  @param bytecode The bytecode to convert.
+             *  @param sourceHash The hash of the source the bytecode was compiled from.
+             *  @param config The configuration the bytecode was compiled with. Case sensitivity, the optimization level
+             *  and the frontend are recorded.
+             *  @param stringTable The string table all entries referenced by bytecode were assigned from.
+             *  @return The binary form of bytecode.
+             */
+            static std::string serialize(const Bytecode& bytecode, const std::uint64_t sourceHash, const InterpreterConfiguration& config, const StringTable& stringTable);
+
+            /**
+             *  @brief Loads bytecode from its binary form.
+             *  @param data The binary form produced by serialize.
+             *  @param sourceHash The hash of the current source. Loading fails if this does not match the recorded hash.
+             *  @param config The configuration of the loading interpreter. Loading fails if any recorded compile option
+             *  does not match it.
+             *  @param stringTable The string table to assign all referenced entries from.
+             *  @return The loaded bytecode. If data is out of date, of a different version or malformed, nullptr is
+             *  returned.
+             */
+            static std::shared_ptr<Bytecode> deserialize(const std::string& data, const std::uint64_t sourceHash, const InterpreterConfiguration& config, StringTable& stringTable);
+    };
+}
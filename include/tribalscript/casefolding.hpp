@@ -0,0 +1,134 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Folds ASCII upper case letters to lower case, leaving every other byte alone. Eight characters are
+     *  folded at a time using plain 64-bit integer arithmetic, so this is fast without relying on any particular
+     *  instruction set. This never allocates.
+     *  @param in The characters to fold.
+     *  @param length The number of characters in in.
+     *  @param out Receives length folded characters. This may be the same as in.
+     */
+    void foldCase(const char* in, const std::size_t length, char* out);
+
+    /**
+     *  @brief Compares two strings ignoring ASCII case without folding either into a copy.
+     */
+    bool equalsCaseInsensitive(const char* lhs, const std::size_t lhsLength, const char* rhs, const std::size_t rhsLength);
+
+    inline bool equalsCaseInsensitive(const std::string& lhs, const std::string& rhs)
+    {
+        return equalsCaseInsensitive(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+
+    inline bool equalsCaseInsensitive(const std::string& lhs, const char* rhs)
+    {
+        return equalsCaseInsensitive(lhs.data(), lhs.size(), rhs, std::strlen(rhs));
+    }
+
+    /**
+     *  @brief Orders two strings ignoring ASCII case, comparing folded characters as unsigned bytes.
+     *  @return A negative value if lhs orders first, a positive value if rhs orders first and zero if both are equal.
+     */
+    int compareCaseInsensitive(const char* lhs, const std::size_t lhsLength, const char* rhs, const std::size_t rhsLength);
+
+    /**
+     *  @brief Hashes a string ignoring ASCII case, so that strings that only differ by case hash the same.
+     */
+    std::size_t hashCaseInsensitive(const char* in, const std::size_t length);
+
+    //! Hasher for containers keyed by names that are looked up ignoring case.
+    struct CaseInsensitiveHash
+    {
+        std::size_t operator()(const std::string& value) const
+        {
+            return hashCaseInsensitive(value.data(), value.size());
+        }
+    };
+
+    //! Key equality for containers keyed by names that are looked up ignoring case.
+    struct CaseInsensitiveEqual
+    {
+        bool operator()(const std::string& lhs, const std::string& rhs) const
+        {
+            return equalsCaseInsensitive(lhs, rhs);
+        }
+    };
+
+    //! Key ordering for ordered containers keyed by names that are looked up ignoring case.
+    struct CaseInsensitiveLess
+    {
+        bool operator()(const std::string& lhs, const std::string& rhs) const
+        {
+            return compareCaseInsensitive(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+        }
+    };
+
+    //! Hasher for containers keyed by names whose case sensitivity is chosen when the container is created.
+    struct ConfigurableCaseHash
+    {
+        explicit ConfigurableCaseHash(const bool caseSensitive = false) : mCaseSensitive(caseSensitive)
+        {
+
+        }
+
+        std::size_t operator()(const std::string& value) const
+        {
+            return mCaseSensitive ? std::hash<std::string>()(value) : hashCaseInsensitive(value.data(), value.size());
+        }
+
+        bool mCaseSensitive;
+    };
+
+    //! Key equality for containers keyed by names whose case sensitivity is chosen when the container is created.
+    struct ConfigurableCaseEqual
+    {
+        explicit ConfigurableCaseEqual(const bool caseSensitive = false) : mCaseSensitive(caseSensitive)
+        {
+
+        }
+
+        bool operator()(const std::string& lhs, const std::string& rhs) const
+        {
+            return mCaseSensitive ? lhs == rhs : equalsCaseInsensitive(lhs, rhs);
+        }
+
+        bool mCaseSensitive;
+    };
+
+    /**
+     *  @brief A map keyed by names that are looked up ignoring case. Names can be looked up as they were written
+     *  rather than folding them to lower case first, which saves an allocation on every lookup. Keys keep the case
+     *  they were first inserted with.
+     */
+    template <typename ValueType>
+    using CaseInsensitiveMap = std::unordered_map<std::string, ValueType, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
+    /**
+     *  @brief A map keyed by names that are looked up either exactly or ignoring case, depending on the hasher and
+     *  key equality it was constructed with. Names are never folded, so lookups do not allocate in either case.
+     */
+    template <typename ValueType>
+    using ConfigurableCaseMap = std::unordered_map<std::string, ValueType, ConfigurableCaseHash, ConfigurableCaseEqual>;
+}
@@ -28,6 +28,7 @@ namespace TribalScript
     class StringTable;
     class ExecutionState;
     class Function;
+    class Bytecode;
 
     /**
      *  @brief A CodeBlock defines a piece of executable code generated from a single input (Ie. a file).
@@ -39,7 +40,13 @@ namespace TribalScript
             CodeBlock(const InstructionSequence& instructions);
 
             /**
-             *  @brief Executes all instructions contained in mInstructions within the provided context.
+             *  @brief Constructs a CodeBlock around bytecode that was already generated, such as bytecode loaded
+             *  from a cache. Such CodeBlocks have no instructions to disassemble.
+             */
+            explicit CodeBlock(std::shared_ptr<Bytecode> bytecode);
+
+            /**
+             *  @brief Executes the bytecode generated from mInstructions within the provided context.
              */
             void execute(ExecutionState* state);
 
@@ -48,11 +55,19 @@ namespace TribalScript
              */
             std::vector<std::string> disassemble();
 
+            /**
+             *  @brief Retrieves the bytecode this CodeBlock executes.
+             */
+            const Bytecode& getBytecode();
+
         private:
             //! All functions registered in this codeblock.
             std::vector<std::shared_ptr<Function>> mFunctions;
 
             //! All instructions that were generated global to the block - ie. should be executed immediately
             InstructionSequence mInstructions;
+
+            //! mInstructions lowered to bytecode. This is what is actually executed.
+            std::shared_ptr<Bytecode> mBytecode;
     };
 }
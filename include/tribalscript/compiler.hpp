@@ -18,6 +18,7 @@
 
 #include "antlr4-runtime.h"
 
+#include <tribalscript/astarena.hpp>
 #include <tribalscript/astvisitor.hpp>
 #include <tribalscript/codeblock.hpp>
 #include <tribalscript/stringtable.hpp>
@@ -30,6 +31,9 @@ namespace TribalScript
     /**
      *  @brief Primary compiler class. This class is an AST visitor that walks the AST tree
      *  generated by a AST::ASTBuilder instance to generate an InstructionSequence instance.
+     *  @details Code is generated in a single pass: each visit appends its instructions to one output
+     *  sequence rather than returning its own, and jumps to code not yet generated are emitted against
+     *  a Label and patched once the label is bound.
      */
     class Compiler : public AST::ASTVisitor
     {
@@ -61,9 +65,115 @@ namespace TribalScript
             const InterpreterConfiguration mConfig;
 
         private:
+            /**
+             *  @brief The kinds of jump the compiler emits against labels.
+             */
+            enum class JumpType
+            {
+                Jump,
+                JumpTrue,
+                JumpFalse,
+                JumpTrueOrPop,
+                JumpFalseOrPop
+            };
+
+            /**
+             *  @brief A position in the output that jumps may target before it is generated.
+             */
+            struct Label
+            {
+                Label() : mBound(false), mAddress(0)
+                {
+
+                }
+
+                //! Whether the position of this label is known yet.
+                bool mBound;
+
+                //! The position of this label in the output once bound.
+                AddressType mAddress;
+
+                //! Jumps emitted before this label was bound, as their position in the output and their kind.
+                std::vector<std::pair<AddressType, JumpType>> mPatches;
+            };
+
+            /**
+             *  @brief The targets of break and continue within a loop being compiled.
+             */
+            struct LoopLabels
+            {
+                Label* mBreak;
+                Label* mContinue;
+            };
+
             std::string mCurrentPackage;
+
+            //! The sequence instructions are currently being emitted to.
+            InstructionSequence mOutput;
+
+            //! The loops enclosing the code currently being compiled, innermost last.
+            std::vector<LoopLabels> mLoops;
+
+            //! Whether locals are being resolved to frame slots. This is only the case within function bodies.
+            bool mResolveLocalSlots;
+
+            //! The names of all locals resolved to slots in the function currently being compiled, indexed by slot.
+            std::vector<StringTableEntry> mLocalSlotNames;
+
+            /**
+             *  @brief Resolves a local variable in the function being compiled to a frame slot, assigning a new
+             *  slot if necessary.
+             *  @param name The name of the local variable.
+             *  @return The slot index of the local variable.
+             */
+            std::size_t getOrAssignLocalSlot(const StringTableEntry name);
             StringTable* mStringTable;
 
+            /**
+             *  @brief Parses a program with the ANTLR frontend, logging any syntax errors.
+             *  @param input The input to parse.
+             *  @param arena The arena to build the tree in.
+             *  @return The parsed program. If an error has occurred, nullptr is returned.
+             */
+            AST::ProgramNode* parseWithANTLR(std::istream& input, StringTable* stringTable, AST::ASTArena* arena);
+
+            /**
+             *  @brief Parses a program with the hand written frontend, logging any syntax errors. The source is read
+             *  into the arena so that the tree can view it directly.
+             *  @param input The input to parse.
+             *  @param arena The arena to build the tree in.
+             *  @return The parsed program. If an error has occurred, nullptr is returned.
+             */
+            AST::ProgramNode* parseWithHandWrittenFrontend(std::istream& input, AST::ASTArena* arena);
+
+            /**
+             *  @brief Appends an instruction to the output, taking ownership of it.
+             */
+            void emit(Instructions::Instruction* instruction);
+
+            /**
+             *  @brief Creates a jump instruction of the given kind.
+             *  @param type The kind of jump to create.
+             *  @param offset The offset of the jump target relative to the jump itself.
+             */
+            static Instructions::Instruction* createJump(const JumpType type, const AddressOffsetType offset);
+
+            /**
+             *  @brief Appends a jump to the given label. If the label is not yet bound, a placeholder is emitted
+             *  and patched once it is.
+             */
+            void emitJump(const JumpType type, Label& label);
+
+            /**
+             *  @brief Binds the label to the next instruction emitted and patches all jumps waiting on it.
+             */
+            void bindLabel(Label& label);
+
+            /**
+             *  @brief Emits the code for each of the given nodes in order.
+             */
+            void emitNodes(const AST::ArenaList<AST::ASTNode*>& nodes);
+
             /*
                 Compiler Routines ==============================
             */
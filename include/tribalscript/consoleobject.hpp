@@ -20,6 +20,7 @@
 #include <unordered_map>
 
 #include <tribalscript/storedvalue.hpp>
+#include <tribalscript/casefolding.hpp>
 
 namespace TribalScript
 {
@@ -31,10 +32,12 @@ namespace TribalScript
 
     typedef ConsoleObject* (*InitializeConsoleObjectFromDescriptorPointer)(Interpreter* interpreter, struct ObjectInstantiationDescriptor& descriptor);
 
+    class Function;
+
     class ConsoleObjectDescriptor
     {
         public:
-            ConsoleObjectDescriptor(const std::string& name, const std::string& parentName, InitializeConsoleObjectFromDescriptorPointer initializePointer) : mName(name), mParentName(parentName), mInitializePointer(initializePointer)
+            ConsoleObjectDescriptor(const std::string& name, const std::string& parentName, InitializeConsoleObjectFromDescriptorPointer initializePointer) : mName(name), mParentName(parentName), mInitializePointer(initializePointer), mMethodTableGeneration(0)
             {
 
             }
@@ -43,6 +46,13 @@ namespace TribalScript
             std::string mParentName;
             std::vector<std::string> mHierarchy;
             InitializeConsoleObjectFromDescriptorPointer mInitializePointer;
+
+            //! Every function callable on objects of this type by name ignoring case, flattened from the entire hierarchy.
+            //! This is built on demand by Interpreter::getBoundFunction.
+            CaseInsensitiveMap<Function*> mMethodTable;
+
+            //! The function generation mMethodTable was built in.
+            std::size_t mMethodTableGeneration;
     };
 
     template <typename classType>
@@ -122,6 +132,12 @@ namespace TribalScript
 
             virtual std::string getVirtualClassName();
 
+            /**
+             *  @brief Retrieves the descriptor of the type returned by getVirtualClassName.
+             *  @return The descriptor of this object's type, or nullptr if there is none.
+             */
+            ConsoleObjectDescriptor* getDescriptor();
+
             virtual bool addChild(ConsoleObject* child);
 
 			virtual bool destroy();
@@ -131,11 +147,14 @@ namespace TribalScript
         protected:
             Interpreter* mInterpreter;
 
+            //! The descriptor of this object's type, resolved on first use.
+            ConsoleObjectDescriptor* mDescriptor;
+
 			std::vector<ConsoleObject*> mChildren;
 			std::vector<ConsoleObject*> mParents;
 
-            //! A mapping of tagged field names to their stored values.
-            std::unordered_map<std::string, StoredValue*> mTaggedFields;
+            //! A mapping of tagged field names to their stored values, ignoring case.
+            CaseInsensitiveMap<StoredValue*> mTaggedFields;
     };
 
     template<>
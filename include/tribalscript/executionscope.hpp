@@ -14,11 +14,13 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 
 #include <tribalscript/storedvalue.hpp>
+#include <tribalscript/casefolding.hpp>
 #include <tribalscript/stringhelpers.hpp>
 #include <tribalscript/function.hpp>
 #include <tribalscript/stringtable.hpp>
@@ -62,25 +64,75 @@ namespace TribalScript
         //! All children of this object. These will not be initialized until the parent is initialized.
         std::vector<ObjectInstantiationDescriptor> mChildren;
 
-        //! All resolved field names mapped to the values to set.
-        std::map<std::string, StoredValue> mFieldAssignments;
+        //! All resolved field names mapped to the values to set, ignoring case like the fields themselves.
+        std::map<std::string, StoredValue, CaseInsensitiveLess> mFieldAssignments;
+    };
+
+    /**
+     *  @brief Stack allocator for the slot resolved local variables of each frame. Storage is held in blocks that are
+     *  never reallocated so that references to slots pushed on to the stack remain valid while nested calls push
+     *  frames of their own.
+     */
+    class LocalSlotStack
+    {
+        public:
+            LocalSlotStack();
+
+            /**
+             *  @brief Allocates a contiguous run of slots initialized to 0.
+             *  @param count The number of slots to allocate.
+             *  @return The first allocated slot, or nullptr if count is 0.
+             */
+            StoredValue* allocate(const std::size_t count);
+
+            /**
+             *  @brief Releases the most recently allocated run of slots.
+             *  @param slots The first slot of the run as returned by allocate.
+             *  @param count The number of slots in the run.
+             */
+            void release(StoredValue* slots, const std::size_t count);
+
+        private:
+            struct Block
+            {
+                explicit Block(const std::size_t capacity);
+
+                //! All slots in this block. This is never resized so the slots never move.
+                std::vector<StoredValue> mSlots;
+
+                //! The number of slots currently allocated from this block.
+                std::size_t mUsed;
+            };
+
+            //! All blocks allocated so far. Blocks after mCurrentBlock are always empty.
+            std::vector<Block> mBlocks;
+
+            //! The block slots are currently being allocated from.
+            std::size_t mCurrentBlock;
     };
 
     struct ExecutionScopeData
     {
-        explicit ExecutionScopeData(Function* function) : mCurrentFunction(function)
+        explicit ExecutionScopeData(Function* function) : mCurrentFunction(function), mLocalSlots(nullptr), mLocalSlotCount(0)
         {
 
         }
 
         Function* mCurrentFunction;
 
+        //! Local variables resolved to slots by the compiler.
+        StoredValue* mLocalSlots;
+
+        //! The number of entries in mLocalSlots.
+        std::size_t mLocalSlotCount;
+
         //! The stack used for execution in this state.
         StoredValueStack mStack;
 
         //! Awaiting root-level object instantiations.
         std::vector<ObjectInstantiationDescriptor> mObjectInstantiations;
 
+        //! Locals that could not be resolved to a slot, such as those accessed as arrays or from outside of a function.
         std::map<StringTableEntry, StoredValue*> mLocalVariables;
     };
 
@@ -107,6 +159,12 @@ namespace TribalScript
             StoredValueStack& getStack();
             StoredValueStack& getReturnStack();
 
+            /**
+             *  @brief Retrieves the slot resolved locals of the current frame.
+             *  @return The first local slot of the current frame, or nullptr if the frame has none.
+             */
+            StoredValue* getLocalSlots();
+
             StoredValue* getVariable(const std::string& name);
             StoredValue* getVariable(const StringTableEntry name);
             StoredValue* getVariableOrAllocate(const StringTableEntry name);
@@ -119,9 +177,24 @@ namespace TribalScript
             const InterpreterConfiguration mConfig;
 
         private:
+            StoredValue* findLocalSlot(ExecutionScopeData& scope, const StringTableEntry name);
+
+            //! Looks up the entry a variable name is keyed by without interning the name.
+            bool findName(const std::string& name, StringTableEntry& result) const;
+
+            //! Retrieves the entry a variable name is keyed by, interning the name if necessary.
+            StringTableEntry internName(const std::string& name);
+
             StringTable* mStringTable;
 
-            //! A stack of mappings of local variable names to their stored value instance.
-            std::vector<ExecutionScopeData> mExecutionScopeData;
+            //! Storage for the slot resolved locals of all frames.
+            LocalSlotStack mLocalSlotStack;
+
+            //! A stack of mappings of local variable names to their stored value instance. Frames are heap allocated so that
+            //! they never move, and entries beyond mFrameDepth are kept for reuse.
+            std::vector<std::unique_ptr<ExecutionScopeData>> mExecutionScopeData;
+
+            //! The number of frames currently in use.
+            std::size_t mFrameDepth;
     };
 }
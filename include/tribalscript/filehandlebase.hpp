@@ -42,6 +42,12 @@ namespace TribalScript
             virtual void openForRead() = 0;
             virtual void openForReadAndWrite() = 0;
 
+            //! Opens the file for reading without newline translation. By default this is the same as openForRead.
+            virtual void openForBinaryRead();
+
+            //! Opens the file for writing without newline translation. By default this is the same as openForWrite.
+            virtual void openForBinaryWrite();
+
             virtual bool exists() = 0;
             virtual bool deleteFile() = 0;
 
@@ -18,6 +18,8 @@
 #include <vector>
 #include <memory>
 
+#include <tribalscript/stringtable.hpp>
+#include <tribalscript/storedvaluespan.hpp>
 #include <tribalscript/instructionsequence.hpp>
 
 namespace TribalScript
@@ -31,6 +33,7 @@ namespace TribalScript
     class StoredValueStack;
     class ExecutionState;
     class ConsoleObject;
+    class Bytecode;
 
     /**
      *  @brief A function is callable subroutine from anywhere in the language, defined by a script. A NativeFunction is a specialization
@@ -42,13 +45,34 @@ namespace TribalScript
             Function(const std::string& package, const std::string& space, const std::string& name);
             Function(const std::string& package, const std::string& space, const std::string& name, const std::vector<std::string>& parameterNames);
 
-            void addInstructions(const InstructionSequence& instructions);
+            /**
+             *  @brief Sets the bytecode executed when this function is called.
+             *  @param bytecode The lowered function body.
+             */
+            void setBytecode(std::shared_ptr<Bytecode> bytecode);
+
+            /**
+             *  @brief Sets the names of all locals the compiler resolved to frame slots. The first slots always hold
+             *  the parameters in declaration order.
+             *  @param names The names of each slot, indexed by slot.
+             */
+            void setLocalSlotNames(const std::vector<StringTableEntry>& names);
+
+            /**
+             *  @brief Retrieves the names of all locals resolved to frame slots.
+             *  @return The names of each slot, indexed by slot.
+             */
+            const std::vector<StringTableEntry>& getLocalSlotNames();
 
             /**
              *  @brief Default implementation will execute virtual instructions but can be overridden to implement native
              *  functions.
+             *  @param thisObject The object this function is being called on, if any.
+             *  @param state The execution state to run in.
+             *  @param parameters The arguments to the call. These live on the caller's stack, so the callee leaves its
+             *  return value on top of them and the caller is responsible for removing them afterwards.
              */
-            virtual void execute(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+            virtual void execute(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
             /**
              *  @brief Retrieves the declared name of this function.
@@ -78,9 +102,12 @@ namespace TribalScript
             //! The name of the function.
             std::string mName;
 
-            //! All instructions associated with this function.
-            InstructionSequence mInstructions;
+            //! The bytecode associated with this function.
+            std::shared_ptr<Bytecode> mBytecode;
 
             std::vector<std::string> mParameterNames;
+
+            //! The names of all locals resolved to frame slots.
+            std::vector<StringTableEntry> mLocalSlotNames;
     };
 }
@@ -19,6 +19,7 @@
 #include <unordered_map>
 
 #include <tribalscript/function.hpp>
+#include <tribalscript/casefolding.hpp>
 
 namespace TribalScript
 {
@@ -40,13 +41,13 @@ namespace TribalScript
 
         }
 
-        //! The package this registry belongs to.
+        //! The package this registry belongs to. Package names are compared ignoring case.
         std::string mPackageName;
 
         //! Whether or not the registry is currently active.
         bool mActive;
 
-        //! A mapping of function namespaces to a mapping of function names to the function object.
-        std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<Function>>> mFunctions;
+        //! A mapping of function namespaces to a mapping of function names to the function object, both ignoring case.
+        CaseInsensitiveMap<CaseInsensitiveMap<std::shared_ptr<Function>>> mFunctions;
     };
 }
@@ -0,0 +1,171 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include <tribalscript/bytecode.hpp>
+#include <tribalscript/instructionsequence.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Optimization pass run over the InstructionSequence generated by the Compiler before it is assembled.
+     *  Arithmetic, comparisons and concatenations of constants are folded using the same coercions the interpreter
+     *  applies at runtime, conditional jumps on constants are resolved, unreachable code is removed and NOPs used as
+     *  jump landing pads are stripped, with all jumps retargeted accordingly. The jumps short circuiting && and || are
+     *  threaded through the conditional jumps they land on, so they branch directly when used as conditions. Finally,
+     *  the most frequent opcode sequences operating on local slots are fused into superinstructions.
+     */
+    class InstructionOptimizer
+    {
+        public:
+            /**
+             *  @brief Optimizes a complete sequence of instructions. Jumps in the sequence must not target anything
+             *  outside of it other than its end.
+             *  @param instructions The instructions to optimize.
+             *  @return The optimized instructions.
+             */
+            static InstructionSequence optimize(const InstructionSequence& instructions);
+
+        private:
+            enum class JumpType
+            {
+                None,
+                Jump,
+                JumpTrue,
+                JumpFalse,
+                JumpTrueOrPop,
+                JumpFalseOrPop,
+                CompareLocalSlotJumpFalse
+            };
+
+            struct Entry
+            {
+                //! The instruction. For jumps this is only kept for reference as they are rebuilt from mJumpType and
+                //! mTarget once optimization completes.
+                std::shared_ptr<Instructions::Instruction> mInstruction;
+
+                //! The kind of jump this is, if any.
+                JumpType mJumpType;
+
+                //! For jumps, the index of the entry jumped to. An index one past the last entry is the end of the sequence.
+                std::size_t mTarget;
+
+                //! Whether this entry is dropped once the current pass completes.
+                bool mRemoved;
+
+                //! The number of operands consumed if this can be folded when all of them are constant, otherwise 0.
+                std::size_t mFoldedOperandCount;
+
+                //! Whether this pushes a constant.
+                bool mConstant;
+
+                //! Whether this is a NOP.
+                bool mNOP;
+
+                //! Whether execution never continues to the next entry after this one, as is the case for returns.
+                bool mReturn;
+
+                //! For CompareLocalSlotJumpFalse, the slot compared.
+                std::size_t mSlot;
+
+                //! For CompareLocalSlotJumpFalse, the comparison performed.
+                OpCode mComparison;
+
+                //! For CompareLocalSlotJumpFalse, the value compared against.
+                float mComparedValue;
+            };
+
+            /**
+             *  @brief Sets the mInstruction of a non jump entry and determines what kind of instruction it is.
+             */
+            static void setInstruction(Entry& entry, std::shared_ptr<Instructions::Instruction> instruction);
+
+            /*
+                Passes. Each returns whether anything was changed and only marks entries as removed, leaving the
+                retargeting of jumps to compact.
+            */
+
+            static bool foldConstants(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Merges the trailing values of a ConcatList that are all constant into a single string.
+             */
+            static bool foldConcatLists(std::vector<Entry>& entries);
+            static bool foldBranches(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Removes the conversion to 0 or 1 at the end of && and || when the right hand side already
+             *  produces 0 or 1, as comparisons do.
+             */
+            static bool removeBooleanConversions(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Retargets jumps through unconditional jumps and NOPs. Short circuiting jumps that land on another
+             *  conditional jump, as && and || do in conditions, take the outcome of that jump directly.
+             */
+            static bool threadJumps(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Threads a single JumpTrueOrPop or JumpFalseOrPop through the conditional jump or pop it lands on.
+             *  @return Whether the jump was changed.
+             */
+            static bool threadShortCircuit(std::vector<Entry>& entries, const std::size_t index);
+            static bool removeUnreachable(std::vector<Entry>& entries);
+            static bool removeNOPs(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Replaces sequences of instructions with equivalent superinstructions. This is run once all other
+             *  passes have completed as they do not understand superinstructions.
+             */
+            static void fuseInstructions(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Drops all removed entries. Jumps to removed entries are retargeted to the next entry that remains.
+             */
+            static void compact(std::vector<Entry>& entries);
+
+            /**
+             *  @brief Determines whether a jump type is JumpTrueOrPop or JumpFalseOrPop.
+             */
+            static bool isShortCircuit(const JumpType type);
+
+            /**
+             *  @brief Determines which entries are targeted by any jump.
+             *  @return A flag for each entry plus one for the end of the sequence.
+             */
+            static std::vector<bool> getJumpTargets(const std::vector<Entry>& entries);
+
+            /**
+             *  @brief Determines whether any entry within the provided inclusive range is targeted by a jump.
+             *  @param targets The result of getJumpTargets.
+             */
+            static bool isJumpTargetInRange(const std::vector<bool>& targets, const std::size_t first, const std::size_t last);
+
+            /**
+             *  @brief Finds the closest entry before the provided index that has not been removed.
+             *  @return The index of the entry, or the entry count if there is none.
+             */
+            static std::size_t getPreviousEntry(const std::vector<Entry>& entries, const std::size_t index);
+
+            /**
+             *  @brief Resolves where execution actually continues when arriving at the provided index, skipping over
+             *  NOPs and following unconditional jumps.
+             */
+            static std::size_t resolveTarget(const std::vector<Entry>& entries, std::size_t index);
+    };
+}
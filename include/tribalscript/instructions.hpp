@@ -26,6 +26,7 @@
 #include <tribalscript/storedvaluestack.hpp>
 #include <tribalscript/executionstate.hpp>
 #include <tribalscript/instructionsequence.hpp>
+#include <tribalscript/bytecode.hpp>
 
 namespace TribalScript
 {
@@ -39,11 +40,11 @@ namespace TribalScript
         {
             public:
                 /**
-                 *  @brief Main execution method of the instruction. This serves as our
-                 *  switching statement that determines how opcodes will behave.
-                 *  @param state The current execution state to act upon.
+                 *  @brief Encodes this instruction into the bytecode that is actually executed.
+                 *  Instructions themselves are only used for code generation and disassembly.
+                 *  @param assembler The assembler to emit the opcode and operands to.
                  */
-                virtual AddressOffsetType execute(ExecutionState* state) = 0;
+                virtual void encode(BytecodeAssembler& assembler) = 0;
 
                 /**
                  *  @brief Helper routine to produce a disassembly for this instruction.
@@ -66,12 +67,11 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    stack.emplace_back(mParameter);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::PushFloat);
+                    assembler.emitFloat(mParameter);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -80,6 +80,14 @@ namespace TribalScript
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the value pushed by this instruction.
+                 */
+                float getValue() const
+                {
+                    return mParameter;
+                }
+
             private:
                 //! The value to push.
                 float mParameter;
@@ -97,12 +105,11 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    stack.emplace_back(mParameter);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::PushInteger);
+                    assembler.emitInteger(mParameter);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -111,6 +118,14 @@ namespace TribalScript
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the value pushed by this instruction.
+                 */
+                int getValue() const
+                {
+                    return mParameter;
+                }
+
             private:
                 //! The value to push.
                 int mParameter;
@@ -128,12 +143,11 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    stack.emplace_back(mString.c_str());
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::PushString);
+                    assembler.emitStringConstant(mString);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -142,11 +156,50 @@ namespace TribalScript
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the value pushed by this instruction.
+                 */
+                const std::string& getValue() const
+                {
+                    return mString;
+                }
+
             private:
                 //! The string table ID of the parameter to push.
                 std::string mString;
         };
 
+        /**
+         *  @brief Push tagged string instruction. This pushes the string table entry of a tagged string
+         *  as an integer.
+         */
+        class PushTaggedStringInstruction : public Instruction
+        {
+            public:
+                PushTaggedStringInstruction(const StringTableEntry value) : mStringID(value)
+                {
+
+                }
+
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    // Encoded as an entry rather than an integer so it can be remapped when bytecode is loaded
+                    assembler.emitOpCode(OpCode::PushInteger);
+                    assembler.emitStringTableEntry(mStringID);
+                }
+
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream out;
+                    out << "PushTaggedString " << mStringID;
+                    return out.str();
+                }
+
+            private:
+                //! The string table ID of the tagged string.
+                StringTableEntry mStringID;
+        };
+
         /**
          *  @brief Push a reference to a named local variable. The parameter provided here
          *  should be excluding the '%' prefix.
@@ -159,12 +212,11 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    stack.emplace_back(state->mExecutionScope.getVariableOrAllocate(mStringID));
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::PushLocalReference);
+                    assembler.emitStringTableEntry(mStringID);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -178,6 +230,43 @@ namespace TribalScript
                 StringTableEntry mStringID;
         };
 
+        /**
+         *  @brief Push a reference to a local variable that the compiler resolved to a slot in the current frame.
+         */
+        class PushLocalSlotInstruction : public Instruction
+        {
+            public:
+                PushLocalSlotInstruction(const std::size_t slot) : mSlot(slot)
+                {
+
+                }
+
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitOpCode(OpCode::PushLocalSlot);
+                    assembler.emitWord(static_cast<BytecodeWord>(mSlot));
+                }
+
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream out;
+                    out << "PushLocalSlot " << mSlot;
+                    return out.str();
+                }
+
+                /**
+                 *  @brief Retrieves the slot pushed a reference to.
+                 */
+                std::size_t getSlot() const
+                {
+                    return mSlot;
+                }
+
+            private:
+                //! The slot to push a reference to.
+                std::size_t mSlot;
+        };
+
         /**
          *  @brief Push a reference to a named global variable. The parameter provided here
          *  should be excluding the '$' prefix.
@@ -190,12 +279,11 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    stack.emplace_back(state->mInterpreter->getGlobalOrAllocate(mStringID));
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::PushGlobalReference);
+                    assembler.emitStringTableEntry(mStringID);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -215,32 +303,10 @@ namespace TribalScript
         class AddAssignmentInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    // Pull two values off the stack
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    float resultRaw = 0.0f;
-                    resultRaw = lhsStored.toFloat();
-                    resultRaw += rhsStored.toFloat();
-
-                    StoredValue result = StoredValue(resultRaw);
-                    if (!lhsStored.setValue(result))
-                    {
-                        state->mInterpreter->mConfig.mPlatform->logError("Attempted to perform no-op assignment!");
-                    }
-
-                    stack.erase(stack.end() - 2, stack.end());
-
-                    // In Torque, the result of the assignment is pushed to stack
-                    stack.push_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::AddAssignment);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -254,27 +320,10 @@ namespace TribalScript
         class AssignmentInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    // Pull two values off the stack
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    if (!lhsStored.setValue(rhsStored))
-                    {
-                        state->mInterpreter->mConfig.mPlatform->logError("Attempted to perform no-op assignment!");
-                    }
-
-                    stack.erase(stack.end() - 2, stack.end());
-
-                    // In Torque, the result of the assignment is pushed to stack
-                    stack.push_back(rhsStored);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Assignment);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -294,37 +343,71 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
+                    assembler.emitOpCode(OpCode::Concat);
+                    assembler.emitString(mSeperator);
+                }
 
-                    // Pull two values off the stack
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream result;
+                    result << "Concat " << mSeperator;
+                    return result.str();
+                }
 
-                    std::string lhs = lhsStored.toString();
-                    std::string rhs = rhsStored.toString();
+                /**
+                 *  @brief Retrieves the separator placed between both values.
+                 */
+                const std::string& getSeperator() const
+                {
+                    return mSeperator;
+                }
 
-                    // Generate a new string ID
-                    const std::string requestedString = lhs + mSeperator + rhs;
+            private:
+                std::string mSeperator;
+        };
 
-                    stack.erase(stack.end() - 2, stack.end());
+        /**
+         *  @brief Concatenates several values at the top of the stack at once and pushes back the
+         *  result. The compiler emits this for chains of concatenations so that the result only has
+         *  to be built once.
+         */
+        class ConcatListInstruction : public Instruction
+        {
+            public:
+                ConcatListInstruction(const std::vector<std::string>& seperators) : mSeperators(seperators)
+                {
+                    assert(mSeperators.size() >= 2);
+                }
 
-                    stack.emplace_back(requestedString.c_str());
-                    return 1;
-                };
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitOpCode(OpCode::ConcatList);
+                    assembler.emitWord(static_cast<BytecodeWord>(mSeperators.size() + 1));
+                    for (const std::string& seperator : mSeperators)
+                    {
+                        assembler.emitString(seperator);
+                    }
+                }
 
                 virtual std::string disassemble() override
                 {
                     std::ostringstream result;
-                    result << "Concat " << mSeperator;
+                    result << "ConcatList " << mSeperators.size() + 1;
                     return result.str();
                 }
 
+                /**
+                 *  @brief Retrieves the separators placed between each pair of adjacent values.
+                 */
+                const std::vector<std::string>& getSeperators() const
+                {
+                    return mSeperators;
+                }
+
             private:
-                std::string mSeperator;
+                std::vector<std::string> mSeperators;
         };
 
 
@@ -334,20 +417,10 @@ namespace TribalScript
         class NegateInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 1);
-
-                    // Pull two values off the stack
-                    StoredValue& storedTarget = stack.back();
-
-                    const float result = -storedTarget.toFloat();
-                    stack.pop_back();
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Negate);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -361,20 +434,10 @@ namespace TribalScript
         class NotInstruction : public Instruction
         {
         public:
-            virtual AddressOffsetType execute(ExecutionState* state) override
+            virtual void encode(BytecodeAssembler& assembler) override
             {
-                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                assert(!stack.empty());
-
-                StoredValue& storedTarget = stack.back();
-
-                const int result = !storedTarget.toBoolean() ? 1 : 0;
-
-                stack.pop_back();
-                stack.emplace_back(result);
-                return 1;
-            };
+                assembler.emitOpCode(OpCode::Not);
+            }
 
             virtual std::string disassemble() override
             {
@@ -399,68 +462,14 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    const std::string namespaceName = toLowerCase(mNameSpace);
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    // FIXME: At the moment we're loading parameters like this which is incurring unnecessary copies
-                    std::vector<StoredValue> parameters;
-                    auto parametersStart = stack.end() - mArgc;
-
-                    for (std::size_t iteration = 0; iteration < mArgc; ++iteration)
-                    {
-                        auto iterator = parametersStart + iteration;
-                        parameters.push_back(*iterator);
-                    }
-                    stack.erase(parametersStart, stack.end());
-
-                    // If we're calling a parent function, perform an alternative lookup
-                    if (namespaceName == "parent")
-                    {
-                        Function* currentFunction = state->mExecutionScope.getCurrentFunction();
-                        if (!currentFunction)
-                        {
-                            state->mInterpreter->mConfig.mPlatform->logError("Attempted to call parent:: function at root!");
-                            stack.push_back(StoredValue(0));
-                            return 1;
-                        }
-
-                        // Once we have a valid function pointer, ask the interpreter to find a super function higher up the chain
-                        std::shared_ptr<Function> parentFunction = state->mInterpreter->getFunctionParent(currentFunction);
-                        if (!parentFunction)
-                        {
-                            std::ostringstream stream;
-
-                            stream << "Could not find parent function '" << mName << "' for calling! Placing 0 on the stack.";
-                            state->mInterpreter->mConfig.mPlatform->logError(stream.str());
-
-                            stack.push_back(StoredValue(0));
-                            return 1;
-                        }
-
-                        // Otherwise, call it
-                        parentFunction->execute(nullptr, state, parameters);
-
-                        return 1;
-                    }
-
-                    std::shared_ptr<Function> functionLookup = state->mInterpreter->getFunction(mNameSpace, mName);
-                    if (functionLookup)
-                    {
-                        functionLookup->execute(nullptr, state, parameters);
-                    }
-                    else
-                    {
-                        std::ostringstream stream;
-
-                        stream << "Could not find function '" << mName << "' for calling! Placing 0 on the stack.";
-                        state->mInterpreter->mConfig.mPlatform->logError(stream.str());
-
-                        stack.push_back(StoredValue(0));
-                    }
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::CallFunction);
+                    assembler.emitString(mNameSpace);
+                    assembler.emitString(mName);
+                    assembler.emitWord(static_cast<BytecodeWord>(mArgc));
+                    assembler.emitCallSiteCache(equalsCaseInsensitive(mNameSpace, "parent"));
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -488,93 +497,16 @@ namespace TribalScript
                     std::size_t mArgc;
         };
 
-        /**
-         *  @brief Performs a logical and of two values on the stack and pushes back the result.
-         */
-        class LogicalAndInstruction : public Instruction
-        {
-            public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
-                {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    const bool lhs = lhsStored.toBoolean();
-                    const bool rhs = rhsStored.toBoolean();
-
-                    const int result = lhs && rhs ? 1 : 0;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
-
-                virtual std::string disassemble() override
-                {
-                    return "LogicalAnd";
-                }
-        };
-
-        /**
-         *  @brief Performs a logical or of two values on the stack and pushes back the result.
-         */
-        class LogicalOrInstruction : public Instruction
-        {
-            public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
-                {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    const bool lhs = lhsStored.toBoolean();
-                    const bool rhs = rhsStored.toBoolean();
-
-                    const int result = lhs || rhs ? 1 : 0;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
-
-                virtual std::string disassemble() override
-                {
-                    return "LogicalOr";
-                }
-        };
-
         /**
          *  @brief Adds together two values on the stack and pushes the sum.
          */
         class AddInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-                    float lhs = lhsStored.toFloat();
-                    float rhs = rhsStored.toFloat();
-
-                    const float result = lhs + rhs;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Add);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -588,25 +520,10 @@ namespace TribalScript
         class MinusInstruction : public Instruction
         {
         public:
-            virtual AddressOffsetType execute(ExecutionState* state) override
+            virtual void encode(BytecodeAssembler& assembler) override
             {
-                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                assert(stack.size() >= 2);
-
-                StoredValue& rhsStored = *(stack.end() - 1);
-                StoredValue& lhsStored = *(stack.end() - 2);
-
-                // NOTE: For now we normalize to floats
-                float lhs = lhsStored.toFloat();
-                float rhs = rhsStored.toFloat();
-
-                const float result = lhs - rhs;
-
-                stack.erase(stack.end() - 2, stack.end());
-                stack.emplace_back(result);
-                return 1;
-            };
+                assembler.emitOpCode(OpCode::Minus);
+            }
 
             virtual std::string disassemble() override
             {
@@ -620,25 +537,10 @@ namespace TribalScript
         class ModulusInstruction : public Instruction
         {
         public:
-            virtual AddressOffsetType execute(ExecutionState* state) override
+            virtual void encode(BytecodeAssembler& assembler) override
             {
-                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                assert(stack.size() >= 2);
-
-                StoredValue& rhsStored = *(stack.end() - 1);
-                StoredValue& lhsStored = *(stack.end() - 2);
-
-                // NOTE: For now we normalize to floats
-                int lhs = lhsStored.toInteger();
-                int rhs = rhsStored.toInteger();
-
-                const int result = lhs % rhs;
-
-                stack.erase(stack.end() - 2, stack.end());
-                stack.emplace_back(result);
-                return 1;
-            };
+                assembler.emitOpCode(OpCode::Modulus);
+            }
 
             virtual std::string disassemble() override
             {
@@ -652,25 +554,10 @@ namespace TribalScript
         class LessThanInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-                    float lhs = lhsStored.toFloat();
-                    float rhs = rhsStored.toFloat();
-
-                    const int result = lhs < rhs ? 1 : 0;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::LessThan);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -681,25 +568,10 @@ namespace TribalScript
         class GreaterThanInstruction : public Instruction
         {
         	public:
-	            virtual AddressOffsetType execute(ExecutionState* state) override
+	            virtual void encode(BytecodeAssembler& assembler) override
 	            {
-	                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-	                assert(stack.size() >= 2);
-
-	                StoredValue& rhsStored = *(stack.end() - 1);
-	                StoredValue& lhsStored = *(stack.end() - 2);
-
-	                // NOTE: For now we normalize to floats
-	                float lhs = lhsStored.toFloat();
-	                float rhs = rhsStored.toFloat();
-
-	                const int result = lhs > rhs ? 1 : 0;
-
-	                stack.erase(stack.end() - 2, stack.end());
-	                stack.emplace_back(result);
-	                return 1;
-	            };
+                    assembler.emitOpCode(OpCode::GreaterThan);
+	            }
 
 	            virtual std::string disassemble() override
 	            {
@@ -710,25 +582,10 @@ namespace TribalScript
 		class GreaterThanOrEqualInstruction : public Instruction
 		{
 			public:
-				virtual AddressOffsetType execute(ExecutionState* state) override
+				virtual void encode(BytecodeAssembler& assembler) override
 				{
-					StoredValueStack& stack = state->mExecutionScope.getStack();
-
-					assert(stack.size() >= 2);
-
-					StoredValue& rhsStored = *(stack.end() - 1);
-					StoredValue& lhsStored = *(stack.end() - 2);
-
-					// NOTE: For now we normalize to floats
-					float lhs = lhsStored.toFloat();
-					float rhs = rhsStored.toFloat();
-
-					const int result = lhs >= rhs ? 1 : 0;
-
-					stack.erase(stack.end() - 2, stack.end());
-					stack.emplace_back(result);
-					return 1;
-				};
+                    assembler.emitOpCode(OpCode::GreaterThanOrEqual);
+				}
 
 				virtual std::string disassemble() override
 				{
@@ -742,25 +599,10 @@ namespace TribalScript
         class EqualsInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-                    float lhs = lhsStored.toFloat();
-                    float rhs = rhsStored.toFloat();
-
-                    const int result = lhs == rhs ? 1 : 0;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Equals);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -774,25 +616,10 @@ namespace TribalScript
         class NotEqualsInstruction : public Instruction
         {
         public:
-            virtual AddressOffsetType execute(ExecutionState* state) override
+            virtual void encode(BytecodeAssembler& assembler) override
             {
-                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                assert(stack.size() >= 2);
-
-                StoredValue& rhsStored = *(stack.end() - 1);
-                StoredValue& lhsStored = *(stack.end() - 2);
-
-                // NOTE: For now we normalize to floats
-                float lhs = lhsStored.toFloat();
-                float rhs = rhsStored.toFloat();
-
-                const int result = lhs != rhs ? 1 : 0;
-
-                stack.erase(stack.end() - 2, stack.end());
-                stack.emplace_back(result);
-                return 1;
-            };
+                assembler.emitOpCode(OpCode::NotEquals);
+            }
 
             virtual std::string disassemble() override
             {
@@ -806,25 +633,10 @@ namespace TribalScript
         class StringEqualsInstruction : public Instruction
         {
         public:
-            virtual AddressOffsetType execute(ExecutionState* state) override
+            virtual void encode(BytecodeAssembler& assembler) override
             {
-                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                assert(stack.size() >= 2);
-
-                StoredValue& rhsStored = *(stack.end() - 1);
-                StoredValue& lhsStored = *(stack.end() - 2);
-
-                // NOTE: For now we normalize to floats
-                std::string lhs = lhsStored.toString();
-                std::string rhs = rhsStored.toString();
-
-                const int result = lhs == rhs ? 1 : 0;
-
-                stack.erase(stack.end() - 2, stack.end());
-                stack.emplace_back(result);
-                return 1;
-            };
+                assembler.emitOpCode(OpCode::StringEquals);
+            }
 
             virtual std::string disassemble() override
             {
@@ -835,25 +647,10 @@ namespace TribalScript
         class StringNotEqualInstruction : public Instruction
         {
         public:
-            virtual AddressOffsetType execute(ExecutionState* state) override
+            virtual void encode(BytecodeAssembler& assembler) override
             {
-                StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                assert(stack.size() >= 2);
-
-                StoredValue& rhsStored = *(stack.end() - 1);
-                StoredValue& lhsStored = *(stack.end() - 2);
-
-                // NOTE: For now we normalize to floats
-                std::string lhs = lhsStored.toString();
-                std::string rhs = rhsStored.toString();
-
-                const int result = lhs != rhs ? 1 : 0;
-
-                stack.erase(stack.end() - 2, stack.end());
-                stack.emplace_back(result);
-                return 1;
-            };
+                assembler.emitOpCode(OpCode::StringNotEqual);
+            }
 
             virtual std::string disassemble() override
             {
@@ -867,25 +664,10 @@ namespace TribalScript
         class BitwiseAndInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-                    int lhs = lhsStored.toInteger();
-                    int rhs = rhsStored.toInteger();
-
-                    const int result = lhs & rhs;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::BitwiseAnd);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -896,25 +678,10 @@ namespace TribalScript
         class BitwiseOrInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-                    int lhs = lhsStored.toInteger();
-                    int rhs = rhsStored.toInteger();
-
-                    const int result = lhs | rhs;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::BitwiseOr);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -929,26 +696,10 @@ namespace TribalScript
         class MultiplyInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-
-                    float lhs = lhsStored.toFloat();
-                    float rhs = rhsStored.toFloat();
-
-                    const float result = lhs * rhs;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Multiply);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -963,26 +714,10 @@ namespace TribalScript
         class DivideInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 2);
-
-                    StoredValue& rhsStored = *(stack.end() - 1);
-                    StoredValue& lhsStored = *(stack.end() - 2);
-
-                    // NOTE: For now we normalize to floats
-
-                    float lhs = lhsStored.toFloat();
-                    float rhs = rhsStored.toFloat();
-
-                    const float result = lhs / rhs;
-
-                    stack.erase(stack.end() - 2, stack.end());
-                    stack.emplace_back(result);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Divide);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -996,15 +731,10 @@ namespace TribalScript
         class PopInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 1);
-                    stack.pop_back();
-
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Pop);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1027,10 +757,10 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    return mOffset;
-                };
+                    assembler.emitJump(OpCode::Jump, mOffset);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1039,6 +769,14 @@ namespace TribalScript
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the instruction offset jumped to, relative to this instruction.
+                 */
+                AddressOffsetType getOffset() const
+                {
+                    return mOffset;
+                }
+
             private:
                 //! The unconditional jump offset.
                 AddressOffsetType mOffset;
@@ -1061,22 +799,10 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 1);
-
-                    StoredValue& booleanStored = stack.back();
-                    if (booleanStored.toBoolean())
-                    {
-                        stack.pop_back();
-                        return mOffset;
-                    }
-
-                    stack.pop_back();
-                    return 1;
-                };
+                    assembler.emitJump(OpCode::JumpTrue, mOffset);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1085,6 +811,14 @@ namespace TribalScript
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the instruction offset jumped to, relative to this instruction.
+                 */
+                AddressOffsetType getOffset() const
+                {
+                    return mOffset;
+                }
+
             private:
                 //! The jump offset.
                 AddressOffsetType mOffset;
@@ -1107,30 +841,110 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
+                    assembler.emitJump(OpCode::JumpFalse, mOffset);
+                }
 
-                    assert(stack.size() >= 1);
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream out;
+                    out << "JumpFalse " << mOffset;
+                    return out.str();
+                }
 
-                    StoredValue& booleanStored = stack.back();
-                    if (!booleanStored.toBoolean())
-                    {
-                        stack.pop_back();
-                        return mOffset;
-                    }
+                /**
+                 *  @brief Retrieves the instruction offset jumped to, relative to this instruction.
+                 */
+                AddressOffsetType getOffset() const
+                {
+                    return mOffset;
+                }
+
+            private:
+                //! The jump offset.
+                AddressOffsetType mOffset;
+        };
+
+        /**
+         *  @brief Jumps to the specified instruction offset if a condition is true, leaving 1 on the stack
+         *  in place of the condition. If the condition is false, this instruction only pops the stack. This
+         *  is used to short circuit the || operator.
+         */
+        class JumpTrueOrPopInstruction : public Instruction
+        {
+            public:
+                /**
+                 *  @brief Constructs a new instance of JumpTrueOrPopInstruction.
+                 *  @param offset The instruction offset to jump to if the condition is true.
+                 */
+                JumpTrueOrPopInstruction(const AddressOffsetType offset) : mOffset(offset)
+                {
+
+                }
 
-                    stack.pop_back();
-                    return 1;
-                };
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitJump(OpCode::JumpTrueOrPop, mOffset);
+                }
 
                 virtual std::string disassemble() override
                 {
                     std::ostringstream out;
-                    out << "JumpFalse " << mOffset;
+                    out << "JumpTrueOrPop " << mOffset;
+                    return out.str();
+                }
+
+                /**
+                 *  @brief Retrieves the instruction offset jumped to, relative to this instruction.
+                 */
+                AddressOffsetType getOffset() const
+                {
+                    return mOffset;
+                }
+
+            private:
+                //! The jump offset.
+                AddressOffsetType mOffset;
+        };
+
+        /**
+         *  @brief Jumps to the specified instruction offset if a condition is false, leaving 0 on the stack
+         *  in place of the condition. If the condition is true, this instruction only pops the stack. This
+         *  is used to short circuit the && operator.
+         */
+        class JumpFalseOrPopInstruction : public Instruction
+        {
+            public:
+                /**
+                 *  @brief Constructs a new instance of JumpFalseOrPopInstruction.
+                 *  @param offset The instruction offset to jump to if the condition is false.
+                 */
+                JumpFalseOrPopInstruction(const AddressOffsetType offset) : mOffset(offset)
+                {
+
+                }
+
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitJump(OpCode::JumpFalseOrPop, mOffset);
+                }
+
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream out;
+                    out << "JumpFalseOrPop " << mOffset;
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the instruction offset jumped to, relative to this instruction.
+                 */
+                AddressOffsetType getOffset() const
+                {
+                    return mOffset;
+                }
+
             private:
                 //! The jump offset.
                 AddressOffsetType mOffset;
@@ -1143,10 +957,10 @@ namespace TribalScript
         class NOPInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::NOP);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1166,22 +980,27 @@ namespace TribalScript
                  *  @param space The namespace this function is defined in.
                  *  @param name The name of this function.
                  *  @param parameterNames The names of all parameters this function is expecting.
+                 *  @param localSlotNames The names of all locals resolved to frame slots, indexed by slot.
                  *  @param instructions The instructions that make up the body of this function.
                  */
-                FunctionDeclarationInstruction(const std::string package, const std::string& space, const std::string& name, const std::vector<std::string> parameterNames, const InstructionSequence& instructions) : mPackageName(package), mNameSpace(space), mName(name), mParameterNames(parameterNames), mInstructions(instructions)
+                FunctionDeclarationInstruction(const std::string package, const std::string& space, const std::string& name, const std::vector<std::string> parameterNames, const std::vector<StringTableEntry>& localSlotNames, const InstructionSequence& instructions) : mPackageName(package), mNameSpace(space), mName(name), mParameterNames(parameterNames), mLocalSlotNames(localSlotNames), mInstructions(instructions)
                 {
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    // Register the function
-                    std::shared_ptr<Function> newFunction = std::shared_ptr<Function>(new Function(mPackageName, mNameSpace, mName, mParameterNames));
-                    newFunction->addInstructions(mInstructions);
-                    state->mInterpreter->addFunction(newFunction);
+                    FunctionPrototype prototype;
+                    prototype.mPackageName = mPackageName;
+                    prototype.mNameSpace = mNameSpace;
+                    prototype.mName = mName;
+                    prototype.mParameterNames = mParameterNames;
+                    prototype.mLocalSlotNames = mLocalSlotNames;
+                    prototype.mBody = BytecodeAssembler::assemble(mInstructions);
 
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::FunctionDeclaration);
+                    assembler.emitFunction(prototype);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1233,6 +1052,7 @@ namespace TribalScript
                 std::string mNameSpace;
                 std::string mName;
                 std::vector<std::string> mParameterNames;
+                std::vector<StringTableEntry> mLocalSlotNames;
                 InstructionSequence mInstructions;
         };
 
@@ -1244,28 +1064,12 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 1);
-
-                    const std::string arrayName = resolveArrayNameFromStack(stack, state, state->mInterpreter->mStringTable.getString(mStringID), mArrayIndices);
-
-                    StoredValue targetStored = stack.back();
-                    stack.pop_back();
-
-                    ConsoleObject* referenced = targetStored.toConsoleObject(state);
-                    if (referenced)
-                    {
-                        // Obtain a reference to the console object's field
-                        stack.emplace_back(referenced->getTaggedFieldOrAllocate(arrayName));
-                        return 1;
-                    }
-
-                    stack.emplace_back(0);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::SubReference);
+                    assembler.emitStringTableEntry(mStringID);
+                    assembler.emitWord(static_cast<BytecodeWord>(mArrayIndices));
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1274,6 +1078,22 @@ namespace TribalScript
                     return out.str();
                 }
 
+                /**
+                 *  @brief Retrieves the name of the field referenced.
+                 */
+                StringTableEntry getStringID() const
+                {
+                    return mStringID;
+                }
+
+                /**
+                 *  @brief Retrieves the number of array indices consumed from the stack.
+                 */
+                std::size_t getArrayIndexCount() const
+                {
+                    return mArrayIndices;
+                }
+
             private:
                 StringTableEntry mStringID;
                 std::size_t mArrayIndices;
@@ -1286,21 +1106,10 @@ namespace TribalScript
         class ReturnInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 1);
-
-                    StoredValue& targetStored = stack.back();
-
-                    // For if we return a variable reference, we want to pass back a copy
-                    StoredValueStack& returnStack = state->mExecutionScope.getReturnStack();
-                    returnStack.push_back(targetStored.getReferencedValueCopy());
-
-                    stack.pop_back();
-                    return 0;
-                };
+                    assembler.emitOpCode(OpCode::Return);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1316,12 +1125,10 @@ namespace TribalScript
         class BreakInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    // This is a placeholder instruction for the compiler
-                    state->mInterpreter->mConfig.mPlatform->logWarning("Break outside of loop, ignoring ...");
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Break);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1335,12 +1142,10 @@ namespace TribalScript
         class ContinueInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    // This is a placeholder instruction for the compiler
-                    state->mInterpreter->mConfig.mPlatform->logWarning("Continue outside of loop, ignoring ...");
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::Continue);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1366,25 +1171,13 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    // When we encounter this instruction, we generate a new variable reference by appending all string representations together
-                    // This is what T2 does - it has no concept of arrays despite pretending to
-
-                    const std::string arrayName = resolveArrayNameFromStack(stack, state, mName, mArgc);
-
-                    if (mGlobal)
-                    {
-                        stack.emplace_back(state->mInterpreter->getGlobalOrAllocate(arrayName));
-                    }
-                    else
-                    {
-                        stack.emplace_back(state->mExecutionScope.getVariableOrAllocate(arrayName));
-                    }
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::AccessArray);
+                    assembler.emitString(mName);
+                    assembler.emitWord(static_cast<BytecodeWord>(mArgc));
+                    assembler.emitWord(mGlobal ? 1 : 0);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1416,62 +1209,13 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-
-                    assert(stack.size() >= 1);
-
-                    // FIXME: At the moment, parameters for bound functions are *after* the target object on the stack
-                    std::vector<StoredValue> parameters;
-                    auto parametersStart = stack.end() - mArgc;
-
-                    for (std::size_t iteration = 0; iteration < mArgc; ++iteration)
-                    {
-                        auto iterator = parametersStart + iteration;
-                        parameters.push_back(*iterator);
-                    }
-                    stack.erase(parametersStart, stack.end());
-
-                    // Next load the target
-                    StoredValue targetStored = stack.back();
-                    stack.pop_back();
-
-                    // Retrieve the referenced ConsoleObject
-                    ConsoleObject* targetObject = targetStored.toConsoleObject(state);
-                    if (!targetObject)
-                    {
-                        std::ostringstream output;
-                        output << "Cannot find object '" << targetStored.toString() << "' to call function '" << mName << "'!";
-                        state->mInterpreter->mConfig.mPlatform->logWarning(output.str());
-
-                        stack.push_back(StoredValue(0));
-                        return 1;
-                    }
-
-                    // Walk the class hierarchy
-                    ConsoleObjectDescriptor* descriptor = state->mInterpreter->lookupDescriptor(targetObject->getVirtualClassName());
-                    assert(descriptor);
-                    assert(descriptor->mHierarchy.size() != 0);
-
-                    for (const std::string& className : descriptor->mHierarchy)
-                    {
-                        // Ask the interpreter to lookup the function
-                        std::shared_ptr<Function> calledFunction = state->mInterpreter->getFunction(className, mName);
-                        if (calledFunction)
-                        {
-                            calledFunction->execute(targetObject, state, parameters);
-                            return 1;
-                        }
-                    }
-
-                    std::ostringstream output;
-                    output << "Cannot find function  '" << mName << "' on object '" << targetStored.toString() << "'!";
-                    state->mInterpreter->mConfig.mPlatform->logWarning(output.str());
-
-                    stack.emplace_back(0);
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::CallBoundFunction);
+                    assembler.emitString(mName);
+                    assembler.emitWord(static_cast<BytecodeWord>(mArgc));
+                    assembler.emitBoundCallSiteCache();
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1488,20 +1232,10 @@ namespace TribalScript
         class PushObjectInstantiationInstruction : public Instruction
         {
             public:
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    assert(stack.size() >= 2);
-
-                    StoredValue objectName = stack.back();
-                    stack.pop_back();
-                    StoredValue objectTypeName = stack.back();
-                    stack.pop_back();
-
-                    state->mExecutionScope.pushObjectInstantiation(objectTypeName.toString(), objectName.toString());
-
-                    return 1;
-                };
+                    assembler.emitOpCode(OpCode::PushObjectInstantiation);
+                }
 
                 virtual std::string disassemble() override
                 {
@@ -1517,114 +1251,161 @@ namespace TribalScript
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    assert(stack.size() >= 2);
+                    assembler.emitOpCode(OpCode::PushObjectField);
+                    assembler.emitWord(static_cast<BytecodeWord>(mFieldComponentCount));
+                }
 
-                    StoredValue rvalue = stack.back();
-                    stack.pop_back();
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream out;
+                    out << "PushObjectField argc=" << mFieldComponentCount;
+                    return out.str();
+                }
 
-                    // Load array components
-                    std::vector<std::string> arrayComponents;
-                    for (unsigned int iteration = 0; iteration < mFieldComponentCount; ++iteration)
-                    {
-                        arrayComponents.push_back(stack.popString(state));
-                    }
+            private:
+                std::size_t mFieldComponentCount;
+        };
 
-                    // Load base name
-                    StoredValue fieldBaseName = stack.back();
-                    stack.pop_back();
+        class PopObjectInstantiationInstruction : public Instruction
+        {
+            public:
+                PopObjectInstantiationInstruction(std::size_t childrenCount) : mChildrenCount(childrenCount)
+                {
 
-                    // FIXME: This should be using the resolveArrayNameFromStack helper function
-                    std::ostringstream out;
-                    out << fieldBaseName.toString();
-                    for (auto iterator = arrayComponents.rbegin(); iterator != arrayComponents.rend(); ++iterator)
-                    {
-                        if (iterator != arrayComponents.rend())
-                        {
-                            out << "_";
-                        }
-                        out << *iterator;
-                    }
+                }
 
-                    // Final field assignment
-                    ObjectInstantiationDescriptor& descriptor = state->mExecutionScope.currentObjectInstantiation();
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitOpCode(OpCode::PopObjectInstantiation);
+                    assembler.emitWord(static_cast<BytecodeWord>(mChildrenCount));
+                }
 
-                    const std::string chosenFieldName = state->mInterpreter->mConfig.mCaseSensitive ? out.str() : toLowerCase(out.str());
-                    auto search = descriptor.mFieldAssignments.find(chosenFieldName);
-                    if (search != descriptor.mFieldAssignments.end())
-                    {
-                        search->second = rvalue;
-                    }
-                    else
-                    {
-                        descriptor.mFieldAssignments.insert(std::make_pair(chosenFieldName, rvalue));
-                    }
+                virtual std::string disassemble() override
+                {
+                    return "PopObjectInstantiation";
+                }
+
+                private:
+                    std::size_t mChildrenCount;
+        };
+
+        /**
+         *  @brief Superinstruction adding a constant to a local slot in place, equivalent to PushLocalSlot, PushInteger,
+         *  AddAssignment and Pop. Nothing is pushed to the stack.
+         */
+        class IncrementLocalSlotInstruction : public Instruction
+        {
+            public:
+                IncrementLocalSlotInstruction(const std::size_t slot, const int amount) : mSlot(slot), mAmount(amount)
+                {
 
-                    return 1;
-                };
+                }
+
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitOpCode(OpCode::IncrementLocalSlot);
+                    assembler.emitWord(static_cast<BytecodeWord>(mSlot));
+                    assembler.emitInteger(mAmount);
+                }
 
                 virtual std::string disassemble() override
                 {
                     std::ostringstream out;
-                    out << "PushObjectField argc=" << mFieldComponentCount;
+                    out << "IncrementLocalSlot " << mSlot << " " << mAmount;
                     return out.str();
                 }
 
             private:
-                std::size_t mFieldComponentCount;
+                //! The slot to add to.
+                std::size_t mSlot;
+
+                //! The amount to add.
+                int mAmount;
         };
 
-        class PopObjectInstantiationInstruction : public Instruction
+        /**
+         *  @brief Superinstruction comparing a local slot against a constant and jumping if the comparison fails,
+         *  equivalent to PushLocalSlot, PushInteger or PushFloat, a float comparison and JumpFalse.
+         */
+        class CompareLocalSlotJumpFalseInstruction : public Instruction
         {
             public:
-                PopObjectInstantiationInstruction(std::size_t childrenCount) : mChildrenCount(childrenCount)
+                /**
+                 *  @brief Constructs a new instance of CompareLocalSlotJumpFalseInstruction.
+                 *  @param slot The slot to compare.
+                 *  @param comparison One of LessThan, GreaterThan, GreaterThanOrEqual, Equals or NotEquals.
+                 *  @param value The value to compare against.
+                 *  @param offset The instruction offset to jump to if the comparison is false.
+                 */
+                CompareLocalSlotJumpFalseInstruction(const std::size_t slot, const OpCode comparison, const float value, const AddressOffsetType offset) : mSlot(slot), mComparison(comparison), mValue(value), mOffset(offset)
                 {
 
                 }
 
-                virtual AddressOffsetType execute(ExecutionState* state) override
+                virtual void encode(BytecodeAssembler& assembler) override
                 {
-                    StoredValueStack& stack = state->mExecutionScope.getStack();
-                    ObjectInstantiationDescriptor descriptor = state->mExecutionScope.popObjectInstantiation();
+                    assembler.emitOpCode(OpCode::CompareLocalSlotJumpFalse);
+                    assembler.emitWord(static_cast<BytecodeWord>(mSlot));
+                    assembler.emitWord(static_cast<BytecodeWord>(mComparison));
+                    assembler.emitFloat(mValue);
+                    assembler.emitJumpTarget(mOffset);
+                }
 
-                    // Ask the interpreter to initialize the resulting tree
-                    ConsoleObject* result = state->mInterpreter->initializeConsoleObjectTree(descriptor);
+                virtual std::string disassemble() override
+                {
+                    std::ostringstream out;
+                    out << "CompareLocalSlotJumpFalse " << mSlot << " " << getOpCodeName(mComparison) << " " << mValue << " " << mOffset;
+                    return out.str();
+                }
 
-                    if (result)
-                    {
-                        // Assign fields -- any construction fields should have been pulled out of the descriptor at this point
-                        descriptor.copyFieldsToConsoleObject(result);
+            private:
+                //! The slot to compare.
+                std::size_t mSlot;
 
-                        // Append children
-                        for (std::size_t iteration = 0; iteration < mChildrenCount; ++iteration)
-                        {
-                            StoredValue nextChildID = stack.back();
-                            stack.pop_back();
+                //! The comparison performed.
+                OpCode mComparison;
 
-                            ConsoleObject* nextChild = state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObject(state->mInterpreter, nextChildID.toInteger());
-                            result->addChild(nextChild);
-                        }
+                //! The value compared against.
+                float mValue;
 
-                        stack.emplace_back((int)state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObjectID(state->mInterpreter, result));
-                    }
-                    else
-                    {
-                        state->mInterpreter->mConfig.mPlatform->logError("Failed to instantiate object!");
-                        stack.emplace_back(-1);
-                    }
+                //! The jump offset.
+                AddressOffsetType mOffset;
+        };
 
-                    return 1;
-                };
+        /**
+         *  @brief Superinstruction pushing a reference to a field of the object named by a local slot, equivalent to
+         *  PushLocalSlot followed by SubReference without array indices.
+         */
+        class PushLocalSlotFieldInstruction : public Instruction
+        {
+            public:
+                PushLocalSlotFieldInstruction(const std::size_t slot, const StringTableEntry field) : mSlot(slot), mField(field)
+                {
+
+                }
+
+                virtual void encode(BytecodeAssembler& assembler) override
+                {
+                    assembler.emitOpCode(OpCode::PushLocalSlotField);
+                    assembler.emitWord(static_cast<BytecodeWord>(mSlot));
+                    assembler.emitStringTableEntry(mField);
+                }
 
                 virtual std::string disassemble() override
                 {
-                    return "PopObjectInstantiation";
+                    std::ostringstream out;
+                    out << "PushLocalSlotField " << mSlot << " " << mField;
+                    return out.str();
                 }
 
-                private:
-                    std::size_t mChildrenCount;
+            private:
+                //! The slot holding the object.
+                std::size_t mSlot;
+
+                //! The name of the field.
+                StringTableEntry mField;
         };
     }
 }
@@ -32,12 +32,11 @@ namespace TribalScript
     typedef long long int AddressOffsetType;
 
     /**
-     *  @brief Storage class for a sequence of instructions to be executed. Also implements the
-     *  primary execution code for running Torque Script virtual instructions.
+     *  @brief Storage class for a sequence of instructions as generated by the compiler. Instruction sequences
+     *  are not executed directly; they are lowered to Bytecode by the BytecodeAssembler first.
      */
     class InstructionSequence : public std::vector<std::shared_ptr<Instructions::Instruction>>
     {
-        public:
-            void execute(ExecutionState* state);
+
     };
 }
@@ -18,8 +18,10 @@
 #include <memory>
 #include <unordered_map>
 
+#include <tribalscript/profiler.hpp>
 #include <tribalscript/interpreterconfiguration.hpp>
 #include <tribalscript/function.hpp>
+#include <tribalscript/casefolding.hpp>
 #include <tribalscript/consoleobject.hpp>
 #include <tribalscript/storedvalue.hpp>
 #include <tribalscript/stringhelpers.hpp>
@@ -117,13 +119,56 @@ namespace TribalScript
             std::shared_ptr<Function> getFunction(const std::string& space, const std::string& name);
             std::shared_ptr<Function> getFunctionParent(Function* function);
 
+            /**
+             *  @brief Looks up a function to call on objects of the provided type, searching the type's entire hierarchy.
+             *  @param descriptor The descriptor of the object type.
+             *  @param name The name of the function to look up.
+             *  @return The function to call, or nullptr if there is none.
+             */
+            Function* getBoundFunction(ConsoleObjectDescriptor* descriptor, const std::string& name);
+
             FunctionRegistry* findFunctionRegistry(const std::string& packageName);
             void addFunctionRegistry(const std::string& packageName);
             void activateFunctionRegistry(const std::string& packageName);
             void deactivateFunctionRegistry(const std::string& packageName);
             void removeFunctionRegistry(const std::string& packageName);
+
+            /**
+             *  @brief Retrieves the current function generation. This changes whenever anything happens that may change
+             *  what a function lookup resolves to, including namespace relinks, so lookups made in the same generation
+             *  may be cached.
+             *  @return The current function generation.
+             */
+            std::size_t getFunctionGeneration() const
+            {
+                return mFunctionGeneration;
+            }
             /// @}
 
+            /**
+             *  @brief Marks the start of bytecode executing in this interpreter. Functions replaced or removed while
+             *  anything is executing are kept alive until the outermost execution ends, as they may still be running.
+             */
+            void enterExecution()
+            {
+                ++mActiveExecutions;
+            }
+
+            /**
+             *  @brief Marks the end of bytecode executing in this interpreter. Once the outermost execution ends, all
+             *  retired functions are released.
+             */
+            void exitExecution();
+
+            /**
+             *  @brief Retrieves the profiler recording execution statistics for this interpreter.
+             *  @return The profiler, or nullptr if profiling was not enabled in the interpreter configuration.
+             */
+            Profiler* getProfiler()
+            {
+                return mProfiler.get();
+            }
+
             //! The string table associated with this interpreter.
             StringTable mStringTable;
 
@@ -144,23 +189,17 @@ namespace TribalScript
             template <typename classType>
             void registerConsoleObjectType(const std::string& typeName, const std::string& superTypeName)
             {
-                const std::string chosenTypeName = mConfig.mCaseSensitive ? typeName : toLowerCase(typeName);
-                const std::string chosenSuperTypeName = mConfig.mCaseSensitive ? superTypeName : toLowerCase(superTypeName);
-
-                ConsoleObjectDescriptor* descriptor = this->registerConsoleObjectDescriptor(chosenTypeName, chosenSuperTypeName, classType::instantiateFromDescriptor);
+                ConsoleObjectDescriptor* descriptor = this->registerConsoleObjectDescriptor(typeName, superTypeName, classType::instantiateFromDescriptor);
                 classType::initializeMemberFields(descriptor);
             }
 
             ConsoleObjectDescriptor* registerConsoleObjectDescriptor(const std::string& typeName, const std::string& superTypeName, InitializeConsoleObjectFromDescriptorPointer initializationFunction)
             {
-                const std::string chosenTypeName = mConfig.mCaseSensitive ? typeName : toLowerCase(typeName);
-                const std::string chosenSuperTypeName = mConfig.mCaseSensitive ? superTypeName : toLowerCase(superTypeName);
-
-                // Ensure descriptors are initialized
+                // Ensure descriptors are initialized. Type names keep their case, the map decides how they are compared.
                 assert(mConsoleObjectDescriptors.find(typeName) == mConsoleObjectDescriptors.end());
 
-                ConsoleObjectDescriptor* descriptor = new ConsoleObjectDescriptor(chosenTypeName, chosenSuperTypeName, initializationFunction);
-                mConsoleObjectDescriptors.insert(std::make_pair(chosenTypeName, descriptor));
+                ConsoleObjectDescriptor* descriptor = new ConsoleObjectDescriptor(typeName, superTypeName, initializationFunction);
+                mConsoleObjectDescriptors.insert(std::make_pair(typeName, descriptor));
 
                 // Ensure namespaces are setup correctly
                 this->relinkNamespaces();
@@ -174,18 +213,39 @@ namespace TribalScript
 
             ConsoleObjectDescriptor* lookupDescriptor(const std::string& objectTypeName);
 
-            std::unordered_map<std::string, ConsoleObjectDescriptor*>& getConsoleObjectDescriptors();
+            ConfigurableCaseMap<ConsoleObjectDescriptor*>& getConsoleObjectDescriptors();
 
         private:
             //! Keep a ready instance of the compiler on hand as it is reusable.
             Compiler* mCompiler;
 
-            std::unordered_map<std::string, ConsoleObjectDescriptor*> mConsoleObjectDescriptors;
+            //! Every registered type by name, compared ignoring case unless the interpreter is case sensitive.
+            ConfigurableCaseMap<ConsoleObjectDescriptor*> mConsoleObjectDescriptors;
 
             //! A mapping of function namespaces to a mapping of function names to the function object.
             std::vector<FunctionRegistry> mFunctionRegistries;
 
-            //! A mapping of global variable names to their stored value instance.
-            std::unordered_map<StringTableEntry, StoredValue*> mGlobalVariables;
+            //! Incremented whenever function lookups may resolve differently.
+            std::size_t mFunctionGeneration;
+
+            /**
+             *  @brief Releases all retired functions if nothing is executing. When profiling, retired functions are kept
+             *  for the lifetime of the interpreter as the profiler reports statistics by function.
+             */
+            void releaseRetiredFunctions();
+
+            //! Functions that were replaced or removed while they may still have been executing. Call site caches never
+            //! use a function after the generation has changed, so these only have to outlive any running frames.
+            std::vector<std::shared_ptr<Function>> mRetiredFunctions;
+
+            //! The number of Bytecode::execute calls in progress in this interpreter.
+            std::size_t mActiveExecutions;
+
+            //! The profiler in use if profiling is enabled.
+            std::unique_ptr<Profiler> mProfiler;
+
+            //! The stored value instance of every global variable, indexed by the string table entry of its name.
+            //! Entries of names that were never used as a global are nullptr.
+            std::vector<StoredValue*> mGlobalVariables;
     };
 }
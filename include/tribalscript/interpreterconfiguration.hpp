@@ -19,6 +19,28 @@
 
 namespace TribalScript
 {
+    /**
+     *  @brief The frontends source code can be parsed with.
+     */
+    enum class ParserFrontend
+    {
+        //! The ANTLR generated Tribes2Lexer and Tribes2Parser, whose parse tree is converted by AST::ASTBuilder.
+        ANTLR,
+
+        //! The hand written Lexer and Parser, which build the AST directly from the source buffer.
+        HandWritten
+    };
+
+    /**
+     *  @brief The frontend used unless one is configured. Building with TRIBALSCRIPT_HANDWRITTEN_FRONTEND makes this
+     *  the hand written frontend so that the test suite can be run against either.
+     */
+#if defined(TRIBALSCRIPT_HANDWRITTEN_FRONTEND)
+    static const ParserFrontend sDefaultParserFrontend = ParserFrontend::HandWritten;
+#else
+    static const ParserFrontend sDefaultParserFrontend = ParserFrontend::ANTLR;
+#endif
+
     /**
      *  @brief A structure representing overall interpreter runtime configuration. Some settings can be
      *  changed at runtime while others are static once initialized.
@@ -26,7 +48,8 @@ namespace TribalScript
     struct InterpreterConfiguration
     {
         explicit InterpreterConfiguration(PlatformContext* platform = new PlatformContext(), ConsoleObjectRegistryBase* registry = new StandardConsoleObjectRegistry()) :
-                                 mPlatform(platform), mConsoleObjectRegistry(registry), mMaxRecursionDepth(1024), mCaseSensitive(false)
+                                 mPlatform(platform), mConsoleObjectRegistry(registry), mMaxRecursionDepth(1024), mCaseSensitive(false), mCacheBytecode(false), mProfile(false), mOptimizationLevel(1),
+                                 mFrontend(sDefaultParserFrontend)
         {
 
         }
@@ -42,5 +65,22 @@ namespace TribalScript
 
         //! Whether or not the interpreter should be case sensitive. While this can be reassigned at runtime, it is not recommended.
         bool mCaseSensitive;
+
+        //! Whether or not compiled scripts are cached next to their source file, with ".dso" appended to the file name.
+        //! Executing a script whose cache matches its source skips compilation entirely.
+        bool mCacheBytecode;
+
+        //! Whether or not the interpreter records per opcode, per function and per call site execution statistics.
+        //! This slows execution down considerably and is only read when the interpreter is constructed.
+        //! @see TribalScript::Interpreter::getProfiler
+        bool mProfile;
+
+        //! The optimization level scripts are compiled with. At 0 code is generated exactly as written, while at 1
+        //! constant expressions are folded, branches on constants and unreachable code are removed and NOPs are stripped.
+        unsigned int mOptimizationLevel;
+
+        //! The frontend source code is parsed with. Both produce the same AST, but the hand written frontend does
+        //! not build an intermediate parse tree.
+        ParserFrontend mFrontend;
     };
 }
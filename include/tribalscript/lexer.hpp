@@ -0,0 +1,183 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <tribalscript/astarena.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief All token types recognized by the Lexer. These mirror the lexer rules and implicit literal
+     *  tokens of Tribes2.g4.
+     */
+    enum class TokenType
+    {
+        EndOfFile,
+
+        // Literals
+        Label,
+        IntegerLiteral,
+        HexIntegerLiteral,
+        FloatLiteral,
+        StringLiteral,
+        TaggedStringLiteral,
+
+        // Keywords
+        KeywordDatablock,
+        KeywordPackage,
+        KeywordFunction,
+        KeywordIf,
+        KeywordElse,
+        KeywordSwitch,
+        KeywordCase,
+        KeywordReturn,
+        KeywordBreak,
+        KeywordContinue,
+        KeywordNew,
+        KeywordWhile,
+        KeywordFor,
+        KeywordTrue,
+        KeywordFalse,
+        KeywordDefault,
+        KeywordOr,
+        KeywordSpaceConcat,
+        KeywordTabConcat,
+        KeywordNewlineConcat,
+
+        // Punctuation
+        LeftParenthesis,
+        RightParenthesis,
+        LeftBrace,
+        RightBrace,
+        LeftBracket,
+        RightBracket,
+        Semicolon,
+        Comma,
+        Colon,
+        DoubleColon,
+        Dot,
+        Question,
+        Dollar,
+
+        // Operators
+        Plus,
+        Minus,
+        Multiply,
+        Divide,
+        Modulus,
+        Assign,
+        PlusAssign,
+        MinusAssign,
+        MultiplyAssign,
+        DivideAssign,
+        OrAssign,
+        AndAssign,
+        ModulusAssign,
+        Increment,
+        Decrement,
+        LessThan,
+        GreaterThan,
+        LessThanOrEqual,
+        GreaterThanOrEqual,
+        Not,
+        Tilde,
+        Equals,
+        NotEqual,
+        StringEquals,
+        StringNotEqual,
+        Concat,
+        LogicalAnd,
+        LogicalOr,
+        LeftBitShift,
+        RightBitShift,
+        BitwiseXor,
+        BitwiseAnd,
+        BitwiseOr
+    };
+
+    /**
+     *  @brief A single token produced by the Lexer.
+     */
+    struct Token
+    {
+        Token(const TokenType type, const AST::StringView& text, const std::size_t line, const std::size_t column) : mType(type), mText(text), mLine(line), mColumn(column)
+        {
+
+        }
+
+        //! The type of this token.
+        TokenType mType;
+
+        //! The raw text of this token as it appeared in the source. This views the input buffer of the Lexer.
+        AST::StringView mText;
+
+        //! The line this token was found on, starting at 1.
+        std::size_t mLine;
+
+        //! The character position in the line this token was found at, starting at 0.
+        std::size_t mColumn;
+    };
+
+    /**
+     *  @brief Hand written lexer for TribalScript. It produces the same token stream the ANTLR generated
+     *  Tribes2Lexer would, reading directly from the input buffer.
+     *  @details Tokens do not copy their text but view the input buffer, which must outlive them.
+     */
+    class Lexer
+    {
+        public:
+            explicit Lexer(const AST::StringView& input);
+
+            /**
+             *  @brief Tokenizes the entire input. The resulting sequence is always terminated by an
+             *  EndOfFile token.
+             *  @return All tokens in the input.
+             */
+            std::vector<Token> tokenize();
+
+            /**
+             *  @brief Retrieves all errors encountered while tokenizing.
+             *  @return A list of all error messages.
+             */
+            const std::vector<std::string>& getErrors();
+
+        private:
+            bool lexNumber(std::vector<Token>& tokens);
+            bool lexString(std::vector<Token>& tokens, const char terminator);
+            void lexIdentifier(std::vector<Token>& tokens);
+            bool lexOperator(std::vector<Token>& tokens);
+
+            void addError(const std::string& message);
+
+            //! The input being tokenized.
+            AST::StringView mInput;
+
+            //! The current read position within mInput.
+            std::size_t mPosition;
+
+            //! The current line number.
+            std::size_t mLine;
+
+            //! Position within mInput that the current line starts at.
+            std::size_t mLineStart;
+
+            //! All errors encountered.
+            std::vector<std::string> mErrors;
+    };
+}
@@ -29,22 +29,22 @@
 
 namespace TribalScript
 {
-    StoredValue EchoBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue EchoBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue ExecBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
-    StoredValue ActivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue ExecBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
+    StoredValue ActivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue DeactivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue DeactivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue DeleteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue DeleteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue GetNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue GetNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue GetIDBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue GetIDBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue GetRealTimeBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue GetRealTimeBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue GetClassNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue GetClassNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
     void registerCoreLibrary(Interpreter* interpreter);
 }
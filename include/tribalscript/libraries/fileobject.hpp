@@ -28,21 +28,21 @@
 
 namespace TribalScript
 {
-    StoredValue OpenForWriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue OpenForWriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue OpenForReadBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue OpenForReadBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue WriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue WriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue CloseBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue CloseBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue IsEOFBuiltin(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue IsEOFBuiltin(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue ReadLineBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue ReadLineBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue IsFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue IsFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
-    StoredValue DeleteFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue DeleteFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
     void registerFileObjectLibrary(Interpreter* interpreter);
 }
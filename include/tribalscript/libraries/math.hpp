@@ -28,7 +28,7 @@
 
 namespace TribalScript
 {
-    StoredValue GetRandomBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue GetRandomBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
     void registerMathLibrary(Interpreter* interpreter);
 }
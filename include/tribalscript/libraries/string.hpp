@@ -28,7 +28,7 @@
 
 namespace TribalScript
 {
-    StoredValue GetWordBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    StoredValue GetWordBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
     void registerStringLibrary(Interpreter* interpreter);
 }
@@ -17,12 +17,13 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <limits>
 
 #include <tribalscript/function.hpp>
 
 namespace TribalScript
 {
-    typedef StoredValue (*NativeFunctionPointer)(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters);
+    typedef StoredValue (*NativeFunctionPointer)(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters);
 
     /**
      *  @brief A NativeFunction is a specialization of Function that allows native C++ programming to be called from within the
@@ -31,15 +32,32 @@ namespace TribalScript
     class NativeFunction : public Function
     {
         public:
-            NativeFunction(NativeFunctionPointer native, const std::string& package, const std::string& space, const std::string& name);
+            //! Used as the maximum argument count of natives that accept any number of arguments.
+            static constexpr std::size_t UnlimitedArguments = std::numeric_limits<std::size_t>::max();
 
             /**
-             *  @brief Executes the native function provided to the interpreter.
+             *  @brief Constructs a new native function.
+             *  @param minimumArguments The fewest arguments the native may be called with.
+             *  @param maximumArguments The most arguments the native may be called with.
              */
-            virtual void execute(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters) override;
+            NativeFunction(NativeFunctionPointer native, const std::string& package, const std::string& space, const std::string& name,
+                           std::size_t minimumArguments = 0, std::size_t maximumArguments = UnlimitedArguments);
+
+            /**
+             *  @brief Executes the native function provided to the interpreter. Calls with an argument count outside of the
+             *  range the native was registered with log an error and place 0 on the stack without calling the native, so
+             *  natives may index their parameters freely within that range.
+             */
+            virtual void execute(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters) override;
 
         private:
             //! The pointer to the native function to call.
             NativeFunctionPointer mNativeFunction;
+
+            //! The fewest arguments the native may be called with.
+            std::size_t mMinimumArguments;
+
+            //! The most arguments the native may be called with.
+            std::size_t mMaximumArguments;
     };
 }
@@ -12,28 +12,22 @@
  *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-#include <tribalscript/instructionsequence.hpp>
-#include <tribalscript/executionstate.hpp>
-#include <tribalscript/instructions.hpp>
+#pragma once
+
+#include <cstddef>
 
 namespace TribalScript
 {
-    void InstructionSequence::execute(ExecutionState* state)
-    {
-        AddressType instructionIndex = 0;
-
-        const std::size_t instructionCount = this->size();
-        while (instructionIndex < instructionCount && instructionIndex >= 0)
-        {
-            std::shared_ptr<Instructions::Instruction>& nextInstruction = this->at(instructionIndex);
+    //! The size of a buffer large enough to hold any float formatted by formatFloat.
+    static const std::size_t FormattedFloatBufferSize = 32;
 
-            state->mInstructionPointer = instructionIndex;
-            const AddressOffsetType advance = nextInstruction->execute(state);
-            if (advance == 0)
-            {
-                break;
-            }
-            instructionIndex += advance;
-        }
-    }
+    /**
+     *  @brief Writes a float to a buffer the way Torque does, which is the printf %g format: six significant
+     *  digits without trailing zeros, using exponent notation for very large and very small values. For example,
+     *  1.5 is "1.5", 3.0 is "3" and 1234567.0 is "1.23457e+06". This never allocates.
+     *  @param value The float to format.
+     *  @param buffer The buffer to write to, at least FormattedFloatBufferSize bytes. The result is NULL terminated.
+     *  @return The number of characters written, excluding the NULL terminator.
+     */
+    std::size_t formatFloat(const float value, char* buffer);
 }
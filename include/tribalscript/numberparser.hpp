@@ -0,0 +1,37 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+namespace TribalScript
+{
+    /**
+     *  @brief Interprets a string as an integer. Leading whitespace and a sign are accepted and parsing stops at
+     *  the first character that is not a decimal digit, so "12abc" is 12. Strings without any digits and values that
+     *  do not fit in an int are 0. This never throws or allocates.
+     *  @param value The NULL terminated string to parse.
+     *  @return The integer value of the string.
+     */
+    int parseInteger(const char* value);
+
+    /**
+     *  @brief Interprets a string as a float with the same results as std::strtof: leading whitespace, a sign,
+     *  decimal and hexadecimal notation, exponents, infinity and NaN are accepted and parsing stops at the first
+     *  character that does not fit, so "1.5abc" is 1.5. Strings that are not numeric at all are 0. This never throws
+     *  or allocates.
+     *  @param value The NULL terminated string to parse.
+     *  @return The float value of the string.
+     */
+    float parseFloat(const char* value);
+}
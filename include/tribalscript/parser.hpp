@@ -0,0 +1,112 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <tribalscript/ast.hpp>
+#include <tribalscript/astarena.hpp>
+#include <tribalscript/lexer.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Hand written recursive descent parser for TribalScript. Binary expressions are handled by precedence
+     *  climbing using the same precedence and associativity as Tribes2.g4, and the produced AST is identical to what
+     *  AST::ASTBuilder generates from the ANTLR parse tree.
+     *  @details Names and string literals in the produced tree view the text of the tokens they came from rather than
+     *  copying it, so the buffer the tokens were lexed from must live as long as the tree.
+     */
+    class Parser
+    {
+        public:
+            Parser(const std::vector<Token>& tokens, AST::ASTArena* arena);
+
+            /**
+             *  @brief Parses the entire token stream into a program.
+             *  @return The parsed program. If any syntax error was encountered, nullptr is returned and the
+             *  errors are available via getErrors.
+             */
+            AST::ProgramNode* parseProgram();
+
+            /**
+             *  @brief Retrieves all errors encountered while parsing.
+             *  @return A list of all error messages.
+             */
+            const std::vector<std::string>& getErrors();
+
+        private:
+            /*
+                Declarations
+            */
+            AST::ASTNode* parseStatement();
+            AST::ASTNode* parseFunctionDeclaration();
+            AST::ASTNode* parsePackageDeclaration();
+            AST::ASTNode* parseDatablockDeclaration();
+            AST::ASTNode* parseFieldAssign();
+            AST::ObjectDeclarationNode* parseObjectDeclaration();
+
+            /*
+                Control statements
+            */
+            AST::ASTNode* parseExpressionStatement();
+            std::vector<AST::ASTNode*> parseControlStatements();
+            AST::ASTNode* parseWhile();
+            AST::ASTNode* parseFor();
+            AST::ASTNode* parseIf();
+            AST::ASTNode* parseSwitch();
+            AST::ASTNode* parseReturn();
+
+            /*
+                Expressions
+            */
+            AST::ASTNode* parsePrimaryExpression();
+            AST::ASTNode* parsePrimaryExpressionOrExpression();
+            AST::ASTNode* parseAssignmentTail(AST::ASTNode* target, bool* handled);
+            AST::ASTNode* parseExpression(const int minimumPrecedence = 0);
+            AST::ASTNode* parseBinaryExpression(AST::ASTNode* left, const int minimumPrecedence);
+            AST::ASTNode* parseUnaryExpression();
+            AST::ASTNode* parseChain();
+            AST::ASTNode* parseChainStart();
+            AST::ASTNode* parseChainElement();
+            AST::ASTNode* parseVariable();
+            std::vector<AST::ASTNode*> parseExpressionList(const TokenType terminator, const bool allowEmpty);
+            AST::StringView parseLabelWithKeywords();
+            AST::StringView stripQuotes(const AST::StringView& raw);
+
+            /*
+                Token stream helpers
+            */
+            const Token& peek(const std::size_t offset = 0) const;
+            const Token& advance();
+            bool check(const TokenType type) const;
+            bool match(const TokenType type);
+            const Token& expect(const TokenType type);
+            void error(const Token& token, const std::string& message);
+
+            //! The token stream being parsed, always terminated by an EndOfFile token.
+            const std::vector<Token>& mTokens;
+
+            //! Index of the next token to be read.
+            std::size_t mPosition;
+
+            //! All errors encountered.
+            std::vector<std::string> mErrors;
+
+            //! The arena the tree is built in.
+            AST::ASTArena* mArena;
+    };
+}
@@ -0,0 +1,198 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+#include <unordered_map>
+
+#include <tribalscript/bytecode.hpp>
+
+namespace TribalScript
+{
+    class Function;
+
+    /**
+     *  @brief Collects execution counts and timings per opcode, per function and per call site while scripts run.
+     *  An interpreter only owns a profiler when InterpreterConfiguration::mProfile is set, so none of this costs
+     *  anything otherwise. All times are in nanoseconds.
+     */
+    class Profiler
+    {
+        public:
+            struct OpCodeStatistics
+            {
+                //! The number of times the opcode was executed.
+                std::uint64_t mCount;
+
+                //! Time spent executing the opcode itself. For calls, this excludes time spent in the called function.
+                std::uint64_t mTime;
+            };
+
+            struct FunctionStatistics
+            {
+                //! The number of times the function was called.
+                std::uint64_t mCalls;
+
+                //! Time spent in the function, including everything it called. Time spent in recursive calls is only
+                //! counted once.
+                std::uint64_t mInclusiveTime;
+
+                //! Time spent in the function, excluding everything it called.
+                std::uint64_t mExclusiveTime;
+            };
+
+            struct CallSiteStatistics
+            {
+                //! The function the call was made from, or nullptr if made outside of any function.
+                Function* mCaller;
+
+                //! The word offset of the call within the caller's bytecode.
+                std::size_t mOffset;
+
+                //! The function called from this site.
+                Function* mCallee;
+
+                //! The number of calls made from this site.
+                std::uint64_t mCalls;
+
+                //! Time spent in calls made from this site.
+                std::uint64_t mInclusiveTime;
+            };
+
+            Profiler();
+
+            /**
+             *  @brief Records that an opcode is about to execute. Time since the previous recorded opcode is
+             *  attributed to that opcode.
+             */
+            void recordInstruction(const OpCode op);
+
+            /**
+             *  @brief Records that the running bytecode finished, so no further time is attributed to the last
+             *  recorded opcode.
+             */
+            void endInstructions();
+
+            /**
+             *  @brief Records entry into a function.
+             *  @param function The function being called.
+             *  @param bytecode The bytecode containing the call.
+             *  @param offset The word offset of the call within bytecode.
+             */
+            void enterFunction(Function* function, const Bytecode* bytecode, const std::size_t offset);
+
+            /**
+             *  @brief Records return from the function most recently entered.
+             */
+            void exitFunction();
+
+            /**
+             *  @brief Discards everything recorded so far.
+             */
+            void reset();
+
+            const OpCodeStatistics& getOpCodeStatistics(const OpCode op) const;
+
+            /**
+             *  @brief Retrieves how often one opcode was directly followed by another within the same bytecode. This
+             *  is what decides which sequences are worth fusing into superinstructions.
+             */
+            std::uint64_t getOpCodePairCount(const OpCode first, const OpCode second) const;
+            const std::unordered_map<Function*, FunctionStatistics>& getFunctionStatistics() const;
+            std::vector<CallSiteStatistics> getCallSiteStatistics() const;
+
+            /**
+             *  @brief Produces a human readable flat profile of opcodes, functions and call sites, each sorted by time,
+             *  followed by the most frequent opcode pairs.
+             */
+            std::string getFlatProfile() const;
+
+            /**
+             *  @brief Produces the exclusive time of every distinct call stack in the collapsed stack format read by
+             *  flamegraph tools: one line per stack of semicolon separated function names followed by the time.
+             */
+            std::string getCollapsedStacks() const;
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            struct CallTreeNode
+            {
+                explicit CallTreeNode(Function* function) : mFunction(function), mExclusiveTime(0)
+                {
+
+                }
+
+                //! The function this node represents, or nullptr for the root.
+                Function* mFunction;
+
+                //! Time spent in this function when called through this exact stack.
+                std::uint64_t mExclusiveTime;
+
+                std::map<Function*, std::unique_ptr<CallTreeNode>> mChildren;
+            };
+
+            struct ActiveCall
+            {
+                Function* mFunction;
+                FunctionStatistics* mStatistics;
+                CallSiteStatistics* mCallSite;
+                CallTreeNode* mNode;
+                Clock::time_point mStart;
+
+                //! Inclusive time of every call made by this one so far.
+                std::uint64_t mChildTime;
+
+                //! The opcode that was accumulating time when the call was made, resumed once it returns.
+                bool mResumeInstruction;
+                OpCode mResumedInstruction;
+            };
+
+            static std::string getFunctionName(Function* function);
+            static void writeCollapsedStacks(std::ostream& out, const CallTreeNode& node, const std::string& prefix);
+
+            OpCodeStatistics mOpCodeStatistics[static_cast<std::size_t>(OpCode::OpCodeCount)];
+
+            //! Execution counts of opcode pairs, indexed by the first and then the second opcode.
+            std::uint64_t mOpCodePairCounts[static_cast<std::size_t>(OpCode::OpCodeCount)][static_cast<std::size_t>(OpCode::OpCodeCount)];
+
+            //! Whether an opcode is currently accumulating time.
+            bool mInstructionActive;
+
+            //! The opcode currently accumulating time.
+            OpCode mActiveInstruction;
+
+            //! When the active opcode started.
+            Clock::time_point mInstructionStart;
+
+            std::unordered_map<Function*, FunctionStatistics> mFunctionStatistics;
+            std::map<std::pair<const Bytecode*, std::size_t>, CallSiteStatistics> mCallSiteStatistics;
+
+            //! All calls currently executing, innermost last.
+            std::vector<ActiveCall> mActiveCalls;
+
+            //! The number of active calls of each function, so recursive calls are not counted twice.
+            std::unordered_map<Function*, std::size_t> mActiveCallCounts;
+
+            //! The root of the tree of every call stack seen.
+            std::unique_ptr<CallTreeNode> mCallTree;
+    };
+}
@@ -22,6 +22,7 @@
 #include <tribalscript/function.hpp>
 #include <tribalscript/consoleobject.hpp>
 #include <tribalscript/storedvalue.hpp>
+#include <tribalscript/casefolding.hpp>
 #include <tribalscript/stringhelpers.hpp>
 #include <tribalscript/storedvaluestack.hpp>
 
@@ -50,12 +51,19 @@ namespace TribalScript
             void removeConsoleObject(Interpreter* interpreter, ConsoleObject* target) override;
 
         private:
-            unsigned int mNextObjectID;
+            //! Every object by ID. IDs are dense indices into this table and released IDs hold nullptr.
+            std::vector<ConsoleObject*> mConsoleObjectsByID;
 
-            //! A mapping of object IDs to their sim objects
-            std::unordered_map<unsigned int, ConsoleObject*> mConsoleObjectsByID;
+            //! Released IDs, reused before the ID table is grown.
+            std::vector<unsigned int> mFreeObjectIDs;
 
-            //! A mapping of object names to their sim objects
-            std::unordered_map<std::string, ConsoleObject*> mConsoleObjectsByName;
+            //! The ID of every registered object.
+            std::unordered_map<ConsoleObject*, unsigned int> mObjectIDs;
+
+            //! A mapping of object names to their sim objects, ignoring case
+            CaseInsensitiveMap<ConsoleObject*> mConsoleObjectsByName;
+
+            //! The lower case name of every named object.
+            std::unordered_map<ConsoleObject*, std::string> mObjectNames;
     };
 }
@@ -39,6 +39,8 @@ namespace TribalScript
             void openForWrite() override;
             void openForRead() override;
             void openForReadAndWrite() override;
+            void openForBinaryRead() override;
+            void openForBinaryWrite() override;
 
             bool exists() override;
             bool deleteFile() override;
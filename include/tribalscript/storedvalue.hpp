@@ -18,7 +18,10 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <cstring>
+#include <cstdint>
+#include <limits>
 
 #include <tribalscript/stringtable.hpp>
 
@@ -28,7 +31,7 @@ namespace TribalScript
     class ConsoleObject;
     class ExecutionState;
 
-    enum StoredValueType
+    enum StoredValueType : std::uint8_t
     {
         NullType,
         Integer,
@@ -37,129 +40,241 @@ namespace TribalScript
         SubfieldReference
     };
 
-    union StoredValueUnion
+    /**
+     *  @brief Reference counted heap storage for strings that are too long to be stored inline in a StoredValue.
+     *  Copying a StoredValue holding one of these only increments the reference count.
+     */
+    struct StoredString
     {
-        int mInteger;
-        float mFloat;
-        char* mStringPointer;
+        //! The number of StoredValue instances sharing this string.
+        std::size_t mReferenceCount;
 
-        StoredValueUnion()
-        {
+        //! The length of the string, excluding the NULL terminator.
+        std::size_t mLength;
 
-        }
+        //! The longest string that fits in the allocation, excluding the NULL terminator.
+        std::size_t mCapacity;
 
-        explicit StoredValueUnion(const int value) : mInteger(value)
-        {
+        //! Whether mInteger and mFloat hold the numeric interpretation of the string. Shared strings never change,
+        //! so this only has to be parsed again after an unshared string has been appended to.
+        bool mNumberParsed;
 
-        }
+        //! The string interpreted as an integer, once mNumberParsed is set.
+        int mInteger;
 
-        explicit StoredValueUnion(const float value) : mFloat(value)
-        {
+        //! The string interpreted as a float, once mNumberParsed is set.
+        float mFloat;
 
-        }
+        //! Where each component of the string starts when split by mComponentDelineator, or nullptr until
+        //! StoredValue::getComponentOffsets is first called. Dropped whenever the string changes.
+        std::vector<std::size_t>* mComponentOffsets;
 
-        explicit StoredValueUnion(char* value) : mStringPointer(value)
-        {
+        //! The delineator mComponentOffsets was built for.
+        unsigned char mComponentDelineator;
 
-        }
+        //! The NULL terminated string data. The allocation extends past the end of the struct.
+        char mCharacters[1];
+
+        /**
+         *  @brief Allocates a new StoredString with a reference count of one.
+         *  @param value The string data to copy in.
+         *  @param length The number of characters to copy from value.
+         */
+        static StoredString* allocate(const char* value, const std::size_t length);
+
+        /**
+         *  @brief Allocates a new StoredString with a reference count of one and room to grow.
+         *  @param value The string data to copy in.
+         *  @param length The number of characters to copy from value.
+         *  @param capacity The longest string the allocation should fit, which must be at least length.
+         */
+        static StoredString* allocate(const char* value, const std::size_t length, const std::size_t capacity);
+
+        /**
+         *  @brief Decrements the reference count of the string, freeing it once no references remain.
+         */
+        static void release(StoredString* string);
     };
 
     /**
      *  @brief Storage class used to keep variable values in-memory of arbitrary data types.
-     *  The data types supported as integers, floats and strings (via string ID table references).
+     *  The data types supported as integers, floats and strings.
+     *  @details Values are a 16 byte tagged union: numbers, references and short strings are stored inline
+     *  and only strings longer than SmallStringCapacity are heap allocated. Copying a numeric value never
+     *  touches the heap.
      */
-    class StoredValue
+    class alignas(8) StoredValue
     {
     public:
-        StoredValue(void* memoryLocation, const StoredValueType type) : mType(type), mStorage(), mMemoryLocation(memoryLocation), mConsoleObject(nullptr), mReference(nullptr)
-        {
+        //! The longest string that is stored inline, excluding the NULL terminator.
+        static const std::size_t SmallStringCapacity = 13;
 
+        StoredValue(void* memoryLocation, const StoredValueType type) : mSmallLength(0), mTag(type == StoredValueType::Integer ? Tag::IntegerLocation : Tag::FloatLocation)
+        {
+            this->store(memoryLocation);
         }
 
-        explicit StoredValue(float* memoryLocation) : mType(StoredValueType::Float), mStorage(), mMemoryLocation(memoryLocation), mConsoleObject(nullptr), mReference(nullptr)
+        explicit StoredValue(float* memoryLocation) : mSmallLength(0), mTag(Tag::FloatLocation)
         {
-
+            this->store(memoryLocation);
         }
 
-        explicit StoredValue(int* memoryLocation) : mType(StoredValueType::Integer), mStorage(), mMemoryLocation(memoryLocation), mConsoleObject(nullptr), mReference(nullptr)
+        explicit StoredValue(int* memoryLocation) : mSmallLength(0), mTag(Tag::IntegerLocation)
         {
-
+            this->store(memoryLocation);
         }
 
-        explicit StoredValue(const int value) : mType(StoredValueType::Integer), mStorage(value), mMemoryLocation(nullptr), mConsoleObject(nullptr), mReference(nullptr)
+        explicit StoredValue(const int value) : mSmallLength(0), mTag(Tag::Integer)
         {
-
+            this->store(value);
         }
 
-        explicit StoredValue(const float value) : mType(StoredValueType::Float), mStorage(value), mMemoryLocation(nullptr), mConsoleObject(nullptr), mReference(nullptr)
+        explicit StoredValue(const float value) : mSmallLength(0), mTag(Tag::Float)
         {
-
+            this->store(value);
         }
 
-        explicit StoredValue(const char* value, const std::size_t stringLength = 0) : mType(StoredValueType::String), mStorage(), mMemoryLocation(nullptr), mConsoleObject(nullptr), mReference(nullptr)
+        explicit StoredValue(const char* value) : StoredValue(value, std::strlen(value))
         {
-            // Initialize memory
-            const std::size_t valueLength = stringLength ? stringLength : strlen(value);
 
-            mStorage.mStringPointer = new char[valueLength + 1];
-            std::memcpy(mStorage.mStringPointer, value, valueLength);
-            mStorage.mStringPointer[valueLength] = 0x00;
         }
 
-        //StoredValue(ConsoleObject* object, const std::size_t field) : mType(StoredValueType::SubfieldReference), mStorage(field), mMemoryLocation(nullptr), mConsoleObject(object), mReference(nullptr)
-       // {
+        explicit StoredValue(const char* value, const std::size_t valueLength) : mSmallLength(0)
+        {
+            if (valueLength <= SmallStringCapacity)
+            {
+                mTag = Tag::SmallString;
+                mSmallLength = static_cast<std::uint8_t>(valueLength);
+                std::memcpy(mData, value, valueLength);
+                mData[valueLength] = 0x00;
+            }
+            else
+            {
+                mTag = Tag::HeapString;
+                this->store(StoredString::allocate(value, valueLength));
+            }
+        }
 
-       // }
+        explicit StoredValue(StoredValue* referenced) : mSmallLength(0), mTag(Tag::Reference)
+        {
+            this->store(referenced);
+        }
 
-        explicit StoredValue(StoredValue* referenced) : mType(StoredValueType::NullType), mMemoryLocation(nullptr), mConsoleObject(nullptr), mReference(referenced)
+        StoredValue(const StoredValue& copied) : mSmallLength(copied.mSmallLength), mTag(copied.mTag)
         {
+            std::memcpy(mData, copied.mData, sizeof(mData));
+            if (mTag == Tag::HeapString)
+            {
+                ++this->load<StoredString*>()->mReferenceCount;
+            }
+        }
 
+        StoredValue(StoredValue&& moved) noexcept : mSmallLength(moved.mSmallLength), mTag(moved.mTag)
+        {
+            std::memcpy(mData, moved.mData, sizeof(mData));
+            moved.mTag = Tag::Null;
         }
 
-        StoredValue(const StoredValue& copied) : mType(copied.mType), mStorage(copied.mStorage), mMemoryLocation(copied.mMemoryLocation), mConsoleObject(copied.mConsoleObject), mReference(copied.mReference)
+        ~StoredValue()
         {
-            if (copied.mType == StoredValueType::String)
+            if (mTag == Tag::HeapString)
             {
-                const std::size_t valueLength = std::strlen(copied.mStorage.mStringPointer);
+                StoredString::release(this->load<StoredString*>());
+            }
+        }
 
-                mStorage.mStringPointer = new char[valueLength + 1];
-                std::memcpy(mStorage.mStringPointer, copied.mStorage.mStringPointer, valueLength);
-                mStorage.mStringPointer[valueLength] = 0x00;
+        StoredValue& operator=(const StoredValue& copied)
+        {
+            if (copied.mTag == Tag::HeapString)
+            {
+                ++copied.load<StoredString*>()->mReferenceCount;
+            }
+            if (mTag == Tag::HeapString)
+            {
+                StoredString::release(this->load<StoredString*>());
             }
+
+            std::memcpy(mData, copied.mData, sizeof(mData));
+            mSmallLength = copied.mSmallLength;
+            mTag = copied.mTag;
+            return *this;
         }
 
-        ~StoredValue()
+        StoredValue& operator=(StoredValue&& moved) noexcept
         {
-            if (mType == StoredValueType::String)
+            if (this != &moved)
             {
-                // delete mStorage.mStringPointer;
+                if (mTag == Tag::HeapString)
+                {
+                    StoredString::release(this->load<StoredString*>());
+                }
+
+                std::memcpy(mData, moved.mData, sizeof(mData));
+                mSmallLength = moved.mSmallLength;
+                mTag = moved.mTag;
+                moved.mTag = Tag::Null;
             }
+            return *this;
         }
 
+        /// @name Arithmetic
+        ///
+        /// Arithmetic is performed in integers when both operands hold integers and in floats otherwise. Integer
+        /// results that do not fit in an int are produced as floats instead.
+        /// @{
+        ///
+
         friend StoredValue operator+(const StoredValue& lhs, const StoredValue& rhs)
         {
-            // FIXME: For now we normalize to floats
+            int lhsInteger;
+            int rhsInteger;
+            if (lhs.loadInteger(lhsInteger) && rhs.loadInteger(rhsInteger))
+            {
+                return fromInteger(static_cast<std::int64_t>(lhsInteger) + rhsInteger);
+            }
             return StoredValue(lhs.toFloat() + rhs.toFloat());
         }
 
         friend StoredValue operator-(const StoredValue& lhs, const StoredValue& rhs)
         {
-            // FIXME: For now we normalize to floats
+            int lhsInteger;
+            int rhsInteger;
+            if (lhs.loadInteger(lhsInteger) && rhs.loadInteger(rhsInteger))
+            {
+                return fromInteger(static_cast<std::int64_t>(lhsInteger) - rhsInteger);
+            }
             return StoredValue(lhs.toFloat() - rhs.toFloat());
         }
 
-        friend StoredValue operator/(const StoredValue& lhs, const StoredValue& rhs)
+        friend StoredValue operator*(const StoredValue& lhs, const StoredValue& rhs)
         {
-            // FIXME: For now we normalize to floats
-            return StoredValue(lhs.toFloat() / rhs.toFloat());
+            int lhsInteger;
+            int rhsInteger;
+            if (lhs.loadInteger(lhsInteger) && rhs.loadInteger(rhsInteger))
+            {
+                return fromInteger(static_cast<std::int64_t>(lhsInteger) * rhsInteger);
+            }
+            return StoredValue(lhs.toFloat() * rhs.toFloat());
         }
 
-        friend StoredValue operator*(const StoredValue& lhs, const StoredValue& rhs)
+        friend StoredValue operator-(const StoredValue& value)
         {
-            // FIXME: For now we normalize to floats
-            return StoredValue(lhs.toFloat() * rhs.toFloat());
+            int integer;
+            if (value.loadInteger(integer))
+            {
+                return fromInteger(-static_cast<std::int64_t>(integer));
+            }
+            return StoredValue(-value.toFloat());
         }
 
+        friend StoredValue operator/(const StoredValue& lhs, const StoredValue& rhs)
+        {
+            // Division always produces a float
+            return StoredValue(lhs.toFloat() / rhs.toFloat());
+        }
+
+        /// @}
+
         /// @name Value Retrieval
         ///
         /// These functions are used to retrieve the data stored in this object.
@@ -180,7 +295,24 @@ namespace TribalScript
          *  @param scope The execution scope within which this conversion is occurring.
          *  @return A string representation of this value.
          */
-        std::string toString();
+        std::string toString() const;
+
+        /**
+         *  @brief Retrieves the characters of a string without copying them.
+         *  @param characters Set to the NULL terminated characters of the string.
+         *  @param length Set to the length of the string.
+         *  @return True if this holds or references a string. Other values are left for toString to convert.
+         */
+        bool getStringData(const char*& characters, std::size_t& length) const;
+
+        /**
+         *  @brief Retrieves where each component of a heap string starts when split by the provided delineator,
+         *  as produced by findComponentOffsets. The offsets are cached on the string itself so that indexing
+         *  into the same string repeatedly only scans it once.
+         *  @return The offsets, or nullptr if this does not hold or reference a heap string. Shorter strings are
+         *  cheap enough to scan every time.
+         */
+        const std::vector<std::size_t>* getComponentOffsets(const unsigned char delineator) const;
 
         bool toBoolean() const;
 
@@ -190,7 +322,7 @@ namespace TribalScript
 
         StoredValue getReferencedValueCopy() const;
 
-        bool isInteger();
+        bool isInteger() const;
 
         /**
          *  @brief Sets the value of this object. Only has an effect if this object
@@ -202,14 +334,107 @@ namespace TribalScript
         bool setValue(const StoredValue& newValue);
         void setValue(const float newValue);
 
-        std::string getRepresentation();
+        /**
+         *  @brief Resizes the string directly held by this value, keeping the characters it already has. A heap
+         *  string not shared with any other value is grown in place and with spare capacity, so appending to it
+         *  repeatedly does not copy it every time; otherwise the characters are copied to a new string.
+         *  @param length The new length of the string, which must be at least the current length.
+         *  @return The NULL terminated characters of the string for the caller to fill in past the old length, or
+         *  nullptr if this does not directly hold a string.
+         */
+        char* resizeString(const std::size_t length);
+
+        std::string getRepresentation() const;
 
     private:
-        StoredValueType mType;
-        StoredValueUnion mStorage;
+        //! What is currently stored in mData.
+        enum class Tag : std::uint8_t
+        {
+            Null,
+            Integer,
+            Float,
+            SmallString,
+            HeapString,
+            Reference,
+            IntegerLocation,
+            FloatLocation
+        };
+
+        template <typename ValueType>
+        ValueType load() const
+        {
+            ValueType result;
+            std::memcpy(&result, mData, sizeof(ValueType));
+            return result;
+        }
+
+        template <typename ValueType>
+        void store(const ValueType value)
+        {
+            std::memcpy(mData, &value, sizeof(ValueType));
+        }
+
+        /**
+         *  @brief Follows references until a value holding actual data is found.
+         */
+        const StoredValue* resolve() const;
+
+        /**
+         *  @brief Retrieves the value as an int without any conversion.
+         *  @return True if this holds or references an integer, in which case it is written to out.
+         */
+        bool loadInteger(int& out) const
+        {
+            const StoredValue* value = this;
+            while (value->mTag == Tag::Reference)
+            {
+                value = value->load<StoredValue*>();
+            }
+
+            switch (value->mTag)
+            {
+                case Tag::Integer:
+                    out = value->load<int>();
+                    return true;
+                case Tag::IntegerLocation:
+                    out = *value->load<int*>();
+                    return true;
+                default:
+                    return false;
+            }
+        }
 
-        void* mMemoryLocation;
-        ConsoleObject* mConsoleObject;
-        StoredValue* mReference;
+        /**
+         *  @brief Produces the result of integer arithmetic, falling back to a float if it does not fit in an int.
+         */
+        static StoredValue fromInteger(const std::int64_t value)
+        {
+            if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+            {
+                return StoredValue(static_cast<float>(value));
+            }
+            return StoredValue(static_cast<int>(value));
+        }
+
+        /**
+         *  @brief Parses the numeric interpretation of a heap string once, caching it on the string.
+         */
+        static const StoredString* parseHeapString(StoredString* string);
+
+        //! The longest formatted float that is cached in mData after the float itself.
+        static const std::size_t FormattedFloatCacheCapacity = SmallStringCapacity + 1 - sizeof(float);
+
+        //! Inline payload: an int, float or pointer depending on mTag, or the characters of a small string. Floats
+        //! are followed by their formatted form once toString has been called, which is why this is mutable.
+        mutable char mData[SmallStringCapacity + 1];
+
+        //! The length of the small string stored in mData, if any. For floats, the length of the cached formatted
+        //! form, or 0 if it has not been cached yet.
+        mutable std::uint8_t mSmallLength;
+
+        //! What is currently stored in mData.
+        Tag mTag;
     };
+
+    static_assert(sizeof(StoredValue) == 16, "StoredValue is expected to be 16 bytes");
 }
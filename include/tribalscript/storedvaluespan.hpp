@@ -0,0 +1,81 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+#include <tribalscript/storedvalue.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief A non owning view over a contiguous run of StoredValue instances. This is used to pass call arguments, which
+     *  remain on the caller's stack for the duration of the call rather than being copied into a container.
+     *  @warning The viewed values are only valid until the stack they live on is modified.
+     */
+    class StoredValueSpan
+    {
+        public:
+            StoredValueSpan() : mData(nullptr), mSize(0)
+            {
+
+            }
+
+            StoredValueSpan(StoredValue* data, const std::size_t size) : mData(data), mSize(size)
+            {
+
+            }
+
+            std::size_t size() const
+            {
+                return mSize;
+            }
+
+            bool empty() const
+            {
+                return mSize == 0;
+            }
+
+            StoredValue& operator[](const std::size_t index) const
+            {
+                assert(index < mSize);
+                return mData[index];
+            }
+
+            StoredValue& back() const
+            {
+                assert(mSize != 0);
+                return mData[mSize - 1];
+            }
+
+            StoredValue* begin() const
+            {
+                return mData;
+            }
+
+            StoredValue* end() const
+            {
+                return mData + mSize;
+            }
+
+        private:
+            //! The first value in the span.
+            StoredValue* mData;
+
+            //! The number of values in the span.
+            std::size_t mSize;
+    };
+}
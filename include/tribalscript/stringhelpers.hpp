@@ -14,19 +14,118 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
 #include <sstream>
 
 #include <tribalscript/storedvaluestack.hpp>
+#include <tribalscript/numberformatter.hpp>
 
 namespace TribalScript
 {
     std::string toLowerCase(const std::string& in);
     std::string expandEscapeSequences(const std::string& in);
-    std::vector<std::pair<std::size_t, std::size_t>> getDelineatorData(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count, std::size_t& realDelineatorCount);
-    std::vector<std::string> getStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count);
-    std::string getStringComponentsJoined(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count);
 
+    /**
+     *  @brief Expands the escape sequences of a string literal in a single pass. This handles \\n, \\t, \\r, \\\\,
+     *  \\" and \\', hex escapes of one or two digits such as \\x41, and the color escapes \\c0 through \\c9 along with
+     *  \\cr, \\cp and \\co. Any other sequence is kept as written.
+     *  @param in The characters of the literal, without its quotes.
+     *  @param length The number of characters.
+     *  @return The expanded string.
+     */
+    std::string expandEscapeSequences(const char* in, const std::size_t length);
+
+    /**
+     *  @brief Finds where each component of a string split by a single character delineator starts. Every
+     *  delineator ends one component and starts the next, so the first component always starts at 0 and a string
+     *  with n delineators has n + 1 components, some of which may be empty.
+     *  @param characters The string to split.
+     *  @param length The length of the string.
+     *  @param delineator The character separating components.
+     *  @param out Replaced with the offset of each component.
+     */
+    void findComponentOffsets(const char* characters, const std::size_t length, const unsigned char delineator, std::vector<std::size_t>& out);
+
+    /**
+     *  @brief Indexes into the components of a string split by a single character delineator, as done by getWord,
+     *  getField and friends. Components are located through findComponentOffsets, which heap strings cache so that
+     *  repeatedly indexing into the same string does not rescan it.
+     */
+    class StringComponents
+    {
+        public:
+            /**
+             *  @param value The value to split. This must outlive the StringComponents instance.
+             *  @param delineator The character separating components.
+             */
+            StringComponents(const StoredValue& value, const unsigned char delineator);
+
+            /**
+             *  @param value The string to split. This must outlive the StringComponents instance.
+             *  @param delineator The character separating components.
+             */
+            StringComponents(const std::string& value, const unsigned char delineator);
+
+            StringComponents(const StringComponents&) = delete;
+            StringComponents& operator=(const StringComponents&) = delete;
+
+            /**
+             *  @brief Retrieves the number of components the way getWordCount counts them: an empty string has none
+             *  and a trailing delineator does not start another component.
+             */
+            std::size_t getCount() const;
+
+            /**
+             *  @brief Retrieves a run of components along with the delineators between them.
+             *  @param first The index of the first component.
+             *  @param count The number of components. Runs past the last component are cut short.
+             *  @return The components, or an empty string if there are none in range.
+             */
+            StoredValue getComponents(const std::size_t first, const std::size_t count) const;
+
+            /**
+             *  @brief Retrieves a run of components as individual strings.
+             */
+            std::vector<std::string> getComponentStrings(const std::size_t first, const std::size_t count) const;
+
+            /**
+             *  @brief Produces a copy of the string with a run of components replaced. Components that do not exist yet
+             *  are appended, with empty components inserted up to the first one if necessary.
+             *  @param first The index of the first component to replace.
+             *  @param newComponents The components to put in place.
+             */
+            std::string setComponents(const std::size_t first, const std::vector<std::string>& newComponents) const;
+
+        private:
+            //! The index one past the last character of a component, excluding the delineator ending it.
+            std::size_t getComponentEnd(const std::size_t component) const
+            {
+                return component + 1 < mOffsets->size() ? (*mOffsets)[component + 1] - 1 : mLength;
+            }
+
+            //! The character separating components.
+            unsigned char mDelineator;
+
+            //! The characters of the string being split.
+            const char* mCharacters;
+
+            //! The length of the string being split.
+            std::size_t mLength;
+
+            //! Where each component starts, either cached on the string or pointing at mOwnedOffsets.
+            const std::vector<std::size_t>* mOffsets;
+
+            //! Offsets for strings that do not cache them.
+            std::vector<std::size_t> mOwnedOffsets;
+
+            //! The string representation of values that are not strings to begin with.
+            std::string mOwnedString;
+    };
+
+    std::vector<std::string> getStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count);
     std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents);
+
     static std::string resolveArrayNameFromStack(StoredValueStack& stack, ExecutionState* state, const std::string& base, const std::size_t argumentCount)
     {
         // Load array components
@@ -88,7 +187,9 @@ namespace TribalScript
     template <typename... parameters>
     static std::string resolveArrayName(const std::string& base, const float value, parameters... params)
     {
-        return TribalScript::resolveArrayName(base + "_" + std::to_string(value), params...);
+        // Formatted the same way as StoredValue::toString so names built natively match those built by scripts
+        char buffer[FormattedFloatBufferSize];
+        return TribalScript::resolveArrayName(base + "_" + std::string(buffer, formatFloat(value, buffer)), params...);
     }
 
 }
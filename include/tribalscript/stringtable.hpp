@@ -15,26 +15,125 @@
 #pragma once
 
 #include <cstddef>
-#include <unordered_map>
+#include <cstdint>
+#include <deque>
+#include <vector>
 #include <string>
-#include <functional>
 
 namespace TribalScript
 {
-    typedef std::size_t StringTableEntry;
+    //! Identifies a string interned in a StringTable. Entries are assigned sequentially starting at 0.
+    typedef std::uint32_t StringTableEntry;
 
     /**
      *  @brief A string table maintains a mapping of numeric identifiers to their
      *  raw string values. This is used to simplify code referencing strings
      *  by using a fixed width identifier.
-     *  @details String identifiers are currently generated by taking a hash of the
-     *  input string. The hash algorithm used is defined by std::hash in the STL.
+     *  @details Every distinct string is stored once and assigned the next sequential identifier, so data keyed by
+     *  strings can be held in flat arrays indexed by entry. Each entry also records the entry of its lower case
+     *  form, which lets case insensitive lookups of previously seen strings complete without folding or allocating.
      */
-    class StringTable : public std::unordered_map<StringTableEntry, std::string>
+    class StringTable
     {
         public:
+            StringTable();
+
+            /**
+             *  @brief Retrieves the entry of a string, assigning a new entry if the string has not been seen before.
+             *  @param string The string to look up. This is case sensitive.
+             *  @return The entry of the string.
+             */
             StringTableEntry getOrAssign(const std::string& string);
 
-            const std::string& getString(const StringTableEntry id);
+            /**
+             *  @brief Retrieves the entry of a string, assigning a new entry if the string has not been seen before.
+             *  No allocation occurs if the string is already present.
+             *  @param string The characters of the string to look up. This does not have to be null terminated.
+             *  @param length The number of characters in string.
+             *  @return The entry of the string.
+             */
+            StringTableEntry getOrAssign(const char* string, const std::size_t length);
+
+            /**
+             *  @brief Retrieves the entry of the lower case form of a string, assigning entries as necessary.
+             *  @param string The string to look up.
+             *  @return The entry of the lower case form of string.
+             */
+            StringTableEntry getOrAssignFolded(const std::string& string);
+
+            /**
+             *  @brief Retrieves the entry of the lower case form of a string, assigning entries as necessary.
+             *  No allocation occurs if the string is already present.
+             *  @param string The characters of the string to look up. This does not have to be null terminated.
+             *  @param length The number of characters in string.
+             *  @return The entry of the lower case form of string.
+             */
+            StringTableEntry getOrAssignFolded(const char* string, const std::size_t length);
+
+            /**
+             *  @brief Looks up the entry of a string without assigning one if the string has not been seen before.
+             *  @param string The characters of the string to look up. This is case sensitive and does not have to be
+             *  null terminated.
+             *  @param length The number of characters in string.
+             *  @param result Receives the entry of the string when it is found.
+             *  @return True if the string has an entry.
+             */
+            bool find(const char* string, const std::size_t length, StringTableEntry& result) const;
+
+            /**
+             *  @brief Looks up the entry of the lower case form of a string without assigning any entries or allocating.
+             *  @param string The characters of the string to look up. This does not have to be null terminated.
+             *  @param length The number of characters in string.
+             *  @param result Receives the entry of the lower case form of string when it is found.
+             *  @return True if the lower case form of string has an entry.
+             */
+            bool findFolded(const char* string, const std::size_t length, StringTableEntry& result) const;
+
+            /**
+             *  @brief Retrieves the entry of the lower case form of an existing entry.
+             *  @param id The entry to fold.
+             *  @return The entry of the lower case form of id. This is id itself if it is already lower case.
+             */
+            StringTableEntry getFolded(const StringTableEntry id) const;
+
+            /**
+             *  @brief Retrieves the string of an existing entry. The returned reference remains valid for the
+             *  lifetime of the string table.
+             *  @param id The entry to look up.
+             *  @return The string assigned to id.
+             *  @throws std::out_of_range If id was never assigned.
+             */
+            const std::string& getString(const StringTableEntry id) const;
+
+            /**
+             *  @brief Retrieves the number of entries assigned so far. All entries are less than this value.
+             */
+            std::size_t size() const;
+
+        private:
+            //! Marks an unused bucket.
+            static const StringTableEntry EmptyBucket = 0xFFFFFFFF;
+
+            static std::size_t hashString(const char* string, const std::size_t length);
+
+            //! Hashes the lower case form of a string without allocating. This matches hashString of the folded string.
+            static std::size_t hashFolded(const char* string, const std::size_t length);
+
+            bool findHashed(const char* string, const std::size_t length, const std::size_t hash, StringTableEntry& result) const;
+
+            StringTableEntry assign(const char* string, const std::size_t length, const std::size_t hash);
+            void insertBucket(const StringTableEntry entry);
+
+            //! The string of every entry. A deque is used so references returned by getString are never invalidated.
+            std::deque<std::string> mStrings;
+
+            //! The hash of every entry.
+            std::vector<std::size_t> mHashes;
+
+            //! The entry of the lower case form of every entry.
+            std::vector<StringTableEntry> mFoldedEntries;
+
+            //! Open addressed hash buckets holding entries. The bucket count is always a power of two.
+            std::vector<StringTableEntry> mBuckets;
     };
 }
@@ -0,0 +1,93 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+
+#include <tribalscript/astarena.hpp>
+
+namespace TribalScript
+{
+    namespace AST
+    {
+        //! Size of each block allocated by an arena. Larger allocations are given a block of their own.
+        static const std::size_t sArenaBlockSize = 64 * 1024;
+
+        ASTArena::ASTArena() : mCurrent(nullptr), mEnd(nullptr), mBytesAllocated(0)
+        {
+
+        }
+
+        ASTArena::~ASTArena()
+        {
+            for (char* block : mBlocks)
+            {
+                delete[] block;
+            }
+        }
+
+        void* ASTArena::allocate(const std::size_t size, const std::size_t alignment)
+        {
+            assert((alignment & (alignment - 1)) == 0);
+            mBytesAllocated += size;
+
+            // Blocks come from new[], which is aligned for any fundamental type
+            if (size > sArenaBlockSize / 4)
+            {
+                char* block = new char[size];
+                mBlocks.push_back(block);
+                return block;
+            }
+
+            std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(mCurrent) + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            if (!mCurrent || address + size > reinterpret_cast<std::uintptr_t>(mEnd))
+            {
+                mCurrent = new char[sArenaBlockSize];
+                mEnd = mCurrent + sArenaBlockSize;
+                mBlocks.push_back(mCurrent);
+
+                address = reinterpret_cast<std::uintptr_t>(mCurrent);
+            }
+
+            mCurrent = reinterpret_cast<char*>(address + size);
+            return reinterpret_cast<void*>(address);
+        }
+
+        StringView ASTArena::createString(const char* data, const std::size_t size)
+        {
+            if (size == 0)
+            {
+                return StringView();
+            }
+
+            char* text = static_cast<char*>(this->allocate(size, 1));
+            std::memcpy(text, data, size);
+            return StringView(text, size);
+        }
+
+        StringView ASTArena::createString(const std::string& string)
+        {
+            return this->createString(string.data(), string.size());
+        }
+
+        std::size_t ASTArena::getBytesAllocated() const
+        {
+            return mBytesAllocated;
+        }
+
+        std::size_t ASTArena::getBlockCount() const
+        {
+            return mBlocks.size();
+        }
+    }
+}
@@ -24,7 +24,7 @@ namespace TribalScript
 {
     namespace AST
     {
-        ASTBuilder::ASTBuilder(StringTable* stringTable) : Tribes2BaseVisitor(), mStringTable(stringTable)
+        ASTBuilder::ASTBuilder(StringTable* stringTable, ASTArena* arena) : Tribes2BaseVisitor(), mStringTable(stringTable), mArena(arena)
         {
 
         }
@@ -50,7 +50,7 @@ namespace TribalScript
         antlrcpp::Any ASTBuilder::visitProgram(Tribes2Parser::ProgramContext* context)
         {
             std::vector<AST::ASTNode*> children = this->visitChildren(context).as<std::vector<AST::ASTNode*>>();
-            return new AST::ProgramNode(children);
+            return mArena->create<AST::ProgramNode>(mArena->createList(children));
         }
 
         antlrcpp::Any ASTBuilder::visitPackage_declaration(Tribes2Parser::Package_declarationContext* context)
@@ -58,7 +58,7 @@ namespace TribalScript
             std::vector<AST::ASTNode*> result;
 
             std::vector<AST::ASTNode*> children = this->visitChildren(context).as<std::vector<AST::ASTNode*>>();
-            auto package = new AST::PackageDeclarationNode(context->LABEL()->getText(), children);
+            auto package = mArena->create<AST::PackageDeclarationNode>(mArena->createString(context->LABEL()->getText()), mArena->createList(children));
 
             result.push_back(package);
             return result;
@@ -73,7 +73,7 @@ namespace TribalScript
             ASTNode* parent = parameters[0];
             parameters.erase(parameters.begin());
 
-            result.push_back(new AST::ArrayNode(parent, parameters));
+            result.push_back(mArena->create<AST::ArrayNode>(parent, mArena->createList(parameters)));
             return result;
         }
 
@@ -86,7 +86,7 @@ namespace TribalScript
             ASTNode* parent = parameters[0];
             parameters.erase(parameters.begin());
 
-            result.push_back(new AST::ArrayNode(parent, parameters));
+            result.push_back(mArena->create<AST::ArrayNode>(parent, mArena->createList(parameters)));
             return result;
         }
 
@@ -105,7 +105,7 @@ namespace TribalScript
             calledFunctionNameSpace = calledFunctionNameComponents[0]->getText();
 
             std::vector<AST::ASTNode*> parameters = this->visitChildren(context).as<std::vector<AST::ASTNode*>>();
-            auto call = new AST::FunctionCallNode(calledFunctionNameSpace, calledFunctionName, parameters);
+            auto call = mArena->create<AST::FunctionCallNode>(mArena->createString(calledFunctionNameSpace), mArena->createString(calledFunctionName), mArena->createList(parameters));
 
             result.push_back(call);
             return result;
@@ -119,7 +119,7 @@ namespace TribalScript
             auto primaryChain = dynamic_cast<Tribes2Parser::Primary_chainContext*>(context->parent);
             const bool isSubcall = dynamic_cast<Tribes2Parser::Chain_startContext*>(context->parent) ? false : true;
 
-            auto call = new AST::SubFunctionCallNode(context->LABEL()->getText(), parameters);
+            auto call = mArena->create<AST::SubFunctionCallNode>(mArena->createString(context->LABEL()->getText()), mArena->createList(parameters));
             result.push_back(call);
 
             return result;
@@ -133,7 +133,7 @@ namespace TribalScript
             Tribes2Parser::Primary_chainContext* primaryChain = dynamic_cast<Tribes2Parser::Primary_chainContext*>(context->parent);
             const bool isSubcall = dynamic_cast<Tribes2Parser::Chain_startContext*>(context->parent) ? false : true;
 
-            AST::FunctionCallNode* call = new AST::FunctionCallNode("", context->LABEL()->getText(), parameters);
+            AST::FunctionCallNode* call = mArena->create<AST::FunctionCallNode>("", mArena->createString(context->LABEL()->getText()), mArena->createList(parameters));
             result.push_back(call);
 
             return result;
@@ -142,7 +142,7 @@ namespace TribalScript
         antlrcpp::Any ASTBuilder::visitField(Tribes2Parser::FieldContext* context)
         {
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::SubFieldNode(context->LABEL()->getText(), std::vector<ASTNode*>()));
+            result.push_back(mArena->create<AST::SubFieldNode>(mArena->createString(context->LABEL()->getText()), AST::ArenaList<ASTNode*>()));
             return result;
         }
 
@@ -151,7 +151,7 @@ namespace TribalScript
             std::vector<AST::ASTNode*> parameters = this->visitChildren(context).as<std::vector<AST::ASTNode*>>();
 ;
             std::vector<ASTNode*> result;
-            result.push_back(new AST::SubFieldNode(context->LABEL()->getText(), parameters));
+            result.push_back(mArena->create<AST::SubFieldNode>(mArena->createString(context->LABEL()->getText()), mArena->createList(parameters)));
             return result;
         }
 
@@ -161,7 +161,7 @@ namespace TribalScript
 
             // Load declaration parameter names
             // NOTE: For now we force locals but it appears globals are technically valid but buggy?
-            std::vector<std::string> parameterNames;
+            std::vector<AST::StringView> parameterNames;
             if (context->function_declaration_parameters())
             {
                 // Function_declaration_parametersContext
@@ -185,7 +185,7 @@ namespace TribalScript
                         }
                     }
 
-                    parameterNames.push_back(currentVariableName);
+                    parameterNames.push_back(mArena->createString(currentVariableName));
                 }
             }
 
@@ -218,7 +218,7 @@ namespace TribalScript
                 std::vector<AST::ASTNode*> statementNodes = this->visitChildren(statement).as<std::vector<AST::ASTNode*>>();
                 bodyStatements.insert(bodyStatements.end(), statementNodes.begin(), statementNodes.end());
             }
-            AST::FunctionDeclarationNode* function = new AST::FunctionDeclarationNode(functionNameSpace, functionName, parameterNames, bodyStatements);
+            AST::FunctionDeclarationNode* function = mArena->create<AST::FunctionDeclarationNode>(mArena->createString(functionNameSpace), mArena->createString(functionName), mArena->createList(parameterNames), mArena->createList(bodyStatements));
 
             result.push_back(function);
             return result;
@@ -230,43 +230,43 @@ namespace TribalScript
 
             if (context->INT())
             {
-                result.push_back(new AST::IntegerNode(std::stoi(context->INT()->getText())));
+                result.push_back(mArena->create<AST::IntegerNode>(std::stoi(context->INT()->getText())));
             }
             else if (context->FLOAT())
             {
-                result.push_back(new AST::FloatNode(std::stof(context->FLOAT()->getText())));
+                result.push_back(mArena->create<AST::FloatNode>(std::stof(context->FLOAT()->getText())));
             }
             else if (context->STRING())
             {
                 // FIXME: Is there a way to utilize the grammar to extract this instead? We don't want the enclosing quotations
                 const std::string rawString = context->STRING()->getText();
-                const std::string stringContent = rawString.substr(1, rawString.size() - 2);
+                const AST::StringView stringContent = mArena->createString(rawString.data() + 1, rawString.size() - 2);
 
-                result.push_back(new AST::StringNode(stringContent));
+                result.push_back(mArena->create<AST::StringNode>(stringContent));
             }
             else if (context->TAGGEDSTRING())
             {
                 // FIXME: Is there a way to utilize the grammar to extract this instead? We don't want the enclosing quotations
                 const std::string rawString = context->TAGGEDSTRING()->getText();
-                const std::string stringContent = rawString.substr(1, rawString.size() - 2);
+                const AST::StringView stringContent = mArena->createString(rawString.data() + 1, rawString.size() - 2);
 
-                result.push_back(new AST::TaggedStringNode(stringContent));
+                result.push_back(mArena->create<AST::TaggedStringNode>(stringContent));
             }
             else if (context->LABEL())
             {
-                result.push_back(new AST::StringNode(context->LABEL()->getText()));
+                result.push_back(mArena->create<AST::StringNode>(mArena->createString(context->LABEL()->getText())));
             }
             else if (context->TRUE())
             {
-                result.push_back(new AST::IntegerNode(1));
+                result.push_back(mArena->create<AST::IntegerNode>(1));
             }
             else if (context->FALSE())
             {
-                result.push_back(new AST::IntegerNode(0));
+                result.push_back(mArena->create<AST::IntegerNode>(0));
             }
             else if (context->HEXINT())
             {
-                result.push_back(new AST::IntegerNode(std::stoul(context->HEXINT()->getText(), nullptr, 16)));
+                result.push_back(mArena->create<AST::IntegerNode>(std::stoul(context->HEXINT()->getText(), nullptr, 16)));
             }
             else
             {
@@ -288,11 +288,11 @@ namespace TribalScript
 
             if (context->LOGICALAND())
             {
-                result.push_back(new AST::LogicalAndNode(left, right));
+                result.push_back(mArena->create<AST::LogicalAndNode>(left, right));
             }
             else if (context->LOGICALOR())
             {
-                result.push_back(new AST::LogicalOrNode(left, right));
+                result.push_back(mArena->create<AST::LogicalOrNode>(left, right));
             }
             else
             {
@@ -314,23 +314,23 @@ namespace TribalScript
 
             if (context->PLUS())
             {
-                result.push_back(new AST::AddNode(left, right));
+                result.push_back(mArena->create<AST::AddNode>(left, right));
             }
             else if (context->MINUS())
             {
-                result.push_back(new AST::MinusNode(left, right));
+                result.push_back(mArena->create<AST::MinusNode>(left, right));
             }
             else if (context->MULTIPLY())
             {
-                result.push_back(new AST::MultiplyNode(left, right));
+                result.push_back(mArena->create<AST::MultiplyNode>(left, right));
             }
             else if (context->DIVIDE())
             {
-                result.push_back(new AST::DivideNode(left, right));
+                result.push_back(mArena->create<AST::DivideNode>(left, right));
             }
             else if (context->MODULUS())
             {
-                result.push_back(new AST::ModulusNode(left, right));
+                result.push_back(mArena->create<AST::ModulusNode>(left, right));
             }
             else
             {
@@ -352,7 +352,7 @@ namespace TribalScript
 
             if (context->BITWISEOR())
             {
-                result.push_back(new AST::BitwiseOrNode(left, right));
+                result.push_back(mArena->create<AST::BitwiseOrNode>(left, right));
             }
             else
             {
@@ -376,7 +376,7 @@ namespace TribalScript
             AST::SubreferenceNode* currentLeft = nullptr;
             for (auto iterator = children.begin(); iterator != children.end(); ++iterator)
             {
-                AST::SubreferenceNode* newNode = new AST::SubreferenceNode(currentLeft, *iterator, nullptr);
+                AST::SubreferenceNode* newNode = mArena->create<AST::SubreferenceNode>(currentLeft, *iterator, nullptr);
 
                 if (currentLeft)
                 {
@@ -406,7 +406,7 @@ namespace TribalScript
             AST::SubreferenceNode* currentLeft = nullptr;
             for (auto iterator = children.begin(); iterator != children.end(); ++iterator)
             {
-                AST::SubreferenceNode* newNode = new AST::SubreferenceNode(currentLeft, *iterator, nullptr);
+                AST::SubreferenceNode* newNode = mArena->create<AST::SubreferenceNode>(currentLeft, *iterator, nullptr);
 
                 if (currentLeft)
                 {
@@ -436,7 +436,7 @@ namespace TribalScript
             AST::SubreferenceNode* currentLeft = nullptr;
             for (auto iterator = children.begin(); iterator != children.end(); ++iterator)
             {
-                AST::SubreferenceNode* newNode = new AST::SubreferenceNode(currentLeft, *iterator, nullptr);
+                AST::SubreferenceNode* newNode = mArena->create<AST::SubreferenceNode>(currentLeft, *iterator, nullptr);
 
                 if (currentLeft)
                 {
@@ -464,7 +464,7 @@ namespace TribalScript
 
             if (context->ASSIGN())
             {
-                result.push_back(new AST::AssignmentNode(left, right));
+                result.push_back(mArena->create<AST::AssignmentNode>(left, right));
             }
             else
             {
@@ -486,15 +486,15 @@ namespace TribalScript
 
             if (context->LESSTHAN())
             {
-                result.push_back(new AST::LessThanNode(left, right));
+                result.push_back(mArena->create<AST::LessThanNode>(left, right));
             }
             else if (context->GREATERTHAN())
             {
-                result.push_back(new AST::GreaterThanNode(left, right));
+                result.push_back(mArena->create<AST::GreaterThanNode>(left, right));
             }
 			else if (context->GREATERTHANOREQUAL())
 			{
-				result.push_back(new AST::GreaterThanOrEqualNode(left, right));
+				result.push_back(mArena->create<AST::GreaterThanOrEqualNode>(left, right));
 			}
             else
             {
@@ -516,19 +516,19 @@ namespace TribalScript
 
             if (context->EQUALS())
             {
-                result.push_back(new AST::EqualsNode(left, right));
+                result.push_back(mArena->create<AST::EqualsNode>(left, right));
             }
             else if (context->NOTEQUAL())
             {
-                result.push_back(new AST::NotEqualsNode(left, right));
+                result.push_back(mArena->create<AST::NotEqualsNode>(left, right));
             }
             else if (context->STRINGEQUALS())
             {
-                result.push_back(new AST::StringEqualsNode(left, right));
+                result.push_back(mArena->create<AST::StringEqualsNode>(left, right));
             }
             else if (context->STRINGNOTEQUAL())
             {
-                result.push_back(new AST::StringNotEqualNode(left, right));
+                result.push_back(mArena->create<AST::StringNotEqualNode>(left, right));
             }
             else
             {
@@ -550,19 +550,19 @@ namespace TribalScript
 
             if (context->CONCAT())
             {
-                result.push_back(new AST::ConcatNode(left, right, ""));
+                result.push_back(mArena->create<AST::ConcatNode>(left, right, ""));
             }
             else if (context->SPACECONCAT())
             {
-                result.push_back(new AST::ConcatNode(left, right, " "));
+                result.push_back(mArena->create<AST::ConcatNode>(left, right, " "));
             }
             else if (context->NEWLINECONCAT())
             {
-                result.push_back(new AST::ConcatNode(left, right, "\n"));
+                result.push_back(mArena->create<AST::ConcatNode>(left, right, "\n"));
             }
             else if (context->TABCONCAT())
             {
-                result.push_back(new AST::ConcatNode(left, right, "\t"));
+                result.push_back(mArena->create<AST::ConcatNode>(left, right, "\t"));
             }
             else
             {
@@ -582,11 +582,11 @@ namespace TribalScript
 
             if (context->MINUS())
             {
-                result.push_back(new AST::NegateNode(inner));
+                result.push_back(mArena->create<AST::NegateNode>(inner));
             }
             else if (context->NOT())
             {
-                result.push_back(new AST::NotNode(inner));
+                result.push_back(mArena->create<AST::NotNode>(inner));
             }
             else
             {
@@ -604,7 +604,7 @@ namespace TribalScript
             AST::ASTNode* incremented = result.back();
             result.pop_back();
 
-            result.push_back(new AST::IncrementNode(incremented));
+            result.push_back(mArena->create<AST::IncrementNode>(incremented));
             return result;
         }
 
@@ -618,7 +618,7 @@ namespace TribalScript
             AST::ASTNode* whileExpression = whileContent.front();
             whileContent.erase(whileContent.begin());
 
-            result.push_back(new AST::WhileNode(whileExpression, whileContent));
+            result.push_back(mArena->create<AST::WhileNode>(whileExpression, mArena->createList(whileContent)));
             return result;
         }
 
@@ -669,7 +669,7 @@ namespace TribalScript
                 AST::ASTNode* elseIfExpression = ifContent.back();
                 ifContent.pop_back();
 
-                elseIfs.push_back(new AST::ElseIfNode(elseIfExpression, elseIfBody));
+                elseIfs.push_back(mArena->create<AST::ElseIfNode>(elseIfExpression, mArena->createList(elseIfBody)));
             }
 
             // Handle primary if
@@ -693,7 +693,7 @@ namespace TribalScript
 
             // Output final result
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::IfNode(ifExpression, ifBody, elseIfs, elseBody));
+            result.push_back(mArena->create<AST::IfNode>(ifExpression, mArena->createList(ifBody), mArena->createList(elseIfs), mArena->createList(elseBody)));
             return result;
         }
 
@@ -744,7 +744,7 @@ namespace TribalScript
 
                 assert(caseExpressions.size() == caseExpressionCount);
 
-                switchCases.push_back(new AST::SwitchCaseNode(caseExpressions, caseBody));
+                switchCases.push_back(mArena->create<AST::SwitchCaseNode>(mArena->createList(caseExpressions), mArena->createList(caseBody)));
             }
 
             // Load switch expression
@@ -755,7 +755,7 @@ namespace TribalScript
 
             // Output final result
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::SwitchNode(switchExpression, switchCases, defaultBody));
+            result.push_back(mArena->create<AST::SwitchNode>(switchExpression, mArena->createList(switchCases), mArena->createList(defaultBody)));
             return result;
         }
 
@@ -773,7 +773,7 @@ namespace TribalScript
             forContent.erase(forContent.begin(), forContent.begin() + 3);
 
             // Remaining content is for body
-            result.push_back(new AST::ForNode(initializer, expression, advance, forContent));
+            result.push_back(mArena->create<AST::ForNode>(initializer, expression, advance, mArena->createList(forContent)));
             return result;
         }
 
@@ -783,46 +783,46 @@ namespace TribalScript
             assert(ternaryContent.size() == 3);
 
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::TernaryNode(ternaryContent[0], ternaryContent[1], ternaryContent[2]));
+            result.push_back(mArena->create<AST::TernaryNode>(ternaryContent[0], ternaryContent[1], ternaryContent[2]));
             return result;
         }
 
         antlrcpp::Any ASTBuilder::visitLocalvariable(Tribes2Parser::LocalvariableContext* context)
         {
-            std::vector<std::string> variableName;
+            std::vector<AST::StringView> variableName;
             std::vector<AST::ASTNode*> result;
             std::vector<Tribes2Parser::LabelwithkeywordsContext*> variableNameComponents = context->labelwithkeywords();
 
             variableName.reserve(variableNameComponents.size());
             for (Tribes2Parser::LabelwithkeywordsContext* component : variableNameComponents)
             {
-                variableName.push_back(component->getText());
+                variableName.push_back(mArena->createString(component->getText()));
             }
 
-            result.push_back(new AST::LocalVariableNode(variableName));
+            result.push_back(mArena->create<AST::LocalVariableNode>(mArena->createList(variableName)));
             return result;
         }
 
         antlrcpp::Any ASTBuilder::visitGlobalvariable(Tribes2Parser::GlobalvariableContext* context)
         {
-            std::vector<std::string> variableName;
+            std::vector<AST::StringView> variableName;
             std::vector<AST::ASTNode*> result;
             std::vector<Tribes2Parser::LabelwithkeywordsContext*> variableNameComponents = context->labelwithkeywords();
 
             variableName.reserve(variableNameComponents.size());
             for (Tribes2Parser::LabelwithkeywordsContext* component : variableNameComponents)
             {
-                variableName.push_back(component->getText());
+                variableName.push_back(mArena->createString(component->getText()));
             }
 
-            result.push_back(new AST::GlobalVariableNode(variableName));
+            result.push_back(mArena->create<AST::GlobalVariableNode>(mArena->createList(variableName)));
             return result;
         }
 
         antlrcpp::Any ASTBuilder::visitBreak_control(Tribes2Parser::Break_controlContext* context)
         {
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::BreakNode());
+            result.push_back(mArena->create<AST::BreakNode>());
 
             return result;
         }
@@ -830,7 +830,7 @@ namespace TribalScript
         antlrcpp::Any ASTBuilder::visitContinue_control(Tribes2Parser::Continue_controlContext* context)
         {
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::ContinueNode());
+            result.push_back(mArena->create<AST::ContinueNode>());
 
             return result;
         }
@@ -847,7 +847,7 @@ namespace TribalScript
                 result.pop_back();
             }
 
-            result.push_back(new AST::ReturnNode(expression));
+            result.push_back(mArena->create<AST::ReturnNode>(expression));
             return result;
         }
 
@@ -863,7 +863,7 @@ namespace TribalScript
             std::string fieldBaseName = context->labelwithkeywords()->getText();
 
             std::vector<AST::ASTNode*> result;
-            result.push_back(new AST::FieldAssignNode(fieldBaseName, fieldExpressions, fieldValue));
+            result.push_back(mArena->create<AST::FieldAssignNode>(mArena->createString(fieldBaseName), mArena->createList(fieldExpressions), fieldValue));
             return result;
         }
 
@@ -885,7 +885,7 @@ namespace TribalScript
             typeName = labels[0]->getText();
             name = labels[1]->getText();
 
-            result.push_back(new AST::DatablockDeclarationNode(name, typeName, parentName, fields));
+            result.push_back(mArena->create<AST::DatablockDeclarationNode>(mArena->createString(name), mArena->createString(typeName), mArena->createString(parentName), mArena->createList(fields)));
             return result;
         }
 
@@ -898,7 +898,7 @@ namespace TribalScript
             AST::ASTNode* typeName = nullptr;
             if (context->LABEL())
             {
-                typeName = new AST::StringNode(context->LABEL()->getText());
+                typeName = mArena->create<AST::StringNode>(mArena->createString(context->LABEL()->getText()));
             }
             else
             {
@@ -931,7 +931,7 @@ namespace TribalScript
                 }
             }
 
-            result.push_back(new AST::ObjectDeclarationNode(name, typeName, children, fields));
+            result.push_back(mArena->create<AST::ObjectDeclarationNode>(name, typeName, mArena->createList(children), mArena->createList(fields)));
             return result;
         }
     }
@@ -0,0 +1,1252 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include <tribalscript/bytecode.hpp>
+#include <tribalscript/function.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/instructions.hpp>
+#include <tribalscript/consoleobject.hpp>
+#include <tribalscript/stringhelpers.hpp>
+#include <tribalscript/executionstate.hpp>
+
+namespace TribalScript
+{
+    static inline float decodeFloat(const BytecodeWord word)
+    {
+        float result;
+        std::memcpy(&result, &word, sizeof(result));
+        return result;
+    }
+
+    static inline int decodeInteger(const BytecodeWord word)
+    {
+        int result;
+        std::memcpy(&result, &word, sizeof(result));
+        return result;
+    }
+
+    /**
+     *  @brief Tells an interpreter that bytecode is executing for as long as it is in scope, including when execution
+     *  ends in an exception.
+     */
+    class ExecutionGuard
+    {
+        public:
+            explicit ExecutionGuard(Interpreter* interpreter) : mInterpreter(interpreter)
+            {
+                mInterpreter->enterExecution();
+            }
+
+            ~ExecutionGuard()
+            {
+                mInterpreter->exitExecution();
+            }
+
+        private:
+            Interpreter* mInterpreter;
+    };
+
+    /**
+     *  @brief Removes the arguments of a completed call from the stack, moving the value returned by the callee, if
+     *  any, down into their place.
+     *  @param stack The stack the call was made from.
+     *  @param argumentsStart The index of the first stack entry belonging to the call.
+     *  @param argumentsEnd The index one past the last argument.
+     */
+    static void popCallArguments(StoredValueStack& stack, const std::size_t argumentsStart, const std::size_t argumentsEnd)
+    {
+        if (stack.size() > argumentsEnd)
+        {
+            stack[argumentsStart] = std::move(stack.back());
+            stack.erase(stack.begin() + argumentsStart + 1, stack.end());
+        }
+        else
+        {
+            stack.erase(stack.begin() + argumentsStart, stack.end());
+        }
+    }
+
+    /*
+        BytecodeAssembler
+    */
+
+    BytecodeAssembler::BytecodeAssembler() : mBytecode(new Bytecode()), mInstructionIndex(0)
+    {
+
+    }
+
+    std::shared_ptr<Bytecode> BytecodeAssembler::assemble(const InstructionSequence& instructions)
+    {
+        BytecodeAssembler assembler;
+
+        // Record where each instruction begins so relative jumps can be resolved to word offsets
+        std::vector<std::size_t> instructionAddresses;
+        instructionAddresses.reserve(instructions.size());
+
+        for (auto&& instruction : instructions)
+        {
+            instructionAddresses.push_back(assembler.mBytecode->mCode.size());
+            instruction->encode(assembler);
+            ++assembler.mInstructionIndex;
+        }
+
+        const std::size_t haltAddress = assembler.mBytecode->mCode.size();
+        assembler.emitOpCode(OpCode::Halt);
+
+        // Jumps outside of the program space end execution just like running off the end does
+        for (const JumpFixup& fixup : assembler.mJumpFixups)
+        {
+            std::size_t target = haltAddress;
+            if (fixup.mTarget >= 0 && static_cast<std::size_t>(fixup.mTarget) < instructionAddresses.size())
+            {
+                target = instructionAddresses[static_cast<std::size_t>(fixup.mTarget)];
+            }
+            assembler.mBytecode->mCode[fixup.mOperand] = static_cast<BytecodeWord>(target);
+        }
+
+        return assembler.mBytecode;
+    }
+
+    void BytecodeAssembler::emitOpCode(const OpCode op)
+    {
+        mBytecode->mCode.push_back(static_cast<BytecodeWord>(op));
+    }
+
+    void BytecodeAssembler::emitWord(const BytecodeWord word)
+    {
+        mBytecode->mCode.push_back(word);
+    }
+
+    void BytecodeAssembler::emitInteger(const int value)
+    {
+        BytecodeWord word;
+        std::memcpy(&word, &value, sizeof(word));
+        mBytecode->mCode.push_back(word);
+    }
+
+    void BytecodeAssembler::emitFloat(const float value)
+    {
+        BytecodeWord word;
+        std::memcpy(&word, &value, sizeof(word));
+        mBytecode->mCode.push_back(word);
+    }
+
+    void BytecodeAssembler::emitStringTableEntry(const StringTableEntry entry)
+    {
+        mBytecode->mStringTableEntryOperands.push_back(mBytecode->mCode.size());
+        mBytecode->mCode.push_back(static_cast<BytecodeWord>(entry));
+    }
+
+    void BytecodeAssembler::emitString(const std::string& value)
+    {
+        auto search = mStringIndices.find(value);
+        if (search != mStringIndices.end())
+        {
+            this->emitWord(search->second);
+            return;
+        }
+
+        const BytecodeWord index = static_cast<BytecodeWord>(mBytecode->mStrings.size());
+        mBytecode->mStrings.push_back(value);
+        mStringIndices.insert(std::make_pair(value, index));
+        this->emitWord(index);
+    }
+
+    void BytecodeAssembler::emitStringConstant(const std::string& value)
+    {
+        auto search = mStringConstantIndices.find(value);
+        if (search != mStringConstantIndices.end())
+        {
+            this->emitWord(search->second);
+            return;
+        }
+
+        const BytecodeWord index = static_cast<BytecodeWord>(mBytecode->mStringConstants.size());
+        mBytecode->mStringConstants.push_back(StoredValue(value.c_str(), value.size()));
+        mStringConstantIndices.insert(std::make_pair(value, index));
+        this->emitWord(index);
+    }
+
+    void BytecodeAssembler::emitJump(const OpCode op, const AddressOffsetType offset)
+    {
+        this->emitOpCode(op);
+        this->emitJumpTarget(offset);
+    }
+
+    void BytecodeAssembler::emitJumpTarget(const AddressOffsetType offset)
+    {
+        // A zero offset stopped execution in the original instruction loop
+        JumpFixup fixup;
+        fixup.mOperand = mBytecode->mCode.size();
+        fixup.mTarget = offset == 0 ? -1 : static_cast<AddressOffsetType>(mInstructionIndex) + offset;
+        mJumpFixups.push_back(fixup);
+
+        this->emitWord(0);
+    }
+
+    void BytecodeAssembler::emitFunction(const FunctionPrototype& prototype)
+    {
+        mBytecode->mFunctions.push_back(prototype);
+        this->emitWord(static_cast<BytecodeWord>(mBytecode->mFunctions.size() - 1));
+    }
+
+    void BytecodeAssembler::emitCallSiteCache(const bool parentCall)
+    {
+        mBytecode->mCallSiteCaches.push_back(CallSiteCache(parentCall));
+        this->emitWord(static_cast<BytecodeWord>(mBytecode->mCallSiteCaches.size() - 1));
+    }
+
+    void BytecodeAssembler::emitBoundCallSiteCache()
+    {
+        mBytecode->mBoundCallSiteCaches.push_back(BoundCallSiteCache());
+        this->emitWord(static_cast<BytecodeWord>(mBytecode->mBoundCallSiteCaches.size() - 1));
+    }
+
+    const char* getOpCodeName(const OpCode op)
+    {
+        static const char* const sOpCodeNames[] = {
+            "PushFloat", "PushInteger", "PushString", "PushLocalReference", "PushLocalSlot", "PushGlobalReference",
+            "AddAssignment", "Assignment", "Concat", "ConcatList", "Negate", "Not", "CallFunction",
+            "Add", "Minus", "Modulus", "LessThan", "GreaterThan", "GreaterThanOrEqual",
+            "Equals", "NotEquals", "StringEquals", "StringNotEqual", "BitwiseAnd", "BitwiseOr",
+            "Multiply", "Divide", "Pop", "Jump", "JumpTrue", "JumpFalse", "JumpTrueOrPop", "JumpFalseOrPop", "NOP",
+            "FunctionDeclaration",
+            "SubReference", "Return", "Break", "Continue", "AccessArray", "CallBoundFunction",
+            "PushObjectInstantiation", "PushObjectField", "PopObjectInstantiation", "IncrementLocalSlot",
+            "CompareLocalSlotJumpFalse", "PushLocalSlotField", "Halt"
+        };
+        static_assert(sizeof(sOpCodeNames) / sizeof(sOpCodeNames[0]) == static_cast<std::size_t>(OpCode::OpCodeCount), "Opcode name table does not cover all opcodes");
+
+        const std::size_t index = static_cast<std::size_t>(op);
+        return index < static_cast<std::size_t>(OpCode::OpCodeCount) ? sOpCodeNames[index] : "Invalid";
+    }
+
+    /**
+     *  @brief Retrieves the number of operand words following an opcode. ConcatList is variable length and
+     *  reports 0 here.
+     */
+    static std::size_t getOperandCount(const OpCode op)
+    {
+        static const unsigned char sOperandCounts[] = {
+            1, 1, 1, 1, 1, 1,
+            0, 0, 1, 0, 0, 0, 4,
+            0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0,
+            0, 0, 0, 1, 1, 1, 1, 1, 0,
+            1,
+            2, 0, 0, 0, 3, 3,
+            0, 1, 1, 2,
+            4, 2, 0
+        };
+        static_assert(sizeof(sOperandCounts) / sizeof(sOperandCounts[0]) == static_cast<std::size_t>(OpCode::OpCodeCount), "Operand count table does not cover all opcodes");
+
+        return sOperandCounts[static_cast<std::size_t>(op)];
+    }
+
+    bool Bytecode::validate(const std::size_t localSlotCount) const
+    {
+        const std::size_t codeSize = mCode.size();
+
+        // Tagged strings are pushed as integers, so a PushInteger operand may or may not be a string table entry
+        enum EntryOperand : unsigned char
+        {
+            NotEntry,
+            OptionalEntry,
+            RequiredEntry,
+            RecordedEntry
+        };
+
+        std::vector<bool> instructionStarts(codeSize, false);
+        std::vector<unsigned char> entryOperands(codeSize, NotEntry);
+        std::vector<std::size_t> jumpTargets;
+
+        OpCode lastOp = OpCode::OpCodeCount;
+        std::size_t position = 0;
+        while (position < codeSize)
+        {
+            if (mCode[position] >= static_cast<BytecodeWord>(OpCode::OpCodeCount))
+            {
+                return false;
+            }
+
+            const OpCode op = static_cast<OpCode>(mCode[position]);
+            const BytecodeWord* operands = mCode.data() + position + 1;
+            const std::size_t available = codeSize - position - 1;
+
+            // ConcatList stores its value count followed by one separator for each pair of adjacent values
+            std::size_t operandCount = getOperandCount(op);
+            if (op == OpCode::ConcatList)
+            {
+                if (available < 1 || operands[0] < 2)
+                {
+                    return false;
+                }
+                operandCount = operands[0];
+            }
+
+            if (available < operandCount)
+            {
+                return false;
+            }
+
+            bool valid = true;
+            switch (op)
+            {
+                case OpCode::PushInteger:
+                    entryOperands[position + 1] = OptionalEntry;
+                    break;
+                case OpCode::PushString:
+                    valid = operands[0] < mStringConstants.size();
+                    break;
+                case OpCode::PushLocalReference:
+                case OpCode::PushGlobalReference:
+                    entryOperands[position + 1] = RequiredEntry;
+                    break;
+                case OpCode::PushLocalSlot:
+                    valid = operands[0] < localSlotCount;
+                    break;
+                case OpCode::Concat:
+                    valid = operands[0] < mStrings.size();
+                    break;
+                case OpCode::ConcatList:
+                    for (std::size_t separator = 1; separator < operandCount; ++separator)
+                    {
+                        valid = valid && operands[separator] < mStrings.size();
+                    }
+                    break;
+                case OpCode::CallFunction:
+                    valid = operands[0] < mStrings.size() && operands[1] < mStrings.size() && operands[3] < mCallSiteCaches.size();
+                    break;
+                case OpCode::Jump:
+                case OpCode::JumpTrue:
+                case OpCode::JumpFalse:
+                case OpCode::JumpTrueOrPop:
+                case OpCode::JumpFalseOrPop:
+                    jumpTargets.push_back(operands[0]);
+                    break;
+                case OpCode::FunctionDeclaration:
+                    valid = operands[0] < mFunctions.size();
+                    break;
+                case OpCode::SubReference:
+                    entryOperands[position + 1] = RequiredEntry;
+                    break;
+                case OpCode::AccessArray:
+                    valid = operands[0] < mStrings.size();
+                    break;
+                case OpCode::CallBoundFunction:
+                    valid = operands[0] < mStrings.size() && operands[2] < mBoundCallSiteCaches.size();
+                    break;
+                case OpCode::IncrementLocalSlot:
+                    valid = operands[0] < localSlotCount;
+                    break;
+                case OpCode::CompareLocalSlotJumpFalse:
+                {
+                    const BytecodeWord comparison = operands[1];
+                    valid = operands[0] < localSlotCount &&
+                            (comparison == static_cast<BytecodeWord>(OpCode::LessThan) || comparison == static_cast<BytecodeWord>(OpCode::GreaterThan) ||
+                             comparison == static_cast<BytecodeWord>(OpCode::GreaterThanOrEqual) || comparison == static_cast<BytecodeWord>(OpCode::Equals) ||
+                             comparison == static_cast<BytecodeWord>(OpCode::NotEquals));
+                    jumpTargets.push_back(operands[3]);
+                    break;
+                }
+                case OpCode::PushLocalSlotField:
+                    valid = operands[0] < localSlotCount;
+                    entryOperands[position + 2] = RequiredEntry;
+                    break;
+                default:
+                    break;
+            }
+
+            if (!valid)
+            {
+                return false;
+            }
+
+            instructionStarts[position] = true;
+            position += 1 + operandCount;
+            lastOp = op;
+        }
+
+        // Execution must never run off the end of the code
+        if (lastOp != OpCode::Halt)
+        {
+            return false;
+        }
+
+        for (const std::size_t target : jumpTargets)
+        {
+            if (target >= codeSize || !instructionStarts[target])
+            {
+                return false;
+            }
+        }
+
+        // Every string table entry operand must be recorded exactly once so it is remapped, and nothing else may be
+        for (const std::size_t operand : mStringTableEntryOperands)
+        {
+            if (operand >= codeSize || (entryOperands[operand] != OptionalEntry && entryOperands[operand] != RequiredEntry))
+            {
+                return false;
+            }
+            entryOperands[operand] = RecordedEntry;
+        }
+        return std::find(entryOperands.begin(), entryOperands.end(), RequiredEntry) == entryOperands.end();
+    }
+
+    /*
+        Bytecode
+    */
+
+    void Bytecode::execute(ExecutionState* state)
+    {
+        const BytecodeWord* const code = mCode.data();
+        const BytecodeWord* ip = code;
+
+        Interpreter* interpreter = state->mInterpreter;
+        const ExecutionGuard executionGuard(interpreter);
+
+        // Frames are heap allocated and every call pops the frames it pushes, so this frame's stack never moves
+        StoredValueStack* const stack = &state->mExecutionScope.getStack();
+
+        // Slot storage never moves while the frame is alive
+        StoredValue* const locals = state->mExecutionScope.getLocalSlots();
+
+        Profiler* const profiler = state->mProfiler;
+
+#if defined(TRIBALSCRIPT_COMPUTED_GOTO)
+        static void* const sDispatchTable[] = {
+            &&OpPushFloat, &&OpPushInteger, &&OpPushString, &&OpPushLocalReference, &&OpPushLocalSlot, &&OpPushGlobalReference,
+            &&OpAddAssignment, &&OpAssignment, &&OpConcat, &&OpConcatList, &&OpNegate, &&OpNot, &&OpCallFunction,
+            &&OpAdd, &&OpMinus, &&OpModulus, &&OpLessThan, &&OpGreaterThan, &&OpGreaterThanOrEqual,
+            &&OpEquals, &&OpNotEquals, &&OpStringEquals, &&OpStringNotEqual, &&OpBitwiseAnd, &&OpBitwiseOr,
+            &&OpMultiply, &&OpDivide, &&OpPop, &&OpJump, &&OpJumpTrue, &&OpJumpFalse, &&OpJumpTrueOrPop, &&OpJumpFalseOrPop, &&OpNOP,
+            &&OpFunctionDeclaration,
+            &&OpSubReference, &&OpReturn, &&OpBreak, &&OpContinue, &&OpAccessArray, &&OpCallBoundFunction,
+            &&OpPushObjectInstantiation, &&OpPushObjectField, &&OpPopObjectInstantiation, &&OpIncrementLocalSlot,
+            &&OpCompareLocalSlotJumpFalse, &&OpPushLocalSlotField, &&OpHalt
+        };
+        static_assert(sizeof(sDispatchTable) / sizeof(sDispatchTable[0]) == static_cast<std::size_t>(OpCode::OpCodeCount), "Dispatch table does not cover all opcodes");
+
+        // When profiling, every opcode is routed through OpProfile first so the regular dispatch path stays untouched.
+        // The table is filled once, when the first call reaches this point, and is never written again afterwards.
+        struct ProfilingDispatchTable
+        {
+            explicit ProfilingDispatchTable(void* const target)
+            {
+                std::fill(std::begin(mTargets), std::end(mTargets), target);
+            }
+
+            void* mTargets[static_cast<std::size_t>(OpCode::OpCodeCount)];
+        };
+        static const ProfilingDispatchTable sProfilingDispatchTable(&&OpProfile);
+
+        void* const* const dispatchTable = profiler ? sProfilingDispatchTable.mTargets : sDispatchTable;
+
+        // A computed goto leaving a block does not destroy the locals declared in it, so handlers keep any local
+        // with a destructor in an inner block that closes before they dispatch
+        #define TRIBALSCRIPT_OPCODE(name) Op##name
+        #define TRIBALSCRIPT_DISPATCH() goto *dispatchTable[*ip++]
+
+        TRIBALSCRIPT_DISPATCH();
+
+        OpProfile:
+        {
+            profiler->recordInstruction(static_cast<OpCode>(ip[-1]));
+            goto *sDispatchTable[ip[-1]];
+        }
+#else
+        #define TRIBALSCRIPT_OPCODE(name) case OpCode::name
+        #define TRIBALSCRIPT_DISPATCH() continue
+
+        while (true)
+        {
+            if (profiler)
+            {
+                profiler->recordInstruction(static_cast<OpCode>(*ip));
+            }
+
+            switch (static_cast<OpCode>(*ip++))
+            {
+#endif
+        TRIBALSCRIPT_OPCODE(PushFloat):
+        {
+            stack->emplace_back(decodeFloat(ip[0]));
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushInteger):
+        {
+            stack->emplace_back(decodeInteger(ip[0]));
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushString):
+        {
+            stack->push_back(mStringConstants[ip[0]]);
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushLocalReference):
+        {
+            stack->emplace_back(state->mExecutionScope.getVariableOrAllocate(static_cast<StringTableEntry>(ip[0])));
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushLocalSlot):
+        {
+            stack->emplace_back(&locals[ip[0]]);
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushGlobalReference):
+        {
+            stack->emplace_back(interpreter->getGlobalOrAllocate(static_cast<StringTableEntry>(ip[0])));
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(AddAssignment):
+        {
+            assert(stack->size() >= 2);
+
+            {
+                StoredValue& rhsStored = *(stack->end() - 1);
+                StoredValue& lhsStored = *(stack->end() - 2);
+
+                StoredValue result = lhsStored + rhsStored;
+                if (!lhsStored.setValue(result))
+                {
+                    interpreter->mConfig.mPlatform->logError("Attempted to perform no-op assignment!");
+                }
+
+                stack->erase(stack->end() - 2, stack->end());
+
+                // In Torque, the result of the assignment is pushed to stack
+                stack->push_back(std::move(result));
+            }
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Assignment):
+        {
+            assert(stack->size() >= 2);
+
+            StoredValue& rhsStored = *(stack->end() - 1);
+            StoredValue& lhsStored = *(stack->end() - 2);
+
+            if (!lhsStored.setValue(rhsStored))
+            {
+                interpreter->mConfig.mPlatform->logError("Attempted to perform no-op assignment!");
+            }
+
+            // In Torque, the result of the assignment is pushed to stack
+            lhsStored = rhsStored;
+            stack->pop_back();
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Concat):
+        {
+            assert(stack->size() >= 2);
+
+            this->concat(state, 2, ip);
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(ConcatList):
+        {
+            const std::size_t count = ip[0];
+            assert(count >= 2 && stack->size() >= count);
+
+            this->concat(state, count, ip + 1);
+            ip += count;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Negate):
+        {
+            assert(stack->size() >= 1);
+
+            stack->back() = -stack->back();
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Not):
+        {
+            assert(!stack->empty());
+
+            const int result = !stack->back().toBoolean() ? 1 : 0;
+            stack->back() = StoredValue(result);
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(CallFunction):
+        {
+            state->mInstructionPointer = static_cast<AddressType>(ip - code - 1);
+            this->callFunction(state, ip);
+            ip += 4;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        #define TRIBALSCRIPT_BINARY_OPCODE(name, type, conversion, expression) \
+        TRIBALSCRIPT_OPCODE(name): \
+        { \
+            assert(stack->size() >= 2); \
+            { \
+                const type lhs = (stack->end() - 2)->conversion(); \
+                const type rhs = (stack->end() - 1)->conversion(); \
+                stack->pop_back(); \
+                stack->back() = StoredValue(expression); \
+            } \
+            TRIBALSCRIPT_DISPATCH(); \
+        }
+
+        // Integer operands stay in integer math, see the StoredValue arithmetic operators
+        #define TRIBALSCRIPT_ARITHMETIC_OPCODE(name, operation) \
+        TRIBALSCRIPT_OPCODE(name): \
+        { \
+            assert(stack->size() >= 2); \
+            { \
+                StoredValue result = *(stack->end() - 2) operation *(stack->end() - 1); \
+                stack->pop_back(); \
+                stack->back() = std::move(result); \
+            } \
+            TRIBALSCRIPT_DISPATCH(); \
+        }
+
+        TRIBALSCRIPT_ARITHMETIC_OPCODE(Add, +)
+        TRIBALSCRIPT_ARITHMETIC_OPCODE(Minus, -)
+        TRIBALSCRIPT_ARITHMETIC_OPCODE(Multiply, *)
+
+        #undef TRIBALSCRIPT_ARITHMETIC_OPCODE
+
+        TRIBALSCRIPT_BINARY_OPCODE(Divide, float, toFloat, lhs / rhs)
+        TRIBALSCRIPT_BINARY_OPCODE(Modulus, int, toInteger, lhs % rhs)
+        TRIBALSCRIPT_BINARY_OPCODE(LessThan, float, toFloat, lhs < rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(GreaterThan, float, toFloat, lhs > rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(GreaterThanOrEqual, float, toFloat, lhs >= rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(Equals, float, toFloat, lhs == rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(NotEquals, float, toFloat, lhs != rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(StringEquals, std::string, toString, lhs == rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(StringNotEqual, std::string, toString, lhs != rhs ? 1 : 0)
+        TRIBALSCRIPT_BINARY_OPCODE(BitwiseAnd, int, toInteger, lhs & rhs)
+        TRIBALSCRIPT_BINARY_OPCODE(BitwiseOr, int, toInteger, lhs | rhs)
+
+        #undef TRIBALSCRIPT_BINARY_OPCODE
+
+        TRIBALSCRIPT_OPCODE(Pop):
+        {
+            assert(stack->size() >= 1);
+            stack->pop_back();
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Jump):
+        {
+            ip = code + ip[0];
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(JumpTrue):
+        {
+            assert(stack->size() >= 1);
+
+            const bool condition = stack->back().toBoolean();
+            stack->pop_back();
+            ip = condition ? code + ip[0] : ip + 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(JumpFalse):
+        {
+            assert(stack->size() >= 1);
+
+            const bool condition = stack->back().toBoolean();
+            stack->pop_back();
+            ip = !condition ? code + ip[0] : ip + 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        // The short circuiting forms of JumpTrue and JumpFalse used by || and &&. When the jump is taken the
+        // condition is left on the stack as the result of the whole expression.
+        TRIBALSCRIPT_OPCODE(JumpTrueOrPop):
+        {
+            assert(stack->size() >= 1);
+
+            if (stack->back().toBoolean())
+            {
+                stack->back() = StoredValue(1);
+                ip = code + ip[0];
+                TRIBALSCRIPT_DISPATCH();
+            }
+            stack->pop_back();
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(JumpFalseOrPop):
+        {
+            assert(stack->size() >= 1);
+
+            if (!stack->back().toBoolean())
+            {
+                stack->back() = StoredValue(0);
+                ip = code + ip[0];
+                TRIBALSCRIPT_DISPATCH();
+            }
+            stack->pop_back();
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(NOP):
+        {
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(FunctionDeclaration):
+        {
+            const FunctionPrototype& prototype = mFunctions[ip[0]];
+            ip += 1;
+
+            // Register the function
+            {
+                std::shared_ptr<Function> newFunction = std::shared_ptr<Function>(new Function(prototype.mPackageName, prototype.mNameSpace, prototype.mName, prototype.mParameterNames));
+                newFunction->setBytecode(prototype.mBody);
+                newFunction->setLocalSlotNames(prototype.mLocalSlotNames);
+                interpreter->addFunction(std::move(newFunction));
+            }
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(SubReference):
+        {
+            this->subReference(state, ip);
+            ip += 2;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Return):
+        {
+            assert(stack->size() >= 1);
+
+            // For if we return a variable reference, we want to pass back a copy
+            StoredValueStack& returnStack = state->mExecutionScope.getReturnStack();
+            returnStack.push_back(stack->back().getReferencedValueCopy());
+            stack->pop_back();
+
+            if (profiler)
+            {
+                profiler->endInstructions();
+            }
+
+            state->mInstructionPointer = static_cast<AddressType>(ip - code - 1);
+            return;
+        }
+
+        TRIBALSCRIPT_OPCODE(Break):
+        {
+            // This is a placeholder instruction for the compiler
+            interpreter->mConfig.mPlatform->logWarning("Break outside of loop, ignoring ...");
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Continue):
+        {
+            // This is a placeholder instruction for the compiler
+            interpreter->mConfig.mPlatform->logWarning("Continue outside of loop, ignoring ...");
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(AccessArray):
+        {
+            this->accessArray(state, ip);
+            ip += 3;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(CallBoundFunction):
+        {
+            state->mInstructionPointer = static_cast<AddressType>(ip - code - 1);
+            this->callBoundFunction(state, ip);
+            ip += 3;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushObjectInstantiation):
+        {
+            assert(stack->size() >= 2);
+
+            {
+                const std::string objectName = stack->popString(state);
+                const std::string objectTypeName = stack->popString(state);
+
+                state->mExecutionScope.pushObjectInstantiation(objectTypeName, objectName);
+            }
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushObjectField):
+        {
+            this->pushObjectField(state, ip);
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PopObjectInstantiation):
+        {
+            state->mInstructionPointer = static_cast<AddressType>(ip - code - 1);
+            this->popObjectInstantiation(state, ip);
+            ip += 1;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(IncrementLocalSlot):
+        {
+            // PushLocalSlot, PushInteger, AddAssignment, Pop
+            StoredValue& local = locals[ip[0]];
+            local.setValue(local + StoredValue(decodeInteger(ip[1])));
+            ip += 2;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(CompareLocalSlotJumpFalse):
+        {
+            // PushLocalSlot, a numeric constant, a float comparison, JumpFalse
+            const float lhs = locals[ip[0]].toFloat();
+            const float rhs = decodeFloat(ip[2]);
+
+            bool condition;
+            switch (static_cast<OpCode>(ip[1]))
+            {
+                case OpCode::LessThan:
+                    condition = lhs < rhs;
+                    break;
+                case OpCode::GreaterThan:
+                    condition = lhs > rhs;
+                    break;
+                case OpCode::GreaterThanOrEqual:
+                    condition = lhs >= rhs;
+                    break;
+                case OpCode::Equals:
+                    condition = lhs == rhs;
+                    break;
+                default:
+                    condition = lhs != rhs;
+                    break;
+            }
+
+            ip = !condition ? code + ip[3] : ip + 4;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(PushLocalSlotField):
+        {
+            // PushLocalSlot, SubReference without array indices
+            this->pushLocalSlotField(state, locals, ip);
+            ip += 2;
+            TRIBALSCRIPT_DISPATCH();
+        }
+
+        TRIBALSCRIPT_OPCODE(Halt):
+        {
+            if (profiler)
+            {
+                profiler->endInstructions();
+            }
+
+            state->mInstructionPointer = static_cast<AddressType>(ip - code - 1);
+            return;
+        }
+
+#if !defined(TRIBALSCRIPT_COMPUTED_GOTO)
+        TRIBALSCRIPT_OPCODE(OpCodeCount):
+            break;
+            }
+
+            throw std::runtime_error("Encountered invalid opcode!");
+        }
+#endif
+
+        #undef TRIBALSCRIPT_OPCODE
+        #undef TRIBALSCRIPT_DISPATCH
+    }
+
+    void Bytecode::callFunction(ExecutionState* state, const BytecodeWord* operands)
+    {
+        const std::size_t argc = operands[2];
+        CallSiteCache& cache = mCallSiteCaches[operands[3]];
+
+        Interpreter* interpreter = state->mInterpreter;
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+        assert(stack.size() >= argc);
+
+        // Arguments are passed in place; the callee copies what it needs out of the stack
+        const std::size_t argumentsEnd = stack.size();
+        const std::size_t argumentsStart = argumentsEnd - argc;
+        const StoredValueSpan parameters(stack.data() + argumentsStart, argc);
+
+        Function* currentFunction = cache.mParentCall ? state->mExecutionScope.getCurrentFunction() : nullptr;
+
+        // Only resolve the function again if something may have changed what this site calls
+        if (cache.mInterpreter != interpreter || cache.mGeneration != interpreter->getFunctionGeneration() || cache.mCaller != currentFunction)
+        {
+            cache.mInterpreter = interpreter;
+            cache.mGeneration = interpreter->getFunctionGeneration();
+            cache.mCaller = currentFunction;
+
+            // If we're calling a parent function, ask the interpreter to find a super function higher up the chain
+            if (cache.mParentCall)
+            {
+                cache.mFunction = currentFunction ? interpreter->getFunctionParent(currentFunction).get() : nullptr;
+            }
+            else
+            {
+                cache.mFunction = interpreter->getFunction(mStrings[operands[0]], mStrings[operands[1]]).get();
+            }
+        }
+
+        if (cache.mFunction)
+        {
+            Profiler* profiler = state->mProfiler;
+            if (profiler)
+            {
+                profiler->enterFunction(cache.mFunction, this, static_cast<std::size_t>(operands - mCode.data() - 1));
+                cache.mFunction->execute(nullptr, state, parameters);
+                profiler->exitFunction();
+            }
+            else
+            {
+                cache.mFunction->execute(nullptr, state, parameters);
+            }
+        }
+        else if (cache.mParentCall && !currentFunction)
+        {
+            interpreter->mConfig.mPlatform->logError("Attempted to call parent:: function at root!");
+            stack.push_back(StoredValue(0));
+        }
+        else
+        {
+            std::ostringstream stream;
+
+            stream << "Could not find " << (cache.mParentCall ? "parent function '" : "function '") << mStrings[operands[1]] << "' for calling! Placing 0 on the stack.";
+            interpreter->mConfig.mPlatform->logError(stream.str());
+
+            stack.push_back(StoredValue(0));
+        }
+        popCallArguments(stack, argumentsStart, argumentsEnd);
+    }
+
+    void Bytecode::callBoundFunction(ExecutionState* state, const BytecodeWord* operands)
+    {
+        const std::string& name = mStrings[operands[0]];
+        const std::size_t argc = operands[1];
+
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+
+        assert(stack.size() >= argc + 1);
+
+        // Parameters for bound functions are *after* the target object on the stack and are passed in place
+        const std::size_t argumentsEnd = stack.size();
+        const std::size_t argumentsStart = argumentsEnd - argc;
+        const StoredValueSpan parameters(stack.data() + argumentsStart, argc);
+
+        // The target is removed along with the arguments
+        const std::size_t targetIndex = argumentsStart - 1;
+        StoredValue& targetStored = stack[targetIndex];
+
+        // Retrieve the referenced ConsoleObject
+        ConsoleObject* targetObject = targetStored.toConsoleObject(state);
+        if (!targetObject)
+        {
+            std::ostringstream output;
+            output << "Cannot find object '" << targetStored.toString() << "' to call function '" << name << "'!";
+            state->mInterpreter->mConfig.mPlatform->logWarning(output.str());
+
+            stack.push_back(StoredValue(0));
+            popCallArguments(stack, targetIndex, argumentsEnd);
+            return;
+        }
+
+        ConsoleObjectDescriptor* descriptor = targetObject->getDescriptor();
+        assert(descriptor);
+
+        Interpreter* interpreter = state->mInterpreter;
+        BoundCallSiteCache& cache = mBoundCallSiteCaches[operands[2]];
+        if (cache.mInterpreter != interpreter || cache.mGeneration != interpreter->getFunctionGeneration())
+        {
+            cache.mInterpreter = interpreter;
+            cache.mGeneration = interpreter->getFunctionGeneration();
+            cache.mUsedEntries = 0;
+            cache.mNextReplacedEntry = 0;
+        }
+
+        // Check the types this site has already seen before falling back to the method table of the type
+        BoundCallSiteCache::Entry* cached = nullptr;
+        for (std::size_t iteration = 0; iteration < cache.mUsedEntries; ++iteration)
+        {
+            if (cache.mEntries[iteration].mDescriptor == descriptor)
+            {
+                cached = &cache.mEntries[iteration];
+                break;
+            }
+        }
+
+        if (!cached)
+        {
+            if (cache.mUsedEntries < BoundCallSiteCache::MaximumEntries)
+            {
+                cached = &cache.mEntries[cache.mUsedEntries++];
+            }
+            else
+            {
+                cached = &cache.mEntries[cache.mNextReplacedEntry];
+                cache.mNextReplacedEntry = (cache.mNextReplacedEntry + 1) % BoundCallSiteCache::MaximumEntries;
+            }
+
+            cached->mDescriptor = descriptor;
+            cached->mFunction = interpreter->getBoundFunction(descriptor, name);
+        }
+
+        if (cached->mFunction)
+        {
+            Profiler* profiler = state->mProfiler;
+            if (profiler)
+            {
+                profiler->enterFunction(cached->mFunction, this, static_cast<std::size_t>(operands - mCode.data() - 1));
+                cached->mFunction->execute(targetObject, state, parameters);
+                profiler->exitFunction();
+            }
+            else
+            {
+                cached->mFunction->execute(targetObject, state, parameters);
+            }
+            popCallArguments(stack, targetIndex, argumentsEnd);
+            return;
+        }
+
+        std::ostringstream output;
+        output << "Cannot find function  '" << name << "' on object '" << targetStored.toString() << "'!";
+        state->mInterpreter->mConfig.mPlatform->logWarning(output.str());
+
+        stack.emplace_back(0);
+        popCallArguments(stack, targetIndex, argumentsEnd);
+    }
+
+    void Bytecode::subReference(ExecutionState* state, const BytecodeWord* operands)
+    {
+        const StringTableEntry stringID = static_cast<StringTableEntry>(operands[0]);
+        const std::size_t arrayIndices = operands[1];
+
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+        assert(stack.size() >= 1);
+
+        const std::string arrayName = resolveArrayNameFromStack(stack, state, state->mInterpreter->mStringTable.getString(stringID), arrayIndices);
+
+        StoredValue targetStored = stack.back();
+        stack.pop_back();
+
+        ConsoleObject* referenced = targetStored.toConsoleObject(state);
+        if (referenced)
+        {
+            // Obtain a reference to the console object's field
+            stack.emplace_back(referenced->getTaggedFieldOrAllocate(arrayName));
+            return;
+        }
+
+        stack.emplace_back(0);
+    }
+
+    void Bytecode::concat(ExecutionState* state, const std::size_t count, const BytecodeWord* separators)
+    {
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+        StoredValue* const values = &*(stack.end() - count);
+
+        // Everything is turned into a string up front so the result is sized once. Numbers always fit inline.
+        std::size_t length = 0;
+        for (std::size_t iteration = 0; iteration < count; ++iteration)
+        {
+            const char* characters;
+            std::size_t valueLength;
+            if (!values[iteration].getStringData(characters, valueLength))
+            {
+                const std::string converted = values[iteration].toString();
+                values[iteration] = StoredValue(converted.c_str(), converted.size());
+                valueLength = converted.size();
+            }
+
+            length += valueLength;
+            if (iteration != 0)
+            {
+                length += mStrings[separators[iteration - 1]].size();
+            }
+        }
+
+        // The first value becomes the result, which is appended to in place when it is a temporary nobody shares
+        StoredValue& result = values[0];
+        result = result.getReferencedValueCopy();
+
+        const char* characters;
+        std::size_t offset;
+        result.getStringData(characters, offset);
+
+        char* const out = result.resizeString(length);
+        for (std::size_t iteration = 1; iteration < count; ++iteration)
+        {
+            const std::string& separator = mStrings[separators[iteration - 1]];
+            std::memcpy(out + offset, separator.data(), separator.size());
+            offset += separator.size();
+
+            std::size_t valueLength;
+            values[iteration].getStringData(characters, valueLength);
+            std::memcpy(out + offset, characters, valueLength);
+            offset += valueLength;
+        }
+        assert(offset == length);
+
+        stack.erase(stack.end() - count + 1, stack.end());
+    }
+
+    void Bytecode::pushLocalSlotField(ExecutionState* state, StoredValue* locals, const BytecodeWord* operands)
+    {
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+
+        ConsoleObject* referenced = locals[operands[0]].toConsoleObject(state);
+        if (referenced)
+        {
+            stack.emplace_back(referenced->getTaggedFieldOrAllocate(state->mInterpreter->mStringTable.getString(static_cast<StringTableEntry>(operands[1]))));
+            return;
+        }
+
+        stack.emplace_back(0);
+    }
+
+    void Bytecode::accessArray(ExecutionState* state, const BytecodeWord* operands)
+    {
+        const std::string& name = mStrings[operands[0]];
+        const std::size_t argc = operands[1];
+        const bool global = operands[2] != 0;
+
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+
+        // When we encounter this instruction, we generate a new variable reference by appending all string representations together
+        // This is what T2 does - it has no concept of arrays despite pretending to
+        const std::string arrayName = resolveArrayNameFromStack(stack, state, name, argc);
+
+        if (global)
+        {
+            stack.emplace_back(state->mInterpreter->getGlobalOrAllocate(arrayName));
+        }
+        else
+        {
+            stack.emplace_back(state->mExecutionScope.getVariableOrAllocate(arrayName));
+        }
+    }
+
+    void Bytecode::pushObjectField(ExecutionState* state, const BytecodeWord* operands)
+    {
+        const std::size_t fieldComponentCount = operands[0];
+
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+        assert(stack.size() >= 2);
+
+        StoredValue rvalue = stack.back();
+        stack.pop_back();
+
+        // Load array components
+        std::vector<std::string> arrayComponents;
+        for (unsigned int iteration = 0; iteration < fieldComponentCount; ++iteration)
+        {
+            arrayComponents.push_back(stack.popString(state));
+        }
+
+        // Load base name
+        StoredValue fieldBaseName = stack.back();
+        stack.pop_back();
+
+        // FIXME: This should be using the resolveArrayNameFromStack helper function
+        std::ostringstream out;
+        out << fieldBaseName.toString();
+
+        for (auto iterator = arrayComponents.rbegin(); iterator != arrayComponents.rend(); ++iterator)
+        {
+            if (iterator != arrayComponents.rend())
+            {
+                out << "_";
+            }
+            out << *iterator;
+        }
+
+        // Final field assignment
+        ObjectInstantiationDescriptor& descriptor = state->mExecutionScope.currentObjectInstantiation();
+
+        const std::string fieldName = out.str();
+        auto search = descriptor.mFieldAssignments.find(fieldName);
+        if (search != descriptor.mFieldAssignments.end())
+        {
+            search->second = rvalue;
+        }
+        else
+        {
+            descriptor.mFieldAssignments.insert(std::make_pair(fieldName, rvalue));
+        }
+    }
+
+    void Bytecode::popObjectInstantiation(ExecutionState* state, const BytecodeWord* operands)
+    {
+        const std::size_t childrenCount = operands[0];
+
+        ObjectInstantiationDescriptor descriptor = state->mExecutionScope.popObjectInstantiation();
+
+        // Ask the interpreter to initialize the resulting tree
+        ConsoleObject* result = state->mInterpreter->initializeConsoleObjectTree(descriptor);
+
+        StoredValueStack& stack = state->mExecutionScope.getStack();
+        if (result)
+        {
+            // Assign fields -- any construction fields should have been pulled out of the descriptor at this point
+            descriptor.copyFieldsToConsoleObject(result);
+
+            // Append children
+            for (std::size_t iteration = 0; iteration < childrenCount; ++iteration)
+            {
+                StoredValue nextChildID = stack.back();
+                stack.pop_back();
+
+                ConsoleObject* nextChild = state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObject(state->mInterpreter, nextChildID.toInteger());
+                result->addChild(nextChild);
+            }
+
+            stack.emplace_back((int)state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObjectID(state->mInterpreter, result));
+        }
+        else
+        {
+            state->mInterpreter->mConfig.mPlatform->logError("Failed to instantiate object!");
+            stack.emplace_back(-1);
+        }
+    }
+}
@@ -0,0 +1,449 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <unordered_map>
+
+#include <tribalscript/bytecodeserializer.hpp>
+#include <tribalscript/bytecode.hpp>
+#include <tribalscript/interpreterconfiguration.hpp>
+
+namespace TribalScript
+{
+    //! Identifies serialized bytecode. This is stored as a word so data written on a host of different byte order is rejected.
+    static const std::uint32_t sMagic = 0x43425354;
+
+    //! Header flag set when bytecode was compiled for a case sensitive interpreter.
+    static const std::uint32_t sCaseSensitiveFlag = 1;
+
+    //! Header flag set when bytecode was compiled from source parsed by the hand written frontend.
+    static const std::uint32_t sHandWrittenFrontendFlag = 2;
+
+    /**
+     *  @brief Packs the compile options recorded in the header, other than the optimization level, into flags.
+     */
+    static std::uint32_t getCompileFlags(const InterpreterConfiguration& config)
+    {
+        std::uint32_t result = 0;
+        if (config.mCaseSensitive)
+        {
+            result |= sCaseSensitiveFlag;
+        }
+        if (config.mFrontend == ParserFrontend::HandWritten)
+        {
+            result |= sHandWrittenFrontendFlag;
+        }
+        return result;
+    }
+
+    template <typename valueType>
+    static void writeValue(std::string& out, const valueType value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static void writeString(std::string& out, const std::string& value)
+    {
+        writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(value.size()));
+        out.append(value);
+    }
+
+    /**
+     *  @brief Writes bytecode, replacing string table entries with indices into a list of every entry referenced.
+     */
+    class BytecodeWriter
+    {
+        public:
+            void writeBytecode(std::string& out, const Bytecode& bytecode)
+            {
+                std::vector<BytecodeWord> code = bytecode.mCode;
+                for (const std::size_t operand : bytecode.mStringTableEntryOperands)
+                {
+                    code[operand] = this->getEntryIndex(static_cast<StringTableEntry>(code[operand]));
+                }
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(code.size()));
+                out.append(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(BytecodeWord));
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(bytecode.mStringTableEntryOperands.size()));
+                for (const std::size_t operand : bytecode.mStringTableEntryOperands)
+                {
+                    writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(operand));
+                }
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(bytecode.mStrings.size()));
+                for (const std::string& string : bytecode.mStrings)
+                {
+                    writeString(out, string);
+                }
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(bytecode.mStringConstants.size()));
+                for (const StoredValue& constant : bytecode.mStringConstants)
+                {
+                    writeString(out, constant.toString());
+                }
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(bytecode.mCallSiteCaches.size()));
+                for (const CallSiteCache& cache : bytecode.mCallSiteCaches)
+                {
+                    writeValue<std::uint8_t>(out, cache.mParentCall ? 1 : 0);
+                }
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(bytecode.mBoundCallSiteCaches.size()));
+
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(bytecode.mFunctions.size()));
+                for (const FunctionPrototype& prototype : bytecode.mFunctions)
+                {
+                    writeString(out, prototype.mPackageName);
+                    writeString(out, prototype.mNameSpace);
+                    writeString(out, prototype.mName);
+
+                    writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(prototype.mParameterNames.size()));
+                    for (const std::string& parameterName : prototype.mParameterNames)
+                    {
+                        writeString(out, parameterName);
+                    }
+
+                    writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(prototype.mLocalSlotNames.size()));
+                    for (const StringTableEntry slotName : prototype.mLocalSlotNames)
+                    {
+                        writeValue<std::uint32_t>(out, this->getEntryIndex(slotName));
+                    }
+
+                    this->writeBytecode(out, *prototype.mBody);
+                }
+            }
+
+            //! Every string table entry referenced so far, in the order they were first referenced.
+            std::vector<StringTableEntry> mEntries;
+
+        private:
+            std::uint32_t getEntryIndex(const StringTableEntry entry)
+            {
+                auto search = mEntryIndices.find(entry);
+                if (search != mEntryIndices.end())
+                {
+                    return search->second;
+                }
+
+                const std::uint32_t index = static_cast<std::uint32_t>(mEntries.size());
+                mEntries.push_back(entry);
+                mEntryIndices.insert(std::make_pair(entry, index));
+                return index;
+            }
+
+            //! The index of every entry in mEntries.
+            std::unordered_map<StringTableEntry, std::uint32_t> mEntryIndices;
+    };
+
+    /**
+     *  @brief Reads bytecode written by BytecodeWriter. Every read is bounds checked and fails rather than reading
+     *  past the end of the data, and the instruction stream of every piece of bytecode read is validated before it
+     *  is returned.
+     */
+    class BytecodeReader
+    {
+        public:
+            explicit BytecodeReader(const std::string& data) : mPosition(data.data()), mEnd(data.data() + data.size())
+            {
+
+            }
+
+            template <typename valueType>
+            bool read(valueType& out)
+            {
+                if (static_cast<std::size_t>(mEnd - mPosition) < sizeof(valueType))
+                {
+                    return false;
+                }
+
+                std::memcpy(&out, mPosition, sizeof(valueType));
+                mPosition += sizeof(valueType);
+                return true;
+            }
+
+            bool readString(std::string& out)
+            {
+                std::uint32_t length;
+                if (!this->read(length) || static_cast<std::size_t>(mEnd - mPosition) < length)
+                {
+                    return false;
+                }
+
+                out.assign(mPosition, length);
+                mPosition += length;
+                return true;
+            }
+
+            bool readEntry(StringTableEntry& out)
+            {
+                std::uint32_t index;
+                if (!this->read(index) || index >= mEntries.size())
+                {
+                    return false;
+                }
+
+                out = mEntries[index];
+                return true;
+            }
+
+            std::shared_ptr<Bytecode> readBytecode(const std::size_t localSlotCount)
+            {
+                std::shared_ptr<Bytecode> result = std::make_shared<Bytecode>();
+
+                std::uint32_t codeSize;
+                if (!this->read(codeSize) || static_cast<std::size_t>(mEnd - mPosition) / sizeof(BytecodeWord) < codeSize || codeSize == 0)
+                {
+                    return nullptr;
+                }
+                result->mCode.resize(codeSize);
+                std::memcpy(result->mCode.data(), mPosition, codeSize * sizeof(BytecodeWord));
+                mPosition += codeSize * sizeof(BytecodeWord);
+
+                // The dispatch loop relies on every program ending in Halt
+                if (result->mCode.back() != static_cast<BytecodeWord>(OpCode::Halt))
+                {
+                    return nullptr;
+                }
+
+                std::uint32_t operandCount;
+                if (!this->read(operandCount))
+                {
+                    return nullptr;
+                }
+                for (std::uint32_t iteration = 0; iteration < operandCount; ++iteration)
+                {
+                    std::uint32_t operand;
+                    if (!this->read(operand) || operand >= codeSize || result->mCode[operand] >= mEntries.size())
+                    {
+                        return nullptr;
+                    }
+
+                    result->mCode[operand] = static_cast<BytecodeWord>(mEntries[result->mCode[operand]]);
+                    result->mStringTableEntryOperands.push_back(operand);
+                }
+
+                std::uint32_t stringCount;
+                if (!this->read(stringCount))
+                {
+                    return nullptr;
+                }
+                for (std::uint32_t iteration = 0; iteration < stringCount; ++iteration)
+                {
+                    std::string string;
+                    if (!this->readString(string))
+                    {
+                        return nullptr;
+                    }
+                    result->mStrings.push_back(string);
+                }
+
+                std::uint32_t constantCount;
+                if (!this->read(constantCount))
+                {
+                    return nullptr;
+                }
+                for (std::uint32_t iteration = 0; iteration < constantCount; ++iteration)
+                {
+                    std::string constant;
+                    if (!this->readString(constant))
+                    {
+                        return nullptr;
+                    }
+                    result->mStringConstants.push_back(StoredValue(constant.c_str(), constant.size()));
+                }
+
+                std::uint32_t callSiteCount;
+                if (!this->read(callSiteCount))
+                {
+                    return nullptr;
+                }
+                for (std::uint32_t iteration = 0; iteration < callSiteCount; ++iteration)
+                {
+                    std::uint8_t parentCall;
+                    if (!this->read(parentCall))
+                    {
+                        return nullptr;
+                    }
+                    result->mCallSiteCaches.push_back(CallSiteCache(parentCall != 0));
+                }
+
+                // Every call site occupies at least one word of code
+                std::uint32_t boundCallSiteCount;
+                if (!this->read(boundCallSiteCount) || boundCallSiteCount > codeSize)
+                {
+                    return nullptr;
+                }
+                result->mBoundCallSiteCaches.resize(boundCallSiteCount);
+
+                std::uint32_t functionCount;
+                if (!this->read(functionCount))
+                {
+                    return nullptr;
+                }
+                for (std::uint32_t iteration = 0; iteration < functionCount; ++iteration)
+                {
+                    FunctionPrototype prototype;
+                    if (!this->readString(prototype.mPackageName) || !this->readString(prototype.mNameSpace) || !this->readString(prototype.mName))
+                    {
+                        return nullptr;
+                    }
+
+                    std::uint32_t parameterCount;
+                    if (!this->read(parameterCount))
+                    {
+                        return nullptr;
+                    }
+                    for (std::uint32_t parameterIteration = 0; parameterIteration < parameterCount; ++parameterIteration)
+                    {
+                        std::string parameterName;
+                        if (!this->readString(parameterName))
+                        {
+                            return nullptr;
+                        }
+                        prototype.mParameterNames.push_back(parameterName);
+                    }
+
+                    std::uint32_t slotCount;
+                    if (!this->read(slotCount))
+                    {
+                        return nullptr;
+                    }
+                    for (std::uint32_t slotIteration = 0; slotIteration < slotCount; ++slotIteration)
+                    {
+                        StringTableEntry slotName;
+                        if (!this->readEntry(slotName))
+                        {
+                            return nullptr;
+                        }
+                        prototype.mLocalSlotNames.push_back(slotName);
+                    }
+
+                    // Parameters are copied into the first slots when the function is called
+                    if (slotCount < prototype.mParameterNames.size())
+                    {
+                        return nullptr;
+                    }
+
+                    prototype.mBody = this->readBytecode(slotCount);
+                    if (!prototype.mBody)
+                    {
+                        return nullptr;
+                    }
+                    result->mFunctions.push_back(prototype);
+                }
+
+                // The code can only be checked once every pool it indexes has been read
+                if (!result->validate(localSlotCount))
+                {
+                    return nullptr;
+                }
+                return result;
+            }
+
+            bool isAtEnd() const
+            {
+                return mPosition == mEnd;
+            }
+
+            //! The string table entries assigned to every string in the string section, by index.
+            std::vector<StringTableEntry> mEntries;
+
+        private:
+            //! The next byte to be read.
+            const char* mPosition;
+
+            //! One past the last byte of the data.
+            const char* mEnd;
+    };
+
+    std::uint64_t BytecodeSerializer::hashSource(const std::string& source)
+    {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const char character : source)
+        {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    std::string BytecodeSerializer::serialize(const Bytecode& bytecode, const std::uint64_t sourceHash, const InterpreterConfiguration& config, const StringTable& stringTable)
+    {
+        // The body is written first as that determines which string table entries must be stored
+        BytecodeWriter writer;
+        std::string body;
+        writer.writeBytecode(body, bytecode);
+
+        std::string result;
+        writeValue<std::uint32_t>(result, sMagic);
+        writeValue<std::uint32_t>(result, FormatVersion);
+        writeValue<std::uint32_t>(result, getCompileFlags(config));
+        writeValue<std::uint32_t>(result, config.mOptimizationLevel);
+        writeValue<std::uint64_t>(result, sourceHash);
+
+        writeValue<std::uint32_t>(result, static_cast<std::uint32_t>(writer.mEntries.size()));
+        for (const StringTableEntry entry : writer.mEntries)
+        {
+            writeString(result, stringTable.getString(entry));
+        }
+
+        result.append(body);
+        return result;
+    }
+
+    std::shared_ptr<Bytecode> BytecodeSerializer::deserialize(const std::string& data, const std::uint64_t sourceHash, const InterpreterConfiguration& config, StringTable& stringTable)
+    {
+        BytecodeReader reader(data);
+
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint32_t optimizationLevel;
+        std::uint64_t recordedHash;
+        if (!reader.read(magic) || magic != sMagic || !reader.read(version) || version != FormatVersion || !reader.read(flags) || !reader.read(optimizationLevel) || !reader.read(recordedHash))
+        {
+            return nullptr;
+        }
+
+        if (recordedHash != sourceHash || flags != getCompileFlags(config) || optimizationLevel != config.mOptimizationLevel)
+        {
+            return nullptr;
+        }
+
+        std::uint32_t entryCount;
+        if (!reader.read(entryCount))
+        {
+            return nullptr;
+        }
+        for (std::uint32_t iteration = 0; iteration < entryCount; ++iteration)
+        {
+            std::string string;
+            if (!reader.readString(string))
+            {
+                return nullptr;
+            }
+            reader.mEntries.push_back(stringTable.getOrAssign(string));
+        }
+
+        // Code outside of functions has no frame slots
+        std::shared_ptr<Bytecode> result = reader.readBytecode(0);
+        if (!result || !reader.isAtEnd())
+        {
+            return nullptr;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include <tribalscript/casefolding.hpp>
+
+namespace TribalScript
+{
+    //! A byte repeated across a whole word.
+    static const std::uint64_t sRepeatedOnes = 0x0101010101010101ULL;
+
+    //! The high bit of every byte of a word.
+    static const std::uint64_t sRepeatedHighBits = 0x8080808080808080ULL;
+
+    /**
+     *  @brief Folds eight characters at once. With the high bit of every byte cleared, adding a constant to the whole
+     *  word can not carry from one byte into the next, so the high bit of each byte afterwards tells whether that
+     *  byte was at least the constant's threshold. Bytes that had their high bit set to begin with are not ASCII and
+     *  are left alone.
+     */
+    static inline std::uint64_t foldWord(const std::uint64_t word)
+    {
+        const std::uint64_t lowBits = word & ~sRepeatedHighBits;
+        const std::uint64_t atLeastA = lowBits + (0x80 - 'A') * sRepeatedOnes;
+        const std::uint64_t aboveZ = lowBits + (0x7F - 'Z') * sRepeatedOnes;
+        const std::uint64_t upper = atLeastA & ~aboveZ & ~word & sRepeatedHighBits;
+
+        // The high bit shifted down twice is 0x20, the difference between upper and lower case
+        return word | (upper >> 2);
+    }
+
+    /**
+     *  @brief Loads up to eight characters into a word, padding with zeros.
+     */
+    static inline std::uint64_t loadWord(const char* in, const std::size_t length)
+    {
+        std::uint64_t result = 0;
+        std::memcpy(&result, in, length < sizeof(result) ? length : sizeof(result));
+        return result;
+    }
+
+    void foldCase(const char* in, const std::size_t length, char* out)
+    {
+        std::size_t offset = 0;
+        for (; offset + sizeof(std::uint64_t) <= length; offset += sizeof(std::uint64_t))
+        {
+            const std::uint64_t folded = foldWord(loadWord(in + offset, sizeof(std::uint64_t)));
+            std::memcpy(out + offset, &folded, sizeof(folded));
+        }
+
+        if (offset < length)
+        {
+            const std::uint64_t folded = foldWord(loadWord(in + offset, length - offset));
+            std::memcpy(out + offset, &folded, length - offset);
+        }
+    }
+
+    bool equalsCaseInsensitive(const char* lhs, const std::size_t lhsLength, const char* rhs, const std::size_t rhsLength)
+    {
+        if (lhsLength != rhsLength)
+        {
+            return false;
+        }
+
+        for (std::size_t offset = 0; offset < lhsLength; offset += sizeof(std::uint64_t))
+        {
+            const std::size_t remaining = lhsLength - offset;
+            if (foldWord(loadWord(lhs + offset, remaining)) != foldWord(loadWord(rhs + offset, remaining)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int compareCaseInsensitive(const char* lhs, const std::size_t lhsLength, const char* rhs, const std::size_t rhsLength)
+    {
+        const std::size_t length = lhsLength < rhsLength ? lhsLength : rhsLength;
+        for (std::size_t offset = 0; offset < length; offset += sizeof(std::uint64_t))
+        {
+            const std::size_t remaining = length - offset;
+            const std::uint64_t lhsWord = foldWord(loadWord(lhs + offset, remaining));
+            const std::uint64_t rhsWord = foldWord(loadWord(rhs + offset, remaining));
+
+            if (lhsWord != rhsWord)
+            {
+                // Words are compared byte by byte so the order does not depend on endianness
+                char lhsFolded[sizeof(std::uint64_t)];
+                char rhsFolded[sizeof(std::uint64_t)];
+                std::memcpy(lhsFolded, &lhsWord, sizeof(lhsWord));
+                std::memcpy(rhsFolded, &rhsWord, sizeof(rhsWord));
+                return std::memcmp(lhsFolded, rhsFolded, sizeof(lhsFolded));
+            }
+        }
+
+        if (lhsLength == rhsLength)
+        {
+            return 0;
+        }
+        return lhsLength < rhsLength ? -1 : 1;
+    }
+
+    std::size_t hashCaseInsensitive(const char* in, const std::size_t length)
+    {
+        // FNV-1a over whole folded words rather than single characters
+        std::uint64_t hash = 14695981039346656037ULL ^ length;
+        for (std::size_t offset = 0; offset < length; offset += sizeof(std::uint64_t))
+        {
+            hash ^= foldWord(loadWord(in + offset, length - offset));
+            hash *= 1099511628211ULL;
+            hash ^= hash >> 32;
+        }
+        return static_cast<std::size_t>(hash ^ (hash >> 32));
+    }
+}
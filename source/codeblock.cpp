@@ -13,6 +13,7 @@
  */
 
 #include <tribalscript/codeblock.hpp>
+#include <tribalscript/bytecode.hpp>
 #include <tribalscript/instructions.hpp>
 #include <tribalscript/stringhelpers.hpp>
 #include <tribalscript/instructionsequence.hpp>
@@ -22,11 +23,17 @@ namespace TribalScript
     CodeBlock::CodeBlock(const InstructionSequence& instructions)
     {
         mInstructions.insert(mInstructions.end(), instructions.begin(), instructions.end());
+        mBytecode = BytecodeAssembler::assemble(mInstructions);
+    }
+
+    CodeBlock::CodeBlock(std::shared_ptr<Bytecode> bytecode) : mBytecode(bytecode)
+    {
+
     }
 
     void CodeBlock::execute(ExecutionState* state)
     {
-        mInstructions.execute(state);
+        mBytecode->execute(state);
     }
 
     std::vector<std::string> CodeBlock::disassemble()
@@ -46,4 +53,9 @@ namespace TribalScript
         }
         return result;
     }
+
+    const Bytecode& CodeBlock::getBytecode()
+    {
+        return *mBytecode;
+    }
 }
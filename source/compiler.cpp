@@ -13,23 +13,109 @@
  */
 
 #include <cassert>
+#include <iterator>
 
 #include <Tribes2Lexer.h>
 #include <Tribes2Parser.h>
 
+#include <tribalscript/lexer.hpp>
+#include <tribalscript/parser.hpp>
 #include <tribalscript/compiler.hpp>
+#include <tribalscript/bytecode.hpp>
 #include <tribalscript/astbuilder.hpp>
+#include <tribalscript/bytecodeserializer.hpp>
 #include <tribalscript/instructionsequence.hpp>
 #include <tribalscript/parsererrorlistener.hpp>
+#include <tribalscript/instructionoptimizer.hpp>
 
 namespace TribalScript
 {
-    Compiler::Compiler(const InterpreterConfiguration& config) : mConfig(config)
+    //! Appended to the path of a script to get the path of its bytecode cache.
+    static const char* sBytecodeCacheExtension = ".dso";
+
+    static std::string readFileContent(FileHandleBase* handle)
     {
+        // Determine file size
+        handle->seek(0, std::ios_base::end);
+        const std::size_t fileSize = handle->tell();
+        handle->seek(0, std::ios_base::beg);
+
+        // Load file content
+        std::string fileContent(fileSize, ' ');
+        handle->read(&fileContent[0], fileSize);
 
+        handle->close();
+        return fileContent;
     }
 
-    CodeBlock* Compiler::compileStream(std::istream& input, StringTable* stringTable)
+    /**
+     *  @brief Flattens a chain of concatenations into the values concatenated and the separators between them.
+     *  Concatenation is associative, so nested concatenations on either side are flattened.
+     */
+    static void getConcatOperands(AST::ASTNode* expression, std::vector<AST::ASTNode*>& operands, std::vector<std::string>& seperators)
+    {
+        AST::ConcatNode* concat = dynamic_cast<AST::ConcatNode*>(expression);
+        if (!concat)
+        {
+            operands.push_back(expression);
+            return;
+        }
+
+        getConcatOperands(concat->mLeft, operands, seperators);
+        seperators.push_back(concat->mSeperator.toString());
+        getConcatOperands(concat->mRight, operands, seperators);
+    }
+
+    /**
+     *  @brief Parses a program with SLL prediction first, falling back to full LL prediction only if that fails.
+     *  @details SLL prediction is much cheaper on the left recursive expression rule and the chain rules, and
+     *  accepts every valid program that does not need full context to disambiguate. The first pass bails out on
+     *  the first error without reporting it; the second pass reparses the buffered tokens from the start with the
+     *  default error strategy, so syntax errors are only ever reported by full LL prediction. The DFA built by
+     *  either pass is shared by all parser instances, so it stays warm across compilations.
+     *  @param parser The parser to use, with no error listeners attached.
+     *  @param errorListener The listener to report syntax errors to.
+     *  @return The parsed program.
+     */
+    static Tribes2Parser::ProgramContext* parseProgram(Tribes2Parser& parser, antlr4::BaseErrorListener* errorListener)
+    {
+        parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+        parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+
+        try
+        {
+            return parser.program();
+        }
+        catch (antlr4::ParseCancellationException&)
+        {
+            parser.reset();
+            parser.addErrorListener(errorListener);
+            parser.setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+            parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::LL);
+            return parser.program();
+        }
+    }
+
+    Compiler::Compiler(const InterpreterConfiguration& config) : mConfig(config), mResolveLocalSlots(false)
+    {
+
+    }
+
+    std::size_t Compiler::getOrAssignLocalSlot(const StringTableEntry name)
+    {
+        for (std::size_t iteration = 0; iteration < mLocalSlotNames.size(); ++iteration)
+        {
+            if (mLocalSlotNames[iteration] == name)
+            {
+                return iteration;
+            }
+        }
+
+        mLocalSlotNames.push_back(name);
+        return mLocalSlotNames.size() - 1;
+    }
+
+    AST::ProgramNode* Compiler::parseWithANTLR(std::istream& input, StringTable* stringTable, AST::ASTArena* arena)
     {
         ParserErrorListener parserErrorListener;
 
@@ -43,33 +129,84 @@ namespace TribalScript
         Tribes2Parser parser(&stream);
         parser.removeErrorListeners();
 
-        parser.addErrorListener(&parserErrorListener);
-
         // Parse the program
-        Tribes2Parser::ProgramContext* program = parser.program();
+        Tribes2Parser::ProgramContext* program = parseProgram(parser, &parserErrorListener);
 
         // Did we receive any errors?
         if (parserErrorListener.getErrors().empty())
         {
-            // Instantiate the program and go
-            AST::ASTBuilder visitor(stringTable);
-            AST::ProgramNode* tree = visitor.visitProgram(program).as<AST::ProgramNode*>();
+            // The tree copies everything it needs out of the parse tree, so it outlives the parser
+            AST::ASTBuilder visitor(stringTable, arena);
+            return visitor.visitProgram(program).as<AST::ProgramNode*>();
+        }
 
-            // Used for generation of instructions
-            mStringTable = stringTable;
-            InstructionSequence instructions = this->visitProgramNode(tree).as<InstructionSequence>();
-            delete tree;
+        for (const std::string& message : parserErrorListener.getErrors())
+        {
+            mConfig.mPlatform->logError(message);
+        }
+        return nullptr;
+    }
+
+    AST::ProgramNode* Compiler::parseWithHandWrittenFrontend(std::istream& input, AST::ASTArena* arena)
+    {
+        const std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        const AST::StringView source = arena->createString(text);
 
-            CodeBlock* result = new CodeBlock(instructions);
-            return result;
+        Lexer lexer(source);
+        const std::vector<Token> tokens = lexer.tokenize();
+        if (!lexer.getErrors().empty())
+        {
+            for (const std::string& message : lexer.getErrors())
+            {
+                mConfig.mPlatform->logError(message);
+            }
+            return nullptr;
         }
 
-        for (const std::string& message : parserErrorListener.getErrors())
+        Parser parser(tokens, arena);
+        AST::ProgramNode* tree = parser.parseProgram();
+        for (const std::string& message : parser.getErrors())
         {
             mConfig.mPlatform->logError(message);
         }
+        return tree;
+    }
 
-        return nullptr;
+    CodeBlock* Compiler::compileStream(std::istream& input, StringTable* stringTable)
+    {
+        // The tree lives in the arena and is released along with it
+        AST::ASTArena arena;
+        AST::ProgramNode* tree = nullptr;
+        if (mConfig.mFrontend == ParserFrontend::HandWritten)
+        {
+            tree = this->parseWithHandWrittenFrontend(input, &arena);
+        }
+        else
+        {
+            tree = this->parseWithANTLR(input, stringTable, &arena);
+        }
+
+        if (!tree)
+        {
+            return nullptr;
+        }
+
+        // Used for generation of instructions
+        mStringTable = stringTable;
+        mOutput.clear();
+        mLoops.clear();
+        this->visitProgramNode(tree);
+
+        InstructionSequence instructions;
+        instructions.swap(mOutput);
+
+        if (mConfig.mOptimizationLevel >= 1)
+        {
+            instructions = InstructionOptimizer::optimize(instructions);
+        }
+
+        CodeBlock* result = new CodeBlock(instructions);
+        return result;
     }
 
     CodeBlock* Compiler::compileString(const std::string& input, StringTable* stringTable)
@@ -84,36 +221,122 @@ namespace TribalScript
         std::unique_ptr<FileHandleBase> handle = mConfig.mPlatform->getFileHandle(path);
         handle->openForRead();
 
-        if (handle->isOpen())
+        if (!handle->isOpen())
         {
-            // Determine file size
-            handle->seek(0, std::ios_base::end);
-            const std::size_t fileSize = handle->tell();
-            handle->seek(0, std::ios_base::beg);
-
-            // Load file content
-            std::string fileContent(fileSize, ' ');
-            handle->read(&fileContent[0], fileSize);
+            return nullptr;
+        }
 
-            handle->close();
+        const std::string fileContent = readFileContent(handle.get());
+        if (!mConfig.mCacheBytecode)
+        {
             return this->compileString(fileContent, stringTable);
         }
 
-        return nullptr;
+        // Use the cached bytecode if it was generated from this exact source
+        const std::uint64_t sourceHash = BytecodeSerializer::hashSource(fileContent);
+        const std::string cachePath = path + sBytecodeCacheExtension;
+
+        std::unique_ptr<FileHandleBase> cacheHandle = mConfig.mPlatform->getFileHandle(cachePath);
+        cacheHandle->openForBinaryRead();
+        if (cacheHandle->isOpen())
+        {
+            const std::string cacheContent = readFileContent(cacheHandle.get());
+            std::shared_ptr<Bytecode> cached = BytecodeSerializer::deserialize(cacheContent, sourceHash, mConfig, *stringTable);
+            if (cached)
+            {
+                return new CodeBlock(cached);
+            }
+        }
+
+        CodeBlock* result = this->compileString(fileContent, stringTable);
+        if (result)
+        {
+            const std::string cacheContent = BytecodeSerializer::serialize(result->getBytecode(), sourceHash, mConfig, *stringTable);
+
+            cacheHandle = mConfig.mPlatform->getFileHandle(cachePath);
+            cacheHandle->openForBinaryWrite();
+            if (cacheHandle->isOpen())
+            {
+                cacheHandle->write(cacheContent.data(), cacheContent.size());
+                cacheHandle->close();
+            }
+            else
+            {
+                mConfig.mPlatform->logWarning("Could not write bytecode cache '" + cachePath + "'");
+            }
+        }
+        return result;
     }
 
     antlrcpp::Any Compiler::defaultResult()
     {
-        return InstructionSequence();
+        // Instructions are emitted to mOutput as they are generated, so visits have no result of their own
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::aggregateResult(antlrcpp::Any& aggregate, antlrcpp::Any& nextResult)
     {
-        InstructionSequence result = aggregate.as<InstructionSequence>();
-        InstructionSequence next = nextResult.as<InstructionSequence>();
+        return antlrcpp::Any();
+    }
 
-        result.insert(result.end(), next.begin(), next.end());
-        return result;
+    void Compiler::emit(Instructions::Instruction* instruction)
+    {
+        mOutput.push_back(std::shared_ptr<Instructions::Instruction>(instruction));
+    }
+
+    Instructions::Instruction* Compiler::createJump(const JumpType type, const AddressOffsetType offset)
+    {
+        switch (type)
+        {
+            case JumpType::Jump:
+                return new Instructions::JumpInstruction(offset);
+            case JumpType::JumpTrue:
+                return new Instructions::JumpTrueInstruction(offset);
+            case JumpType::JumpFalse:
+                return new Instructions::JumpFalseInstruction(offset);
+            case JumpType::JumpTrueOrPop:
+                return new Instructions::JumpTrueOrPopInstruction(offset);
+            case JumpType::JumpFalseOrPop:
+                return new Instructions::JumpFalseOrPopInstruction(offset);
+        }
+
+        throw std::runtime_error("Unknown jump type");
+    }
+
+    void Compiler::emitJump(const JumpType type, Label& label)
+    {
+        const AddressType address = mOutput.size();
+        if (label.mBound)
+        {
+            this->emit(createJump(type, (AddressOffsetType)label.mAddress - (AddressOffsetType)address));
+            return;
+        }
+
+        // Leave a placeholder to be filled in once the target is known
+        label.mPatches.push_back(std::make_pair(address, type));
+        mOutput.push_back(nullptr);
+    }
+
+    void Compiler::bindLabel(Label& label)
+    {
+        assert(!label.mBound);
+
+        label.mBound = true;
+        label.mAddress = mOutput.size();
+
+        for (const std::pair<AddressType, JumpType>& patch : label.mPatches)
+        {
+            mOutput[patch.first] = std::shared_ptr<Instructions::Instruction>(createJump(patch.second, (AddressOffsetType)label.mAddress - (AddressOffsetType)patch.first));
+        }
+        label.mPatches.clear();
+    }
+
+    void Compiler::emitNodes(const AST::ArenaList<AST::ASTNode*>& nodes)
+    {
+        for (AST::ASTNode* node : nodes)
+        {
+            node->accept(this);
+        }
     }
 
     /*
@@ -121,20 +344,14 @@ namespace TribalScript
     */
     antlrcpp::Any Compiler::visitFunctionCallNode(AST::FunctionCallNode* call)
     {
-        InstructionSequence result;
-
-        for (AST::ASTNode* node : call->mParameters)
-        {
-            InstructionSequence parameterCode = node->accept(this).as<InstructionSequence>();
-            result.insert(result.end(), parameterCode.begin(), parameterCode.end());
-        }
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::CallFunctionInstruction(call->mNameSpace, call->mName, call->mParameters.size())));
-        return result;
+        this->emitNodes(call->mParameters);
+        this->emit(new Instructions::CallFunctionInstruction(call->mNameSpace.toString(), call->mName.toString(), call->mParameters.size()));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitPackageDeclarationNode(AST::PackageDeclarationNode* package)
     {
-        mCurrentPackage = package->mName;
+        mCurrentPackage = package->mName.toString();
 
         antlrcpp::Any result = ASTVisitor::visitPackageDeclarationNode(package);
 
@@ -144,574 +361,443 @@ namespace TribalScript
 
     antlrcpp::Any Compiler::visitFunctionDeclarationNode(AST::FunctionDeclarationNode* function)
     {
-        InstructionSequence functionBody;
-        for (AST::ASTNode* node : function->mBody)
+        std::vector<std::string> parameterNames;
+        for (const AST::StringView& parameterName : function->mParameterNames)
         {
-            InstructionSequence nodeInstructions = node->accept(this).as<InstructionSequence>();
-            functionBody.insert(functionBody.end(), nodeInstructions.begin(), nodeInstructions.end());
+            parameterNames.push_back(mConfig.mCaseSensitive ? parameterName.toString() : toLowerCase(parameterName.toString()));
         }
-        functionBody.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushIntegerInstruction(0))); // Add an empty return if we hit end of control but nothing returned
 
-        std::vector<std::string> parameterNames = function->mParameterNames;
-        if (!mConfig.mCaseSensitive)
+        // Parameters always occupy the first slots in declaration order so calls can write them directly
+        mResolveLocalSlots = true;
+        mLocalSlotNames.clear();
+        for (const std::string& parameterName : parameterNames)
         {
-            for (unsigned int iteration = 0; iteration < parameterNames.size(); ++iteration)
-            {
-                parameterNames[iteration] = toLowerCase(parameterNames[iteration]);
-            }
+            mLocalSlotNames.push_back(mStringTable->getOrAssign(parameterName));
         }
 
-        InstructionSequence result;
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::FunctionDeclarationInstruction(mCurrentPackage, function->mNameSpace, function->mName, parameterNames, functionBody)));
-        return result;
-    }
+        // The body is generated into its own sequence as it is stored in the declaration
+        InstructionSequence enclosingOutput;
+        std::vector<LoopLabels> enclosingLoops;
+        mOutput.swap(enclosingOutput);
+        mLoops.swap(enclosingLoops);
 
-    antlrcpp::Any Compiler::visitSubFieldNode(AST::SubFieldNode* subfield)
-    {
-        InstructionSequence result;
+        this->emitNodes(function->mBody);
+        this->emit(new Instructions::PushIntegerInstruction(0)); // Add an empty return if we hit end of control but nothing returned
 
-        const StringTableEntry stringID = mStringTable->getOrAssign(mConfig.mCaseSensitive ? subfield->mName : toLowerCase(subfield->mName));
+        InstructionSequence functionBody;
+        functionBody.swap(mOutput);
+        mOutput.swap(enclosingOutput);
+        mLoops.swap(enclosingLoops);
 
-        // Push array indices
-        for (AST::ASTNode* node : subfield->mIndices)
+        mResolveLocalSlots = false;
+
+        if (mConfig.mOptimizationLevel >= 1)
         {
-            InstructionSequence childInstructions = node->accept(this).as<InstructionSequence>();
-            result.insert(result.end(), childInstructions.begin(), childInstructions.end());
+            functionBody = InstructionOptimizer::optimize(functionBody);
         }
 
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::SubReferenceInstruction(stringID, subfield->mIndices.size())));
-        return result;
+        this->emit(new Instructions::FunctionDeclarationInstruction(mCurrentPackage, function->mNameSpace.toString(), function->mName.toString(), parameterNames, mLocalSlotNames, functionBody));
+        return antlrcpp::Any();
     }
 
-    antlrcpp::Any Compiler::visitSubFunctionCallNode(AST::SubFunctionCallNode* call)
+    antlrcpp::Any Compiler::visitSubFieldNode(AST::SubFieldNode* subfield)
     {
-        InstructionSequence result;
-        for (AST::ASTNode* node : call->mParameters)
-        {
-            InstructionSequence parameterCode = node->accept(this).as<InstructionSequence>();
-            result.insert(result.end(), parameterCode.begin(), parameterCode.end());
-        }
+        const StringTableEntry stringID = mConfig.mCaseSensitive ? mStringTable->getOrAssign(subfield->mName.data(), subfield->mName.size()) : mStringTable->getOrAssignFolded(subfield->mName.data(), subfield->mName.size());
 
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::CallBoundFunctionInstruction(call->mName, call->mParameters.size())));
-        return result;
+        // Push array indices
+        this->emitNodes(subfield->mIndices);
+        this->emit(new Instructions::SubReferenceInstruction(stringID, subfield->mIndices.size()));
+        return antlrcpp::Any();
     }
 
-    antlrcpp::Any Compiler::visitLogicalOrNode(AST::LogicalOrNode* expression)
+    antlrcpp::Any Compiler::visitSubFunctionCallNode(AST::SubFunctionCallNode* call)
     {
-        InstructionSequence result;
+        this->emitNodes(call->mParameters);
+        this->emit(new Instructions::CallBoundFunctionInstruction(call->mName.toString(), call->mParameters.size()));
+        return antlrcpp::Any();
+    }
 
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
+    antlrcpp::Any Compiler::visitLogicalOrNode(AST::LogicalOrNode* expression)
+    {
+        // The right hand side is only evaluated if the left hand side is false. Either side being true leaves 1 on the
+        // stack and jumps to the NOP at the end, otherwise both are popped and 0 is pushed in their place.
+        Label end;
 
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::LogicalOrInstruction()));
+        expression->mLeft->accept(this);
+        this->emitJump(JumpType::JumpTrueOrPop, end);
+        expression->mRight->accept(this);
+        this->emitJump(JumpType::JumpTrueOrPop, end);
+        this->emit(new Instructions::PushIntegerInstruction(0));
 
-        return result;
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitLogicalAndNode(AST::LogicalAndNode* expression)
     {
-        InstructionSequence result;
+        // The right hand side is only evaluated if the left hand side is true. Either side being false leaves 0 on the
+        // stack and jumps to the NOP at the end, otherwise both are popped and 1 is pushed in their place.
+        Label end;
 
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
+        expression->mLeft->accept(this);
+        this->emitJump(JumpType::JumpFalseOrPop, end);
+        expression->mRight->accept(this);
+        this->emitJump(JumpType::JumpFalseOrPop, end);
+        this->emit(new Instructions::PushIntegerInstruction(1));
 
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::LogicalAndInstruction()));
-
-        return result;
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitAddNode(AST::AddNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::AddInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::AddInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitBitwiseOrNode(AST::BitwiseOrNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::BitwiseOrInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::BitwiseOrInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitMinusNode(AST::MinusNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::MinusInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::MinusInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitModulusNode(AST::ModulusNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::ModulusInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::ModulusInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitIntegerNode(AST::IntegerNode* value)
     {
-        InstructionSequence result;
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushIntegerInstruction(value->mValue)));
-        return result;
+        this->emit(new Instructions::PushIntegerInstruction(value->mValue));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitFloatNode(AST::FloatNode* value)
     {
-        InstructionSequence result;
-
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushFloatInstruction(value->mValue)));
-        return result;
+        this->emit(new Instructions::PushFloatInstruction(value->mValue));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitStringNode(AST::StringNode* value)
     {
-        InstructionSequence result;
-
-        const std::string pushedString = expandEscapeSequences(value->mValue);
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushStringInstruction(pushedString)));
-        return result;
+        const std::string pushedString = expandEscapeSequences(value->mValue.data(), value->mValue.size());
+        this->emit(new Instructions::PushStringInstruction(pushedString));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitTaggedStringNode(AST::TaggedStringNode* value)
     {
-        InstructionSequence result;
-
-        const StringTableEntry stringID = mStringTable->getOrAssign(expandEscapeSequences(value->mValue));
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushIntegerInstruction((int)stringID)));
-        return result;
+        const StringTableEntry stringID = mStringTable->getOrAssign(expandEscapeSequences(value->mValue.data(), value->mValue.size()));
+        this->emit(new Instructions::PushTaggedStringInstruction(stringID));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitLocalVariableNode(AST::LocalVariableNode* value)
     {
-        InstructionSequence out;
-
         // NOTE: For now we collapse the name into a single string for lookup
         std::string lookupName = value->getName();
 
-        const StringTableEntry stringID = mStringTable->getOrAssign(mConfig.mCaseSensitive ? lookupName : toLowerCase(lookupName));
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushLocalReferenceInstruction(stringID)));
-        return out;
+        const StringTableEntry stringID = mConfig.mCaseSensitive ? mStringTable->getOrAssign(lookupName) : mStringTable->getOrAssignFolded(lookupName);
+
+        // Locals outside of functions live in the frame of whoever executes the code, so they must be looked up by name
+        if (mResolveLocalSlots)
+        {
+            this->emit(new Instructions::PushLocalSlotInstruction(this->getOrAssignLocalSlot(stringID)));
+        }
+        else
+        {
+            this->emit(new Instructions::PushLocalReferenceInstruction(stringID));
+        }
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitGlobalVariableNode(AST::GlobalVariableNode* value)
     {
-        InstructionSequence out;
-
         // NOTE: For now we collapse the name into a single string for lookup
         std::string lookupName = value->getName();
 
-        const StringTableEntry stringID = mStringTable->getOrAssign(mConfig.mCaseSensitive ? lookupName : toLowerCase(lookupName));
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushGlobalReferenceInstruction(stringID)));
-        return out;
+        const StringTableEntry stringID = mConfig.mCaseSensitive ? mStringTable->getOrAssign(lookupName) : mStringTable->getOrAssignFolded(lookupName);
+        this->emit(new Instructions::PushGlobalReferenceInstruction(stringID));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitAssignmentNode(AST::AssignmentNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::AssignmentInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::AssignmentInstruction());
+        return antlrcpp::Any();
     }
 
 	antlrcpp::Any Compiler::visitGreaterThanOrEqualNode(AST::GreaterThanOrEqualNode* expression)
 	{
-		InstructionSequence result;
-
-		InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-		InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-		result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-		result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-		result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::GreaterThanOrEqualInstruction()));
-
-		return result;
+		expression->mLeft->accept(this);
+		expression->mRight->accept(this);
+		this->emit(new Instructions::GreaterThanOrEqualInstruction());
+		return antlrcpp::Any();
 	}
 
     antlrcpp::Any Compiler::visitGreaterThanNode(AST::GreaterThanNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::GreaterThanInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::GreaterThanInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitLessThanNode(AST::LessThanNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), lhsCode.begin(), lhsCode.end());
-        result.insert(result.end(), rhsCode.begin(), rhsCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::LessThanInstruction()));
-
-        return result;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::LessThanInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitNegateNode(AST::NegateNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence innerCode = expression->mInner->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), innerCode.begin(), innerCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NegateInstruction()));
-
-        return result;
+        expression->mInner->accept(this);
+        this->emit(new Instructions::NegateInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitNotNode(AST::NotNode* expression)
     {
-        InstructionSequence result;
-
-        InstructionSequence innerCode = expression->mInner->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), innerCode.begin(), innerCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NotInstruction()));
-
-        return result;
+        expression->mInner->accept(this);
+        this->emit(new Instructions::NotInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitIncrementNode(AST::IncrementNode* expression)
     {
-        InstructionSequence result;
-        InstructionSequence innerCode = expression->mInner->accept(this).as<InstructionSequence>();
-
-        result.insert(result.end(), innerCode.begin(), innerCode.end());
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushIntegerInstruction(1)));
-        result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::AddAssignmentInstruction()));
-
-        return result;
+        expression->mInner->accept(this);
+        this->emit(new Instructions::PushIntegerInstruction(1));
+        this->emit(new Instructions::AddAssignmentInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitWhileNode(AST::WhileNode* node)
     {
-        InstructionSequence out;
+        Label condition;
+        Label end;
 
-        InstructionSequence bodyCode;
-        InstructionSequence expressionCode = node->mExpression->accept(this).as<InstructionSequence>();
-        for (AST::ASTNode* bodyNode : node->mBody)
-        {
-            InstructionSequence childCode = bodyNode->accept(this).as<InstructionSequence>();
-            bodyCode.insert(bodyCode.end(), childCode.begin(), childCode.end());
-        }
+        // Expression should jump over body if false
+        this->bindLabel(condition);
+        node->mExpression->accept(this);
+        this->emitJump(JumpType::JumpFalse, end);
 
-        // Expression should jump over body if false (+2 added for the NOP and jump below)
-        expressionCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction(bodyCode.size() + 2)));
+        // Continue reevaluates the expression, break leaves the loop
+        LoopLabels loop;
+        loop.mBreak = &end;
+        loop.mContinue = &condition;
+
+        mLoops.push_back(loop);
+        this->emitNodes(node->mBody);
+        mLoops.pop_back();
 
         // Body should jump back to the expression to reevaluate
-        const AddressOffsetType jumpTarget = -((int)(bodyCode.size() + expressionCode.size()));
-        bodyCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(jumpTarget)));
+        this->emitJump(JumpType::Jump, condition);
 
         // Add a NOP for a jump target
-        bodyCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NOPInstruction()));
-
-        out.insert(out.end(), expressionCode.begin(), expressionCode.end());
-
-        for (std::size_t iteration = 0; iteration < bodyCode.size(); ++iteration)
-        {
-            std::shared_ptr<Instructions::ContinueInstruction> continueInstruction = std::dynamic_pointer_cast<Instructions::ContinueInstruction>(bodyCode[iteration]);
-            std::shared_ptr<Instructions::BreakInstruction> breakInstruction = std::dynamic_pointer_cast<Instructions::BreakInstruction>(bodyCode[iteration]);
-
-            if (continueInstruction)
-            {
-                // Replace instruction with jump end
-                const AddressType continueTarget = bodyCode.size() - expressionCode.size() - 1; // -1 to account for the jump and NOP added at the end of body
-                const AddressOffsetType continueRelative = continueTarget - iteration;
-                bodyCode[iteration] = std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(continueRelative));
-            }
-            else if (breakInstruction)
-            {
-                // Replace instruction with pointer to NOP
-                const AddressType breakTarget = bodyCode.size();
-                const AddressOffsetType breakRelative = breakTarget - iteration - 1; // -1 to account for POP at the end
-                bodyCode[iteration] = std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(breakRelative));
-            }
-        }
-
-        out.insert(out.end(), bodyCode.begin(), bodyCode.end());
-
-
-        return out;
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitForNode(AST::ForNode* node)
     {
-        InstructionSequence out;
-        InstructionSequence initializerCode = node->mInitializer->accept(this).as<InstructionSequence>();
-        InstructionSequence expressionCode = node->mExpression->accept(this).as<InstructionSequence>();
-        InstructionSequence advanceCode = node->mAdvance->accept(this).as<InstructionSequence>();
-
-        InstructionSequence forBody;
-        for (AST::ASTNode* bodyNode : node->mBody)
-        {
-            InstructionSequence childInstructions = bodyNode->accept(this).as<InstructionSequence>();
-            forBody.insert(forBody.end(), childInstructions.begin(), childInstructions.end());
-        }
-
-        // Pop the result of our advance so it doesn't corrupt the stack
-        advanceCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PopInstruction()));
-
-        // At the end of the loop, run advance
-        forBody.insert(forBody.end(), advanceCode.begin(), advanceCode.end());
+        Label condition;
+        Label advance;
+        Label end;
 
         // Pop the result of our initializer so it doesn't corrupt the stack
-        initializerCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PopInstruction()));
-
-        // Our body should return to the expression
-        const AddressOffsetType jumpTarget = expressionCode.size() + forBody.size() + 1; // Consider the POP at the end of advance
-        forBody.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(-jumpTarget)));
-        forBody.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NOPInstruction()));
+        node->mInitializer->accept(this);
+        this->emit(new Instructions::PopInstruction());
 
         // Check if our expression is false
-        expressionCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction((int)forBody.size())));
+        this->bindLabel(condition);
+        node->mExpression->accept(this);
+        this->emitJump(JumpType::JumpFalse, end);
 
-        // Output final code, also resolve break/continue instructions
-        out.insert(out.end(), initializerCode.begin(), initializerCode.end());
-        out.insert(out.end(), expressionCode.begin(), expressionCode.end());
+        LoopLabels loop;
+        loop.mBreak = &end;
+        loop.mContinue = &advance;
 
-        for (std::size_t iteration = 0; iteration < forBody.size(); ++iteration)
-        {
-            std::shared_ptr<Instructions::ContinueInstruction> continueInstruction = std::dynamic_pointer_cast<Instructions::ContinueInstruction>(forBody[iteration]);
-            std::shared_ptr<Instructions::BreakInstruction> breakInstruction = std::dynamic_pointer_cast<Instructions::BreakInstruction>(forBody[iteration]);
+        mLoops.push_back(loop);
+        this->emitNodes(node->mBody);
+        mLoops.pop_back();
 
-            if (continueInstruction)
-            {
-                // Replace instruction with jump end
-                const AddressType continueTarget = forBody.size() - advanceCode.size() - 2; // -2 to account for the jump and NOP added at the end of body
-                const AddressOffsetType continueRelative = continueTarget - iteration;
-                forBody[iteration] = std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(continueRelative));
-            }
-            else if (breakInstruction)
-            {
-                // Replace instruction with pointer to NOP
-                const AddressType breakTarget = forBody.size();
-                const AddressOffsetType breakRelative = breakTarget - iteration - 1; // -1 to account for POP at the end
-                forBody[iteration] = std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(breakRelative));
-            }
-        }
+        // At the end of the loop, run advance and pop its result so it doesn't corrupt the stack
+        this->bindLabel(advance);
+        node->mAdvance->accept(this);
+        this->emit(new Instructions::PopInstruction());
 
-        out.insert(out.end(), forBody.begin(), forBody.end());
+        // Our body should return to the expression
+        this->emitJump(JumpType::Jump, condition);
 
-        return out;
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitBreakNode(AST::BreakNode* node)
     {
-        InstructionSequence out;
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::BreakInstruction()));
-        return out;
+        if (mLoops.empty())
+        {
+            this->emit(new Instructions::BreakInstruction());
+        }
+        else
+        {
+            this->emitJump(JumpType::Jump, *mLoops.back().mBreak);
+        }
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitContinueNode(AST::ContinueNode* node)
     {
-        InstructionSequence out;
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::ContinueInstruction()));
-        return out;
+        if (mLoops.empty())
+        {
+            this->emit(new Instructions::ContinueInstruction());
+        }
+        else
+        {
+            this->emitJump(JumpType::Jump, *mLoops.back().mContinue);
+        }
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitReturnNode(AST::ReturnNode* node)
     {
-        InstructionSequence out;
         if (node->mExpression)
         {
-            out = node->mExpression->accept(this).as<InstructionSequence>();
+            node->mExpression->accept(this);
         }
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::ReturnInstruction()));
-        return out;
+        this->emit(new Instructions::ReturnInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitTernaryNode(AST::TernaryNode* node)
     {
-        InstructionSequence out;
-
-        InstructionSequence expressionCode = node->mExpression->accept(this).as<InstructionSequence>();
-        InstructionSequence trueValueCode = node->mTrueValue->accept(this).as<InstructionSequence>();
-        InstructionSequence falseValueCode = node->mFalseValue->accept(this).as<InstructionSequence>();
+        Label falseValue;
+        Label end;
 
-        // We add a NOP to the false expressions for a target to jump to
-        falseValueCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NOPInstruction()));
+        // Jump to the false expression if our expression is false
+        node->mExpression->accept(this);
+        this->emitJump(JumpType::JumpFalse, falseValue);
 
         // In the true expression we need to jump over the false expression
-        trueValueCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(falseValueCode.size())));
+        node->mTrueValue->accept(this);
+        this->emitJump(JumpType::Jump, end);
 
-        // Jump to the false expression if our expression is false
-        expressionCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction(falseValueCode.size() + 1)));
-
-        out.insert(out.end(), expressionCode.begin(), expressionCode.end());
-        out.insert(out.end(), trueValueCode.begin(), trueValueCode.end());
-        out.insert(out.end(), falseValueCode.begin(), falseValueCode.end());
+        this->bindLabel(falseValue);
+        node->mFalseValue->accept(this);
 
-        return out;
+        // We add a NOP to the false expressions for a target to jump to
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitSwitchNode(AST::SwitchNode* node)
     {
-        InstructionSequence out;
+        Label end;
 
-        InstructionSequence expressionCode = node->mExpression->accept(this).as<InstructionSequence>();
-
-        // NOTE: We intentionally process in reverse order due to needing to know how long existing code is to jump over
-        // Add a NOP to jump to
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NOPInstruction()));
-
-        InstructionSequence defaultInstructions;
-        for (AST::ASTNode* defaultNode : node->mDefaultBody)
+        // NOTE: Cases are stored in reverse order by the AST builder
+        for (auto caseIterator = node->mCases.rbegin(); caseIterator != node->mCases.rend(); ++caseIterator)
         {
-            InstructionSequence childInstructions = defaultNode->accept(this).as<InstructionSequence>();
-            defaultInstructions.insert(defaultInstructions.end(), childInstructions.begin(), childInstructions.end());
-        }
-        out.insert(out.begin(), defaultInstructions.begin(), defaultInstructions.end());
+            AST::SwitchCaseNode* caseNode = *caseIterator;
 
-        // Process all cases
-        for (AST::SwitchCaseNode* caseNode : node->mCases)
-        {
-            InstructionSequence caseBody;
-            for (AST::ASTNode* node : caseNode->mBody)
-            {
-                InstructionSequence childInstructions = node->accept(this).as<InstructionSequence>();
-                caseBody.insert(caseBody.end(), childInstructions.begin(), childInstructions.end());
-            }
-            // If we enter this body we should skip over the rest of the instructions
-            caseBody.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(out.size())));
+            Label caseBody;
+            Label nextCase;
 
-            // Generate a sequence of checks until something comes out to be true
-            InstructionSequence caseExpressions;
-            for (auto iterator = caseNode->mCases.begin(); iterator != caseNode->mCases.end(); ++iterator)
+            // Generate a sequence of checks until something comes out to be true, the first value listed being checked last
+            for (auto iterator = caseNode->mCases.rbegin(); iterator != caseNode->mCases.rend(); ++iterator)
             {
-                AST::ASTNode* currentCaseExpression = *iterator;
-                InstructionSequence caseExpressionCode = currentCaseExpression->accept(this).as<InstructionSequence>();
-
                 // Place our expression to check against and then check if equal
-                caseExpressionCode.insert(caseExpressionCode.end(), expressionCode.begin(), expressionCode.end());
-                caseExpressionCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::EqualsInstruction()));
+                (*iterator)->accept(this);
+                node->mExpression->accept(this);
+                this->emit(new Instructions::EqualsInstruction());
 
-                if (iterator != caseNode->mCases.begin())
+                if (iterator + 1 != caseNode->mCases.rend())
                 {
-                    caseExpressionCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpTrueInstruction(caseExpressions.size() + 1)));
+                    this->emitJump(JumpType::JumpTrue, caseBody);
                 }
                 else
                 {
-                    caseExpressionCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction(caseBody.size() + 1)));
+                    this->emitJump(JumpType::JumpFalse, nextCase);
                 }
-
-                caseExpressions.insert(caseExpressions.begin(), caseExpressionCode.begin(), caseExpressionCode.end());
             }
 
-            out.insert(out.begin(), caseBody.begin(), caseBody.end());
-            out.insert(out.begin(), caseExpressions.begin(), caseExpressions.end());
+            // If we enter this body we should skip over the rest of the instructions
+            this->bindLabel(caseBody);
+            this->emitNodes(caseNode->mBody);
+            this->emitJump(JumpType::Jump, end);
+
+            this->bindLabel(nextCase);
         }
 
-        return out;
+        this->emitNodes(node->mDefaultBody);
+
+        // Add a NOP to jump to
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitIfNode(AST::IfNode* node)
     {
-        InstructionSequence out;
-
-        // Generate else code
-        InstructionSequence elseCode;
-        for (AST::ASTNode* bodyNode : node->mElseBody)
-        {
-            InstructionSequence childInstructions = bodyNode->accept(this).as<InstructionSequence>();
-            elseCode.insert(elseCode.end(), childInstructions.begin(), childInstructions.end());
-        }
-        elseCode.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NOPInstruction())); // Add a NOP for jump targets
-        out.insert(out.end(), elseCode.begin(), elseCode.end());
+        Label end;
 
-        // Generate all else if's
-        for (AST::ElseIfNode* elseIf : node->mElseIfs)
-        {
-            InstructionSequence elseIfBody;
+        // Generate primary if condition. The expression must jump over our body if false
+        Label nextBranch;
+        node->mExpression->accept(this);
+        this->emitJump(JumpType::JumpFalse, nextBranch);
 
-            for (AST::ASTNode* bodyNode : elseIf->mBody)
-            {
-                InstructionSequence childInstructions = bodyNode->accept(this).as<InstructionSequence>();
-                elseIfBody.insert(elseIfBody.end(), childInstructions.begin(), childInstructions.end());
-            }
-
-            InstructionSequence elseIfExpression = elseIf->mExpression->accept(this).as<InstructionSequence>();
-
-            // The expression must jump over our body if false
-            elseIfExpression.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction(elseIfBody.size() + 2)));
-
-            // The body, when done, must jump over the remaining code
-            elseIfBody.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(out.size())));
+        // The body, when done, must jump over the remaining code
+        this->emitNodes(node->mBody);
+        this->emitJump(JumpType::Jump, end);
+        this->bindLabel(nextBranch);
 
-            out.insert(out.begin(), elseIfBody.begin(), elseIfBody.end());
-            out.insert(out.begin(), elseIfExpression.begin(), elseIfExpression.end());
-        }
+        // Generate all else if's. NOTE: These are stored in reverse order by the AST builder
+        for (auto iterator = node->mElseIfs.rbegin(); iterator != node->mElseIfs.rend(); ++iterator)
+        {
+            AST::ElseIfNode* elseIf = *iterator;
 
-        // Generate primary if condition
-        InstructionSequence ifExpression = node->mExpression->accept(this).as<InstructionSequence>();
+            Label nextElseIf;
+            elseIf->mExpression->accept(this);
+            this->emitJump(JumpType::JumpFalse, nextElseIf);
 
-        InstructionSequence ifBody;
-        for (AST::ASTNode* bodyNode : node->mBody)
-        {
-            InstructionSequence childInstructions = bodyNode->accept(this).as<InstructionSequence>();
-            ifBody.insert(ifBody.end(), childInstructions.begin(), childInstructions.end());
+            this->emitNodes(elseIf->mBody);
+            this->emitJump(JumpType::Jump, end);
+            this->bindLabel(nextElseIf);
         }
 
-        // The expression must jump over our body if false
-        ifExpression.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction(ifBody.size() + 2)));
-
-        // The body, when done, must jump over the remaining code
-        ifBody.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(out.size())));
+        // Generate else code
+        this->emitNodes(node->mElseBody);
 
-        out.insert(out.begin(), ifBody.begin(), ifBody.end());
-        out.insert(out.begin(), ifExpression.begin(), ifExpression.end());
-        return out;
+        this->bindLabel(end);
+        this->emit(new Instructions::NOPInstruction()); // Add a NOP for jump targets
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitArrayNode(AST::ArrayNode* array)
     {
-        InstructionSequence out;
-
         AST::LocalVariableNode* localVariable = dynamic_cast<AST::LocalVariableNode*>(array->mTarget);
         AST::GlobalVariableNode* globalVariable = dynamic_cast<AST::GlobalVariableNode*>(array->mTarget);
 
@@ -719,112 +805,80 @@ namespace TribalScript
         std::string variableName = localVariable ? localVariable->getName() : globalVariable->getName();
 
         // Ask all indices to generate their code
-        for (AST::ASTNode* node : array->mIndices)
-        {
-            InstructionSequence childInstructions = node->accept(this).as<InstructionSequence>();
-            out.insert(out.end(), childInstructions.begin(), childInstructions.end());
-        }
-
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::AccessArrayInstruction(variableName, array->mIndices.size(), globalVariable != nullptr)));
-        return out;
+        this->emitNodes(array->mIndices);
+        this->emit(new Instructions::AccessArrayInstruction(variableName, array->mIndices.size(), globalVariable != nullptr));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitEqualsNode(AST::EqualsNode* expression)
     {
-        InstructionSequence out;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::EqualsInstruction()));
-
-        return out;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::EqualsInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitNotEqualsNode(AST::NotEqualsNode* expression)
     {
-        InstructionSequence out;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NotEqualsInstruction()));
-
-        return out;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::NotEqualsInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitStringEqualsNode(AST::StringEqualsNode* expression)
     {
-        InstructionSequence out;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::StringEqualsInstruction()));
-
-        return out;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::StringEqualsInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitStringNotEqualNode(AST::StringNotEqualNode* expression)
     {
-        InstructionSequence out;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::StringNotEqualInstruction()));
-
-        return out;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::StringNotEqualInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitConcatNode(AST::ConcatNode* expression)
     {
-        InstructionSequence out;
+        std::vector<AST::ASTNode*> operands;
+        std::vector<std::string> seperators;
+        getConcatOperands(expression, operands, seperators);
 
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::ConcatInstruction(expression->mSeperator)));
+        for (AST::ASTNode* operand : operands)
+        {
+            operand->accept(this);
+        }
 
-        return out;
+        // Chains are built in one go rather than one intermediate string per concatenation
+        if (seperators.size() == 1)
+        {
+            this->emit(new Instructions::ConcatInstruction(seperators[0]));
+        }
+        else
+        {
+            this->emit(new Instructions::ConcatListInstruction(seperators));
+        }
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitDivideNode(AST::DivideNode* expression)
     {
-        InstructionSequence out;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::DivideInstruction()));
-
-        return out;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::DivideInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitMultiplyNode(AST::MultiplyNode* expression)
     {
-        InstructionSequence out;
-
-        InstructionSequence lhsCode = expression->mLeft->accept(this).as<InstructionSequence>();
-        InstructionSequence rhsCode = expression->mRight->accept(this).as<InstructionSequence>();
-
-        out.insert(out.end(), lhsCode.begin(), lhsCode.end());
-        out.insert(out.end(), rhsCode.begin(), rhsCode.end());
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::MultiplyInstruction()));
-
-        return out;
+        expression->mLeft->accept(this);
+        expression->mRight->accept(this);
+        this->emit(new Instructions::MultiplyInstruction());
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitDatablockDeclarationNode(AST::DatablockDeclarationNode* datablock)
@@ -834,69 +888,52 @@ namespace TribalScript
 
     antlrcpp::Any Compiler::visitFieldAssignNode(AST::FieldAssignNode* node)
     {
-        InstructionSequence out;
-
         // Push base
-        const std::string stringData = node->mFieldBaseName;
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushStringInstruction(stringData)));
+        const std::string stringData = node->mFieldBaseName.toString();
+        this->emit(new Instructions::PushStringInstruction(stringData));
 
         // Push all array components
-        for (AST::ASTNode* childNode : node->mFieldExpressions)
-        {
-            InstructionSequence childCode = childNode->accept(this).as<InstructionSequence>();
-            out.insert(out.end(), childCode.begin(), childCode.end());
-        }
+        this->emitNodes(node->mFieldExpressions);
 
         // Push the rvalue
-        InstructionSequence rvalueCode = node->mRight->accept(this).as<InstructionSequence>();
-        out.insert(out.end(), rvalueCode.begin(), rvalueCode.end());
+        node->mRight->accept(this);
 
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushObjectFieldInstruction(node->mFieldExpressions.size())));
-        return out;
+        this->emit(new Instructions::PushObjectFieldInstruction(node->mFieldExpressions.size()));
+        return antlrcpp::Any();
     }
 
     antlrcpp::Any Compiler::visitObjectDeclarationNode(AST::ObjectDeclarationNode* object)
     {
-        InstructionSequence out;
-
         // The stack should look something like:
         // ...
         // ObjectTypeName
         // ObjectName
-        InstructionSequence typeNameCode = object->mType->accept(this).as<InstructionSequence>();
-        out.insert(out.begin(), typeNameCode.begin(), typeNameCode.end());
+        object->mType->accept(this);
 
         if (object->mName)
         {
-            InstructionSequence nameCode = object->mName->accept(this).as<InstructionSequence>();
-            out.insert(out.end(), nameCode.begin(), nameCode.end());
+            object->mName->accept(this);
         }
         else
         {
             const std::string stringData = "";
-            out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushStringInstruction(stringData)));
+            this->emit(new Instructions::PushStringInstruction(stringData));
         }
 
         // Push Object
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PushObjectInstantiationInstruction()));
+        this->emit(new Instructions::PushObjectInstantiationInstruction());
 
         // ... gen fields
-        for (AST::ASTNode* field : object->mFields)
-        {
-            InstructionSequence fieldCode = field->accept(this).as<InstructionSequence>();
-            out.insert(out.end(), fieldCode.begin(), fieldCode.end());
-        }
+        this->emitNodes(object->mFields);
 
         // ... gen children
         for (AST::ObjectDeclarationNode* child : object->mChildren)
         {
-            InstructionSequence childCode = child->accept(this).as<InstructionSequence>();
-            out.insert(out.end(), childCode.begin(), childCode.end());
+            child->accept(this);
         }
 
         // Pop object
-        out.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::PopObjectInstantiationInstruction(object->mChildren.size())));
-
-        return out;
+        this->emit(new Instructions::PopObjectInstantiationInstruction(object->mChildren.size()));
+        return antlrcpp::Any();
     }
 }
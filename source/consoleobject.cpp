@@ -18,7 +18,7 @@
 
 namespace TribalScript
 {
-    ConsoleObject::ConsoleObject(Interpreter* interpreter) : mInterpreter(interpreter)
+    ConsoleObject::ConsoleObject(Interpreter* interpreter) : mInterpreter(interpreter), mDescriptor(nullptr)
     {
 
     }
@@ -34,8 +34,7 @@ namespace TribalScript
 
     StoredValue* ConsoleObject::getTaggedField(const std::string& name)
     {
-        const std::string searchName = toLowerCase(name);
-        auto search = mTaggedFields.find(searchName);
+        auto search = mTaggedFields.find(name);
 
         if (search != mTaggedFields.end())
         {
@@ -46,8 +45,7 @@ namespace TribalScript
 
     StoredValue* ConsoleObject::getTaggedFieldOrAllocate(const std::string& name)
     {
-        const std::string searchName = toLowerCase(name);
-        auto search = mTaggedFields.find(searchName);
+        auto search = mTaggedFields.find(name);
 
         if (search != mTaggedFields.end())
         {
@@ -61,16 +59,14 @@ namespace TribalScript
 
     void ConsoleObject::setTaggedField(const std::string& name, StoredValue value)
     {
-        const std::string setName = toLowerCase(name);
-
-        auto search = mTaggedFields.find(setName);
+        auto search = mTaggedFields.find(name);
         if (search != mTaggedFields.end())
         {
             search->second->setValue(value);
         }
         else
         {
-            mTaggedFields.insert(std::make_pair(setName, new StoredValue(value)));
+            mTaggedFields.insert(std::make_pair(name, new StoredValue(value)));
         }
     }
 
@@ -106,6 +102,16 @@ namespace TribalScript
         return this->getClassName();
     }
 
+    ConsoleObjectDescriptor* ConsoleObject::getDescriptor()
+    {
+        // The virtual class name of an object never changes and descriptors are never removed
+        if (!mDescriptor)
+        {
+            mDescriptor = mInterpreter->lookupDescriptor(this->getVirtualClassName());
+        }
+        return mDescriptor;
+    }
+
 	void ConsoleObject::associateWithParent(ConsoleObject* parent)
 	{
 		parent->mChildren.push_back(this);
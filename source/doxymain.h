@@ -19,6 +19,7 @@
  *  <ul>
  *      <li>TribalScript::AST::ASTNode</li>
  *      <li>TribalScript::Instructions::Instruction</li>
+ *      <li>TribalScript::Bytecode</li>
  *      <li>TribalScript::Compiler</li>
  *  </ul>
  */
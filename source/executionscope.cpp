@@ -13,23 +13,32 @@
  */
 
 
+#include <cassert>
+#include <algorithm>
+
 #include <tribalscript/executionscope.hpp>
 
 namespace TribalScript
 {
-    ExecutionScope::ExecutionScope(const InterpreterConfiguration& config, StringTable* table) : mConfig(config), mStringTable(table)
+    ExecutionScope::ExecutionScope(const InterpreterConfiguration& config, StringTable* table) : mConfig(config), mStringTable(table), mFrameDepth(0)
     {
         this->pushFrame(nullptr);
     }
 
     StoredValue* ExecutionScope::getVariable(const StringTableEntry name)
     {
-        if (mExecutionScopeData.empty())
+        if (mFrameDepth == 0)
         {
             return nullptr;
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
+
+        StoredValue* slot = this->findLocalSlot(currentScope, name);
+        if (slot)
+        {
+            return slot;
+        }
 
         auto search = currentScope.mLocalVariables.find(name);
         if (search != currentScope.mLocalVariables.end())
@@ -42,12 +51,18 @@ namespace TribalScript
 
     StoredValue* ExecutionScope::getVariableOrAllocate(const StringTableEntry name)
     {
-        if (mExecutionScopeData.empty())
+        if (mFrameDepth == 0)
         {
             return nullptr;
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
+
+        StoredValue* slot = this->findLocalSlot(currentScope, name);
+        if (slot)
+        {
+            return slot;
+        }
 
         auto search = currentScope.mLocalVariables.find(name);
         if (search != currentScope.mLocalVariables.end())
@@ -62,54 +77,48 @@ namespace TribalScript
 
     StoredValue* ExecutionScope::getVariableOrAllocate(const std::string& name)
     {
-        if (mExecutionScopeData.empty())
+        if (mFrameDepth == 0)
         {
             return nullptr;
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
-
-        const StringTableEntry nameEntry = mStringTable->getOrAssign(mConfig.mCaseSensitive ? name : toLowerCase(name));
-        auto search = currentScope.mLocalVariables.find(nameEntry);
-        if (search != currentScope.mLocalVariables.end())
+        // The name is only interned when the variable does not exist yet
+        StringTableEntry nameEntry;
+        if (this->findName(name, nameEntry))
         {
-            return search->second;
+            return this->getVariableOrAllocate(nameEntry);
         }
-
-        StoredValue* newValue = new StoredValue(0);
-        currentScope.mLocalVariables.insert(std::make_pair(nameEntry, newValue));
-        return newValue;
+        return this->getVariableOrAllocate(this->internName(name));
     }
 
     StoredValue* ExecutionScope::getVariable(const std::string& name)
     {
-        const StringTableEntry lookup = mStringTable->getOrAssign(mConfig.mCaseSensitive ? name : toLowerCase(name));
-
-        if (mExecutionScopeData.empty())
+        if (mFrameDepth == 0)
         {
             return nullptr;
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
-
-        auto search = currentScope.mLocalVariables.find(lookup);
-        if (search != currentScope.mLocalVariables.end())
-        {
-            return search->second;
-        }
-
-        return nullptr;
+        // Names that were never interned cannot refer to a variable
+        StringTableEntry lookup;
+        return this->findName(name, lookup) ? this->getVariable(lookup) : nullptr;
     }
 
     void ExecutionScope::setVariable(const StringTableEntry name, const StoredValue& variable)
     {
         // Initialize if necessary
-        if (mExecutionScopeData.empty())
+        if (mFrameDepth == 0)
         {
             this->pushFrame(nullptr);
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
+
+        StoredValue* slot = this->findLocalSlot(currentScope, name);
+        if (slot)
+        {
+            slot->setValue(variable);
+            return;
+        }
 
         auto search = currentScope.mLocalVariables.find(name);
         if (search != currentScope.mLocalVariables.end())
@@ -123,77 +132,206 @@ namespace TribalScript
 
     void ExecutionScope::setVariable(const std::string& name, const StoredValue& variable)
     {
-        const StringTableEntry key = mStringTable->getOrAssign(mConfig.mCaseSensitive ? name : toLowerCase(name));
+        // The name is only interned when the variable does not exist yet
+        StringTableEntry key;
+        if (!this->findName(name, key))
+        {
+            key = this->internName(name);
+        }
+        this->setVariable(key, variable);
+    }
 
-        // Initialize if necessary
-        if (mExecutionScopeData.empty())
+    bool ExecutionScope::findName(const std::string& name, StringTableEntry& result) const
+    {
+        return mConfig.mCaseSensitive ? mStringTable->find(name.data(), name.size(), result) : mStringTable->findFolded(name.data(), name.size(), result);
+    }
+
+    StringTableEntry ExecutionScope::internName(const std::string& name)
+    {
+        return mConfig.mCaseSensitive ? mStringTable->getOrAssign(name) : mStringTable->getOrAssignFolded(name);
+    }
+
+    LocalSlotStack::Block::Block(const std::size_t capacity) : mSlots(capacity, StoredValue(0)), mUsed(0)
+    {
+
+    }
+
+    LocalSlotStack::LocalSlotStack() : mCurrentBlock(0)
+    {
+
+    }
+
+    StoredValue* LocalSlotStack::allocate(const std::size_t count)
+    {
+        // Enough slots for most call chains without having to allocate another block
+        const std::size_t minimumBlockSize = 1024;
+
+        if (count == 0)
         {
-            this->pushFrame(nullptr);
+            return nullptr;
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
-        auto search = currentScope.mLocalVariables.find(key);
-        if (search != currentScope.mLocalVariables.end())
+        if (!mBlocks.empty())
+        {
+            Block& currentBlock = mBlocks[mCurrentBlock];
+            if (currentBlock.mSlots.size() - currentBlock.mUsed >= count)
+            {
+                StoredValue* result = currentBlock.mSlots.data() + currentBlock.mUsed;
+                currentBlock.mUsed += count;
+                return result;
+            }
+
+            // Frames never span blocks; leave the remainder of a partially used block alone
+            if (currentBlock.mUsed != 0)
+            {
+                ++mCurrentBlock;
+            }
+        }
+
+        if (mCurrentBlock == mBlocks.size())
+        {
+            mBlocks.push_back(Block(std::max(minimumBlockSize, count)));
+        }
+        else if (mBlocks[mCurrentBlock].mSlots.size() < count)
+        {
+            // The block is empty so nothing can be referencing it
+            mBlocks[mCurrentBlock] = Block(count);
+        }
+
+        Block& currentBlock = mBlocks[mCurrentBlock];
+        currentBlock.mUsed = count;
+        return currentBlock.mSlots.data();
+    }
+
+    void LocalSlotStack::release(StoredValue* slots, const std::size_t count)
+    {
+        if (count == 0)
         {
-            search->second->setValue(variable);
             return;
         }
-        currentScope.mLocalVariables.insert(std::make_pair(key, new StoredValue(variable)));
+
+        Block& currentBlock = mBlocks[mCurrentBlock];
+        assert(slots + count == currentBlock.mSlots.data() + currentBlock.mUsed);
+
+        // Reset the slots so the next frame to use them starts out with 0
+        for (std::size_t iteration = 0; iteration < count; ++iteration)
+        {
+            slots[iteration] = StoredValue(0);
+        }
+
+        currentBlock.mUsed -= count;
+        if (currentBlock.mUsed == 0 && mCurrentBlock > 0)
+        {
+            --mCurrentBlock;
+        }
+    }
+
+    StoredValue* ExecutionScope::findLocalSlot(ExecutionScopeData& scope, const StringTableEntry name)
+    {
+        if (!scope.mLocalSlotCount)
+        {
+            return nullptr;
+        }
+
+        const std::vector<StringTableEntry>& slotNames = scope.mCurrentFunction->getLocalSlotNames();
+        for (std::size_t iteration = 0; iteration < slotNames.size(); ++iteration)
+        {
+            if (slotNames[iteration] == name)
+            {
+                return &scope.mLocalSlots[iteration];
+            }
+        }
+        return nullptr;
     }
 
     void ExecutionScope::pushFrame(Function* function)
     {
-        mExecutionScopeData.push_back(ExecutionScopeData(function));
+        // Frames are kept around once allocated so their stacks keep their capacity between calls
+        if (mFrameDepth == mExecutionScopeData.size())
+        {
+            mExecutionScopeData.push_back(std::unique_ptr<ExecutionScopeData>(new ExecutionScopeData(function)));
+        }
+
+        ExecutionScopeData& newFrame = *mExecutionScopeData[mFrameDepth];
+        ++mFrameDepth;
+
+        newFrame.mCurrentFunction = function;
+        if (function)
+        {
+            newFrame.mLocalSlotCount = function->getLocalSlotNames().size();
+            newFrame.mLocalSlots = mLocalSlotStack.allocate(newFrame.mLocalSlotCount);
+        }
     }
 
     void ExecutionScope::popFrame()
     {
-        mExecutionScopeData.pop_back();
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
+        --mFrameDepth;
+
+        mLocalSlotStack.release(currentScope.mLocalSlots, currentScope.mLocalSlotCount);
+        currentScope.mLocalSlots = nullptr;
+        currentScope.mLocalSlotCount = 0;
+
+        for (auto&& local : currentScope.mLocalVariables)
+        {
+            delete local.second;
+        }
+        currentScope.mLocalVariables.clear();
+
+        currentScope.mStack.clear();
+        currentScope.mObjectInstantiations.clear();
+        currentScope.mCurrentFunction = nullptr;
+    }
+
+    StoredValue* ExecutionScope::getLocalSlots()
+    {
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
+        return currentScope.mLocalSlots;
     }
 
     std::size_t ExecutionScope::getFrameDepth()
     {
-        return mExecutionScopeData.size();
+        return mFrameDepth;
     }
 
     Function* ExecutionScope::getCurrentFunction()
     {
-        if (mExecutionScopeData.empty())
+        if (mFrameDepth == 0)
         {
             return nullptr;
         }
 
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
         return currentScope.mCurrentFunction;
     }
 
     StoredValueStack& ExecutionScope::getStack()
     {
-        ExecutionScopeData& currentScope = *mExecutionScopeData.rbegin();
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
         return currentScope.mStack;
     }
 
     StoredValueStack& ExecutionScope::getReturnStack()
     {
-        ExecutionScopeData& currentScope = *(mExecutionScopeData.rbegin() + 1);
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 2];
         return currentScope.mStack;
     }
 
     bool ExecutionScope::isAwaitingParentInstantiation()
     {
-        ExecutionScopeData& currentScope = *(mExecutionScopeData.rbegin());
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
         return currentScope.mObjectInstantiations.size() != 0;
     }
 
     void ExecutionScope::pushObjectInstantiation(const std::string& typeName, const std::string& name)
     {
-        ExecutionScopeData& currentScope = *(mExecutionScopeData.rbegin());
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
         currentScope.mObjectInstantiations.push_back(ObjectInstantiationDescriptor(typeName, name));
     }
 
     ObjectInstantiationDescriptor ExecutionScope::popObjectInstantiation()
     {
-        ExecutionScopeData& currentScope = *(mExecutionScopeData.rbegin());
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
         ObjectInstantiationDescriptor result = currentScope.mObjectInstantiations.back();
         currentScope.mObjectInstantiations.pop_back();
         return result;
@@ -201,7 +339,7 @@ namespace TribalScript
 
     ObjectInstantiationDescriptor& ExecutionScope::currentObjectInstantiation()
     {
-        ExecutionScopeData& currentScope = *(mExecutionScopeData.rbegin());
+        ExecutionScopeData& currentScope = *mExecutionScopeData[mFrameDepth - 1];
         return currentScope.mObjectInstantiations.back();
     }
 }
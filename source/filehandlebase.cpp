@@ -28,6 +28,16 @@ namespace TribalScript
 
     }
 
+    void FileHandleBase::openForBinaryRead()
+    {
+        this->openForRead();
+    }
+
+    void FileHandleBase::openForBinaryWrite()
+    {
+        this->openForWrite();
+    }
+
     FileHandleBase::~FileHandleBase()
     {
         this->close();
@@ -12,8 +12,12 @@
  *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <cassert>
+
 #include <tribalscript/function.hpp>
-#include <tribalscript/instructions.hpp>
+#include <tribalscript/bytecode.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/executionstate.hpp>
 #include <tribalscript/stringhelpers.hpp>
 #include <tribalscript/storedvaluestack.hpp>
 
@@ -29,84 +33,52 @@ namespace TribalScript
 
     }
 
-    void Function::addInstructions(const InstructionSequence& instructions)
+    void Function::setBytecode(std::shared_ptr<Bytecode> bytecode)
     {
-        for (auto iterator = instructions.begin(); iterator != instructions.end(); ++iterator)
-        {
-            mInstructions.push_back(*iterator);
-        }
+        mBytecode = bytecode;
     }
 
-    void Function::execute(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    void Function::setLocalSlotNames(const std::vector<StringTableEntry>& names)
     {
-        StoredValueStack& stack = state->mExecutionScope.getStack();
-
-        // OPTIMIZATION: We incur a copy cost here
-        std::vector<std::string> parameterNames = mParameterNames;
+        mLocalSlotNames = names;
+    }
 
-        std::map<std::string, StoredValue> newLocals;
+    const std::vector<StringTableEntry>& Function::getLocalSlotNames()
+    {
+        return mLocalSlotNames;
+    }
 
-        // If thisObject is non-null, we always provide this as the first parameter
-        if (thisObject && !parameterNames.empty())
+    void Function::execute(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        // Check if we're at max recursion depth
+        if (state->mInterpreter->mConfig.mMaxRecursionDepth > 0 && state->mExecutionScope.getFrameDepth() >= state->mInterpreter->mConfig.mMaxRecursionDepth)
         {
-            const std::string thisParameterName = parameterNames[0];
-            parameterNames.erase(parameterNames.begin());
-
-            newLocals.emplace(std::make_pair(thisParameterName, (int)state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObjectID(state->mInterpreter, thisObject)));
+            state->mInterpreter->mConfig.mPlatform->logError("Reached maximum recursion depth! Pushing 0 and returning.");
+            state->mExecutionScope.getStack().push_back(StoredValue(0));
+            return;
         }
 
-        // Calculate expected versus provided to determine what parameters should be left empty
-        const std::size_t expectedParameterCount = parameterNames.size();
-        const std::size_t emptyParameters = expectedParameterCount > parameters.size() ? expectedParameterCount - parameters.size() : 0;
-
-        // If we have too many parameters, just remove them
-        std::size_t adjustedArgumentCount = parameters.size();
-        if (parameters.size() > expectedParameterCount)
-        {
-            const std::size_t removedParameters = parameters.size() - expectedParameterCount;
-
-            for (std::size_t iteration = 0; iteration < removedParameters; ++iteration)
-            {
-                parameters.pop_back();
-            }
-            adjustedArgumentCount -= removedParameters;
-        }
+        state->mExecutionScope.pushFrame(this);
 
-        // Once we know what parameters we're providing for, set the values
-        for (unsigned int iteration = 0; iteration < adjustedArgumentCount; ++iteration)
-        {
-            const std::string nextParameterName = parameterNames[parameterNames.size() - (iteration + emptyParameters + 1)];
-
-            auto search = newLocals.find(nextParameterName);
-            if (search != newLocals.end())
-            {
-                search->second = parameters.back().getReferencedValueCopy();
-            }
-            else
-            {
-                newLocals.insert(std::make_pair(nextParameterName, parameters.back().getReferencedValueCopy()));
-            }
-
-            parameters.pop_back();
-        }
+        // Parameters occupy the first slots, so they can be written directly. Any parameters not provided are left at 0 and
+        // any excess arguments are dropped.
+        assert(mLocalSlotNames.size() >= mParameterNames.size());
+        StoredValue* locals = state->mExecutionScope.getLocalSlots();
+        std::size_t parameterIndex = 0;
 
-        // Once we've cleared the stack, check if we're at max recursion depth
-        if (state->mInterpreter->mConfig.mMaxRecursionDepth > 0 && state->mExecutionScope.getFrameDepth() >= state->mInterpreter->mConfig.mMaxRecursionDepth)
+        // If thisObject is non-null, we always provide this as the first parameter
+        if (thisObject && !mParameterNames.empty())
         {
-            state->mInterpreter->mConfig.mPlatform->logError("Reached maximum recursion depth! Pushing 0 and returning.");
-            stack.push_back(StoredValue(0));
-            return;
+            locals[parameterIndex++] = StoredValue((int)state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObjectID(state->mInterpreter, thisObject));
         }
 
-        // Push scope once we're done dealing with locals and load in to current scope
-        state->mExecutionScope.pushFrame(this);
-        for (auto localIterator = newLocals.begin(); localIterator != newLocals.end(); ++localIterator)
+        // This is the only copy made of each argument
+        for (std::size_t argument = 0; argument < parameters.size() && parameterIndex < mParameterNames.size(); ++argument)
         {
-            auto currentLocal = *localIterator;
-            state->mExecutionScope.setVariable(currentLocal.first, currentLocal.second);
+            locals[parameterIndex++] = parameters[argument].getReferencedValueCopy();
         }
 
-        mInstructions.execute(state);
+        mBytecode->execute(state);
 
         state->mExecutionScope.popFrame();
     }
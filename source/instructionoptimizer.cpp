@@ -0,0 +1,933 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/instructions.hpp>
+#include <tribalscript/instructionoptimizer.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Retrieves the value pushed by an instruction if it pushes a constant.
+     *  @return True if the instruction pushes a constant, in which case its value is written to out.
+     */
+    static bool getConstant(Instructions::Instruction* instruction, StoredValue& out)
+    {
+        if (Instructions::PushIntegerInstruction* pushInteger = dynamic_cast<Instructions::PushIntegerInstruction*>(instruction))
+        {
+            out = StoredValue(pushInteger->getValue());
+            return true;
+        }
+        else if (Instructions::PushFloatInstruction* pushFloat = dynamic_cast<Instructions::PushFloatInstruction*>(instruction))
+        {
+            out = StoredValue(pushFloat->getValue());
+            return true;
+        }
+        else if (Instructions::PushStringInstruction* pushString = dynamic_cast<Instructions::PushStringInstruction*>(instruction))
+        {
+            out = StoredValue(pushString->getValue().c_str(), pushString->getValue().size());
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     *  @brief Retrieves the value pushed by an instruction if it pushes a numeric constant.
+     *  @return True if the instruction pushes an integer or float, in which case its value is written to out.
+     */
+    static bool getNumericConstant(Instructions::Instruction* instruction, float& out)
+    {
+        if (Instructions::PushIntegerInstruction* pushInteger = dynamic_cast<Instructions::PushIntegerInstruction*>(instruction))
+        {
+            out = StoredValue(pushInteger->getValue()).toFloat();
+            return true;
+        }
+        else if (Instructions::PushFloatInstruction* pushFloat = dynamic_cast<Instructions::PushFloatInstruction*>(instruction))
+        {
+            out = pushFloat->getValue();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     *  @brief Determines which float comparison an instruction performs.
+     *  @return True if the instruction can be fused into CompareLocalSlotJumpFalse, in which case its opcode is written to out.
+     */
+    static bool getComparison(Instructions::Instruction* instruction, OpCode& out)
+    {
+        if (dynamic_cast<Instructions::LessThanInstruction*>(instruction))
+        {
+            out = OpCode::LessThan;
+        }
+        else if (dynamic_cast<Instructions::GreaterThanInstruction*>(instruction))
+        {
+            out = OpCode::GreaterThan;
+        }
+        else if (dynamic_cast<Instructions::GreaterThanOrEqualInstruction*>(instruction))
+        {
+            out = OpCode::GreaterThanOrEqual;
+        }
+        else if (dynamic_cast<Instructions::EqualsInstruction*>(instruction))
+        {
+            out = OpCode::Equals;
+        }
+        else if (dynamic_cast<Instructions::NotEqualsInstruction*>(instruction))
+        {
+            out = OpCode::NotEquals;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     *  @brief Determines whether an instruction always pushes either 0 or 1.
+     */
+    static bool producesBoolean(Instructions::Instruction* instruction)
+    {
+        OpCode comparison;
+        return getComparison(instruction, comparison) || dynamic_cast<Instructions::StringEqualsInstruction*>(instruction) ||
+               dynamic_cast<Instructions::StringNotEqualInstruction*>(instruction) || dynamic_cast<Instructions::NotInstruction*>(instruction);
+    }
+
+    /**
+     *  @brief Determines how many values an instruction consumes if it can be folded when all of them are constant.
+     *  @return The number of operands, or 0 if the instruction can not be folded.
+     */
+    static std::size_t getFoldedOperandCount(Instructions::Instruction* instruction)
+    {
+        if (dynamic_cast<Instructions::NotInstruction*>(instruction) || dynamic_cast<Instructions::NegateInstruction*>(instruction))
+        {
+            return 1;
+        }
+
+        if (dynamic_cast<Instructions::AddInstruction*>(instruction) || dynamic_cast<Instructions::MinusInstruction*>(instruction) ||
+            dynamic_cast<Instructions::MultiplyInstruction*>(instruction) || dynamic_cast<Instructions::DivideInstruction*>(instruction) ||
+            dynamic_cast<Instructions::ModulusInstruction*>(instruction) || dynamic_cast<Instructions::LessThanInstruction*>(instruction) ||
+            dynamic_cast<Instructions::GreaterThanInstruction*>(instruction) || dynamic_cast<Instructions::GreaterThanOrEqualInstruction*>(instruction) ||
+            dynamic_cast<Instructions::EqualsInstruction*>(instruction) || dynamic_cast<Instructions::NotEqualsInstruction*>(instruction) ||
+            dynamic_cast<Instructions::StringEqualsInstruction*>(instruction) || dynamic_cast<Instructions::StringNotEqualInstruction*>(instruction) ||
+            dynamic_cast<Instructions::BitwiseAndInstruction*>(instruction) || dynamic_cast<Instructions::BitwiseOrInstruction*>(instruction) ||
+            dynamic_cast<Instructions::ConcatInstruction*>(instruction))
+        {
+            return 2;
+        }
+        return 0;
+    }
+
+    static std::shared_ptr<Instructions::Instruction> pushFloat(const float value)
+    {
+        return std::shared_ptr<Instructions::Instruction>(new Instructions::PushFloatInstruction(value));
+    }
+
+    static std::shared_ptr<Instructions::Instruction> pushInteger(const int value)
+    {
+        return std::shared_ptr<Instructions::Instruction>(new Instructions::PushIntegerInstruction(value));
+    }
+
+    /**
+     *  @brief Produces the instruction pushing the numeric result of an arithmetic operator.
+     */
+    static std::shared_ptr<Instructions::Instruction> pushNumber(const StoredValue& value)
+    {
+        return value.isInteger() ? pushInteger(value.toInteger()) : pushFloat(value.toFloat());
+    }
+
+    /**
+     *  @brief Produces the instruction pushing the result of a unary instruction applied to a constant. This mirrors
+     *  what Bytecode::execute does for the same opcode.
+     */
+    static std::shared_ptr<Instructions::Instruction> foldUnary(Instructions::Instruction* instruction, const StoredValue& operand)
+    {
+        if (dynamic_cast<Instructions::NotInstruction*>(instruction))
+        {
+            return pushInteger(!operand.toBoolean() ? 1 : 0);
+        }
+        return pushNumber(-operand);
+    }
+
+    /**
+     *  @brief Produces the instruction pushing the result of a binary instruction applied to two constants. This
+     *  mirrors what Bytecode::execute does for the same opcode.
+     *  @return The instruction to use in place of the operation, or nullptr if it must be left to runtime.
+     */
+    static std::shared_ptr<Instructions::Instruction> foldBinary(Instructions::Instruction* instruction, const StoredValue& lhs, const StoredValue& rhs)
+    {
+        if (Instructions::ConcatInstruction* concat = dynamic_cast<Instructions::ConcatInstruction*>(instruction))
+        {
+            return std::shared_ptr<Instructions::Instruction>(new Instructions::PushStringInstruction(lhs.toString() + concat->getSeperator() + rhs.toString()));
+        }
+
+        if (dynamic_cast<Instructions::AddInstruction*>(instruction))
+        {
+            return pushNumber(lhs + rhs);
+        }
+        else if (dynamic_cast<Instructions::MinusInstruction*>(instruction))
+        {
+            return pushNumber(lhs - rhs);
+        }
+        else if (dynamic_cast<Instructions::MultiplyInstruction*>(instruction))
+        {
+            return pushNumber(lhs * rhs);
+        }
+        else if (dynamic_cast<Instructions::DivideInstruction*>(instruction))
+        {
+            return pushFloat(lhs.toFloat() / rhs.toFloat());
+        }
+        else if (dynamic_cast<Instructions::ModulusInstruction*>(instruction))
+        {
+            // Leave undefined integer operations to runtime
+            const int divisor = rhs.toInteger();
+            if (divisor == 0 || divisor == -1)
+            {
+                return nullptr;
+            }
+            return pushInteger(lhs.toInteger() % divisor);
+        }
+        else if (dynamic_cast<Instructions::LessThanInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toFloat() < rhs.toFloat() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::GreaterThanInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toFloat() > rhs.toFloat() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::GreaterThanOrEqualInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toFloat() >= rhs.toFloat() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::EqualsInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toFloat() == rhs.toFloat() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::NotEqualsInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toFloat() != rhs.toFloat() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::StringEqualsInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toString() == rhs.toString() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::StringNotEqualInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toString() != rhs.toString() ? 1 : 0);
+        }
+        else if (dynamic_cast<Instructions::BitwiseAndInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toInteger() & rhs.toInteger());
+        }
+        else if (dynamic_cast<Instructions::BitwiseOrInstruction*>(instruction))
+        {
+            return pushInteger(lhs.toInteger() | rhs.toInteger());
+        }
+        return nullptr;
+    }
+
+    InstructionSequence InstructionOptimizer::optimize(const InstructionSequence& instructions)
+    {
+        std::vector<Entry> entries;
+        entries.reserve(instructions.size());
+
+        for (std::size_t iteration = 0; iteration < instructions.size(); ++iteration)
+        {
+            Entry entry;
+            entry.mJumpType = JumpType::None;
+            entry.mTarget = 0;
+            entry.mRemoved = false;
+            setInstruction(entry, instructions[iteration]);
+
+            AddressOffsetType offset = 0;
+            if (Instructions::JumpInstruction* jump = dynamic_cast<Instructions::JumpInstruction*>(entry.mInstruction.get()))
+            {
+                entry.mJumpType = JumpType::Jump;
+                offset = jump->getOffset();
+            }
+            else if (Instructions::JumpTrueInstruction* jumpTrue = dynamic_cast<Instructions::JumpTrueInstruction*>(entry.mInstruction.get()))
+            {
+                entry.mJumpType = JumpType::JumpTrue;
+                offset = jumpTrue->getOffset();
+            }
+            else if (Instructions::JumpFalseInstruction* jumpFalse = dynamic_cast<Instructions::JumpFalseInstruction*>(entry.mInstruction.get()))
+            {
+                entry.mJumpType = JumpType::JumpFalse;
+                offset = jumpFalse->getOffset();
+            }
+            else if (Instructions::JumpTrueOrPopInstruction* jumpTrueOrPop = dynamic_cast<Instructions::JumpTrueOrPopInstruction*>(entry.mInstruction.get()))
+            {
+                entry.mJumpType = JumpType::JumpTrueOrPop;
+                offset = jumpTrueOrPop->getOffset();
+            }
+            else if (Instructions::JumpFalseOrPopInstruction* jumpFalseOrPop = dynamic_cast<Instructions::JumpFalseOrPopInstruction*>(entry.mInstruction.get()))
+            {
+                entry.mJumpType = JumpType::JumpFalseOrPop;
+                offset = jumpFalseOrPop->getOffset();
+            }
+
+            if (entry.mJumpType != JumpType::None)
+            {
+                // Jumps with a zero offset or that leave the sequence end execution, same as jumping to the end
+                const AddressOffsetType target = static_cast<AddressOffsetType>(iteration) + offset;
+                const bool leavesSequence = offset == 0 || target < 0 || target >= static_cast<AddressOffsetType>(instructions.size());
+                entry.mTarget = leavesSequence ? instructions.size() : static_cast<std::size_t>(target);
+            }
+            entries.push_back(entry);
+        }
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+
+            changed |= removeNOPs(entries);
+            compact(entries);
+            changed |= foldConstants(entries);
+            compact(entries);
+            changed |= foldConcatLists(entries);
+            compact(entries);
+            changed |= foldBranches(entries);
+            compact(entries);
+            changed |= removeBooleanConversions(entries);
+            compact(entries);
+            changed |= removeUnreachable(entries);
+            compact(entries);
+            changed |= threadJumps(entries);
+            compact(entries);
+        }
+
+        fuseInstructions(entries);
+        compact(entries);
+
+        // A jump to itself is an infinite loop, but a zero offset ends execution so these need a NOP to land on
+        std::vector<std::size_t> addresses;
+        addresses.reserve(entries.size() + 1);
+
+        std::size_t address = 0;
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            const bool jumpsToItself = entries[iteration].mJumpType != JumpType::None && entries[iteration].mTarget == iteration;
+            addresses.push_back(address);
+            address += jumpsToItself ? 2 : 1;
+        }
+        addresses.push_back(address);
+
+        InstructionSequence result;
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            const Entry& entry = entries[iteration];
+            if (entry.mJumpType == JumpType::None)
+            {
+                result.push_back(entry.mInstruction);
+                continue;
+            }
+
+            // Entries jumping to themselves are placed after their NOP, which is also where jumps to them land
+            AddressOffsetType offset = static_cast<AddressOffsetType>(addresses[entry.mTarget]) - static_cast<AddressOffsetType>(addresses[iteration]);
+            if (entry.mTarget == iteration)
+            {
+                result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::NOPInstruction()));
+                offset = -1;
+            }
+
+            switch (entry.mJumpType)
+            {
+                case JumpType::Jump:
+                    result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpInstruction(offset)));
+                    break;
+                case JumpType::JumpTrue:
+                    result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpTrueInstruction(offset)));
+                    break;
+                case JumpType::JumpTrueOrPop:
+                    result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpTrueOrPopInstruction(offset)));
+                    break;
+                case JumpType::JumpFalseOrPop:
+                    result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseOrPopInstruction(offset)));
+                    break;
+                case JumpType::CompareLocalSlotJumpFalse:
+                    result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::CompareLocalSlotJumpFalseInstruction(entry.mSlot, entry.mComparison, entry.mComparedValue, offset)));
+                    break;
+                default:
+                    result.push_back(std::shared_ptr<Instructions::Instruction>(new Instructions::JumpFalseInstruction(offset)));
+                    break;
+            }
+        }
+        return result;
+    }
+
+    void InstructionOptimizer::setInstruction(Entry& entry, std::shared_ptr<Instructions::Instruction> instruction)
+    {
+        Instructions::Instruction* raw = instruction.get();
+        entry.mInstruction = instruction;
+
+        StoredValue unused(0);
+        entry.mConstant = getConstant(raw, unused);
+        entry.mFoldedOperandCount = entry.mConstant ? 0 : getFoldedOperandCount(raw);
+        entry.mNOP = !entry.mConstant && !entry.mFoldedOperandCount && dynamic_cast<Instructions::NOPInstruction*>(raw);
+        entry.mReturn = !entry.mConstant && !entry.mFoldedOperandCount && dynamic_cast<Instructions::ReturnInstruction*>(raw);
+    }
+
+    bool InstructionOptimizer::foldConstants(std::vector<Entry>& entries)
+    {
+        // Folding never changes where jumps go, so these remain valid throughout the pass
+        const std::vector<bool> targets = getJumpTargets(entries);
+        bool changed = false;
+
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            const std::size_t operandCount = entries[iteration].mJumpType == JumpType::None ? entries[iteration].mFoldedOperandCount : 0;
+            if (operandCount == 0)
+            {
+                continue;
+            }
+
+            // Find the instructions pushing each operand, which must be constants
+            std::size_t operandIndices[2];
+            StoredValue operands[2] = { StoredValue(0), StoredValue(0) };
+
+            bool constant = true;
+            std::size_t current = iteration;
+            for (std::size_t operand = 0; operand < operandCount && constant; ++operand)
+            {
+                current = getPreviousEntry(entries, current);
+                constant = current < entries.size() && entries[current].mJumpType == JumpType::None && entries[current].mConstant;
+                if (constant)
+                {
+                    getConstant(entries[current].mInstruction.get(), operands[operandCount - operand - 1]);
+                }
+                operandIndices[operand] = current;
+            }
+
+            // Anything jumping in between the operands and the operation expects part of the operands on the stack already
+            if (!constant || isJumpTargetInRange(targets, current + 1, iteration))
+            {
+                continue;
+            }
+
+            Instructions::Instruction* instruction = entries[iteration].mInstruction.get();
+            std::shared_ptr<Instructions::Instruction> folded = operandCount == 1 ? foldUnary(instruction, operands[0]) : foldBinary(instruction, operands[0], operands[1]);
+            if (!folded)
+            {
+                continue;
+            }
+
+            for (std::size_t operand = 0; operand < operandCount; ++operand)
+            {
+                entries[operandIndices[operand]].mRemoved = true;
+            }
+            setInstruction(entries[iteration], folded);
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool InstructionOptimizer::foldConcatLists(std::vector<Entry>& entries)
+    {
+        const std::vector<bool> targets = getJumpTargets(entries);
+        bool changed = false;
+
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            Instructions::ConcatListInstruction* concat = dynamic_cast<Instructions::ConcatListInstruction*>(entries[iteration].mInstruction.get());
+            if (!concat || entries[iteration].mJumpType != JumpType::None)
+            {
+                continue;
+            }
+
+            // Only the trailing values can be told apart without knowing where each value's code starts
+            const std::vector<std::string>& seperators = concat->getSeperators();
+            const std::size_t valueCount = seperators.size() + 1;
+
+            std::vector<std::size_t> constantIndices;
+            std::size_t current = iteration;
+            while (constantIndices.size() < valueCount)
+            {
+                const std::size_t previous = getPreviousEntry(entries, current);
+                if (previous >= entries.size() || entries[previous].mJumpType != JumpType::None || !entries[previous].mConstant)
+                {
+                    break;
+                }
+                constantIndices.push_back(previous);
+                current = previous;
+            }
+
+            if (constantIndices.size() < 2 || isJumpTargetInRange(targets, current + 1, iteration))
+            {
+                continue;
+            }
+
+            // constantIndices runs backwards from the last value
+            const std::size_t firstFolded = valueCount - constantIndices.size();
+            std::string folded;
+            for (std::size_t value = firstFolded; value < valueCount; ++value)
+            {
+                StoredValue constant(0);
+                getConstant(entries[constantIndices[valueCount - value - 1]].mInstruction.get(), constant);
+
+                if (value != firstFolded)
+                {
+                    folded += seperators[value - 1];
+                }
+                folded += constant.toString();
+            }
+
+            for (const std::size_t index : constantIndices)
+            {
+                entries[index].mRemoved = true;
+            }
+
+            std::shared_ptr<Instructions::Instruction> pushFolded(new Instructions::PushStringInstruction(folded));
+            if (firstFolded == 0)
+            {
+                setInstruction(entries[iteration], pushFolded);
+            }
+            else
+            {
+                entries[current].mRemoved = false;
+                setInstruction(entries[current], pushFolded);
+
+                const std::vector<std::string> remaining(seperators.begin(), seperators.begin() + firstFolded);
+                if (remaining.size() == 1)
+                {
+                    setInstruction(entries[iteration], std::shared_ptr<Instructions::Instruction>(new Instructions::ConcatInstruction(remaining[0])));
+                }
+                else
+                {
+                    setInstruction(entries[iteration], std::shared_ptr<Instructions::Instruction>(new Instructions::ConcatListInstruction(remaining)));
+                }
+            }
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool InstructionOptimizer::foldBranches(std::vector<Entry>& entries)
+    {
+        const std::vector<bool> targets = getJumpTargets(entries);
+        bool changed = false;
+
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            Entry& entry = entries[iteration];
+            if (entry.mJumpType != JumpType::JumpTrue && entry.mJumpType != JumpType::JumpFalse && !isShortCircuit(entry.mJumpType))
+            {
+                continue;
+            }
+
+            const std::size_t conditionIndex = getPreviousEntry(entries, iteration);
+            StoredValue condition(0);
+            if (conditionIndex >= entries.size() || entries[conditionIndex].mJumpType != JumpType::None || !entries[conditionIndex].mConstant)
+            {
+                continue;
+            }
+            getConstant(entries[conditionIndex].mInstruction.get(), condition);
+
+            if (isJumpTargetInRange(targets, conditionIndex + 1, iteration))
+            {
+                continue;
+            }
+
+            const bool jumpsOnTrue = entry.mJumpType == JumpType::JumpTrue || entry.mJumpType == JumpType::JumpTrueOrPop;
+            const bool taken = jumpsOnTrue == condition.toBoolean();
+            if (taken && isShortCircuit(entry.mJumpType))
+            {
+                // The condition stays on the stack as the result
+                setInstruction(entries[conditionIndex], pushInteger(jumpsOnTrue ? 1 : 0));
+                entry.mJumpType = JumpType::Jump;
+                changed = true;
+                continue;
+            }
+
+            if (taken)
+            {
+                entry.mJumpType = JumpType::Jump;
+            }
+            else
+            {
+                entry.mRemoved = true;
+            }
+            entries[conditionIndex].mRemoved = true;
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool InstructionOptimizer::removeBooleanConversions(std::vector<Entry>& entries)
+    {
+        const std::vector<bool> targets = getJumpTargets(entries);
+        bool changed = false;
+
+        for (std::size_t iteration = 0; iteration + 1 < entries.size(); ++iteration)
+        {
+            Entry& entry = entries[iteration];
+            if (!isShortCircuit(entry.mJumpType))
+            {
+                continue;
+            }
+
+            const std::size_t conditionIndex = getPreviousEntry(entries, iteration);
+            if (conditionIndex >= entries.size() || entries[conditionIndex].mJumpType != JumpType::None || !producesBoolean(entries[conditionIndex].mInstruction.get()))
+            {
+                continue;
+            }
+
+            // The conversion pushes the opposite of what the jump leaves on the stack and falls through to the same place
+            const std::size_t conversionIndex = iteration + 1;
+            const Entry& conversion = entries[conversionIndex];
+            Instructions::PushIntegerInstruction* push = conversion.mJumpType == JumpType::None ? dynamic_cast<Instructions::PushIntegerInstruction*>(conversion.mInstruction.get()) : nullptr;
+            if (!push || push->getValue() != (entry.mJumpType == JumpType::JumpFalseOrPop ? 1 : 0))
+            {
+                continue;
+            }
+
+            // The condition must be the only way to arrive at the jump
+            if (isJumpTargetInRange(targets, iteration, conversionIndex) || resolveTarget(entries, conversionIndex + 1) != resolveTarget(entries, entry.mTarget))
+            {
+                continue;
+            }
+
+            entry.mRemoved = true;
+            entries[conversionIndex].mRemoved = true;
+            iteration = conversionIndex;
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool InstructionOptimizer::threadJumps(std::vector<Entry>& entries)
+    {
+        bool changed = false;
+
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            Entry& entry = entries[iteration];
+            if (entry.mJumpType == JumpType::None)
+            {
+                continue;
+            }
+
+            const std::size_t target = resolveTarget(entries, entry.mTarget);
+            if (target != entry.mTarget)
+            {
+                entry.mTarget = target;
+                changed = true;
+            }
+
+            if (isShortCircuit(entry.mJumpType))
+            {
+                changed |= threadShortCircuit(entries, iteration);
+                continue;
+            }
+
+            // Jumps to where execution would continue anyway do nothing but pop their condition
+            if (target != iteration && resolveTarget(entries, iteration + 1) == target)
+            {
+                if (entry.mJumpType == JumpType::Jump)
+                {
+                    entry.mRemoved = true;
+                }
+                else
+                {
+                    entry.mJumpType = JumpType::None;
+                    setInstruction(entry, std::shared_ptr<Instructions::Instruction>(new Instructions::PopInstruction()));
+                }
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool InstructionOptimizer::removeUnreachable(std::vector<Entry>& entries)
+    {
+        std::vector<bool> reachable(entries.size(), false);
+        std::vector<std::size_t> pending;
+
+        if (!entries.empty())
+        {
+            pending.push_back(0);
+        }
+
+        while (!pending.empty())
+        {
+            const std::size_t current = pending.back();
+            pending.pop_back();
+
+            if (current >= entries.size() || reachable[current])
+            {
+                continue;
+            }
+            reachable[current] = true;
+
+            const Entry& entry = entries[current];
+            if (entry.mJumpType != JumpType::None)
+            {
+                pending.push_back(entry.mTarget);
+            }
+
+            const bool fallsThrough = entry.mJumpType == JumpType::None ? !entry.mReturn : entry.mJumpType != JumpType::Jump;
+            if (fallsThrough)
+            {
+                pending.push_back(current + 1);
+            }
+        }
+
+        bool changed = false;
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            if (!reachable[iteration])
+            {
+                entries[iteration].mRemoved = true;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool InstructionOptimizer::removeNOPs(std::vector<Entry>& entries)
+    {
+        bool changed = false;
+        for (Entry& entry : entries)
+        {
+            if (entry.mJumpType == JumpType::None && entry.mNOP)
+            {
+                entry.mRemoved = true;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    void InstructionOptimizer::fuseInstructions(std::vector<Entry>& entries)
+    {
+        const std::vector<bool> targets = getJumpTargets(entries);
+
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            Entry& entry = entries[iteration];
+            Instructions::PushLocalSlotInstruction* pushSlot = entry.mJumpType == JumpType::None ? dynamic_cast<Instructions::PushLocalSlotInstruction*>(entry.mInstruction.get()) : nullptr;
+            if (!pushSlot)
+            {
+                continue;
+            }
+
+            // Only the first instruction of a fused sequence may be jumped to
+            const std::size_t remaining = entries.size() - iteration - 1;
+            const std::size_t slot = pushSlot->getSlot();
+
+            Instructions::SubReferenceInstruction* subReference = remaining >= 1 && entries[iteration + 1].mJumpType == JumpType::None ? dynamic_cast<Instructions::SubReferenceInstruction*>(entries[iteration + 1].mInstruction.get()) : nullptr;
+            if (subReference && subReference->getArrayIndexCount() == 0 && !targets[iteration + 1])
+            {
+                setInstruction(entry, std::shared_ptr<Instructions::Instruction>(new Instructions::PushLocalSlotFieldInstruction(slot, subReference->getStringID())));
+                entries[iteration + 1].mRemoved = true;
+                iteration += 1;
+                continue;
+            }
+
+            float value;
+            if (remaining < 3 || isJumpTargetInRange(targets, iteration + 1, iteration + 3) || entries[iteration + 1].mJumpType != JumpType::None ||
+                entries[iteration + 2].mJumpType != JumpType::None || !getNumericConstant(entries[iteration + 1].mInstruction.get(), value))
+            {
+                continue;
+            }
+
+            Instructions::Instruction* operation = entries[iteration + 2].mInstruction.get();
+            const Entry& last = entries[iteration + 3];
+
+            OpCode comparison;
+            Instructions::PushIntegerInstruction* pushAmount = dynamic_cast<Instructions::PushIntegerInstruction*>(entries[iteration + 1].mInstruction.get());
+            if (pushAmount && last.mJumpType == JumpType::None && dynamic_cast<Instructions::AddAssignmentInstruction*>(operation) && dynamic_cast<Instructions::PopInstruction*>(last.mInstruction.get()))
+            {
+                setInstruction(entry, std::shared_ptr<Instructions::Instruction>(new Instructions::IncrementLocalSlotInstruction(slot, pushAmount->getValue())));
+            }
+            else if (last.mJumpType == JumpType::JumpFalse && getComparison(operation, comparison))
+            {
+                entry.mJumpType = JumpType::CompareLocalSlotJumpFalse;
+                entry.mTarget = last.mTarget;
+                entry.mSlot = slot;
+                entry.mComparison = comparison;
+                entry.mComparedValue = value;
+            }
+            else
+            {
+                continue;
+            }
+
+            entries[iteration + 1].mRemoved = true;
+            entries[iteration + 2].mRemoved = true;
+            entries[iteration + 3].mRemoved = true;
+            iteration += 3;
+        }
+    }
+
+    void InstructionOptimizer::compact(std::vector<Entry>& entries)
+    {
+        // Map every index, including the end of the sequence, to the index of the next entry that remains
+        std::vector<std::size_t> newIndices(entries.size() + 1);
+
+        std::size_t liveCount = 0;
+        for (std::size_t iteration = 0; iteration < entries.size(); ++iteration)
+        {
+            newIndices[iteration] = liveCount;
+            if (!entries[iteration].mRemoved)
+            {
+                ++liveCount;
+            }
+        }
+        newIndices[entries.size()] = liveCount;
+
+        if (liveCount == entries.size())
+        {
+            return;
+        }
+
+        std::vector<Entry> result;
+        result.reserve(liveCount);
+        for (Entry& entry : entries)
+        {
+            if (entry.mRemoved)
+            {
+                continue;
+            }
+
+            if (entry.mJumpType != JumpType::None)
+            {
+                entry.mTarget = newIndices[entry.mTarget];
+            }
+            result.push_back(entry);
+        }
+        entries.swap(result);
+    }
+
+    bool InstructionOptimizer::threadShortCircuit(std::vector<Entry>& entries, const std::size_t index)
+    {
+        Entry& entry = entries[index];
+        if (entry.mTarget >= entries.size() || entry.mTarget == index)
+        {
+            return false;
+        }
+
+        // The value left on the stack when the jump is taken
+        const bool kept = entry.mJumpType == JumpType::JumpTrueOrPop;
+        const JumpType popping = kept ? JumpType::JumpTrue : JumpType::JumpFalse;
+
+        const Entry& landing = entries[entry.mTarget];
+        JumpType jumpType;
+        std::size_t target;
+
+        if (landing.mJumpType == JumpType::None && dynamic_cast<Instructions::PopInstruction*>(landing.mInstruction.get()))
+        {
+            // The kept value is discarded straight away
+            jumpType = popping;
+            target = entry.mTarget + 1;
+        }
+        else if (landing.mJumpType == JumpType::JumpTrue || landing.mJumpType == JumpType::JumpFalse || isShortCircuit(landing.mJumpType))
+        {
+            const bool landingJumpsOnTrue = landing.mJumpType == JumpType::JumpTrue || landing.mJumpType == JumpType::JumpTrueOrPop;
+            if (landingJumpsOnTrue == kept)
+            {
+                jumpType = isShortCircuit(landing.mJumpType) ? entry.mJumpType : popping;
+                target = landing.mTarget;
+            }
+            else
+            {
+                jumpType = popping;
+                target = entry.mTarget + 1;
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        if (jumpType == entry.mJumpType && target == entry.mTarget)
+        {
+            return false;
+        }
+        entry.mJumpType = jumpType;
+        entry.mTarget = target;
+        return true;
+    }
+
+    bool InstructionOptimizer::isShortCircuit(const JumpType type)
+    {
+        return type == JumpType::JumpTrueOrPop || type == JumpType::JumpFalseOrPop;
+    }
+
+    std::vector<bool> InstructionOptimizer::getJumpTargets(const std::vector<Entry>& entries)
+    {
+        std::vector<bool> result(entries.size() + 1, false);
+        for (const Entry& entry : entries)
+        {
+            if (entry.mJumpType != JumpType::None)
+            {
+                result[entry.mTarget] = true;
+            }
+        }
+        return result;
+    }
+
+    bool InstructionOptimizer::isJumpTargetInRange(const std::vector<bool>& targets, const std::size_t first, const std::size_t last)
+    {
+        for (std::size_t current = first; current <= last; ++current)
+        {
+            if (targets[current])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t InstructionOptimizer::getPreviousEntry(const std::vector<Entry>& entries, const std::size_t index)
+    {
+        for (std::size_t current = index; current > 0; --current)
+        {
+            if (!entries[current - 1].mRemoved)
+            {
+                return current - 1;
+            }
+        }
+        return entries.size();
+    }
+
+    std::size_t InstructionOptimizer::resolveTarget(const std::vector<Entry>& entries, std::size_t index)
+    {
+        const std::size_t start = index;
+
+        // Jump cycles are infinite loops, so they are left alone
+        for (std::size_t steps = 0; index < entries.size(); ++steps)
+        {
+            if (steps > entries.size())
+            {
+                return start;
+            }
+
+            const Entry& entry = entries[index];
+            if (entry.mRemoved || (entry.mJumpType == JumpType::None && entry.mNOP))
+            {
+                ++index;
+            }
+            else if (entry.mJumpType == JumpType::Jump && entry.mTarget != index)
+            {
+                index = entry.mTarget;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return index;
+    }
+}
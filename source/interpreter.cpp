@@ -27,10 +27,17 @@ namespace TribalScript
 
     }
 
-    Interpreter::Interpreter(const InterpreterConfiguration& config) : mConfig(config)
+    Interpreter::Interpreter(const InterpreterConfiguration& config) : mConfig(config),
+                                                                       mConsoleObjectDescriptors(0, ConfigurableCaseHash(config.mCaseSensitive), ConfigurableCaseEqual(config.mCaseSensitive)),
+                                                                       mFunctionGeneration(1), mActiveExecutions(0)
     {
         mCompiler = new Compiler(mConfig);
 
+        if (mConfig.mProfile)
+        {
+            mProfiler.reset(new Profiler());
+        }
+
         // "" is the default top-level
         this->addFunctionRegistry(PACKAGE_EMPTY);
         this->activateFunctionRegistry(PACKAGE_EMPTY);
@@ -94,50 +101,40 @@ namespace TribalScript
 
     StoredValue* Interpreter::getGlobal(const std::string& name)
     {
-        const StringTableEntry stringID = mStringTable.getOrAssign(mConfig.mCaseSensitive ? name : toLowerCase(name));
-        auto search = mGlobalVariables.find(stringID);
-        if (search != mGlobalVariables.end())
-        {
-            return search->second;
-        }
-        return nullptr;
+        // Names that were never interned cannot refer to a global, so there is no need to intern them
+        StringTableEntry stringID;
+        const bool found = mConfig.mCaseSensitive ? mStringTable.find(name.data(), name.size(), stringID) : mStringTable.findFolded(name.data(), name.size(), stringID);
+        return found ? this->getGlobal(stringID) : nullptr;
     }
 
     StoredValue* Interpreter::getGlobal(const StringTableEntry name)
     {
-        auto search = mGlobalVariables.find(name);
-        if (search != mGlobalVariables.end())
+        if (name < mGlobalVariables.size())
         {
-            return search->second;
+            return mGlobalVariables[name];
         }
         return nullptr;
     }
 
     StoredValue* Interpreter::getGlobalOrAllocate(const StringTableEntry name)
     {
-        auto search = mGlobalVariables.find(name);
-        if (search != mGlobalVariables.end())
+        if (name >= mGlobalVariables.size())
         {
-            return search->second;
+            mGlobalVariables.resize(mStringTable.size(), nullptr);
         }
 
-        StoredValue* newValue = new StoredValue(0);
-        mGlobalVariables.insert(std::make_pair(name, newValue));
-        return newValue;
+        StoredValue*& result = mGlobalVariables[name];
+        if (!result)
+        {
+            result = new StoredValue(0);
+        }
+        return result;
     }
 
     StoredValue* Interpreter::getGlobalOrAllocate(const std::string& name)
     {
-        const StringTableEntry stringEntry = mStringTable.getOrAssign(mConfig.mCaseSensitive ? name : toLowerCase(name));
-        auto search = mGlobalVariables.find(stringEntry);
-        if (search != mGlobalVariables.end())
-        {
-            return search->second;
-        }
-
-        StoredValue* newValue = new StoredValue(0);
-        mGlobalVariables.insert(std::make_pair(stringEntry, newValue));
-        return newValue;
+        const StringTableEntry stringEntry = mConfig.mCaseSensitive ? mStringTable.getOrAssign(name) : mStringTable.getOrAssignFolded(name);
+        return this->getGlobalOrAllocate(stringEntry);
     }
 
     void Interpreter::addFunction(std::shared_ptr<Function> function)
@@ -147,27 +144,47 @@ namespace TribalScript
         this->addFunctionRegistry(package);
         FunctionRegistry* registry = this->findFunctionRegistry(package);
 
-        const std::string storedName = toLowerCase(function->getDeclaredName());
-        const std::string storedNameSpace = toLowerCase(function->getDeclaredNameSpace());
-        registry->mFunctions[storedNameSpace][storedName] = function;
+        std::shared_ptr<Function>& storedFunction = registry->mFunctions[function->getDeclaredNameSpace()][function->getDeclaredName()];
+        if (storedFunction)
+        {
+            mRetiredFunctions.push_back(storedFunction);
+        }
+        storedFunction = function;
+
+        ++mFunctionGeneration;
+        this->releaseRetiredFunctions();
+    }
+
+    void Interpreter::exitExecution()
+    {
+        assert(mActiveExecutions > 0);
+        if (--mActiveExecutions == 0 && !mRetiredFunctions.empty())
+        {
+            this->releaseRetiredFunctions();
+        }
+    }
+
+    void Interpreter::releaseRetiredFunctions()
+    {
+        if (mActiveExecutions == 0 && !mProfiler)
+        {
+            mRetiredFunctions.clear();
+        }
     }
 
     std::shared_ptr<Function> Interpreter::getFunction(const std::string& space, const std::string& name)
     {
         // Search registries back to front
-        const std::string searchedName = toLowerCase(name);
-        const std::string searchedNameSpace = toLowerCase(space);
-
         for (auto iterator = mFunctionRegistries.rbegin(); iterator != mFunctionRegistries.rend(); ++iterator)
         {
             FunctionRegistry& registry = *iterator;
 
             if (registry.mActive)
             {
-                auto namespaceSearch = registry.mFunctions.find(searchedNameSpace);
+                auto namespaceSearch = registry.mFunctions.find(space);
                 if (namespaceSearch != registry.mFunctions.end())
                 {
-                    auto nameSearch = namespaceSearch->second.find(searchedName);
+                    auto nameSearch = namespaceSearch->second.find(name);
                     if (nameSearch != namespaceSearch->second.end())
                     {
                         return nameSearch->second;
@@ -181,9 +198,9 @@ namespace TribalScript
 
     std::shared_ptr<Function> Interpreter::getFunctionParent(Function* function)
     {
-        const std::string searchedPackage = toLowerCase(function->getDeclaredPackage());
-        const std::string searchedNameSpace = toLowerCase(function->getDeclaredNameSpace());
-        const std::string searchedFunction = toLowerCase(function->getDeclaredName());
+        const std::string& searchedPackage = function->getDeclaredPackage();
+        const std::string& searchedNameSpace = function->getDeclaredNameSpace();
+        const std::string& searchedFunction = function->getDeclaredName();
 
         // Search registries back to front
         bool shouldSearchFunction = false;
@@ -197,7 +214,7 @@ namespace TribalScript
             }
             else if (!shouldSearchFunction)
             {
-                if (registry.mActive && registry.mPackageName == searchedPackage)
+                if (registry.mActive && equalsCaseInsensitive(registry.mPackageName, searchedPackage))
                 {
                     shouldSearchFunction = true;
                 }
@@ -218,38 +235,73 @@ namespace TribalScript
         return nullptr;
     }
 
-    void Interpreter::setGlobal(const std::string& name, StoredValue value)
+    Function* Interpreter::getBoundFunction(ConsoleObjectDescriptor* descriptor, const std::string& name)
     {
-        const StringTableEntry key = mStringTable.getOrAssign(mConfig.mCaseSensitive ? name : toLowerCase(name));
+        if (descriptor->mMethodTableGeneration != mFunctionGeneration)
+        {
+            descriptor->mMethodTable.clear();
+            descriptor->mMethodTableGeneration = mFunctionGeneration;
+
+            // Derived types take precedence over their parents, and within a type later registries take precedence
+            for (const std::string& className : descriptor->mHierarchy)
+            {
+                for (auto iterator = mFunctionRegistries.rbegin(); iterator != mFunctionRegistries.rend(); ++iterator)
+                {
+                    FunctionRegistry& registry = *iterator;
+                    if (!registry.mActive)
+                    {
+                        continue;
+                    }
 
-        auto search = mGlobalVariables.find(key);
-        if (search != mGlobalVariables.end())
+                    auto namespaceSearch = registry.mFunctions.find(className);
+                    if (namespaceSearch != registry.mFunctions.end())
+                    {
+                        for (auto&& function : namespaceSearch->second)
+                        {
+                            descriptor->mMethodTable.emplace(function.first, function.second.get());
+                        }
+                    }
+                }
+            }
+        }
+
+        auto search = descriptor->mMethodTable.find(name);
+        if (search != descriptor->mMethodTable.end())
         {
-            search->second->setValue(value);
-            return;
+            return search->second;
         }
+        return nullptr;
+    }
 
-        mGlobalVariables.emplace(std::make_pair(key, new StoredValue(value)));
+    void Interpreter::setGlobal(const std::string& name, StoredValue value)
+    {
+        const StringTableEntry key = mConfig.mCaseSensitive ? mStringTable.getOrAssign(name) : mStringTable.getOrAssignFolded(name);
+        this->setGlobal(key, value);
     }
 
     void Interpreter::setGlobal(const StringTableEntry name, StoredValue value)
     {
-        auto search = mGlobalVariables.find(name);
-        if (search != mGlobalVariables.end())
+        if (name >= mGlobalVariables.size())
+        {
+            mGlobalVariables.resize(mStringTable.size(), nullptr);
+        }
+
+        StoredValue*& global = mGlobalVariables[name];
+        if (global)
         {
-            search->second->setValue(value);
+            global->setValue(value);
             return;
         }
 
-        mGlobalVariables.emplace(std::make_pair(name, new StoredValue(value)));
+        // New globals take the value as is, which allows binding them to memory locations
+        global = new StoredValue(value);
     }
 
     FunctionRegistry* Interpreter::findFunctionRegistry(const std::string& packageName)
     {
-        std::string searchedName = toLowerCase(packageName);
         for (FunctionRegistry& registry : mFunctionRegistries)
         {
-            if (registry.mPackageName == searchedName)
+            if (equalsCaseInsensitive(registry.mPackageName, packageName))
             {
                 return &registry;
             }
@@ -262,14 +314,23 @@ namespace TribalScript
         // We cannot remove root level
         assert(packageName != PACKAGE_EMPTY);
 
-        std::string removedName = toLowerCase(packageName);
         for (auto iterator = mFunctionRegistries.begin(); iterator != mFunctionRegistries.end(); ++iterator)
         {
             FunctionRegistry& registry = *iterator;
 
-            if (registry.mPackageName == packageName)
+            if (equalsCaseInsensitive(registry.mPackageName, packageName))
             {
+                for (auto&& nameSpace : registry.mFunctions)
+                {
+                    for (auto&& function : nameSpace.second)
+                    {
+                        mRetiredFunctions.push_back(function.second);
+                    }
+                }
+
                 mFunctionRegistries.erase(iterator);
+                ++mFunctionGeneration;
+                this->releaseRetiredFunctions();
                 return;
             }
         }
@@ -277,7 +338,6 @@ namespace TribalScript
 
     void Interpreter::addFunctionRegistry(const std::string& packageName)
     {
-        std::string addedName = toLowerCase(packageName);
         if (this->findFunctionRegistry(packageName))
         {
             return;
@@ -288,19 +348,18 @@ namespace TribalScript
 
     void Interpreter::activateFunctionRegistry(const std::string& packageName)
     {
-        std::string activatedName = toLowerCase(packageName);
-
         // When we activate a package, it gets moved to the back to take precedence in the stack
         for (auto iterator = mFunctionRegistries.begin(); iterator != mFunctionRegistries.end(); ++iterator)
         {
             FunctionRegistry& registry = *iterator;
 
-            if (registry.mPackageName == packageName)
+            if (equalsCaseInsensitive(registry.mPackageName, packageName))
             {
                 if (!registry.mActive)
                 {
                     registry.mActive = true;
                     std::rotate(iterator, iterator + 1, mFunctionRegistries.end());
+                    ++mFunctionGeneration;
                 }
 
                 return;
@@ -310,19 +369,21 @@ namespace TribalScript
 
     void Interpreter::deactivateFunctionRegistry(const std::string& packageName)
     {
-        std::string deactivatedName = toLowerCase(packageName);
-
-        FunctionRegistry* deactivated = this->findFunctionRegistry(deactivatedName);
+        FunctionRegistry* deactivated = this->findFunctionRegistry(packageName);
         if (!deactivated)
         {
             return;
         }
 
         deactivated->mActive = false;
+        ++mFunctionGeneration;
     }
 
     void Interpreter::relinkNamespaces()
     {
+        // Hierarchies determine which functions may be called on objects
+        ++mFunctionGeneration;
+
         for (auto&& entry : mConsoleObjectDescriptors)
         {
             // Reset the hierarchy of this namespace
@@ -333,9 +394,7 @@ namespace TribalScript
 
     ConsoleObjectDescriptor* Interpreter::lookupDescriptor(const std::string& objectTypeName)
     {
-        const std::string chosenTypeName = mConfig.mCaseSensitive ? objectTypeName : toLowerCase(objectTypeName);
-
-        auto lookup = mConsoleObjectDescriptors.find(chosenTypeName);
+        auto lookup = mConsoleObjectDescriptors.find(objectTypeName);
 
         if (lookup != mConsoleObjectDescriptors.end())
         {
@@ -344,7 +403,7 @@ namespace TribalScript
         return nullptr;
     }
 
-    std::unordered_map<std::string, ConsoleObjectDescriptor*>& Interpreter::getConsoleObjectDescriptors()
+    ConfigurableCaseMap<ConsoleObjectDescriptor*>& Interpreter::getConsoleObjectDescriptors()
     {
         return mConsoleObjectDescriptors;
     }
@@ -366,7 +425,7 @@ namespace TribalScript
 
         // ConsoleObject won't have an entry
         // FIXME: Is there a more appropriate way to handle this?
-        if (toLowerCase(currentDescriptor->mParentName) == "consoleobject")
+        if (equalsCaseInsensitive(currentDescriptor->mParentName, "consoleobject"))
         {
             return result;
         }
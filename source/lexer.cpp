@@ -0,0 +1,361 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <sstream>
+
+#include <tribalscript/lexer.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Maps the text of a fixed token, such as an operator or keyword, to its token type.
+     */
+    struct OperatorDescriptor
+    {
+        //! The text of the token.
+        const char* mText;
+
+        //! The type of token produced for the text.
+        TokenType mType;
+    };
+
+    //! All operators and punctuation, longest first so that the first match is also the longest match.
+    static const OperatorDescriptor sOperators[] = {
+        { "!$=", TokenType::StringNotEqual },
+        { "$=", TokenType::StringEquals },
+        { "::", TokenType::DoubleColon },
+        { "++", TokenType::Increment },
+        { "--", TokenType::Decrement },
+        { "+=", TokenType::PlusAssign },
+        { "-=", TokenType::MinusAssign },
+        { "*=", TokenType::MultiplyAssign },
+        { "/=", TokenType::DivideAssign },
+        { "|=", TokenType::OrAssign },
+        { "&=", TokenType::AndAssign },
+        { "%=", TokenType::ModulusAssign },
+        { "<=", TokenType::LessThanOrEqual },
+        { ">=", TokenType::GreaterThanOrEqual },
+        { "==", TokenType::Equals },
+        { "!=", TokenType::NotEqual },
+        { "&&", TokenType::LogicalAnd },
+        { "||", TokenType::LogicalOr },
+        { "<<", TokenType::LeftBitShift },
+        { ">>", TokenType::RightBitShift },
+        { "(", TokenType::LeftParenthesis },
+        { ")", TokenType::RightParenthesis },
+        { "{", TokenType::LeftBrace },
+        { "}", TokenType::RightBrace },
+        { "[", TokenType::LeftBracket },
+        { "]", TokenType::RightBracket },
+        { ";", TokenType::Semicolon },
+        { ",", TokenType::Comma },
+        { ":", TokenType::Colon },
+        { ".", TokenType::Dot },
+        { "?", TokenType::Question },
+        { "$", TokenType::Dollar },
+        { "+", TokenType::Plus },
+        { "-", TokenType::Minus },
+        { "*", TokenType::Multiply },
+        { "/", TokenType::Divide },
+        { "%", TokenType::Modulus },
+        { "=", TokenType::Assign },
+        { "<", TokenType::LessThan },
+        { ">", TokenType::GreaterThan },
+        { "!", TokenType::Not },
+        { "~", TokenType::Tilde },
+        { "@", TokenType::Concat },
+        { "^", TokenType::BitwiseXor },
+        { "&", TokenType::BitwiseAnd },
+        { "|", TokenType::BitwiseOr }
+    };
+
+    //! Keywords are case sensitive, just like the literal tokens in the grammar.
+    static const OperatorDescriptor sKeywords[] = {
+        { "datablock", TokenType::KeywordDatablock },
+        { "package", TokenType::KeywordPackage },
+        { "function", TokenType::KeywordFunction },
+        { "if", TokenType::KeywordIf },
+        { "else", TokenType::KeywordElse },
+        { "switch", TokenType::KeywordSwitch },
+        { "case", TokenType::KeywordCase },
+        { "return", TokenType::KeywordReturn },
+        { "break", TokenType::KeywordBreak },
+        { "continue", TokenType::KeywordContinue },
+        { "new", TokenType::KeywordNew },
+        { "while", TokenType::KeywordWhile },
+        { "for", TokenType::KeywordFor },
+        { "true", TokenType::KeywordTrue },
+        { "false", TokenType::KeywordFalse },
+        { "default", TokenType::KeywordDefault },
+        { "or", TokenType::KeywordOr },
+        { "SPC", TokenType::KeywordSpaceConcat },
+        { "TAB", TokenType::KeywordTabConcat },
+        { "NL", TokenType::KeywordNewlineConcat }
+    };
+
+    static bool isDigit(const char character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    static bool isHexDigit(const char character)
+    {
+        return isDigit(character) || (character >= 'a' && character <= 'f') || (character >= 'A' && character <= 'F');
+    }
+
+    static bool isLabelStart(const char character)
+    {
+        return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') || character == '_';
+    }
+
+    static bool isLabelCharacter(const char character)
+    {
+        return isLabelStart(character) || isDigit(character);
+    }
+
+    static bool isEscapeCharacter(const char character)
+    {
+        return (isLabelCharacter(character) && character != '_') || (character != 0x00 && std::strchr("|{}\"'\\", character) != nullptr);
+    }
+
+    Lexer::Lexer(const AST::StringView& input) : mInput(input), mPosition(0), mLine(1), mLineStart(0)
+    {
+
+    }
+
+    std::vector<Token> Lexer::tokenize()
+    {
+        std::vector<Token> tokens;
+
+        const std::size_t inputLength = mInput.size();
+        while (mPosition < inputLength)
+        {
+            const char character = mInput[mPosition];
+
+            // Skip whitespace
+            if (character == ' ' || character == '\t' || character == '\r')
+            {
+                ++mPosition;
+                continue;
+            }
+            else if (character == '\n')
+            {
+                ++mPosition;
+                ++mLine;
+                mLineStart = mPosition;
+                continue;
+            }
+
+            // Skip line comments
+            if (character == '/' && mPosition + 1 < inputLength && mInput[mPosition + 1] == '/')
+            {
+                while (mPosition < inputLength && mInput[mPosition] != '\n' && mInput[mPosition] != '\r')
+                {
+                    ++mPosition;
+                }
+                continue;
+            }
+
+            if (isDigit(character))
+            {
+                if (!this->lexNumber(tokens))
+                {
+                    break;
+                }
+            }
+            else if (character == '"' || character == '\'')
+            {
+                if (!this->lexString(tokens, character))
+                {
+                    break;
+                }
+            }
+            else if (isLabelStart(character))
+            {
+                this->lexIdentifier(tokens);
+            }
+            else if (!this->lexOperator(tokens))
+            {
+                std::ostringstream message;
+                message << "token recognition error at: '" << character << "'";
+                this->addError(message.str());
+                ++mPosition;
+            }
+        }
+
+        tokens.emplace_back(TokenType::EndOfFile, "<EOF>", mLine, mPosition - mLineStart);
+        return tokens;
+    }
+
+    const std::vector<std::string>& Lexer::getErrors()
+    {
+        return mErrors;
+    }
+
+    bool Lexer::lexNumber(std::vector<Token>& tokens)
+    {
+        const std::size_t start = mPosition;
+        const std::size_t inputLength = mInput.size();
+
+        // Hex integers
+        if (mInput[mPosition] == '0' && mPosition + 2 < inputLength && mInput[mPosition + 1] == 'x' && isHexDigit(mInput[mPosition + 2]))
+        {
+            mPosition += 2;
+            while (mPosition < inputLength && isHexDigit(mInput[mPosition]))
+            {
+                ++mPosition;
+            }
+
+            tokens.emplace_back(TokenType::HexIntegerLiteral, mInput.substr(start, mPosition - start), mLine, start - mLineStart);
+            return true;
+        }
+
+        while (mPosition < inputLength && isDigit(mInput[mPosition]))
+        {
+            ++mPosition;
+        }
+
+        bool isFloat = false;
+
+        // Decimal component
+        if (mPosition + 1 < inputLength && mInput[mPosition] == '.' && isDigit(mInput[mPosition + 1]))
+        {
+            isFloat = true;
+            ++mPosition;
+            while (mPosition < inputLength && isDigit(mInput[mPosition]))
+            {
+                ++mPosition;
+            }
+        }
+
+        // Exponent is only consumed if it is well formed
+        if (mPosition < inputLength && (mInput[mPosition] == 'e' || mInput[mPosition] == 'E'))
+        {
+            std::size_t exponentEnd = mPosition + 1;
+            if (exponentEnd < inputLength && (mInput[exponentEnd] == '+' || mInput[exponentEnd] == '-'))
+            {
+                ++exponentEnd;
+            }
+
+            if (exponentEnd < inputLength && isDigit(mInput[exponentEnd]))
+            {
+                while (exponentEnd < inputLength && isDigit(mInput[exponentEnd]))
+                {
+                    ++exponentEnd;
+                }
+
+                isFloat = true;
+                mPosition = exponentEnd;
+            }
+        }
+
+        tokens.emplace_back(isFloat ? TokenType::FloatLiteral : TokenType::IntegerLiteral, mInput.substr(start, mPosition - start), mLine, start - mLineStart);
+        return true;
+    }
+
+    bool Lexer::lexString(std::vector<Token>& tokens, const char terminator)
+    {
+        const std::size_t start = mPosition;
+        const std::size_t startLine = mLine;
+        const std::size_t startColumn = mPosition - mLineStart;
+        const std::size_t inputLength = mInput.size();
+
+        ++mPosition;
+        while (mPosition < inputLength)
+        {
+            const char character = mInput[mPosition];
+
+            if (character == terminator)
+            {
+                ++mPosition;
+                tokens.emplace_back(terminator == '"' ? TokenType::StringLiteral : TokenType::TaggedStringLiteral, mInput.substr(start, mPosition - start), startLine, startColumn);
+                return true;
+            }
+            else if (character == '\\')
+            {
+                if (mPosition + 1 >= inputLength || !isEscapeCharacter(mInput[mPosition + 1]))
+                {
+                    std::ostringstream message;
+                    message << "token recognition error at: '" << mInput.substr(start, mPosition - start + 2).toString() << "'";
+                    this->addError(message.str());
+                    return false;
+                }
+
+                mPosition += 2;
+            }
+            else
+            {
+                if (character == '\n')
+                {
+                    ++mLine;
+                    mLineStart = mPosition + 1;
+                }
+                ++mPosition;
+            }
+        }
+
+        std::ostringstream message;
+        message << "token recognition error at: '" << mInput.substr(start).toString() << "'";
+        this->addError(message.str());
+        return false;
+    }
+
+    void Lexer::lexIdentifier(std::vector<Token>& tokens)
+    {
+        const std::size_t start = mPosition;
+        const std::size_t inputLength = mInput.size();
+
+        while (mPosition < inputLength && isLabelCharacter(mInput[mPosition]))
+        {
+            ++mPosition;
+        }
+
+        const std::size_t length = mPosition - start;
+        TokenType type = TokenType::Label;
+        for (const OperatorDescriptor& keyword : sKeywords)
+        {
+            if (std::strlen(keyword.mText) == length && mInput.matches(start, keyword.mText, length))
+            {
+                type = keyword.mType;
+                break;
+            }
+        }
+
+        tokens.emplace_back(type, mInput.substr(start, length), mLine, start - mLineStart);
+    }
+
+    bool Lexer::lexOperator(std::vector<Token>& tokens)
+    {
+        for (const OperatorDescriptor& descriptor : sOperators)
+        {
+            const std::size_t length = std::strlen(descriptor.mText);
+            if (mInput.matches(mPosition, descriptor.mText, length))
+            {
+                tokens.emplace_back(descriptor.mType, descriptor.mText, mLine, mPosition - mLineStart);
+                mPosition += length;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Lexer::addError(const std::string& message)
+    {
+        std::ostringstream out;
+        out << "Syntax Error on Line " << mLine << " Character " << mPosition - mLineStart << std::endl;
+        out << message << std::endl;
+        mErrors.push_back(out.str());
+    }
+}
@@ -14,31 +14,28 @@
 
 #include <assert.h>
 #include <chrono>
+#include <sstream>
 
 #include <tribalscript/libraries/core.hpp>
 
 namespace TribalScript
 {
-    StoredValue EchoBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue EchoBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
         std::string outputString = "";
 
-        for (unsigned int iteration = 0; iteration < parameters.size(); ++iteration)
+        for (const StoredValue& parameter : parameters)
         {
-            // Parameters will flow right to left so we build the string considering this
-            std::string printedPayload = parameters.back().toString();
-            parameters.pop_back();
-
-            outputString = printedPayload + outputString;
+            outputString += parameter.toString();
         }
 
         state->mInterpreter->mConfig.mPlatform->logEcho(outputString);
         return StoredValue(0);
     }
 
-    StoredValue GetRealTimeBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetRealTimeBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -54,7 +51,7 @@ namespace TribalScript
     typedef std::chrono::duration<float, std::milli> millisecondFloat;
     static std::vector<millisecondFloat> sPrecisionTimers;
     static std::vector<size_t> sAvailablePrecisionTimerIndices;
-    StoredValue StartPrecisionTimerBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue StartPrecisionTimerBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         // Retrieve a previously used index first, if available
         bool newPrecisionTimer = true;
@@ -81,9 +78,17 @@ namespace TribalScript
         return StoredValue((int)nextIndex);
     }
 
-    StoredValue StopPrecisionTimerBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue StopPrecisionTimerBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
-        int precisionTimerID = parameters[0].toInteger();
+        const int precisionTimerID = parameters[0].toInteger();
+        if (precisionTimerID < 0 || static_cast<std::size_t>(precisionTimerID) >= sPrecisionTimers.size())
+        {
+            std::ostringstream output;
+            output << "stopPrecisionTimer: unknown precision timer '" << parameters[0].toString() << "'! Returning 0.";
+            state->mInterpreter->mConfig.mPlatform->logError(output.str());
+            return StoredValue(0);
+        }
+
         const millisecondFloat& startTime = sPrecisionTimers[precisionTimerID];
 
         // Load end time as the current time
@@ -94,14 +99,13 @@ namespace TribalScript
         return StoredValue(deltaTime.count());
     }
 
-    StoredValue ExecBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue ExecBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
-        for (unsigned int iteration = 0; iteration < parameters.size(); ++iteration)
+        for (const StoredValue& parameter : parameters)
         {
-            std::string executedFile = parameters.back().toString();
-            parameters.pop_back();
+            std::string executedFile = parameter.toString();
 
             std::ostringstream output;
             output << "Executing " << executedFile << " ...";
@@ -113,35 +117,33 @@ namespace TribalScript
         return StoredValue(0);
     }
 
-    StoredValue ActivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue ActivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
-        for (unsigned int iteration = 0; iteration < parameters.size(); ++iteration)
+        for (const StoredValue& parameter : parameters)
         {
-            std::string activatedPackage = parameters.back().toString();
+            std::string activatedPackage = parameter.toString();
             state->mInterpreter->activateFunctionRegistry(activatedPackage);
-            parameters.pop_back();
         }
 
         return StoredValue(0);
     }
 
-    StoredValue DeactivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue DeactivatePackageBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
-        for (unsigned int iteration = 0; iteration < parameters.size(); ++iteration)
+        for (const StoredValue& parameter : parameters)
         {
-            std::string deactivatedPackage = parameters.back().toString();
+            std::string deactivatedPackage = parameter.toString();
             state->mInterpreter->deactivateFunctionRegistry(deactivatedPackage);
-            parameters.pop_back();
         }
 
         return StoredValue(0);
     }
 
-    StoredValue DeleteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue DeleteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -153,7 +155,7 @@ namespace TribalScript
         return StoredValue(0);
     }
 
-    StoredValue GetNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -161,7 +163,7 @@ namespace TribalScript
         return StoredValue(stringData.c_str());
     }
 
-    StoredValue GetClassNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetClassNameBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -169,7 +171,7 @@ namespace TribalScript
         return StoredValue(stringData.c_str());
     }
 
-    StoredValue GetIDBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetIDBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -183,14 +185,14 @@ namespace TribalScript
         interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(ExecBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "exec")));
         interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(ActivatePackageBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "activatePackage")));
         interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(DeactivatePackageBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "deactivatePackage")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetRealTimeBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getRealTime")));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetRealTimeBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getRealTime", 0, 0)));
 
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(StartPrecisionTimerBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "startPrecisionTimer")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(StopPrecisionTimerBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "stopPrecisionTimer")));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(StartPrecisionTimerBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "startPrecisionTimer", 0, 0)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(StopPrecisionTimerBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "stopPrecisionTimer", 1, 1)));
 
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetClassNameBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getClassName")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetNameBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getName")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetIDBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getID")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(DeleteBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "delete")));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetClassNameBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getClassName", 0, 0)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetNameBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getName", 0, 0)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetIDBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getID", 0, 0)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(DeleteBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "delete", 0, 0)));
     }
 }
@@ -18,7 +18,7 @@
 
 namespace TribalScript
 {
-    StoredValue OpenForWriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue OpenForWriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
         std::string path = parameters.back().toString();
@@ -36,7 +36,7 @@ namespace TribalScript
         return StoredValue(-1);
     }
 
-    StoredValue OpenForReadBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue OpenForReadBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
         std::string path = parameters.back().toString();
@@ -54,7 +54,7 @@ namespace TribalScript
         return StoredValue(-1);
     }
 
-    StoredValue WriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue WriteBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
         std::string written = parameters.back().toString();
@@ -68,7 +68,7 @@ namespace TribalScript
         return StoredValue(0);
     }
 
-    StoredValue CloseBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue CloseBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -81,7 +81,7 @@ namespace TribalScript
         return StoredValue(0);
     }
 
-    StoredValue IsEOFBuiltin(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue IsEOFBuiltin(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -93,7 +93,7 @@ namespace TribalScript
         return StoredValue(fileObject->isEOF() ? 1 : 0);
     }
 
-    StoredValue ReadLineBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue ReadLineBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -106,7 +106,7 @@ namespace TribalScript
         return StoredValue(stringData.c_str());
     }
 
-    StoredValue IsFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue IsFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
         std::string path = parameters.back().toString();
@@ -115,7 +115,7 @@ namespace TribalScript
         return StoredValue(handle->exists() ? 1 : 0);
     }
 
-    StoredValue DeleteFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue DeleteFileBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
         std::string path = parameters.back().toString();
@@ -126,15 +126,15 @@ namespace TribalScript
 
     void registerFileObjectLibrary(Interpreter* interpreter)
     {
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(OpenForWriteBuiltIn, PACKAGE_EMPTY, "FileObject", "openForWrite")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(OpenForReadBuiltIn, PACKAGE_EMPTY, "FileObject", "openForRead")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(WriteBuiltIn, PACKAGE_EMPTY, "FileObject", "write")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(CloseBuiltIn, PACKAGE_EMPTY, "FileObject", "close")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(IsEOFBuiltin, PACKAGE_EMPTY, "FileObject", "isEOF")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(ReadLineBuiltIn, PACKAGE_EMPTY, "FileObject", "readLine")));
-
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(IsFileBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "isFile")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(DeleteFileBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "deleteFile")));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(OpenForWriteBuiltIn, PACKAGE_EMPTY, "FileObject", "openForWrite", 1, 1)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(OpenForReadBuiltIn, PACKAGE_EMPTY, "FileObject", "openForRead", 1, 1)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(WriteBuiltIn, PACKAGE_EMPTY, "FileObject", "write", 1, 1)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(CloseBuiltIn, PACKAGE_EMPTY, "FileObject", "close", 0, 0)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(IsEOFBuiltin, PACKAGE_EMPTY, "FileObject", "isEOF", 0, 0)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(ReadLineBuiltIn, PACKAGE_EMPTY, "FileObject", "readLine", 0, 0)));
+
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(IsFileBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "isFile", 1, 1)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(DeleteFileBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "deleteFile", 1, 1)));
 
         INTERPRETER_REGISTER_CONSOLEOBJECT_TYPE(interpreter, FileObject, ConsoleObject);
         //interpreter->registerConsoleObjectType<FileObject>();
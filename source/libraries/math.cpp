@@ -18,7 +18,7 @@
 
 namespace TribalScript
 {
-    StoredValue GetRandomBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetRandomBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         StoredValueStack& stack = state->mExecutionScope.getStack();
 
@@ -29,6 +29,6 @@ namespace TribalScript
 
     void registerMathLibrary(Interpreter* interpreter)
     {
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetRandomBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getRandom")));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetRandomBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getRandom", 0, 2)));
     }
 }
@@ -18,14 +18,14 @@
 
 namespace TribalScript
 {
-    StoredValue GetCountBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetCountBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
         SimSet* set = reinterpret_cast<SimSet*>(thisObject);
 
         return StoredValue((int)set->getCount());
     }
 
-	StoredValue GetObjectBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+	StoredValue GetObjectBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
 	{
 		SimSet* set = reinterpret_cast<SimSet*>(thisObject);
 
@@ -34,7 +34,7 @@ namespace TribalScript
 		return StoredValue((int)state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObjectID(state->mInterpreter, set->getObject(index)));
 	}
 
-	StoredValue AddObjectBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+	StoredValue AddObjectBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
 	{
 		SimSet* set = reinterpret_cast<SimSet*>(thisObject);
 
@@ -49,9 +49,9 @@ namespace TribalScript
 
     void registerSimSetLibrary(Interpreter* interpreter)
     {
-		interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetCountBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getCount")));
-		interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetObjectBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getObject")));
-		interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(AddObjectBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "add")));
+		interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetCountBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getCount", 0, 0)));
+		interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetObjectBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "getObject", 1, 1)));
+		interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(AddObjectBuiltIn, PACKAGE_EMPTY, "ConsoleObject", "add", 0, NativeFunction::UnlimitedArguments)));
 
         INTERPRETER_REGISTER_CONSOLEOBJECT_TYPE(interpreter, SimSet, ConsoleObject);
         //interpreter->registerConsoleObjectType<FileObject>();
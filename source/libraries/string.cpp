@@ -13,92 +13,109 @@
  */
 
 #include <assert.h>
+#include <limits>
 
 #include <tribalscript/libraries/string.hpp>
 #include <tribalscript/stringhelpers.hpp>
 
 namespace TribalScript
 {
-    /* Words */
-    StoredValue GetWordBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    /**
+     *  @brief Reads a component index parameter. Negative indices never refer to a component.
+     */
+    static std::size_t getComponentIndex(const StoredValue& parameter)
     {
-        std::string result = getStringComponentsJoined(parameters[0].toString(), ' ', parameters[1].toInteger(), 1);
-        return StoredValue(result.c_str());
+        const int index = parameter.toInteger();
+        return index < 0 ? std::numeric_limits<std::size_t>::max() : static_cast<std::size_t>(index);
     }
 
-    StoredValue GetWordsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    static StoredValue getComponents(const StoredValueSpan& parameters, const unsigned char delineator, const std::size_t count)
     {
-        std::string result = getStringComponentsJoined(parameters[0].toString(), ' ', parameters[1].toInteger(), parameters[2].toInteger());
-        return StoredValue(result.c_str());
+        return StringComponents(parameters[0], delineator).getComponents(getComponentIndex(parameters[1]), count);
     }
 
-    StoredValue SetWordBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    static StoredValue setComponents(const StoredValueSpan& parameters, const unsigned char delineator)
     {
-        // std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents)
-        std::string result = setStringComponents(parameters[0].toString(), ' ', parameters[1].toInteger(), {
-            parameters[2].toString()
-        });
-        return StoredValue(result.c_str());
-    }
+        const std::size_t first = getComponentIndex(parameters[1]);
+        if (first == std::numeric_limits<std::size_t>::max())
+        {
+            return parameters[0].getReferencedValueCopy();
+        }
 
-    StoredValue SetWordsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
-    {
-        // std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents)
-        std::vector<std::string> newWords;
+        std::vector<std::string> newComponents;
         for (std::size_t iteration = 2; iteration < parameters.size(); ++iteration)
         {
-            newWords.push_back(parameters[iteration].toString());
+            newComponents.push_back(parameters[iteration].toString());
         }
 
-        std::string result = setStringComponents(parameters[0].toString(), ' ', parameters[1].toInteger(), newWords);
-        return StoredValue(result.c_str());
+        const std::string result = StringComponents(parameters[0], delineator).setComponents(first, newComponents);
+        return StoredValue(result.c_str(), result.size());
+    }
+
+    /* Words */
+    StoredValue GetWordBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        return getComponents(parameters, ' ', 1);
+    }
+
+    StoredValue GetWordsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        return getComponents(parameters, ' ', getComponentIndex(parameters[2]));
+    }
+
+    StoredValue GetWordCountBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        return StoredValue(static_cast<int>(StringComponents(parameters[0], ' ').getCount()));
+    }
+
+    StoredValue SetWordBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        return setComponents(parameters, ' ');
+    }
+
+    StoredValue SetWordsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        return setComponents(parameters, ' ');
     }
 
     /* Fields */
-    StoredValue GetFieldBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetFieldBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
-        std::string result = getStringComponentsJoined(parameters[0].toString(), '\t', parameters[1].toInteger(), 1);
-        return StoredValue(result.c_str());
+        return getComponents(parameters, '\t', 1);
     }
 
-    StoredValue GetFieldsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetFieldsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
-        std::string result = getStringComponentsJoined(parameters[0].toString(), '\t', parameters[1].toInteger(), parameters[2].toInteger());
-        return StoredValue(result.c_str());
+        return getComponents(parameters, '\t', getComponentIndex(parameters[2]));
     }
 
-    StoredValue SetFieldBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue GetFieldCountBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
-        // std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents)
-        std::string result = setStringComponents(parameters[0].toString(), '\t', parameters[1].toInteger(), {
-            parameters[2].toString()
-        });
-        return StoredValue(result.c_str());
+        return StoredValue(static_cast<int>(StringComponents(parameters[0], '\t').getCount()));
     }
 
-    StoredValue SetFieldsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    StoredValue SetFieldBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
-        // std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents)
-        std::vector<std::string> newWords;
-        for (std::size_t iteration = 2; iteration < parameters.size(); ++iteration)
-        {
-            newWords.push_back(parameters[iteration].toString());
-        }
+        return setComponents(parameters, '\t');
+    }
 
-        std::string result = setStringComponents(parameters[0].toString(), '\t', parameters[1].toInteger(), newWords);
-        return StoredValue(result.c_str());
+    StoredValue SetFieldsBuiltIn(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
+    {
+        return setComponents(parameters, '\t');
     }
 
     void registerStringLibrary(Interpreter* interpreter)
     {
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetWordBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getWord")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetFieldsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getWords")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetWordBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setWord")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetWordsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setWords")));
-
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetFieldBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getField")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetWordsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getFields")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetFieldBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setField")));
-        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetFieldsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setFields")));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetWordBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getWord", 2, 2)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetWordsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getWords", 3, 3)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetWordCountBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getWordCount", 1, 1)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetWordBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setWord", 3, 3)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetWordsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setWords", 3, NativeFunction::UnlimitedArguments)));
+
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetFieldBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getField", 2, 2)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetFieldsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getFields", 3, 3)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(GetFieldCountBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "getFieldCount", 1, 1)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetFieldBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setField", 3, 3)));
+        interpreter->addFunction(std::shared_ptr<Function>(new NativeFunction(SetFieldsBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "setFields", 3, NativeFunction::UnlimitedArguments)));
     }
 }
@@ -12,20 +12,49 @@
  *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <sstream>
+
 #include <tribalscript/nativefunction.hpp>
 #include <tribalscript/instructions.hpp>
 #include <tribalscript/stringhelpers.hpp>
 #include <tribalscript/storedvaluestack.hpp>
+#include <tribalscript/interpreter.hpp>
 
 namespace TribalScript
 {
-    NativeFunction::NativeFunction(NativeFunctionPointer native, const std::string& package, const std::string& space, const std::string& name) : mNativeFunction(native), Function(package, space, name)
+    NativeFunction::NativeFunction(NativeFunctionPointer native, const std::string& package, const std::string& space, const std::string& name,
+                                   std::size_t minimumArguments, std::size_t maximumArguments) : mNativeFunction(native), mMinimumArguments(minimumArguments),
+                                                                                                 mMaximumArguments(maximumArguments), Function(package, space, name)
     {
 
     }
 
-    void NativeFunction::execute(ConsoleObject* thisObject, ExecutionState* state, std::vector<StoredValue>& parameters)
+    void NativeFunction::execute(ConsoleObject* thisObject, ExecutionState* state, const StoredValueSpan& parameters)
     {
+        // Arguments are read in place from the caller's stack, so a native must never index past the ones it was given
+        if (parameters.size() < mMinimumArguments || parameters.size() > mMaximumArguments)
+        {
+            std::ostringstream output;
+            output << getDeclaredName() << ": wrong number of arguments (expected ";
+            if (mMinimumArguments == mMaximumArguments)
+            {
+                output << mMinimumArguments;
+            }
+            else if (mMaximumArguments == UnlimitedArguments)
+            {
+                output << "at least " << mMinimumArguments;
+            }
+            else
+            {
+                output << mMinimumArguments << " to " << mMaximumArguments;
+            }
+            output << ", got " << parameters.size() << ")! Returning 0.";
+            state->mInterpreter->mConfig.mPlatform->logError(output.str());
+
+            state->mExecutionScope.getStack().push_back(StoredValue(0));
+            return;
+        }
+
         state->mExecutionScope.getStack().push_back(mNativeFunction(thisObject, state, parameters));
     }
 }
@@ -0,0 +1,124 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+
+#include <tribalscript/numberformatter.hpp>
+
+namespace TribalScript
+{
+    //! The number of significant digits %g produces by default.
+    static const int sSignificantDigits = 6;
+
+    //! Powers of ten from 10^-4, the smallest value %g writes without an exponent, up to 10^9. All powers from 10^0
+    //! onwards are exact.
+    static const double sPowersOfTen[] = {
+        1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+    };
+
+    //! The exponent of the first entry in sPowersOfTen.
+    static const int sSmallestExponent = -4;
+
+    std::size_t formatFloat(const float value, char* buffer)
+    {
+        const double magnitude = std::fabs(static_cast<double>(value));
+
+        std::size_t length = 0;
+        if (std::signbit(value) && !std::isnan(value))
+        {
+            buffer[length++] = '-';
+        }
+
+        if (magnitude == 0.0)
+        {
+            buffer[length++] = '0';
+            buffer[length] = 0x00;
+            return length;
+        }
+
+        // Exponent notation, infinity and NaN are rare enough to be left to the C library
+        if (!(magnitude >= sPowersOfTen[0] && magnitude < sPowersOfTen[-sSmallestExponent + sSignificantDigits]))
+        {
+            return static_cast<std::size_t>(std::snprintf(buffer, FormattedFloatBufferSize, "%g", static_cast<double>(value)));
+        }
+
+        // Find the decimal exponent of the leading digit
+        int exponent = sSmallestExponent;
+        while (magnitude >= sPowersOfTen[exponent - sSmallestExponent + 1])
+        {
+            ++exponent;
+        }
+
+        // Scale so the significant digits form an integer. A float has 24 significant bits and the scale is at most
+        // 10^9, which has 21 bits besides its power of two, so this product is exact in a double and rounding it to
+        // the nearest integer with ties to even gives the same digits printf does
+        const int scale = sSignificantDigits - 1 - exponent;
+        std::uint32_t digits = static_cast<std::uint32_t>(std::nearbyint(magnitude * sPowersOfTen[scale - sSmallestExponent]));
+
+        // Rounding may carry into another digit, such as 9.999999 becoming 10
+        if (digits == 1000000)
+        {
+            digits = 100000;
+            ++exponent;
+            if (exponent >= sSignificantDigits)
+            {
+                return static_cast<std::size_t>(std::snprintf(buffer, FormattedFloatBufferSize, "%g", static_cast<double>(value)));
+            }
+        }
+
+        char characters[sSignificantDigits];
+        for (int digit = sSignificantDigits - 1; digit >= 0; --digit)
+        {
+            characters[digit] = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+
+        // %g drops trailing zeros from the fraction
+        int significantCount = sSignificantDigits;
+        while (significantCount > 1 && significantCount > exponent + 1 && characters[significantCount - 1] == '0')
+        {
+            --significantCount;
+        }
+
+        if (exponent < 0)
+        {
+            buffer[length++] = '0';
+            buffer[length++] = '.';
+            for (int zero = -1; zero > exponent; --zero)
+            {
+                buffer[length++] = '0';
+            }
+            for (int digit = 0; digit < significantCount; ++digit)
+            {
+                buffer[length++] = characters[digit];
+            }
+        }
+        else
+        {
+            for (int digit = 0; digit < significantCount; ++digit)
+            {
+                if (digit == exponent + 1)
+                {
+                    buffer[length++] = '.';
+                }
+                buffer[length++] = characters[digit];
+            }
+        }
+
+        buffer[length] = 0x00;
+        return length;
+    }
+}
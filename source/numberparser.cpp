@@ -0,0 +1,194 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+#include <tribalscript/numberparser.hpp>
+
+namespace TribalScript
+{
+    //! Powers of ten that are exactly representable as floats.
+    static const float sPowersOfTen[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+    };
+
+    //! The largest exponent found in sPowersOfTen.
+    static const int sMaximumExactExponent = 10;
+
+    //! The largest integer below which every integer is exactly representable as a float.
+    static const std::uint64_t sMaximumExactMantissa = 1 << 24;
+
+    //! Significant digits beyond this could overflow the mantissa accumulator.
+    static const int sMaximumSignificantDigits = 19;
+
+    static inline bool isSpace(const char character)
+    {
+        // The characters std::isspace accepts in the C locale
+        return character == ' ' || (character >= '\t' && character <= '\r');
+    }
+
+    static inline bool isDigit(const char character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    int parseInteger(const char* value)
+    {
+        const char* current = value;
+        while (isSpace(*current))
+        {
+            ++current;
+        }
+
+        bool negative = false;
+        if (*current == '+' || *current == '-')
+        {
+            negative = *current == '-';
+            ++current;
+        }
+
+        // Values only grow with each digit, so anything beyond the magnitude of the smallest int is out of range
+        const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<int>::max()) + 1;
+
+        std::uint64_t result = 0;
+        for (; isDigit(*current); ++current)
+        {
+            result = result * 10 + static_cast<std::uint64_t>(*current - '0');
+            if (result > limit)
+            {
+                return 0;
+            }
+        }
+
+        if (negative)
+        {
+            return result == limit ? std::numeric_limits<int>::min() : -static_cast<int>(result);
+        }
+        return result == limit ? 0 : static_cast<int>(result);
+    }
+
+    float parseFloat(const char* value)
+    {
+        const char* current = value;
+        while (isSpace(*current))
+        {
+            ++current;
+        }
+
+        bool negative = false;
+        if (*current == '+' || *current == '-')
+        {
+            negative = *current == '-';
+            ++current;
+        }
+
+        // Hexadecimal, infinity and NaN are rare enough to be left to the C library
+        if ((current[0] == '0' && (current[1] == 'x' || current[1] == 'X')) || current[0] == 'i' || current[0] == 'I' || current[0] == 'n' || current[0] == 'N')
+        {
+            return std::strtof(value, nullptr);
+        }
+
+        // Accumulate the significant digits as an integer, tracking where the decimal point goes in exponent
+        std::uint64_t mantissa = 0;
+        int significantDigits = 0;
+        int exponent = 0;
+        bool digits = false;
+
+        for (; isDigit(*current); ++current)
+        {
+            digits = true;
+            if (mantissa != 0 || *current != '0')
+            {
+                if (++significantDigits > sMaximumSignificantDigits)
+                {
+                    return std::strtof(value, nullptr);
+                }
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*current - '0');
+            }
+        }
+
+        if (*current == '.')
+        {
+            for (++current; isDigit(*current); ++current)
+            {
+                digits = true;
+                if (mantissa != 0 || *current != '0')
+                {
+                    if (++significantDigits > sMaximumSignificantDigits)
+                    {
+                        return std::strtof(value, nullptr);
+                    }
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*current - '0');
+                }
+                --exponent;
+            }
+        }
+
+        if (!digits)
+        {
+            return 0.0f;
+        }
+
+        // An exponent is only consumed if it has at least one digit
+        if (*current == 'e' || *current == 'E')
+        {
+            const char* exponentCurrent = current + 1;
+
+            bool negativeExponent = false;
+            if (*exponentCurrent == '+' || *exponentCurrent == '-')
+            {
+                negativeExponent = *exponentCurrent == '-';
+                ++exponentCurrent;
+            }
+
+            int exponentValue = 0;
+            for (; isDigit(*exponentCurrent); ++exponentCurrent)
+            {
+                // Anything this large over or underflows regardless of the mantissa
+                if (exponentValue < 100000)
+                {
+                    exponentValue = exponentValue * 10 + (*exponentCurrent - '0');
+                }
+            }
+            exponent += negativeExponent ? -exponentValue : exponentValue;
+        }
+
+        if (mantissa == 0)
+        {
+            return negative ? -0.0f : 0.0f;
+        }
+
+        // Trailing zeros only make the mantissa needlessly large
+        while (mantissa % 10 == 0 && exponent < sMaximumExactExponent)
+        {
+            mantissa /= 10;
+            ++exponent;
+        }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+        // When both the mantissa and the power of ten are exact, a single multiplication or division is correctly
+        // rounded just like strtof. This covers nearly every number written in scripts.
+        if (mantissa <= sMaximumExactMantissa && exponent >= -sMaximumExactExponent && exponent <= sMaximumExactExponent)
+        {
+            const float result = exponent < 0 ? static_cast<float>(mantissa) / sPowersOfTen[-exponent] : static_cast<float>(mantissa) * sPowersOfTen[exponent];
+            return negative ? -result : result;
+        }
+#endif
+
+        return std::strtof(value, nullptr);
+    }
+}
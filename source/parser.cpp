@@ -0,0 +1,980 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <tribalscript/parser.hpp>
+
+namespace TribalScript
+{
+    /**
+     *  @brief Thrown internally to unwind the parser once a syntax error has been recorded.
+     */
+    struct SyntaxError
+    {
+
+    };
+
+    /*
+        Binary operator precedence, mirroring the order of the left recursive expression rule in Tribes2.g4.
+        Higher values bind tighter.
+    */
+    static const int PRECEDENCE_NONE = -1;
+    static const int PRECEDENCE_CONCAT = 1;
+    static const int PRECEDENCE_EQUALITY = 2;
+    static const int PRECEDENCE_LOGICAL = 3;
+    static const int PRECEDENCE_BITSHIFT = 4;
+    static const int PRECEDENCE_RELATIONAL = 5;
+    static const int PRECEDENCE_TERNARY = 6;
+    static const int PRECEDENCE_ADDITIVE = 7;
+    static const int PRECEDENCE_MULTIPLICATIVE = 8;
+    static const int PRECEDENCE_BITWISE = 9;
+
+    static int getBinaryPrecedence(const TokenType type)
+    {
+        switch (type)
+        {
+            case TokenType::Concat:
+            case TokenType::KeywordSpaceConcat:
+            case TokenType::KeywordTabConcat:
+            case TokenType::KeywordNewlineConcat:
+                return PRECEDENCE_CONCAT;
+            case TokenType::Equals:
+            case TokenType::NotEqual:
+            case TokenType::StringEquals:
+            case TokenType::StringNotEqual:
+                return PRECEDENCE_EQUALITY;
+            case TokenType::LogicalAnd:
+            case TokenType::LogicalOr:
+                return PRECEDENCE_LOGICAL;
+            case TokenType::LeftBitShift:
+            case TokenType::RightBitShift:
+                return PRECEDENCE_BITSHIFT;
+            case TokenType::LessThan:
+            case TokenType::GreaterThan:
+            case TokenType::LessThanOrEqual:
+            case TokenType::GreaterThanOrEqual:
+                return PRECEDENCE_RELATIONAL;
+            case TokenType::Question:
+                return PRECEDENCE_TERNARY;
+            case TokenType::Plus:
+            case TokenType::Minus:
+                return PRECEDENCE_ADDITIVE;
+            case TokenType::Modulus:
+            case TokenType::Multiply:
+            case TokenType::Divide:
+                return PRECEDENCE_MULTIPLICATIVE;
+            case TokenType::BitwiseXor:
+            case TokenType::BitwiseOr:
+            case TokenType::BitwiseAnd:
+                return PRECEDENCE_BITWISE;
+            default:
+                return PRECEDENCE_NONE;
+        }
+    }
+
+    static AST::ASTNode* createBinaryNode(AST::ASTArena* arena, const TokenType type, AST::ASTNode* left, AST::ASTNode* right)
+    {
+        switch (type)
+        {
+            case TokenType::Concat:
+                return arena->create<AST::ConcatNode>(left, right, "");
+            case TokenType::KeywordSpaceConcat:
+                return arena->create<AST::ConcatNode>(left, right, " ");
+            case TokenType::KeywordTabConcat:
+                return arena->create<AST::ConcatNode>(left, right, "\t");
+            case TokenType::KeywordNewlineConcat:
+                return arena->create<AST::ConcatNode>(left, right, "\n");
+            case TokenType::Equals:
+                return arena->create<AST::EqualsNode>(left, right);
+            case TokenType::NotEqual:
+                return arena->create<AST::NotEqualsNode>(left, right);
+            case TokenType::StringEquals:
+                return arena->create<AST::StringEqualsNode>(left, right);
+            case TokenType::StringNotEqual:
+                return arena->create<AST::StringNotEqualNode>(left, right);
+            case TokenType::LogicalAnd:
+                return arena->create<AST::LogicalAndNode>(left, right);
+            case TokenType::LogicalOr:
+                return arena->create<AST::LogicalOrNode>(left, right);
+            case TokenType::LessThan:
+                return arena->create<AST::LessThanNode>(left, right);
+            case TokenType::GreaterThan:
+                return arena->create<AST::GreaterThanNode>(left, right);
+            case TokenType::GreaterThanOrEqual:
+                return arena->create<AST::GreaterThanOrEqualNode>(left, right);
+            case TokenType::Plus:
+                return arena->create<AST::AddNode>(left, right);
+            case TokenType::Minus:
+                return arena->create<AST::MinusNode>(left, right);
+            case TokenType::Modulus:
+                return arena->create<AST::ModulusNode>(left, right);
+            case TokenType::Multiply:
+                return arena->create<AST::MultiplyNode>(left, right);
+            case TokenType::Divide:
+                return arena->create<AST::DivideNode>(left, right);
+            case TokenType::BitwiseOr:
+                return arena->create<AST::BitwiseOrNode>(left, right);
+            case TokenType::BitwiseXor:
+            case TokenType::BitwiseAnd:
+                throw std::runtime_error("Unhandled bitwise type!");
+            case TokenType::LessThanOrEqual:
+                throw std::runtime_error("Unhandled Relational Type!");
+            default:
+                throw std::runtime_error("Unhandled binary operator type!");
+        }
+    }
+
+    static bool isAssignmentOperator(const TokenType type)
+    {
+        switch (type)
+        {
+            case TokenType::Assign:
+            case TokenType::PlusAssign:
+            case TokenType::MinusAssign:
+            case TokenType::MultiplyAssign:
+            case TokenType::DivideAssign:
+            case TokenType::OrAssign:
+            case TokenType::ModulusAssign:
+            case TokenType::AndAssign:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool isLabelWithKeywords(const TokenType type)
+    {
+        switch (type)
+        {
+            case TokenType::Label:
+            case TokenType::KeywordPackage:
+            case TokenType::KeywordReturn:
+            case TokenType::KeywordBreak:
+            case TokenType::KeywordContinue:
+            case TokenType::KeywordWhile:
+            case TokenType::KeywordFalse:
+            case TokenType::KeywordTrue:
+            case TokenType::KeywordFunction:
+            case TokenType::KeywordElse:
+            case TokenType::KeywordIf:
+            case TokenType::KeywordDatablock:
+            case TokenType::KeywordCase:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool isChainStart(const TokenType type)
+    {
+        switch (type)
+        {
+            case TokenType::Modulus:
+            case TokenType::Dollar:
+            case TokenType::Label:
+            case TokenType::IntegerLiteral:
+            case TokenType::HexIntegerLiteral:
+            case TokenType::FloatLiteral:
+            case TokenType::StringLiteral:
+            case TokenType::TaggedStringLiteral:
+            case TokenType::KeywordTrue:
+            case TokenType::KeywordFalse:
+            case TokenType::KeywordNew:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     *  @brief Returns the final element of a chain; the node itself if it is not a chain.
+     */
+    static AST::ASTNode* getChainTail(AST::ASTNode* node)
+    {
+        auto subreference = dynamic_cast<AST::SubreferenceNode*>(node);
+        if (!subreference)
+        {
+            return node;
+        }
+
+        while (subreference->mRight)
+        {
+            subreference = dynamic_cast<AST::SubreferenceNode*>(subreference->mRight);
+        }
+        return subreference->mTarget;
+    }
+
+    static bool isAssignableChain(AST::ASTNode* node)
+    {
+        if (dynamic_cast<AST::SubreferenceNode*>(node))
+        {
+            return dynamic_cast<AST::SubFieldNode*>(getChainTail(node)) != nullptr;
+        }
+
+        return dynamic_cast<AST::LocalVariableNode*>(node) || dynamic_cast<AST::GlobalVariableNode*>(node) || dynamic_cast<AST::ArrayNode*>(node);
+    }
+
+    static bool isCallChain(AST::ASTNode* node)
+    {
+        if (dynamic_cast<AST::SubreferenceNode*>(node))
+        {
+            return dynamic_cast<AST::SubFunctionCallNode*>(getChainTail(node)) != nullptr;
+        }
+
+        return dynamic_cast<AST::FunctionCallNode*>(node) != nullptr;
+    }
+
+    AST::StringView Parser::stripQuotes(const AST::StringView& raw)
+    {
+        return raw.substr(1, raw.size() - 2);
+    }
+
+    Parser::Parser(const std::vector<Token>& tokens, AST::ASTArena* arena) : mTokens(tokens), mPosition(0), mArena(arena)
+    {
+
+    }
+
+    AST::ProgramNode* Parser::parseProgram()
+    {
+        std::vector<AST::ASTNode*> statements;
+
+        try
+        {
+            while (!this->check(TokenType::EndOfFile))
+            {
+                statements.push_back(this->parseStatement());
+            }
+        }
+        catch (const SyntaxError&)
+        {
+            return nullptr;
+        }
+
+        return mArena->create<AST::ProgramNode>(mArena->createList(statements));
+    }
+
+    const std::vector<std::string>& Parser::getErrors()
+    {
+        return mErrors;
+    }
+
+    /*
+        Declarations
+    */
+
+    AST::ASTNode* Parser::parseStatement()
+    {
+        switch (this->peek().mType)
+        {
+            case TokenType::KeywordFunction:
+                return this->parseFunctionDeclaration();
+            case TokenType::KeywordPackage:
+                return this->parsePackageDeclaration();
+            default:
+                return this->parseExpressionStatement();
+        }
+    }
+
+    AST::ASTNode* Parser::parseFunctionDeclaration()
+    {
+        this->expect(TokenType::KeywordFunction);
+
+        AST::StringView functionNameSpace;
+        AST::StringView functionName = this->expect(TokenType::Label).mText;
+        if (this->match(TokenType::DoubleColon))
+        {
+            functionNameSpace = functionName;
+            functionName = this->expect(TokenType::Label).mText;
+        }
+
+        // NOTE: For now we force locals but it appears globals are technically valid but buggy?
+        std::vector<AST::StringView> parameterNames;
+        this->expect(TokenType::LeftParenthesis);
+        if (!this->check(TokenType::RightParenthesis))
+        {
+            do
+            {
+                this->expect(TokenType::Modulus);
+
+                // NOTE: For now we just combine :: into a single variable name
+                AST::StringView parameterName = this->parseLabelWithKeywords();
+                if (this->check(TokenType::DoubleColon))
+                {
+                    std::string combinedName = parameterName.toString();
+                    while (this->match(TokenType::DoubleColon))
+                    {
+                        combinedName += "::" + this->parseLabelWithKeywords().toString();
+                    }
+                    parameterName = mArena->createString(combinedName);
+                }
+                parameterNames.push_back(parameterName);
+            } while (this->match(TokenType::Comma));
+        }
+        this->expect(TokenType::RightParenthesis);
+
+        std::vector<AST::ASTNode*> body;
+        this->expect(TokenType::LeftBrace);
+        while (!this->match(TokenType::RightBrace))
+        {
+            body.push_back(this->parseExpressionStatement());
+        }
+
+        return mArena->create<AST::FunctionDeclarationNode>(functionNameSpace, functionName, mArena->createList(parameterNames), mArena->createList(body));
+    }
+
+    AST::ASTNode* Parser::parsePackageDeclaration()
+    {
+        this->expect(TokenType::KeywordPackage);
+        const AST::StringView packageName = this->expect(TokenType::Label).mText;
+        this->expect(TokenType::LeftBrace);
+
+        std::vector<AST::ASTNode*> functions;
+        do
+        {
+            functions.push_back(this->parseFunctionDeclaration());
+        } while (!this->match(TokenType::RightBrace));
+        this->expect(TokenType::Semicolon);
+
+        return mArena->create<AST::PackageDeclarationNode>(packageName, mArena->createList(functions));
+    }
+
+    AST::ASTNode* Parser::parseDatablockDeclaration()
+    {
+        this->expect(TokenType::KeywordDatablock);
+
+        const AST::StringView typeName = this->expect(TokenType::Label).mText;
+        this->expect(TokenType::LeftParenthesis);
+        const AST::StringView name = this->expect(TokenType::Label).mText;
+        this->expect(TokenType::RightParenthesis);
+
+        AST::StringView parentName;
+        if (this->match(TokenType::Colon))
+        {
+            parentName = this->expect(TokenType::Label).mText;
+        }
+
+        std::vector<AST::ASTNode*> fields;
+        this->expect(TokenType::LeftBrace);
+        do
+        {
+            fields.push_back(this->parseFieldAssign());
+        } while (!this->match(TokenType::RightBrace));
+
+        return mArena->create<AST::DatablockDeclarationNode>(name, typeName, parentName, mArena->createList(fields));
+    }
+
+    AST::ASTNode* Parser::parseFieldAssign()
+    {
+        const AST::StringView fieldBaseName = this->parseLabelWithKeywords();
+
+        std::vector<AST::ASTNode*> fieldExpressions;
+        if (this->match(TokenType::LeftBracket))
+        {
+            fieldExpressions = this->parseExpressionList(TokenType::RightBracket, false);
+        }
+
+        this->expect(TokenType::Assign);
+        AST::ASTNode* fieldValue = this->parsePrimaryExpressionOrExpression();
+        this->expect(TokenType::Semicolon);
+
+        return mArena->create<AST::FieldAssignNode>(fieldBaseName, mArena->createList(fieldExpressions), fieldValue);
+    }
+
+    AST::ObjectDeclarationNode* Parser::parseObjectDeclaration()
+    {
+        this->expect(TokenType::KeywordNew);
+
+        AST::ASTNode* typeName = nullptr;
+        if (this->match(TokenType::LeftParenthesis))
+        {
+            typeName = this->parseExpression();
+            this->expect(TokenType::RightParenthesis);
+        }
+        else
+        {
+            typeName = mArena->create<AST::StringNode>(this->expect(TokenType::Label).mText);
+        }
+
+        AST::ASTNode* name = nullptr;
+        this->expect(TokenType::LeftParenthesis);
+        if (!this->check(TokenType::RightParenthesis))
+        {
+            name = this->parsePrimaryExpressionOrExpression();
+        }
+        this->expect(TokenType::RightParenthesis);
+
+        std::vector<AST::ObjectDeclarationNode*> children;
+        std::vector<AST::ASTNode*> fields;
+        if (this->match(TokenType::LeftBrace))
+        {
+            while (isLabelWithKeywords(this->peek().mType))
+            {
+                fields.push_back(this->parseFieldAssign());
+            }
+
+            while (this->check(TokenType::KeywordNew))
+            {
+                children.push_back(this->parseObjectDeclaration());
+                this->expect(TokenType::Semicolon);
+            }
+            this->expect(TokenType::RightBrace);
+        }
+
+        return mArena->create<AST::ObjectDeclarationNode>(name, typeName, mArena->createList(children), mArena->createList(fields));
+    }
+
+    /*
+        Control statements
+    */
+
+    AST::ASTNode* Parser::parseExpressionStatement()
+    {
+        AST::ASTNode* result = nullptr;
+
+        switch (this->peek().mType)
+        {
+            case TokenType::KeywordWhile:
+                return this->parseWhile();
+            case TokenType::KeywordFor:
+                return this->parseFor();
+            case TokenType::KeywordIf:
+                return this->parseIf();
+            case TokenType::KeywordSwitch:
+                return this->parseSwitch();
+            case TokenType::KeywordContinue:
+                this->advance();
+                result = mArena->create<AST::ContinueNode>();
+                break;
+            case TokenType::KeywordBreak:
+                this->advance();
+                result = mArena->create<AST::BreakNode>();
+                break;
+            case TokenType::KeywordReturn:
+                result = this->parseReturn();
+                break;
+            default:
+                result = this->parsePrimaryExpression();
+                break;
+        }
+
+        this->expect(TokenType::Semicolon);
+        return result;
+    }
+
+    std::vector<AST::ASTNode*> Parser::parseControlStatements()
+    {
+        std::vector<AST::ASTNode*> result;
+
+        if (this->match(TokenType::LeftBrace))
+        {
+            while (!this->match(TokenType::RightBrace))
+            {
+                result.push_back(this->parseExpressionStatement());
+            }
+        }
+        else
+        {
+            result.push_back(this->parseExpressionStatement());
+        }
+        return result;
+    }
+
+    AST::ASTNode* Parser::parseWhile()
+    {
+        this->expect(TokenType::KeywordWhile);
+        this->expect(TokenType::LeftParenthesis);
+        AST::ASTNode* expression = this->parseExpression();
+        this->expect(TokenType::RightParenthesis);
+
+        return mArena->create<AST::WhileNode>(expression, mArena->createList(this->parseControlStatements()));
+    }
+
+    AST::ASTNode* Parser::parseFor()
+    {
+        this->expect(TokenType::KeywordFor);
+        this->expect(TokenType::LeftParenthesis);
+        AST::ASTNode* initializer = this->parsePrimaryExpressionOrExpression();
+        this->expect(TokenType::Semicolon);
+        AST::ASTNode* expression = this->parsePrimaryExpressionOrExpression();
+        this->expect(TokenType::Semicolon);
+        AST::ASTNode* advance = this->parsePrimaryExpressionOrExpression();
+        this->expect(TokenType::RightParenthesis);
+
+        return mArena->create<AST::ForNode>(initializer, expression, advance, mArena->createList(this->parseControlStatements()));
+    }
+
+    AST::ASTNode* Parser::parseIf()
+    {
+        this->expect(TokenType::KeywordIf);
+        this->expect(TokenType::LeftParenthesis);
+        AST::ASTNode* expression = this->parsePrimaryExpressionOrExpression();
+        this->expect(TokenType::RightParenthesis);
+        std::vector<AST::ASTNode*> body = this->parseControlStatements();
+
+        std::vector<AST::ElseIfNode*> elseIfs;
+        while (this->check(TokenType::KeywordElse) && this->peek(1).mType == TokenType::KeywordIf)
+        {
+            this->advance();
+            this->advance();
+
+            this->expect(TokenType::LeftParenthesis);
+            AST::ASTNode* elseIfExpression = this->parsePrimaryExpressionOrExpression();
+            this->expect(TokenType::RightParenthesis);
+
+            elseIfs.push_back(mArena->create<AST::ElseIfNode>(elseIfExpression, mArena->createList(this->parseControlStatements())));
+        }
+
+        std::vector<AST::ASTNode*> elseBody;
+        if (this->match(TokenType::KeywordElse))
+        {
+            elseBody = this->parseControlStatements();
+        }
+
+        // The compiler expects else ifs in reverse order of declaration
+        std::reverse(elseIfs.begin(), elseIfs.end());
+        return mArena->create<AST::IfNode>(expression, mArena->createList(body), mArena->createList(elseIfs), mArena->createList(elseBody));
+    }
+
+    AST::ASTNode* Parser::parseSwitch()
+    {
+        this->expect(TokenType::KeywordSwitch);
+        this->match(TokenType::Dollar);
+        this->expect(TokenType::LeftParenthesis);
+        AST::ASTNode* expression = this->parsePrimaryExpressionOrExpression();
+        this->expect(TokenType::RightParenthesis);
+        this->expect(TokenType::LeftBrace);
+
+        std::vector<AST::SwitchCaseNode*> cases;
+        do
+        {
+            this->expect(TokenType::KeywordCase);
+
+            std::vector<AST::ASTNode*> caseExpressions;
+            do
+            {
+                caseExpressions.push_back(this->parseExpression());
+            } while (this->match(TokenType::KeywordOr));
+            this->expect(TokenType::Colon);
+
+            std::vector<AST::ASTNode*> caseBody;
+            while (!this->check(TokenType::KeywordCase) && !this->check(TokenType::KeywordDefault) && !this->check(TokenType::RightBrace))
+            {
+                caseBody.push_back(this->parseExpressionStatement());
+            }
+
+            cases.push_back(mArena->create<AST::SwitchCaseNode>(mArena->createList(caseExpressions), mArena->createList(caseBody)));
+        } while (this->check(TokenType::KeywordCase));
+
+        std::vector<AST::ASTNode*> defaultBody;
+        if (this->match(TokenType::KeywordDefault))
+        {
+            this->expect(TokenType::Colon);
+            while (!this->check(TokenType::RightBrace))
+            {
+                defaultBody.push_back(this->parseExpressionStatement());
+            }
+        }
+        this->expect(TokenType::RightBrace);
+
+        // The compiler expects cases in reverse order of declaration
+        std::reverse(cases.begin(), cases.end());
+        return mArena->create<AST::SwitchNode>(expression, mArena->createList(cases), mArena->createList(defaultBody));
+    }
+
+    AST::ASTNode* Parser::parseReturn()
+    {
+        this->expect(TokenType::KeywordReturn);
+
+        AST::ASTNode* expression = nullptr;
+        if (!this->check(TokenType::Semicolon))
+        {
+            expression = this->parsePrimaryExpressionOrExpression();
+        }
+        return mArena->create<AST::ReturnNode>(expression);
+    }
+
+    /*
+        Expressions
+    */
+
+    AST::ASTNode* Parser::parsePrimaryExpression()
+    {
+        if (this->check(TokenType::KeywordDatablock))
+        {
+            return this->parseDatablockDeclaration();
+        }
+
+        const Token& startToken = this->peek();
+        AST::ASTNode* chain = this->parseChain();
+
+        bool handled = false;
+        AST::ASTNode* result = this->parseAssignmentTail(chain, &handled);
+        if (handled)
+        {
+            return result;
+        }
+
+        // Only calls and object declarations are actionable on their own
+        if (isCallChain(chain) || dynamic_cast<AST::ObjectDeclarationNode*>(chain))
+        {
+            return chain;
+        }
+
+        this->error(startToken, "expression is not a statement");
+        return nullptr;
+    }
+
+    AST::ASTNode* Parser::parsePrimaryExpressionOrExpression()
+    {
+        if (this->check(TokenType::KeywordDatablock))
+        {
+            return this->parseDatablockDeclaration();
+        }
+        else if (!isChainStart(this->peek().mType))
+        {
+            return this->parseExpression();
+        }
+
+        AST::ASTNode* chain = this->parseChain();
+
+        bool handled = false;
+        AST::ASTNode* result = this->parseAssignmentTail(chain, &handled);
+        if (handled)
+        {
+            return result;
+        }
+
+        // Otherwise the chain is the leftmost operand of an expression
+        return this->parseBinaryExpression(chain, 0);
+    }
+
+    AST::ASTNode* Parser::parseAssignmentTail(AST::ASTNode* target, bool* handled)
+    {
+        const TokenType type = this->peek().mType;
+        *handled = false;
+
+        if (!isAssignmentOperator(type) && type != TokenType::Increment && type != TokenType::Decrement)
+        {
+            return nullptr;
+        }
+        else if (!isAssignableChain(target))
+        {
+            this->error(this->peek(), "mismatched input '" + this->peek().mText.toString() + "'");
+        }
+
+        *handled = true;
+        this->advance();
+
+        if (type == TokenType::Increment)
+        {
+            return mArena->create<AST::IncrementNode>(target);
+        }
+        else if (type == TokenType::Decrement)
+        {
+            // FIXME: Decrement is not yet implemented and resolves to the target itself
+            return target;
+        }
+
+        AST::ASTNode* right = this->parseExpression();
+        if (type != TokenType::Assign)
+        {
+            throw std::runtime_error("Unhandled assignment type!");
+        }
+        return mArena->create<AST::AssignmentNode>(target, right);
+    }
+
+    AST::ASTNode* Parser::parseExpression(const int minimumPrecedence)
+    {
+        return this->parseBinaryExpression(this->parseUnaryExpression(), minimumPrecedence);
+    }
+
+    AST::ASTNode* Parser::parseBinaryExpression(AST::ASTNode* left, const int minimumPrecedence)
+    {
+        while (true)
+        {
+            const TokenType type = this->peek().mType;
+            const int precedence = getBinaryPrecedence(type);
+
+            if (precedence == PRECEDENCE_NONE || precedence < minimumPrecedence)
+            {
+                return left;
+            }
+            this->advance();
+
+            if (type == TokenType::Question)
+            {
+                AST::ASTNode* trueValue = this->parseExpression();
+                this->expect(TokenType::Colon);
+                AST::ASTNode* falseValue = this->parseExpression(precedence + 1);
+
+                left = mArena->create<AST::TernaryNode>(left, trueValue, falseValue);
+                continue;
+            }
+            else if (precedence == PRECEDENCE_BITSHIFT)
+            {
+                throw std::runtime_error("Unhandled bitshift type!");
+            }
+
+            // All binary operators are left associative
+            AST::ASTNode* right = this->parseExpression(precedence + 1);
+            left = createBinaryNode(mArena, type, left, right);
+        }
+    }
+
+    AST::ASTNode* Parser::parseUnaryExpression()
+    {
+        const Token& token = this->peek();
+
+        switch (token.mType)
+        {
+            case TokenType::Minus:
+                this->advance();
+                return mArena->create<AST::NegateNode>(this->parseUnaryExpression());
+            case TokenType::Not:
+                this->advance();
+                return mArena->create<AST::NotNode>(this->parseUnaryExpression());
+            case TokenType::Tilde:
+                throw std::runtime_error("Unknown Unary Type!");
+            case TokenType::LeftParenthesis:
+            {
+                this->advance();
+                AST::ASTNode* result = this->parseExpression();
+                this->expect(TokenType::RightParenthesis);
+                return result;
+            }
+            default:
+                return this->parseChain();
+        }
+    }
+
+    AST::ASTNode* Parser::parseChain()
+    {
+        std::vector<AST::ASTNode*> elements;
+        elements.push_back(this->parseChainStart());
+
+        while (this->match(TokenType::Dot))
+        {
+            elements.push_back(this->parseChainElement());
+        }
+
+        if (elements.size() == 1)
+        {
+            return elements.front();
+        }
+
+        // Every pair of items should have a subreference
+        AST::SubreferenceNode* result = nullptr;
+        AST::SubreferenceNode* currentLeft = nullptr;
+        for (AST::ASTNode* element : elements)
+        {
+            AST::SubreferenceNode* newNode = mArena->create<AST::SubreferenceNode>(currentLeft, element, nullptr);
+
+            if (currentLeft)
+            {
+                currentLeft->mRight = newNode;
+            }
+            else
+            {
+                result = newNode;
+            }
+            currentLeft = newNode;
+        }
+        return result;
+    }
+
+    AST::ASTNode* Parser::parseChainStart()
+    {
+        const Token& token = this->peek();
+
+        switch (token.mType)
+        {
+            case TokenType::Modulus:
+            case TokenType::Dollar:
+            {
+                AST::ASTNode* variable = this->parseVariable();
+                if (this->match(TokenType::LeftBracket))
+                {
+                    return mArena->create<AST::ArrayNode>(variable, mArena->createList(this->parseExpressionList(TokenType::RightBracket, false)));
+                }
+                return variable;
+            }
+            case TokenType::Label:
+                this->advance();
+
+                if (this->match(TokenType::LeftParenthesis))
+                {
+                    return mArena->create<AST::FunctionCallNode>("", token.mText, mArena->createList(this->parseExpressionList(TokenType::RightParenthesis, true)));
+                }
+                else if (this->check(TokenType::DoubleColon) && this->peek(1).mType == TokenType::Label && this->peek(2).mType == TokenType::LeftParenthesis)
+                {
+                    this->advance();
+                    const AST::StringView calledFunctionName = this->advance().mText;
+                    this->advance();
+
+                    return mArena->create<AST::FunctionCallNode>(token.mText, calledFunctionName, mArena->createList(this->parseExpressionList(TokenType::RightParenthesis, true)));
+                }
+                return mArena->create<AST::StringNode>(token.mText);
+            case TokenType::IntegerLiteral:
+                this->advance();
+                return mArena->create<AST::IntegerNode>(std::stoi(token.mText.toString()));
+            case TokenType::HexIntegerLiteral:
+                this->advance();
+                return mArena->create<AST::IntegerNode>(std::stoul(token.mText.toString(), nullptr, 16));
+            case TokenType::FloatLiteral:
+                this->advance();
+                return mArena->create<AST::FloatNode>(std::stof(token.mText.toString()));
+            case TokenType::StringLiteral:
+                this->advance();
+                return mArena->create<AST::StringNode>(this->stripQuotes(token.mText));
+            case TokenType::TaggedStringLiteral:
+                this->advance();
+                return mArena->create<AST::TaggedStringNode>(this->stripQuotes(token.mText));
+            case TokenType::KeywordTrue:
+                this->advance();
+                return mArena->create<AST::IntegerNode>(1);
+            case TokenType::KeywordFalse:
+                this->advance();
+                return mArena->create<AST::IntegerNode>(0);
+            case TokenType::KeywordNew:
+                return this->parseObjectDeclaration();
+            default:
+                this->error(token, "no viable alternative at input '" + token.mText.toString() + "'");
+                return nullptr;
+        }
+    }
+
+    AST::ASTNode* Parser::parseChainElement()
+    {
+        const AST::StringView name = this->expect(TokenType::Label).mText;
+
+        if (this->match(TokenType::LeftParenthesis))
+        {
+            return mArena->create<AST::SubFunctionCallNode>(name, mArena->createList(this->parseExpressionList(TokenType::RightParenthesis, true)));
+        }
+        else if (this->match(TokenType::LeftBracket))
+        {
+            return mArena->create<AST::SubFieldNode>(name, mArena->createList(this->parseExpressionList(TokenType::RightBracket, false)));
+        }
+        return mArena->create<AST::SubFieldNode>(name, AST::ArenaList<AST::ASTNode*>());
+    }
+
+    AST::ASTNode* Parser::parseVariable()
+    {
+        const bool isGlobal = this->advance().mType == TokenType::Dollar;
+
+        std::vector<AST::StringView> variableName;
+        variableName.push_back(this->parseLabelWithKeywords());
+        while (this->match(TokenType::DoubleColon))
+        {
+            variableName.push_back(this->parseLabelWithKeywords());
+        }
+
+        if (isGlobal)
+        {
+            return mArena->create<AST::GlobalVariableNode>(mArena->createList(variableName));
+        }
+        return mArena->create<AST::LocalVariableNode>(mArena->createList(variableName));
+    }
+
+    std::vector<AST::ASTNode*> Parser::parseExpressionList(const TokenType terminator, const bool allowEmpty)
+    {
+        std::vector<AST::ASTNode*> result;
+
+        if (allowEmpty && this->match(terminator))
+        {
+            return result;
+        }
+
+        do
+        {
+            result.push_back(this->parsePrimaryExpressionOrExpression());
+        } while (this->match(TokenType::Comma));
+
+        this->expect(terminator);
+        return result;
+    }
+
+    AST::StringView Parser::parseLabelWithKeywords()
+    {
+        const Token& token = this->peek();
+        if (!isLabelWithKeywords(token.mType))
+        {
+            this->error(token, "mismatched input '" + token.mText.toString() + "' expecting label");
+        }
+
+        this->advance();
+        return token.mText;
+    }
+
+    /*
+        Token stream helpers
+    */
+
+    const Token& Parser::peek(const std::size_t offset) const
+    {
+        const std::size_t index = mPosition + offset;
+        if (index >= mTokens.size())
+        {
+            return mTokens.back();
+        }
+        return mTokens[index];
+    }
+
+    const Token& Parser::advance()
+    {
+        const Token& result = this->peek();
+        if (mPosition < mTokens.size() - 1)
+        {
+            ++mPosition;
+        }
+        return result;
+    }
+
+    bool Parser::check(const TokenType type) const
+    {
+        return this->peek().mType == type;
+    }
+
+    bool Parser::match(const TokenType type)
+    {
+        if (this->check(type))
+        {
+            this->advance();
+            return true;
+        }
+        return false;
+    }
+
+    const Token& Parser::expect(const TokenType type)
+    {
+        if (!this->check(type))
+        {
+            this->error(this->peek(), "mismatched input '" + this->peek().mText.toString() + "'");
+        }
+        return this->advance();
+    }
+
+    void Parser::error(const Token& token, const std::string& message)
+    {
+        std::ostringstream out;
+        out << "Syntax Error on Line " << token.mLine << " Character " << token.mColumn << " : '" << token.mText.toString() << "'" << std::endl;
+        out << message << std::endl;
+        mErrors.push_back(out.str());
+
+        throw SyntaxError();
+    }
+}
@@ -0,0 +1,296 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#include <tribalscript/profiler.hpp>
+#include <tribalscript/function.hpp>
+
+namespace TribalScript
+{
+    //! The number of most frequent opcode pairs listed in the flat profile.
+    static const std::size_t sMaximumListedPairs = 20;
+
+    Profiler::Profiler() : mInstructionActive(false), mActiveInstruction(OpCode::NOP)
+    {
+        this->reset();
+    }
+
+    void Profiler::recordInstruction(const OpCode op)
+    {
+        const Clock::time_point now = Clock::now();
+
+        if (mInstructionActive)
+        {
+            mOpCodeStatistics[static_cast<std::size_t>(mActiveInstruction)].mTime += std::chrono::duration_cast<std::chrono::nanoseconds>(now - mInstructionStart).count();
+            ++mOpCodePairCounts[static_cast<std::size_t>(mActiveInstruction)][static_cast<std::size_t>(op)];
+        }
+
+        ++mOpCodeStatistics[static_cast<std::size_t>(op)].mCount;
+        mInstructionActive = true;
+        mActiveInstruction = op;
+        mInstructionStart = now;
+    }
+
+    void Profiler::endInstructions()
+    {
+        if (mInstructionActive)
+        {
+            mOpCodeStatistics[static_cast<std::size_t>(mActiveInstruction)].mTime += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - mInstructionStart).count();
+            mInstructionActive = false;
+        }
+    }
+
+    void Profiler::enterFunction(Function* function, const Bytecode* bytecode, const std::size_t offset)
+    {
+        const bool resumeInstruction = mInstructionActive;
+        const OpCode resumedInstruction = mActiveInstruction;
+        this->endInstructions();
+
+        FunctionStatistics& statistics = mFunctionStatistics[function];
+        ++statistics.mCalls;
+
+        CallTreeNode* parentNode = mActiveCalls.empty() ? mCallTree.get() : mActiveCalls.back().mNode;
+        std::unique_ptr<CallTreeNode>& node = parentNode->mChildren[function];
+        if (!node)
+        {
+            node.reset(new CallTreeNode(function));
+        }
+
+        auto callSiteSearch = mCallSiteStatistics.find(std::make_pair(bytecode, offset));
+        if (callSiteSearch == mCallSiteStatistics.end())
+        {
+            CallSiteStatistics callSite;
+            callSite.mCaller = mActiveCalls.empty() ? nullptr : mActiveCalls.back().mFunction;
+            callSite.mOffset = offset;
+            callSite.mCallee = function;
+            callSite.mCalls = 0;
+            callSite.mInclusiveTime = 0;
+            callSiteSearch = mCallSiteStatistics.insert(std::make_pair(std::make_pair(bytecode, offset), callSite)).first;
+        }
+
+        CallSiteStatistics* callSite = &callSiteSearch->second;
+        ++callSite->mCalls;
+
+        // The callee may differ between calls of the same site
+        callSite->mCallee = function;
+
+        ++mActiveCallCounts[function];
+
+        ActiveCall call;
+        call.mFunction = function;
+        call.mStatistics = &statistics;
+        call.mCallSite = callSite;
+        call.mNode = node.get();
+        call.mChildTime = 0;
+        call.mResumeInstruction = resumeInstruction;
+        call.mResumedInstruction = resumedInstruction;
+        call.mStart = Clock::now();
+        mActiveCalls.push_back(call);
+    }
+
+    void Profiler::exitFunction()
+    {
+        this->endInstructions();
+
+        if (mActiveCalls.empty())
+        {
+            return;
+        }
+
+        const Clock::time_point now = Clock::now();
+        const ActiveCall call = mActiveCalls.back();
+        mActiveCalls.pop_back();
+
+        const std::uint64_t inclusiveTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - call.mStart).count();
+        const std::uint64_t exclusiveTime = inclusiveTime > call.mChildTime ? inclusiveTime - call.mChildTime : 0;
+
+        call.mStatistics->mExclusiveTime += exclusiveTime;
+        call.mNode->mExclusiveTime += exclusiveTime;
+        call.mCallSite->mInclusiveTime += inclusiveTime;
+
+        // Only the outermost active call of a function contributes inclusive time
+        if (--mActiveCallCounts[call.mFunction] == 0)
+        {
+            call.mStatistics->mInclusiveTime += inclusiveTime;
+        }
+
+        if (!mActiveCalls.empty())
+        {
+            mActiveCalls.back().mChildTime += inclusiveTime;
+        }
+
+        mInstructionActive = call.mResumeInstruction;
+        mActiveInstruction = call.mResumedInstruction;
+        mInstructionStart = now;
+    }
+
+    void Profiler::reset()
+    {
+        for (OpCodeStatistics& statistics : mOpCodeStatistics)
+        {
+            statistics.mCount = 0;
+            statistics.mTime = 0;
+        }
+
+        for (auto&& row : mOpCodePairCounts)
+        {
+            for (std::uint64_t& count : row)
+            {
+                count = 0;
+            }
+        }
+
+        mInstructionActive = false;
+        mFunctionStatistics.clear();
+        mCallSiteStatistics.clear();
+        mActiveCalls.clear();
+        mActiveCallCounts.clear();
+        mCallTree.reset(new CallTreeNode(nullptr));
+    }
+
+    const Profiler::OpCodeStatistics& Profiler::getOpCodeStatistics(const OpCode op) const
+    {
+        return mOpCodeStatistics[static_cast<std::size_t>(op)];
+    }
+
+    std::uint64_t Profiler::getOpCodePairCount(const OpCode first, const OpCode second) const
+    {
+        return mOpCodePairCounts[static_cast<std::size_t>(first)][static_cast<std::size_t>(second)];
+    }
+
+    const std::unordered_map<Function*, Profiler::FunctionStatistics>& Profiler::getFunctionStatistics() const
+    {
+        return mFunctionStatistics;
+    }
+
+    std::vector<Profiler::CallSiteStatistics> Profiler::getCallSiteStatistics() const
+    {
+        std::vector<CallSiteStatistics> result;
+        for (auto&& callSite : mCallSiteStatistics)
+        {
+            result.push_back(callSite.second);
+        }
+        return result;
+    }
+
+    std::string Profiler::getFunctionName(Function* function)
+    {
+        if (!function)
+        {
+            return "<root>";
+        }
+
+        std::string result = function->getDeclaredNameSpace().empty() ? function->getDeclaredName() : function->getDeclaredNameSpace() + "::" + function->getDeclaredName();
+        if (!function->getDeclaredPackage().empty())
+        {
+            result += "[" + function->getDeclaredPackage() + "]";
+        }
+        return result;
+    }
+
+    std::string Profiler::getFlatProfile() const
+    {
+        std::ostringstream out;
+
+        std::vector<OpCode> opCodes;
+        for (std::size_t iteration = 0; iteration < static_cast<std::size_t>(OpCode::OpCodeCount); ++iteration)
+        {
+            if (mOpCodeStatistics[iteration].mCount)
+            {
+                opCodes.push_back(static_cast<OpCode>(iteration));
+            }
+        }
+        std::sort(opCodes.begin(), opCodes.end(), [this](const OpCode lhs, const OpCode rhs) {
+            return this->getOpCodeStatistics(lhs).mTime > this->getOpCodeStatistics(rhs).mTime;
+        });
+
+        out << "Opcodes:" << std::endl;
+        out << std::setw(24) << std::left << "opcode" << std::setw(16) << std::right << "count" << std::setw(16) << "time (ns)" << std::endl;
+        for (const OpCode op : opCodes)
+        {
+            const OpCodeStatistics& statistics = this->getOpCodeStatistics(op);
+            out << std::setw(24) << std::left << getOpCodeName(op) << std::setw(16) << std::right << statistics.mCount << std::setw(16) << statistics.mTime << std::endl;
+        }
+
+        std::vector<std::pair<Function*, FunctionStatistics>> functions(mFunctionStatistics.begin(), mFunctionStatistics.end());
+        std::sort(functions.begin(), functions.end(), [](const std::pair<Function*, FunctionStatistics>& lhs, const std::pair<Function*, FunctionStatistics>& rhs) {
+            return lhs.second.mExclusiveTime > rhs.second.mExclusiveTime;
+        });
+
+        out << std::endl << "Functions:" << std::endl;
+        out << std::setw(40) << std::left << "function" << std::setw(16) << std::right << "calls" << std::setw(20) << "inclusive (ns)" << std::setw(20) << "exclusive (ns)" << std::endl;
+        for (auto&& function : functions)
+        {
+            out << std::setw(40) << std::left << getFunctionName(function.first) << std::setw(16) << std::right << function.second.mCalls << std::setw(20) << function.second.mInclusiveTime << std::setw(20) << function.second.mExclusiveTime << std::endl;
+        }
+
+        std::vector<CallSiteStatistics> callSites = this->getCallSiteStatistics();
+        std::sort(callSites.begin(), callSites.end(), [](const CallSiteStatistics& lhs, const CallSiteStatistics& rhs) {
+            return lhs.mInclusiveTime > rhs.mInclusiveTime;
+        });
+
+        out << std::endl << "Call sites:" << std::endl;
+        out << std::setw(40) << std::left << "caller@offset" << std::setw(40) << "callee" << std::setw(16) << std::right << "calls" << std::setw(20) << "inclusive (ns)" << std::endl;
+        for (const CallSiteStatistics& callSite : callSites)
+        {
+            const std::string location = getFunctionName(callSite.mCaller) + "@" + std::to_string(callSite.mOffset);
+            out << std::setw(40) << std::left << location << std::setw(40) << getFunctionName(callSite.mCallee) << std::setw(16) << std::right << callSite.mCalls << std::setw(20) << callSite.mInclusiveTime << std::endl;
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        for (std::size_t first = 0; first < static_cast<std::size_t>(OpCode::OpCodeCount); ++first)
+        {
+            for (std::size_t second = 0; second < static_cast<std::size_t>(OpCode::OpCodeCount); ++second)
+            {
+                if (mOpCodePairCounts[first][second])
+                {
+                    pairs.push_back(std::make_pair(first, second));
+                }
+            }
+        }
+        std::sort(pairs.begin(), pairs.end(), [this](const std::pair<std::size_t, std::size_t>& lhs, const std::pair<std::size_t, std::size_t>& rhs) {
+            return mOpCodePairCounts[lhs.first][lhs.second] > mOpCodePairCounts[rhs.first][rhs.second];
+        });
+
+        out << std::endl << "Opcode pairs:" << std::endl;
+        out << std::setw(48) << std::left << "pair" << std::setw(16) << std::right << "count" << std::endl;
+        for (std::size_t iteration = 0; iteration < pairs.size() && iteration < sMaximumListedPairs; ++iteration)
+        {
+            const std::string pair = std::string(getOpCodeName(static_cast<OpCode>(pairs[iteration].first))) + ", " + getOpCodeName(static_cast<OpCode>(pairs[iteration].second));
+            out << std::setw(48) << std::left << pair << std::setw(16) << std::right << mOpCodePairCounts[pairs[iteration].first][pairs[iteration].second] << std::endl;
+        }
+
+        return out.str();
+    }
+
+    void Profiler::writeCollapsedStacks(std::ostream& out, const CallTreeNode& node, const std::string& prefix)
+    {
+        for (auto&& child : node.mChildren)
+        {
+            const std::string stack = prefix.empty() ? getFunctionName(child.first) : prefix + ";" + getFunctionName(child.first);
+            out << stack << " " << child.second->mExclusiveTime << std::endl;
+            writeCollapsedStacks(out, *child.second, stack);
+        }
+    }
+
+    std::string Profiler::getCollapsedStacks() const
+    {
+        std::ostringstream out;
+        writeCollapsedStacks(out, *mCallTree, "");
+        return out.str();
+    }
+}
@@ -21,7 +21,8 @@ namespace TribalScript
 
     ScriptObject::ScriptObject(Interpreter* interpreter, const std::string& className) : mClassName(className), ConsoleObject(interpreter)
     {
-        if (className != "")
+        // Every object of a given class shares one descriptor
+        if (className != "" && !interpreter->lookupDescriptor(className))
         {
             interpreter->registerConsoleObjectDescriptor(className, "ScriptObject", ScriptObject::instantiateFromDescriptor);
         }
@@ -22,7 +22,7 @@
 
 namespace TribalScript
 {
-    StandardConsoleObjectRegistry::StandardConsoleObjectRegistry() : mNextObjectID(0)
+    StandardConsoleObjectRegistry::StandardConsoleObjectRegistry()
     {
 
     }
@@ -30,7 +30,31 @@ namespace TribalScript
     void StandardConsoleObjectRegistry::setConsoleObject(Interpreter* interpreter, const std::string& name, ConsoleObject* value)
     {
         const std::string setName = toLowerCase(name);
-        mConsoleObjectsByName[setName] = value;
+
+        // Drop the name this object previously had
+        auto oldName = mObjectNames.find(value);
+        if (oldName != mObjectNames.end())
+        {
+            mConsoleObjectsByName.erase(oldName->second);
+            mObjectNames.erase(oldName);
+        }
+
+        // An empty name leaves the object unnamed
+        if (!setName.empty())
+        {
+            // Take the name from whatever object held it before
+            auto previousOwner = mConsoleObjectsByName.find(setName);
+            if (previousOwner != mConsoleObjectsByName.end())
+            {
+                mObjectNames.erase(previousOwner->second);
+                previousOwner->second = value;
+            }
+            else
+            {
+                mConsoleObjectsByName.emplace(setName, value);
+            }
+            mObjectNames[value] = setName;
+        }
 
         // Ensure an ID mapping exists
         this->addConsoleObject(interpreter, value);
@@ -38,8 +62,7 @@ namespace TribalScript
 
     ConsoleObject* StandardConsoleObjectRegistry::getConsoleObject(Interpreter* interpreter, const std::string& name)
     {
-        const std::string searchedName = toLowerCase(name);
-        auto search = mConsoleObjectsByName.find(searchedName);
+        auto search = mConsoleObjectsByName.find(name);
 
         if (search != mConsoleObjectsByName.end())
         {
@@ -50,23 +73,19 @@ namespace TribalScript
 
     ConsoleObject* StandardConsoleObjectRegistry::getConsoleObject(Interpreter* interpreter, const unsigned int id)
     {
-        auto search = mConsoleObjectsByID.find(id);
-
-        if (search != mConsoleObjectsByID.end())
+        if (id < mConsoleObjectsByID.size())
         {
-            return search->second;
+            return mConsoleObjectsByID[id];
         }
-
         return nullptr;
     }
 
     void StandardConsoleObjectRegistry::removeConsoleObject(Interpreter* interpreter, const std::string& name)
     {
-        const std::string removedName = toLowerCase(name);
-
-        auto search = mConsoleObjectsByName.find(removedName);
+        auto search = mConsoleObjectsByName.find(name);
         if (search != mConsoleObjectsByName.end())
         {
+            mObjectNames.erase(search->second);
             mConsoleObjectsByName.erase(search);
         }
     }
@@ -74,63 +93,64 @@ namespace TribalScript
     void StandardConsoleObjectRegistry::removeConsoleObject(Interpreter* interpreter, ConsoleObject* target)
     {
         // Remove from name mapping & ID mapping
-        for (auto iterator = mConsoleObjectsByName.begin(); iterator != mConsoleObjectsByName.end(); ++iterator)
+        auto name = mObjectNames.find(target);
+        if (name != mObjectNames.end())
         {
-            if (iterator->second == target)
-            {
-                mConsoleObjectsByName.erase(iterator);
-                break;
-            }
+            mConsoleObjectsByName.erase(name->second);
+            mObjectNames.erase(name);
         }
 
-        for (auto iterator = mConsoleObjectsByID.begin(); iterator != mConsoleObjectsByID.end(); ++iterator)
+        auto id = mObjectIDs.find(target);
+        if (id != mObjectIDs.end())
         {
-            if (iterator->second == target)
-            {
-                mConsoleObjectsByID.erase(iterator);
-                break;
-            }
+            mConsoleObjectsByID[id->second] = nullptr;
+            mFreeObjectIDs.push_back(id->second);
+            mObjectIDs.erase(id);
         }
     }
 
     unsigned int StandardConsoleObjectRegistry::addConsoleObject(Interpreter* interpreter, ConsoleObject* value)
     {
         // Check if it exists already in our ID mapping
-        for (auto iterator = mConsoleObjectsByID.begin(); iterator != mConsoleObjectsByID.end(); ++iterator)
+        auto search = mObjectIDs.find(value);
+        if (search != mObjectIDs.end())
         {
-            if (iterator->second == value)
-            {
-                return iterator->first;
-            }
+            return search->second;
         }
 
-        const unsigned int result = mNextObjectID++;
+        unsigned int result;
+        if (!mFreeObjectIDs.empty())
+        {
+            result = mFreeObjectIDs.back();
+            mFreeObjectIDs.pop_back();
+            mConsoleObjectsByID[result] = value;
+        }
+        else
+        {
+            result = static_cast<unsigned int>(mConsoleObjectsByID.size());
+            mConsoleObjectsByID.push_back(value);
+        }
 
-        mConsoleObjectsByID[result] = value;
+        mObjectIDs.emplace(value, result);
         return result;
     }
 
     std::string StandardConsoleObjectRegistry::getConsoleObjectName(Interpreter* interpreter, ConsoleObject* target)
     {
-        // Search name set
-        for (auto iterator = mConsoleObjectsByName.begin(); iterator != mConsoleObjectsByName.end(); ++iterator)
+        auto search = mObjectNames.find(target);
+        if (search != mObjectNames.end())
         {
-            if (iterator->second == target)
-            {
-                return iterator->first;
-            }
+            return search->second;
         }
         return "";
     }
 
     unsigned int StandardConsoleObjectRegistry::getConsoleObjectID(Interpreter* interpreter, ConsoleObject* target)
     {
-        for (auto iterator = mConsoleObjectsByID.begin(); iterator != mConsoleObjectsByID.end(); ++iterator)
+        auto search = mObjectIDs.find(target);
+        if (search != mObjectIDs.end())
         {
-            if (iterator->second == target)
-            {
-                return iterator->first;
-            }
+            return search->second;
         }
         return 0;
     }
@@ -94,6 +94,16 @@ namespace TribalScript
         mFileHandle = std::fstream(mPath, std::fstream::in | std::fstream::out);
     }
 
+    void StandardFileHandle::openForBinaryRead()
+    {
+        mFileHandle = std::fstream(mPath, std::fstream::in | std::fstream::binary);
+    }
+
+    void StandardFileHandle::openForBinaryWrite()
+    {
+        mFileHandle = std::fstream(mPath, std::fstream::out | std::fstream::binary);
+    }
+
     bool StandardFileHandle::exists()
     {
         FILE* handle = std::fopen(mPath.c_str(), "r");
@@ -12,30 +12,79 @@
  *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
+
 #include <tribalscript/storedvalue.hpp>
+#include <tribalscript/numberparser.hpp>
+#include <tribalscript/numberformatter.hpp>
+#include <tribalscript/stringhelpers.hpp>
 #include <tribalscript/interpreter.hpp>
 #include <tribalscript/consoleobject.hpp>
 #include <tribalscript/executionstate.hpp>
 
 namespace TribalScript
 {
-    bool StoredValue::toBoolean() const
+    StoredString* StoredString::allocate(const char* value, const std::size_t length)
     {
-        if (mReference)
+        return allocate(value, length, length);
+    }
+
+    StoredString* StoredString::allocate(const char* value, const std::size_t length, const std::size_t capacity)
+    {
+        assert(capacity >= length);
+
+        // mCharacters already accounts for the NULL terminator
+        StoredString* result = static_cast<StoredString*>(::operator new(sizeof(StoredString) + capacity));
+        result->mReferenceCount = 1;
+        result->mLength = length;
+        result->mCapacity = capacity;
+        result->mNumberParsed = false;
+        result->mComponentOffsets = nullptr;
+
+        std::memcpy(result->mCharacters, value, length);
+        result->mCharacters[length] = 0x00;
+        return result;
+    }
+
+    void StoredString::release(StoredString* string)
+    {
+        assert(string->mReferenceCount > 0);
+
+        if (--string->mReferenceCount == 0)
         {
-            return mReference->toInteger();
+            delete string->mComponentOffsets;
+            ::operator delete(string);
         }
+    }
 
-        return this->toInteger() != 0;
+    const StoredString* StoredValue::parseHeapString(StoredString* string)
+    {
+        if (!string->mNumberParsed)
+        {
+            string->mInteger = parseInteger(string->mCharacters);
+            string->mFloat = parseFloat(string->mCharacters);
+            string->mNumberParsed = true;
+        }
+        return string;
     }
 
-    ConsoleObject* StoredValue::toConsoleObject(ExecutionState* state)
+    const StoredValue* StoredValue::resolve() const
     {
-        if (mReference)
+        const StoredValue* result = this;
+        while (result->mTag == Tag::Reference)
         {
-            return mReference->toConsoleObject(state);
+            result = result->load<StoredValue*>();
         }
+        return result;
+    }
 
+    bool StoredValue::toBoolean() const
+    {
+        return this->toInteger() != 0;
+    }
+
+    ConsoleObject* StoredValue::toConsoleObject(ExecutionState* state)
+    {
         StoredValue rawValue = this->getReferencedValueCopy();
 
         // Search by ID first
@@ -52,207 +101,270 @@ namespace TribalScript
         return state->mInterpreter->mConfig.mConsoleObjectRegistry->getConsoleObject(state->mInterpreter, lookupName);
     }
 
-    bool StoredValue::isInteger()
+    bool StoredValue::isInteger() const
     {
-        if (mReference)
-        {
-            return mReference->isInteger();
-        }
-
-        return mType == StoredValueType::Integer;
+        const StoredValue* value = this->resolve();
+        return value->mTag == Tag::Integer || value->mTag == Tag::IntegerLocation;
     }
 
     bool StoredValue::setValue(const StoredValue& newValue)
     {
-        if (mReference)
+        if (mTag == Tag::Reference)
         {
-            return mReference->setValue(newValue);
+            return this->load<StoredValue*>()->setValue(newValue);
         }
-        else if (mMemoryLocation)
+
+        switch (mTag)
         {
-            switch (mType)
-            {
-            case StoredValueType::Float:
-                *reinterpret_cast<float*>(mMemoryLocation) = newValue.toFloat();
+            case Tag::FloatLocation:
+                *this->load<float*>() = newValue.toFloat();
                 return true;
-            case StoredValueType::Integer:
-                *reinterpret_cast<int*>(mMemoryLocation) = newValue.toInteger();
+            case Tag::IntegerLocation:
+                *this->load<int*>() = newValue.toInteger();
                 return true;
             default:
-                throw std::runtime_error("Unknown Memory Type");
-            }
+                break;
         }
 
         // Copy over stored data
-        if (newValue.mReference)
+        *this = newValue.getReferencedValueCopy();
+        return true;
+    }
+
+    char* StoredValue::resizeString(const std::size_t length)
+    {
+        if (mTag == Tag::SmallString)
         {
-            mType = newValue.mReference->mType;
-            mStorage = newValue.mReference->mStorage;
+            assert(length >= mSmallLength);
+
+            if (length <= SmallStringCapacity)
+            {
+                mSmallLength = static_cast<std::uint8_t>(length);
+                mData[length] = 0x00;
+                return mData;
+            }
+
+            StoredString* grown = StoredString::allocate(mData, mSmallLength, length);
+            grown->mLength = length;
+            grown->mCharacters[length] = 0x00;
+
+            mTag = Tag::HeapString;
+            this->store(grown);
+            return grown->mCharacters;
         }
-        else
+        else if (mTag != Tag::HeapString)
         {
-            mType = newValue.mType;
-            mStorage = newValue.mStorage;
+            return nullptr;
         }
 
-        return true;
+        StoredString* string = this->load<StoredString*>();
+        assert(length >= string->mLength);
+
+        if (string->mReferenceCount == 1 && length <= string->mCapacity)
+        {
+            string->mLength = length;
+            string->mNumberParsed = false;
+            string->mCharacters[length] = 0x00;
+
+            delete string->mComponentOffsets;
+            string->mComponentOffsets = nullptr;
+            return string->mCharacters;
+        }
+
+        // Only unshared strings are likely to be appended to again, so copies of shared ones are sized exactly
+        const std::size_t capacity = string->mReferenceCount == 1 ? std::max(length, string->mCapacity * 2) : length;
+        StoredString* grown = StoredString::allocate(string->mCharacters, string->mLength, capacity);
+        grown->mLength = length;
+        grown->mCharacters[length] = 0x00;
+
+        StoredString::release(string);
+        this->store(grown);
+        return grown->mCharacters;
     }
 
     void StoredValue::setValue(const float newValue)
     {
-        if (mReference)
+        switch (mTag)
         {
-            return mReference->setValue(newValue);
-        }
-        else if (mMemoryLocation)
-        {
-            switch (mType)
-            {
-            case StoredValueType::Float:
-                *reinterpret_cast<float*>(mMemoryLocation) = newValue;
+            case Tag::Reference:
+                this->load<StoredValue*>()->setValue(newValue);
                 return;
-            case StoredValueType::Integer:
-                *reinterpret_cast<int*>(mMemoryLocation) = static_cast<int>(newValue);
+            case Tag::FloatLocation:
+                *this->load<float*>() = newValue;
+                return;
+            case Tag::IntegerLocation:
+                *this->load<int*>() = static_cast<int>(newValue);
                 return;
             default:
-                throw std::runtime_error("Unknown Memory Type");
-            }
+                *this = StoredValue(newValue);
+                return;
         }
-
-        mType = StoredValueType::Float;
-        mStorage.mFloat = newValue;
     }
 
     int StoredValue::toInteger() const
     {
-        if (mReference)
+        const StoredValue* value = this->resolve();
+
+        switch (value->mTag)
         {
-            return mReference->toInteger();
+            case Tag::Null:
+                return 0;
+            case Tag::Integer:
+                return value->load<int>();
+            case Tag::Float:
+                return (int)value->load<float>();
+            case Tag::IntegerLocation:
+                return *value->load<int*>();
+            case Tag::FloatLocation:
+                return (int)*value->load<float*>();
+            case Tag::SmallString:
+                return parseInteger(value->mData);
+            case Tag::HeapString:
+                return parseHeapString(value->load<StoredString*>())->mInteger;
+            default:
+                break;
         }
 
-        StoredValue* referenced;
+        throw std::runtime_error("Unknown Conversion");
+    }
 
-        switch (mType)
+    std::string StoredValue::toString() const
+    {
+        const StoredValue* value = this->resolve();
+
+        switch (value->mTag)
         {
-        case StoredValueType::Integer:
-            return mStorage.mInteger;
-        case StoredValueType::Float:
-            return (int)mStorage.mFloat;
-        case StoredValueType::String:
-            try
+            case Tag::Null:
+                return "";
+            case Tag::Integer:
+                return std::to_string(value->load<int>());
+            case Tag::Float:
             {
-                return std::stoi(mStorage.mStringPointer);
+                // Floats remember their formatted form in the otherwise unused part of mData when it fits
+                if (value->mSmallLength != 0)
+                {
+                    return std::string(value->mData + sizeof(float), value->mSmallLength);
+                }
+
+                char buffer[FormattedFloatBufferSize];
+                const std::size_t length = formatFloat(value->load<float>(), buffer);
+                if (length <= FormattedFloatCacheCapacity)
+                {
+                    std::memcpy(value->mData + sizeof(float), buffer, length);
+                    value->mSmallLength = static_cast<std::uint8_t>(length);
+                }
+                return std::string(buffer, length);
             }
-            catch (std::invalid_argument exception)
+            case Tag::IntegerLocation:
+                return std::to_string(*value->load<int*>());
+            case Tag::FloatLocation:
             {
-                return 0;
+                char buffer[FormattedFloatBufferSize];
+                return std::string(buffer, formatFloat(*value->load<float*>(), buffer));
+            }
+            case Tag::SmallString:
+                return std::string(value->mData, value->mSmallLength);
+            case Tag::HeapString:
+            {
+                const StoredString* string = value->load<StoredString*>();
+                return std::string(string->mCharacters, string->mLength);
             }
+            default:
+                break;
         }
 
         throw std::runtime_error("Unknown Conversion");
     }
 
-    std::string StoredValue::toString()
+    bool StoredValue::getStringData(const char*& characters, std::size_t& length) const
     {
-        if (mReference)
-        {
-            return mReference->toString();
-        }
-
-        StoredValue* referenced;
+        const StoredValue* value = this->resolve();
 
-        switch (mType)
+        switch (value->mTag)
         {
-        case StoredValueType::Integer:
-            return std::to_string(mStorage.mInteger);
-        case StoredValueType::Float:
-            return std::to_string(mStorage.mFloat);
-        case StoredValueType::String:
-            return mStorage.mStringPointer;
+            case Tag::SmallString:
+                characters = value->mData;
+                length = value->mSmallLength;
+                return true;
+            case Tag::HeapString:
+            {
+                const StoredString* string = value->load<StoredString*>();
+                characters = string->mCharacters;
+                length = string->mLength;
+                return true;
+            }
+            default:
+                return false;
         }
-
-        throw std::runtime_error("Unknown Conversion");
     }
 
-    StoredValue StoredValue::getReferencedValueCopy() const
+    const std::vector<std::size_t>* StoredValue::getComponentOffsets(const unsigned char delineator) const
     {
-        if (mReference)
+        const StoredValue* value = this->resolve();
+        if (value->mTag != Tag::HeapString)
         {
-            return mReference->getReferencedValueCopy();
+            return nullptr;
         }
 
-        switch (mType)
+        StoredString* string = value->load<StoredString*>();
+        if (!string->mComponentOffsets)
+        {
+            string->mComponentOffsets = new std::vector<std::size_t>();
+        }
+        else if (string->mComponentDelineator == delineator)
         {
-        case StoredValueType::Integer:
-            return StoredValue(mStorage.mInteger);
-        case StoredValueType::Float:
-            return StoredValue(mStorage.mFloat);
-        case StoredValueType::String:
-            return StoredValue(mStorage.mStringPointer);
+            return string->mComponentOffsets;
         }
 
-        throw std::runtime_error("Unknown Conversion");
+        string->mComponentDelineator = delineator;
+        findComponentOffsets(string->mCharacters, string->mLength, delineator, *string->mComponentOffsets);
+        return string->mComponentOffsets;
     }
 
-    float StoredValue::toFloat() const
+    StoredValue StoredValue::getReferencedValueCopy() const
     {
-        if (mReference)
-        {
-            return mReference->toFloat();
-        }
-        else if (mMemoryLocation)
+        const StoredValue* value = this->resolve();
+
+        switch (value->mTag)
         {
-            switch (mType)
-            {
-            case StoredValueType::Float:
-                return *reinterpret_cast<float*>(mMemoryLocation);
-            case StoredValueType::Integer:
-                return static_cast<float>(*reinterpret_cast<int*>(mMemoryLocation));
+            case Tag::IntegerLocation:
+                return StoredValue(*value->load<int*>());
+            case Tag::FloatLocation:
+                return StoredValue(*value->load<float*>());
             default:
-                throw std::runtime_error("Unknown Memory Type");
-            }
+                return *value;
         }
+    }
 
-        StoredValue* referenced;
+    float StoredValue::toFloat() const
+    {
+        const StoredValue* value = this->resolve();
 
-        switch (mType)
+        switch (value->mTag)
         {
-
-        case StoredValueType::Integer:
-            return (float)mStorage.mInteger;
-        case StoredValueType::Float:
-            return mStorage.mFloat;
-        case StoredValueType::String:
-            try
-            {
-                return std::stof(mStorage.mStringPointer);
-            }
-            catch (std::invalid_argument exception)
-            {
-                return 0;
-            }
+            case Tag::Null:
+                return 0.0f;
+            case Tag::Integer:
+                return (float)value->load<int>();
+            case Tag::Float:
+                return value->load<float>();
+            case Tag::IntegerLocation:
+                return static_cast<float>(*value->load<int*>());
+            case Tag::FloatLocation:
+                return *value->load<float*>();
+            case Tag::SmallString:
+                return parseFloat(value->mData);
+            case Tag::HeapString:
+                return parseHeapString(value->load<StoredString*>())->mFloat;
+            default:
+                break;
         }
 
         throw std::runtime_error("Unknown Conversion");
     }
 
-    std::string StoredValue::getRepresentation()
+    std::string StoredValue::getRepresentation() const
     {
-        if (mReference)
-        {
-            return mReference->getRepresentation();
-        }
-
-        switch (mType)
-        {
-        case StoredValueType::Integer:
-            return std::to_string(mStorage.mInteger);
-        case StoredValueType::Float:
-            return std::to_string(mStorage.mFloat);
-        case StoredValueType::String:
-            return mStorage.mStringPointer;
-        }
-
-        throw std::runtime_error("Unknown Conversion");
+        return this->toString();
     }
 }
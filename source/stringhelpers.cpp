@@ -12,250 +12,270 @@
  *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-#include <regex>
 #include <string>
 #include <vector>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 
+#include <tribalscript/casefolding.hpp>
 #include <tribalscript/stringhelpers.hpp>
 
 namespace TribalScript
 {
-    std::vector<std::pair<std::size_t, std::size_t>> getDelineatorData(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count, std::size_t& realDelineatorCount)
+    void findComponentOffsets(const char* characters, const std::size_t length, const unsigned char delineator, std::vector<std::size_t>& out)
     {
-        std::vector<std::pair<std::size_t, std::size_t>> dataLocations;
-        dataLocations.reserve(count);
+        out.clear();
+        out.push_back(0);
 
-        // Search for the delineators that we need
-        std::size_t currentDataStart = 0;
-        std::size_t currentDelineatorCount = 0;
-        for (std::size_t iteration = 0; iteration < in.size(); ++iteration)
+        // memchr is vectorized by the C library, which matters for long lists
+        const char* const end = characters + length;
+        const char* current = characters;
+        while ((current = static_cast<const char*>(std::memchr(current, delineator, static_cast<std::size_t>(end - current)))))
         {
-            unsigned char character = in[iteration];
-
-            // Increment delineator count
-            if (currentDelineatorCount >= startComponent && (character == delineator || iteration == in.size() - 1))
-            {
-                const std::size_t dataEnd = iteration == in.size() - 1 ? iteration + 1 : iteration;
-
-                if (currentDelineatorCount >= startComponent)
-                {
-                    dataLocations.push_back(std::make_pair(currentDataStart, dataEnd));
-                }
-
-                // Set next start
-                currentDataStart = iteration + 1;
-                ++currentDelineatorCount;
-
-                if (currentDelineatorCount >= count + startComponent)
-                {
-                    break;
-                }
-            }
-            else if (character == delineator)
-            {
-                currentDataStart = iteration + 1;
-                ++currentDelineatorCount;
-            }
+            ++current;
+            out.push_back(static_cast<std::size_t>(current - characters));
         }
-
-        realDelineatorCount = currentDelineatorCount;
-        return dataLocations;
     }
 
-    std::vector<std::string> getStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count)
+    StringComponents::StringComponents(const StoredValue& value, const unsigned char delineator) : mDelineator(delineator), mCharacters(nullptr), mLength(0), mOffsets(nullptr)
     {
-        std::vector<std::string> result;
-        result.reserve(count);
-
-        std::size_t realDelineatorCount;
-        std::vector<std::pair<std::size_t, std::size_t>> dataLocations = getDelineatorData(in, delineator, startComponent, count, realDelineatorCount);
-
-        // Process all pairs now
-        for (auto&& dataPair : dataLocations)
+        if (!value.getStringData(mCharacters, mLength))
         {
-            const std::size_t dataStart = dataPair.first;
-            const std::size_t dataEnd = dataPair.second;
+            mOwnedString = value.toString();
+            mCharacters = mOwnedString.c_str();
+            mLength = mOwnedString.size();
+        }
 
-            result.push_back(in.substr(dataStart, dataEnd - dataStart));
+        mOffsets = value.getComponentOffsets(delineator);
+        if (!mOffsets)
+        {
+            findComponentOffsets(mCharacters, mLength, delineator, mOwnedOffsets);
+            mOffsets = &mOwnedOffsets;
         }
-        return result;
     }
 
-    std::string getStringComponentsJoined(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count)
+    StringComponents::StringComponents(const std::string& value, const unsigned char delineator) : mDelineator(delineator), mCharacters(value.c_str()), mLength(value.size()), mOffsets(&mOwnedOffsets)
     {
-        const std::vector<std::string> components = getStringComponents(in, delineator, startComponent, count);
+        findComponentOffsets(mCharacters, mLength, delineator, mOwnedOffsets);
+    }
 
-        std::ostringstream result;
-        for (std::size_t iteration = 0; iteration < components.size(); ++iteration)
+    std::size_t StringComponents::getCount() const
+    {
+        if (mLength == 0)
         {
-            if (iteration != components.size() - 1)
-            {
-                result << components[iteration] << delineator;
-            }
-            else
-            {
-                result << components[iteration];
-            }
+            return 0;
         }
-
-        return result.str();
+        return static_cast<unsigned char>(mCharacters[mLength - 1]) == mDelineator ? mOffsets->size() - 1 : mOffsets->size();
     }
 
-    std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents)
+    StoredValue StringComponents::getComponents(const std::size_t first, const std::size_t count) const
     {
-        std::size_t realDelineatorCount = 0;
-        std::vector<std::pair<std::size_t, std::size_t>> delineatorData = getDelineatorData(in, delineator, startComponent, newComponents.size(), realDelineatorCount);
+        if (first >= mOffsets->size() || count == 0)
+        {
+            return StoredValue("");
+        }
 
-        // If the delineator data is not equal to our component count then some of the data needs appended (with the delineator in between)
-        const std::size_t endIndex = startComponent + newComponents.size();
-        std::size_t appendedCount = endIndex >= realDelineatorCount ? endIndex - realDelineatorCount : 0;
+        const std::size_t last = count > mOffsets->size() - first ? mOffsets->size() - 1 : first + count - 1;
+        const std::size_t start = (*mOffsets)[first];
+        const std::size_t end = this->getComponentEnd(last);
 
-        std::string leftHalf;
-        std::string rightHalf;
-        std::ostringstream stream;
+        return StoredValue(mCharacters + start, end - start);
+    }
 
-        if (delineatorData.size() != 0)
-        {
-            leftHalf = in.substr(0,delineatorData[0].first);
-            rightHalf = in.substr(delineatorData[delineatorData.size() - 1].second, in.size() );
-        }
-        else
+    std::vector<std::string> StringComponents::getComponentStrings(const std::size_t first, const std::size_t count) const
+    {
+        std::vector<std::string> result;
+        for (std::size_t component = first; component < mOffsets->size() && component - first < count; ++component)
         {
-            stream << in;
-            appendedCount = newComponents.size();
+            const std::size_t start = (*mOffsets)[component];
+            result.push_back(std::string(mCharacters + start, this->getComponentEnd(component) - start));
         }
+        return result;
+    }
 
-        // Set everything in between now ...
-        stream << leftHalf;
+    std::string StringComponents::setComponents(const std::size_t first, const std::vector<std::string>& newComponents) const
+    {
+        std::string result;
 
-        for (std::size_t iteration = 0; iteration < delineatorData.size(); ++iteration)
+        std::size_t suffixStart = mLength;
+        if (first < mOffsets->size())
         {
-            const std::pair<std::size_t, std::size_t>& dataPair = delineatorData[iteration];
-            const std::string nextField = iteration < newComponents.size() ? newComponents[iteration] : in.substr(dataPair.first, dataPair.second - dataPair.first);
+            result.assign(mCharacters, (*mOffsets)[first]);
 
-            if (iteration == 0)
-            {
-                stream << nextField;
-            }
-            else
-            {
-                stream << delineator << nextField;
-            }
+            const std::size_t replacedCount = std::min(newComponents.size(), mOffsets->size() - first);
+            suffixStart = replacedCount ? this->getComponentEnd(first + replacedCount - 1) : (*mOffsets)[first];
+        }
+        else
+        {
+            // Pad with empty components up to the first new one
+            result.assign(mCharacters, mLength);
+            result.append(first - mOffsets->size() + 1, static_cast<char>(mDelineator));
         }
 
-        // Append empty delineators
-        if (startComponent - appendedCount >= realDelineatorCount)
+        for (std::size_t iteration = 0; iteration < newComponents.size(); ++iteration)
         {
-            const std::size_t emptyDelineatorCount = (startComponent - appendedCount) - 1;
-            for (std::size_t iteration = 0; iteration < emptyDelineatorCount; ++iteration)
+            if (iteration != 0)
             {
-                stream << delineator;
+                result += static_cast<char>(mDelineator);
             }
+            result += newComponents[iteration];
         }
 
-        // Handle appended results now
-        for (std::size_t iteration = newComponents.size() - appendedCount; iteration < newComponents.size(); ++iteration)
-        {
-            stream << delineator << newComponents[iteration];
-        }
+        result.append(mCharacters + suffixStart, mLength - suffixStart);
+        return result;
+    }
+
+    std::vector<std::string> getStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::size_t count)
+    {
+        return StringComponents(in, delineator).getComponentStrings(startComponent, count);
+    }
 
-        stream << rightHalf;
-        return stream.str();
+    std::string setStringComponents(const std::string& in, const unsigned char delineator, const std::size_t startComponent, const std::vector<std::string>& newComponents)
+    {
+        return StringComponents(in, delineator).setComponents(startComponent, newComponents);
     }
 
     std::string toLowerCase(const std::string& in)
     {
         std::string result = in;
-        std::transform(result.begin(), result.end(), result.begin(), [](unsigned char character) { return std::tolower(character); });
+        if (!result.empty())
+        {
+            foldCase(result.data(), result.size(), &result[0]);
+        }
         return result;
     }
 
-    std::string expandEscapeSequences(const std::string& in)
+    /**
+     *  @brief Converts a hex digit to its value.
+     *  @return The value of the digit, or -1 if the character is not a hex digit.
+     */
+    static int getHexDigitValue(const char character)
     {
-        std::regex colorRegex("\\\\c([0-9])");
-        std::regex hexRegex("\\\\x([0-9a-f]{1,2})");
-        std::regex otherSequences("\\\\([tn])");
+        if (character >= '0' && character <= '9')
+        {
+            return character - '0';
+        }
+        else if (character >= 'a' && character <= 'f')
+        {
+            return character - 'a' + 10;
+        }
+        else if (character >= 'A' && character <= 'F')
+        {
+            return character - 'A' + 10;
+        }
+        return -1;
+    }
 
-        std::string result = in;
+    //! The characters \c0 through \c9 expand to. In T2 these are just aliases for unprintable characters used as color codes.
+    static const char sColorEscapes[] = { 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0B, 0x0C, 0x0E };
 
-        // Handle hex escapes
-        std::smatch match;
-        while (std::regex_search(result, match, hexRegex))
+    std::string expandEscapeSequences(const char* in, const std::size_t length)
+    {
+        // Most strings contain no escapes at all
+        const char* const end = in + length;
+        const char* escape = static_cast<const char*>(std::memchr(in, '\\', length));
+        if (!escape)
         {
-            const unsigned long hexValue = std::stoul(match[1], nullptr, 16);
-            std::string hexString(1, (const char)hexValue);
-
-            const std::string beginning = result.substr(0, match.position());
-            const std::string ending = result.substr(match.position() + match.length(), result.size());
-            result = beginning + hexString + ending;
+            return std::string(in, length);
         }
 
-        // Handle color escapes - in T2 these are just aliases for an unprintable
-        while (std::regex_search(result, match, colorRegex))
+        // Escapes only ever shrink the string
+        std::string result;
+        result.reserve(length);
+
+        const char* current = in;
+        while (escape)
         {
-            const unsigned long integerValue = std::stoul(match[1], nullptr, 10);
-            std::string colorString = "";
-            switch (integerValue)
+            result.append(current, escape);
+            current = escape + 1;
+
+            const char type = current != end ? *current : '\0';
+            switch (type)
             {
-                case 0:
-                    colorString = "\x02";
-                    break;
-                case 1:
-                    colorString = "\x03";
+                case 'n':
+                    result += '\n';
+                    ++current;
                     break;
-                case 2:
-                    colorString = "\x04";
+                case 't':
+                    result += '\t';
+                    ++current;
                     break;
-                case 3:
-                    colorString = "\x05";
+                case 'r':
+                    result += '\r';
+                    ++current;
                     break;
-                case 4:
-                    colorString = "\x06";
+                case '\\':
+                case '"':
+                case '\'':
+                    result += type;
+                    ++current;
                     break;
-                case 5:
-                    colorString = "\x07";
-                    break;
-                case 6:
-                    colorString = "\x08";
-                    break;
-                case 7:
-                    colorString = "\x0B";
+                case 'x':
+                {
+                    // One or two hex digits
+                    const int high = current + 1 != end ? getHexDigitValue(current[1]) : -1;
+                    if (high < 0)
+                    {
+                        result += '\\';
+                        break;
+                    }
+
+                    const int low = current + 2 != end ? getHexDigitValue(current[2]) : -1;
+                    if (low < 0)
+                    {
+                        result += static_cast<char>(high);
+                        current += 2;
+                    }
+                    else
+                    {
+                        result += static_cast<char>(high * 16 + low);
+                        current += 3;
+                    }
                     break;
-                case 8:
-                    colorString = "\x0C";
+                }
+                case 'c':
+                {
+                    const char color = current + 1 != end ? current[1] : '\0';
+                    if (color >= '0' && color <= '9')
+                    {
+                        result += sColorEscapes[color - '0'];
+                    }
+                    else if (color == 'r')
+                    {
+                        result += '\x0F';
+                    }
+                    else if (color == 'p')
+                    {
+                        result += '\x10';
+                    }
+                    else if (color == 'o')
+                    {
+                        result += '\x11';
+                    }
+                    else
+                    {
+                        result += '\\';
+                        break;
+                    }
+                    current += 2;
                     break;
-                case 9:
-                    colorString = "\x0E";
+                }
+                default:
+                    // Unknown sequences are kept as written
+                    result += '\\';
                     break;
             }
 
-            const std::string beginning = result.substr(0, match.position());
-            const std::string ending = result.substr(match.position() + match.length(), result.size());
-            result = beginning + colorString + ending;
-        }
-
-        // Handle ie. tab and newline sequences
-        while (std::regex_search(result, match, otherSequences))
-        {
-            const std::string beginning = result.substr(0, match.position());
-            const std::string ending = result.substr(match.position() + match.length(), result.size());
-
-            if (match[1] == "n")
-            {
-                result = beginning + '\n' + ending;
-            }
-            else if (match[1] == "t")
-            {
-                result = beginning + '\t' + ending;
-            }
-            else
-            {
-                throw std::invalid_argument("Unexpected escape type!");
-            }
+            escape = static_cast<const char*>(std::memchr(current, '\\', static_cast<std::size_t>(end - current)));
         }
 
+        result.append(current, end);
         return result;
     }
+
+    std::string expandEscapeSequences(const std::string& in)
+    {
+        return expandEscapeSequences(in.data(), in.size());
+    }
 }
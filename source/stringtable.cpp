@@ -12,26 +12,200 @@
  *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <cstring>
+
 #include <tribalscript/stringtable.hpp>
+#include <tribalscript/stringhelpers.hpp>
+#include <tribalscript/casefolding.hpp>
 
 namespace TribalScript
 {
+    //! The number of buckets a new string table starts out with.
+    static const std::size_t sInitialBucketCount = 256;
+
+    const StringTableEntry StringTable::EmptyBucket;
+
+    StringTable::StringTable() : mBuckets(sInitialBucketCount, EmptyBucket)
+    {
+
+    }
+
+    //! The FNV-1a offset basis.
+    static const std::uint64_t sHashBasis = 14695981039346656037ULL;
+
+    /**
+     *  @brief Continues an FNV-1a hash over more characters.
+     */
+    static inline std::uint64_t hashCharacters(std::uint64_t hash, const char* string, const std::size_t length)
+    {
+        for (std::size_t iteration = 0; iteration < length; ++iteration)
+        {
+            hash ^= static_cast<unsigned char>(string[iteration]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    static inline std::size_t finishHash(const std::uint64_t hash)
+    {
+        return static_cast<std::size_t>(hash ^ (hash >> 32));
+    }
+
+    std::size_t StringTable::hashString(const char* string, const std::size_t length)
+    {
+        return finishHash(hashCharacters(sHashBasis, string, length));
+    }
+
+    std::size_t StringTable::hashFolded(const char* string, const std::size_t length)
+    {
+        // Fold through a small buffer so the hash matches that of the lower case form without building it
+        char folded[64];
+
+        std::uint64_t hash = sHashBasis;
+        for (std::size_t offset = 0; offset < length; offset += sizeof(folded))
+        {
+            const std::size_t chunk = length - offset < sizeof(folded) ? length - offset : sizeof(folded);
+            foldCase(string + offset, chunk, folded);
+            hash = hashCharacters(hash, folded, chunk);
+        }
+        return finishHash(hash);
+    }
+
     StringTableEntry StringTable::getOrAssign(const std::string& string)
     {
-        std::hash<std::string> hasher;
+        return this->getOrAssign(string.data(), string.size());
+    }
 
-        const StringTableEntry stringHash = hasher(string);
-        auto search = this->find(stringHash);
+    bool StringTable::findHashed(const char* string, const std::size_t length, const std::size_t hash, StringTableEntry& result) const
+    {
+        const std::size_t mask = mBuckets.size() - 1;
 
-        if (search == this->end())
+        for (std::size_t bucket = hash & mask; mBuckets[bucket] != EmptyBucket; bucket = (bucket + 1) & mask)
         {
-            this->emplace(std::make_pair(stringHash, string));
+            const StringTableEntry entry = mBuckets[bucket];
+            const std::string& candidate = mStrings[entry];
+
+            if (mHashes[entry] == hash && candidate.size() == length && std::memcmp(candidate.data(), string, length) == 0)
+            {
+                result = entry;
+                return true;
+            }
         }
-        return stringHash;
+        return false;
     }
 
-    const std::string& StringTable::getString(const StringTableEntry id)
+    StringTableEntry StringTable::getOrAssign(const char* string, const std::size_t length)
     {
-        return this->at(id);
+        const std::size_t hash = hashString(string, length);
+
+        StringTableEntry result;
+        if (this->findHashed(string, length, hash, result))
+        {
+            return result;
+        }
+        return this->assign(string, length, hash);
+    }
+
+    bool StringTable::find(const char* string, const std::size_t length, StringTableEntry& result) const
+    {
+        return this->findHashed(string, length, hashString(string, length), result);
+    }
+
+    bool StringTable::findFolded(const char* string, const std::size_t length, StringTableEntry& result) const
+    {
+        // Strings seen before in any case already know their lower case form
+        StringTableEntry entry;
+        if (this->find(string, length, entry))
+        {
+            result = mFoldedEntries[entry];
+            return true;
+        }
+
+        // Otherwise look for the lower case form itself. An entry that is its own lower case form and matches ignoring
+        // case is exactly the folded string.
+        const std::size_t hash = hashFolded(string, length);
+        const std::size_t mask = mBuckets.size() - 1;
+
+        for (std::size_t bucket = hash & mask; mBuckets[bucket] != EmptyBucket; bucket = (bucket + 1) & mask)
+        {
+            const StringTableEntry candidateEntry = mBuckets[bucket];
+            const std::string& candidate = mStrings[candidateEntry];
+
+            if (mHashes[candidateEntry] == hash && mFoldedEntries[candidateEntry] == candidateEntry && equalsCaseInsensitive(candidate.data(), candidate.size(), string, length))
+            {
+                result = candidateEntry;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    StringTableEntry StringTable::getOrAssignFolded(const std::string& string)
+    {
+        return mFoldedEntries[this->getOrAssign(string.data(), string.size())];
+    }
+
+    StringTableEntry StringTable::getOrAssignFolded(const char* string, const std::size_t length)
+    {
+        return mFoldedEntries[this->getOrAssign(string, length)];
+    }
+
+    StringTableEntry StringTable::getFolded(const StringTableEntry id) const
+    {
+        return mFoldedEntries.at(id);
+    }
+
+    const std::string& StringTable::getString(const StringTableEntry id) const
+    {
+        return mStrings.at(id);
+    }
+
+    std::size_t StringTable::size() const
+    {
+        return mStrings.size();
+    }
+
+    StringTableEntry StringTable::assign(const char* string, const std::size_t length, const std::size_t hash)
+    {
+        const StringTableEntry entry = static_cast<StringTableEntry>(mStrings.size());
+
+        mStrings.emplace_back(string, length);
+        mHashes.push_back(hash);
+        mFoldedEntries.push_back(entry);
+
+        // Keep the load factor at or below one half
+        if (mStrings.size() * 2 > mBuckets.size())
+        {
+            mBuckets.assign(mBuckets.size() * 2, EmptyBucket);
+            for (StringTableEntry existing = 0; existing < mStrings.size(); ++existing)
+            {
+                this->insertBucket(existing);
+            }
+        }
+        else
+        {
+            this->insertBucket(entry);
+        }
+
+        // Link the lower case form, which may assign another entry
+        const std::string folded = toLowerCase(mStrings[entry]);
+        if (folded != mStrings[entry])
+        {
+            const StringTableEntry foldedEntry = this->getOrAssign(folded);
+            mFoldedEntries[entry] = foldedEntry;
+        }
+        return entry;
+    }
+
+    void StringTable::insertBucket(const StringTableEntry entry)
+    {
+        const std::size_t mask = mBuckets.size() - 1;
+
+        std::size_t bucket = mHashes[entry] & mask;
+        while (mBuckets[bucket] != EmptyBucket)
+        {
+            bucket = (bucket + 1) & mask;
+        }
+        mBuckets[bucket] = entry;
     }
 }
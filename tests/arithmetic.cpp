@@ -0,0 +1,120 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <climits>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+static TribalScript::StoredValue* evaluateGlobal(TribalScript::Interpreter& interpreter, const std::string& source, const std::string& global)
+{
+    interpreter.evaluate(source);
+    return interpreter.getGlobal(global);
+}
+
+TEST(ArithmeticTest, IntegerOperators)
+{
+    const TribalScript::StoredValue two(2);
+    const TribalScript::StoredValue three(3);
+
+    ASSERT_TRUE((two + three).isInteger());
+    ASSERT_EQ((two + three).toInteger(), 5);
+    ASSERT_TRUE((two - three).isInteger());
+    ASSERT_EQ((two - three).toInteger(), -1);
+    ASSERT_TRUE((two * three).isInteger());
+    ASSERT_EQ((two * three).toInteger(), 6);
+    ASSERT_TRUE((-two).isInteger());
+    ASSERT_EQ((-two).toInteger(), -2);
+
+    // Division and anything involving a float or string produces a float
+    ASSERT_FALSE((three / two).isInteger());
+    ASSERT_EQ((three / two).toFloat(), 1.5f);
+    ASSERT_FALSE((two + TribalScript::StoredValue(0.5f)).isInteger());
+    ASSERT_EQ((two + TribalScript::StoredValue(0.5f)).toFloat(), 2.5f);
+    ASSERT_FALSE((two + TribalScript::StoredValue("3")).isInteger());
+    ASSERT_EQ((two + TribalScript::StoredValue("3")).toFloat(), 5.0f);
+
+    // References to integers are integers too
+    TribalScript::StoredValue variable(7);
+    ASSERT_TRUE((TribalScript::StoredValue(&variable) + two).isInteger());
+    ASSERT_EQ((TribalScript::StoredValue(&variable) + two).toInteger(), 9);
+}
+
+TEST(ArithmeticTest, IntegerOverflow)
+{
+    const TribalScript::StoredValue maximum(INT_MAX);
+    const TribalScript::StoredValue minimum(INT_MIN);
+
+    ASSERT_FALSE((maximum + TribalScript::StoredValue(1)).isInteger());
+    ASSERT_EQ((maximum + TribalScript::StoredValue(1)).toFloat(), 2147483648.0f);
+    ASSERT_FALSE((minimum - TribalScript::StoredValue(1)).isInteger());
+    ASSERT_FALSE((maximum * maximum).isInteger());
+    ASSERT_FALSE((-minimum).isInteger());
+    ASSERT_EQ((-minimum).toFloat(), 2147483648.0f);
+}
+
+TEST(ArithmeticTest, StringConversions)
+{
+    // Strings that are not numeric, or only partially so, never throw
+    ASSERT_EQ(TribalScript::StoredValue("").toInteger(), 0);
+    ASSERT_EQ(TribalScript::StoredValue("").toFloat(), 0.0f);
+    ASSERT_EQ(TribalScript::StoredValue("name").toInteger(), 0);
+    ASSERT_EQ(TribalScript::StoredValue("12abc").toInteger(), 12);
+    ASSERT_EQ(TribalScript::StoredValue("2.5").toFloat(), 2.5f);
+    ASSERT_EQ(TribalScript::StoredValue("99999999999999").toInteger(), 0);
+
+    // Long strings cache their numeric interpretation, which must survive copies
+    const TribalScript::StoredValue heap("        1234.5    ");
+    const TribalScript::StoredValue copy = heap;
+    ASSERT_EQ(heap.toFloat(), 1234.5f);
+    ASSERT_EQ(copy.toFloat(), 1234.5f);
+    ASSERT_EQ(copy.toInteger(), 1234);
+    ASSERT_EQ(TribalScript::StoredValue("a long string that is not a number").toFloat(), 0.0f);
+}
+
+TEST(ArithmeticTest, ScriptedCounters)
+{
+    for (unsigned int level = 0; level < 2; ++level)
+    {
+        TribalScript::InterpreterConfiguration config;
+        config.mOptimizationLevel = level;
+        TribalScript::Interpreter interpreter(config);
+        TribalScript::registerAllLibraries(&interpreter);
+
+        TribalScript::StoredValue* result = evaluateGlobal(interpreter, "function count(%n) { %total = 0; for (%i = 0; %i < %n; %i++) { %total = %total + %i * 2 - 1; } return %total; } $result = count(100);", "result");
+        ASSERT_TRUE(result->isInteger());
+        ASSERT_EQ(result->toString(), "9800");
+
+        result = evaluateGlobal(interpreter, "$folded = -(2 + 3) * 4;", "folded");
+        ASSERT_TRUE(result->isInteger());
+        ASSERT_EQ(result->toInteger(), -20);
+
+        result = evaluateGlobal(interpreter, "$mixed = 1 + 0.5;", "mixed");
+        ASSERT_FALSE(result->isInteger());
+        ASSERT_EQ(result->toFloat(), 1.5f);
+
+        result = evaluateGlobal(interpreter, "$large = 16777216; $large = $large + 1;", "large");
+        ASSERT_EQ(result->toInteger(), 16777217);
+    }
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/ast.hpp>
+#include <tribalscript/astarena.hpp>
+
+TEST(ASTArena, Alignment)
+{
+    TribalScript::AST::ASTArena arena;
+
+    // Interleave small and wide allocations so that the arena has to pad between them
+    for (unsigned int iteration = 0; iteration < 1000; ++iteration)
+    {
+        void* byte = arena.allocate(1, 1);
+        void* wide = arena.allocate(sizeof(double), alignof(double));
+
+        ASSERT_NE(byte, nullptr);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(wide) % alignof(double), 0);
+    }
+    ASSERT_GE(arena.getBytesAllocated(), 1000 * (1 + sizeof(double)));
+}
+
+TEST(ASTArena, Blocks)
+{
+    TribalScript::AST::ASTArena arena;
+    ASSERT_EQ(arena.getBlockCount(), 0);
+
+    arena.allocate(16, 8);
+    ASSERT_EQ(arena.getBlockCount(), 1);
+
+    // An allocation too large to share a block gets one of its own
+    unsigned char* large = static_cast<unsigned char*>(arena.allocate(1024 * 1024, 8));
+    large[1024 * 1024 - 1] = 0xFF;
+    ASSERT_EQ(arena.getBlockCount(), 2);
+
+    // Smaller allocations continue to come from the shared block
+    arena.allocate(16, 8);
+    ASSERT_EQ(arena.getBlockCount(), 2);
+}
+
+TEST(ASTArena, Strings)
+{
+    TribalScript::AST::ASTArena arena;
+
+    std::string source = "Hello World";
+    const TribalScript::AST::StringView hello = arena.createString(source.data(), 5);
+    const TribalScript::AST::StringView world = arena.createString(std::string("World"));
+    const TribalScript::AST::StringView empty = arena.createString("", 0);
+
+    // The arena owns a copy of the text, independent of the source
+    source = "Changed";
+    ASSERT_EQ(hello.toString(), "Hello");
+    ASSERT_EQ(world.toString(), "World");
+    ASSERT_EQ(world.size(), 5);
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.toString(), "");
+}
+
+TEST(ASTArena, Nodes)
+{
+    TribalScript::AST::ASTArena arena;
+
+    std::vector<TribalScript::AST::ASTNode*> operands;
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        operands.push_back(arena.create<TribalScript::AST::IntegerNode>(iteration));
+    }
+
+    const TribalScript::AST::ArenaList<TribalScript::AST::ASTNode*> list = arena.createList(operands);
+    ASSERT_EQ(list.size(), 3);
+    ASSERT_EQ(list.front(), operands.front());
+    ASSERT_EQ(list.back(), operands.back());
+
+    // Lists are walked in both directions by the compiler
+    std::vector<TribalScript::AST::ASTNode*> reversed(list.rbegin(), list.rend());
+    ASSERT_EQ(reversed, std::vector<TribalScript::AST::ASTNode*>(operands.rbegin(), operands.rend()));
+
+    ASSERT_TRUE(arena.createList(std::vector<TribalScript::AST::ASTNode*>()).empty());
+    ASSERT_EQ(static_cast<TribalScript::AST::IntegerNode*>(list[2])->mValue, 2);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
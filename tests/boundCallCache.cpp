@@ -0,0 +1,56 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+#include <tribalscript/executionstate.hpp>
+
+static int getGlobalInteger(TribalScript::Interpreter& interpreter, const std::string& name)
+{
+    TribalScript::StoredValue* value = interpreter.getGlobal(name);
+    EXPECT_TRUE(value);
+    return value ? value->toInteger() : -1;
+}
+
+TEST(InterpreterTest, BoundCallCache)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+
+    TribalScript::ExecutionState state = TribalScript::ExecutionState(&interpreter);
+    interpreter.execute("cases/boundCallCache.cs", &state);
+
+    // A single call site dispatching on several types
+    ASSERT_EQ(getGlobalInteger(interpreter, "plain"), 1);
+    ASSERT_EQ(getGlobalInteger(interpreter, "dog"), 2);
+    ASSERT_EQ(getGlobalInteger(interpreter, "cat"), 1);
+
+    // Changes to the function table must be picked up
+    ASSERT_EQ(getGlobalInteger(interpreter, "catRedefined"), 3);
+    ASSERT_EQ(getGlobalInteger(interpreter, "dogActivated"), 12);
+    ASSERT_EQ(getGlobalInteger(interpreter, "dogDeactivated"), 2);
+
+    ASSERT_EQ(getGlobalInteger(interpreter, "sum"), 3 * (1 + 2 + 3 + 4 + 5 + 6));
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
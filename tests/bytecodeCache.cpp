@@ -0,0 +1,308 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/bytecode.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/executionstate.hpp>
+#include <tribalscript/bytecodeserializer.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+static const char* sScriptPath = "cases/bytecodeCache.cs";
+static const char* sCachePath = "cases/bytecodeCache.cs.dso";
+
+static std::string readFile(const std::string& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    return buffer.str();
+}
+
+static void writeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream output(path, std::ios::binary);
+    output.write(content.data(), content.size());
+}
+
+static TribalScript::InterpreterConfiguration getCachingConfiguration()
+{
+    TribalScript::InterpreterConfiguration config;
+    config.mCacheBytecode = true;
+    return config;
+}
+
+static void checkResults(TribalScript::Interpreter& interpreter)
+{
+    ASSERT_TRUE(interpreter.getGlobal("sum"));
+    ASSERT_EQ(interpreter.getGlobal("sum")->toInteger(), 5);
+
+    ASSERT_TRUE(interpreter.getGlobal("packagedSum"));
+    ASSERT_EQ(interpreter.getGlobal("packagedSum")->toInteger(), 10);
+
+    ASSERT_TRUE(interpreter.getGlobal("arrayResult"));
+    ASSERT_EQ(interpreter.getGlobal("arrayResult")->toString(), "element");
+
+    ASSERT_TRUE(interpreter.getGlobal("described"));
+    ASSERT_EQ(interpreter.getGlobal("described")->toString(), "value: 42");
+
+    // Tagged strings must refer to the same string in whichever interpreter loaded the bytecode
+    ASSERT_TRUE(interpreter.getGlobal("tagged"));
+    ASSERT_EQ(interpreter.mStringTable.getString(interpreter.getGlobal("tagged")->toInteger()), "tagged");
+}
+
+TEST(BytecodeCacheTest, WriteAndLoad)
+{
+    std::remove(sCachePath);
+
+    {
+        TribalScript::Interpreter interpreter(getCachingConfiguration());
+        TribalScript::registerAllLibraries(&interpreter);
+        interpreter.execute(sScriptPath, nullptr);
+        checkResults(interpreter);
+    }
+
+    const std::string cache = readFile(sCachePath);
+    ASSERT_FALSE(cache.empty());
+
+    {
+        // Assign some unrelated strings first so the string table entries differ from the ones the cache was written with
+        TribalScript::Interpreter interpreter(getCachingConfiguration());
+        interpreter.setGlobal("unrelated", TribalScript::StoredValue(1));
+        interpreter.setGlobal("another unrelated", TribalScript::StoredValue(2));
+        TribalScript::registerAllLibraries(&interpreter);
+
+        interpreter.execute(sScriptPath, nullptr);
+        checkResults(interpreter);
+    }
+
+    // Loading must not have rewritten the cache
+    ASSERT_EQ(readFile(sCachePath), cache);
+    std::remove(sCachePath);
+}
+
+TEST(BytecodeCacheTest, UsesMatchingCache)
+{
+    TribalScript::Interpreter interpreter(getCachingConfiguration());
+    TribalScript::registerAllLibraries(&interpreter);
+
+    // A cache recorded against the script's source is used in place of the script
+    TribalScript::CodeBlock* replacement = interpreter.compile("$replaced = 1;");
+    ASSERT_TRUE(replacement);
+
+    const std::uint64_t sourceHash = TribalScript::BytecodeSerializer::hashSource(readFile(sScriptPath));
+    writeFile(sCachePath, TribalScript::BytecodeSerializer::serialize(replacement->getBytecode(), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+    delete replacement;
+
+    interpreter.execute(sScriptPath, nullptr);
+    ASSERT_TRUE(interpreter.getGlobal("replaced"));
+    ASSERT_EQ(interpreter.getGlobal("replaced")->toInteger(), 1);
+    ASSERT_FALSE(interpreter.getGlobal("sum"));
+    std::remove(sCachePath);
+}
+
+TEST(BytecodeCacheTest, ReplacesInvalidCache)
+{
+    writeFile(sCachePath, "not bytecode");
+
+    TribalScript::Interpreter interpreter(getCachingConfiguration());
+    TribalScript::registerAllLibraries(&interpreter);
+    interpreter.execute(sScriptPath, nullptr);
+    checkResults(interpreter);
+
+    ASSERT_NE(readFile(sCachePath), "not bytecode");
+    std::remove(sCachePath);
+}
+
+TEST(BytecodeCacheTest, ReplacesOutdatedCache)
+{
+    TribalScript::Interpreter interpreter(getCachingConfiguration());
+    TribalScript::registerAllLibraries(&interpreter);
+
+    // A cache written by the previous format version, which formatted folded floats differently, must not be used
+    TribalScript::CodeBlock* replacement = interpreter.compile("$replaced = 1.5 @ \"\";");
+    ASSERT_TRUE(replacement);
+
+    const std::uint64_t sourceHash = TribalScript::BytecodeSerializer::hashSource(readFile(sScriptPath));
+    std::string outdated = TribalScript::BytecodeSerializer::serialize(replacement->getBytecode(), sourceHash, interpreter.mConfig, interpreter.mStringTable);
+    delete replacement;
+
+    const std::uint32_t outdatedVersion = TribalScript::BytecodeSerializer::FormatVersion - 1;
+    ASSERT_GE(outdated.size(), 2 * sizeof(std::uint32_t));
+    outdated.replace(sizeof(std::uint32_t), sizeof(outdatedVersion), reinterpret_cast<const char*>(&outdatedVersion), sizeof(outdatedVersion));
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(outdated, sourceHash, interpreter.mConfig, interpreter.mStringTable));
+
+    writeFile(sCachePath, outdated);
+    interpreter.execute(sScriptPath, nullptr);
+    checkResults(interpreter);
+    ASSERT_FALSE(interpreter.getGlobal("replaced"));
+
+    // The script was compiled again and the cache rewritten with the current version
+    const std::string rewritten = readFile(sCachePath);
+    ASSERT_NE(rewritten, outdated);
+    ASSERT_TRUE(TribalScript::BytecodeSerializer::deserialize(rewritten, sourceHash, interpreter.mConfig, interpreter.mStringTable));
+    std::remove(sCachePath);
+}
+
+TEST(BytecodeCacheTest, RejectsMismatchedData)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+
+    const std::string source = readFile(sScriptPath);
+    TribalScript::CodeBlock* compiled = interpreter.compile(source);
+    ASSERT_TRUE(compiled);
+
+    const std::uint64_t sourceHash = TribalScript::BytecodeSerializer::hashSource(source);
+    const std::string data = TribalScript::BytecodeSerializer::serialize(compiled->getBytecode(), sourceHash, interpreter.mConfig, interpreter.mStringTable);
+    delete compiled;
+
+    ASSERT_TRUE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash, interpreter.mConfig, interpreter.mStringTable));
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash + 1, interpreter.mConfig, interpreter.mStringTable));
+
+    // Bytecode compiled with any other option that affects code generation must be rejected as well
+    TribalScript::InterpreterConfiguration caseSensitive;
+    caseSensitive.mCaseSensitive = true;
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash, caseSensitive, interpreter.mStringTable));
+
+    TribalScript::InterpreterConfiguration unoptimized;
+    unoptimized.mOptimizationLevel = 0;
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash, unoptimized, interpreter.mStringTable));
+
+    TribalScript::InterpreterConfiguration otherFrontend;
+    otherFrontend.mFrontend = interpreter.mConfig.mFrontend == TribalScript::ParserFrontend::ANTLR ? TribalScript::ParserFrontend::HandWritten : TribalScript::ParserFrontend::ANTLR;
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash, otherFrontend, interpreter.mStringTable));
+
+    // Truncated data must be rejected rather than read past its end
+    for (std::size_t length = 0; length < data.size(); ++length)
+    {
+        ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(data.substr(0, length), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+    }
+}
+
+/**
+ *  @brief Finds the byte offset of the first word of top level code in serialized bytecode by skipping the header
+ *  and the string section.
+ */
+static std::size_t getCodeOffset(const std::string& data)
+{
+    // Magic, version, flags, optimization level and source hash
+    std::size_t offset = 4 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    std::uint32_t entryCount;
+    std::memcpy(&entryCount, data.data() + offset, sizeof(entryCount));
+    offset += sizeof(entryCount);
+    for (std::uint32_t iteration = 0; iteration < entryCount; ++iteration)
+    {
+        std::uint32_t length;
+        std::memcpy(&length, data.data() + offset, sizeof(length));
+        offset += sizeof(length) + length;
+    }
+
+    // The code size precedes the code
+    return offset + sizeof(std::uint32_t);
+}
+
+static std::string replaceWord(const std::string& data, const std::size_t codeOffset, const std::size_t word, const TribalScript::BytecodeWord value)
+{
+    std::string result = data;
+    result.replace(codeOffset + word * sizeof(value), sizeof(value), reinterpret_cast<const char*>(&value), sizeof(value));
+    return result;
+}
+
+TEST(BytecodeCacheTest, AcceptsEveryCase)
+{
+    static const char* const sCases[] = {
+        "array", "boundCallCache", "breakFor", "bytecodeCache", "callSiteCache", "chaining", "chains", "combined",
+        "continueWhile", "controlFlow", "for", "function", "if", "localSlots", "memoryReference", "nestedBreakFor",
+        "opOrder", "package", "scriptObject", "shortCircuit", "simGroup", "switch", "treeInitialization", "while"
+    };
+
+    // Validation must never reject bytecode the compiler produced, at any optimization level
+    for (unsigned int optimizationLevel = 0; optimizationLevel <= 1; ++optimizationLevel)
+    {
+        TribalScript::InterpreterConfiguration config;
+        config.mOptimizationLevel = optimizationLevel;
+        TribalScript::Interpreter interpreter(config);
+
+        for (const char* caseName : sCases)
+        {
+            const std::string source = readFile(std::string("cases/") + caseName + ".cs");
+            ASSERT_FALSE(source.empty()) << caseName;
+
+            std::unique_ptr<TribalScript::CodeBlock> compiled(interpreter.compile(source));
+            ASSERT_TRUE(compiled) << caseName;
+
+            const std::uint64_t sourceHash = TribalScript::BytecodeSerializer::hashSource(source);
+            const std::string data = TribalScript::BytecodeSerializer::serialize(compiled->getBytecode(), sourceHash, interpreter.mConfig, interpreter.mStringTable);
+            ASSERT_TRUE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash, interpreter.mConfig, interpreter.mStringTable)) << caseName;
+        }
+    }
+}
+
+TEST(BytecodeCacheTest, RejectsCorruptedCode)
+{
+    TribalScript::Interpreter interpreter;
+
+    const std::string source = "$a = \"hello\"; while ($a !$= \"x\") { $a = \"y\"; }";
+    std::unique_ptr<TribalScript::CodeBlock> compiled(interpreter.compile(source));
+    ASSERT_TRUE(compiled);
+
+    const std::uint64_t sourceHash = TribalScript::BytecodeSerializer::hashSource(source);
+    const std::string data = TribalScript::BytecodeSerializer::serialize(compiled->getBytecode(), sourceHash, interpreter.mConfig, interpreter.mStringTable);
+    ASSERT_TRUE(TribalScript::BytecodeSerializer::deserialize(data, sourceHash, interpreter.mConfig, interpreter.mStringTable));
+
+    // The code starts by assigning a string constant to a global and ends by jumping back to the loop condition
+    const std::vector<TribalScript::BytecodeWord>& code = compiled->getBytecode().mCode;
+    const std::size_t codeOffset = getCodeOffset(data);
+    const std::size_t pushString = 2;
+    const std::size_t jump = code.size() - 3;
+
+    ASSERT_EQ(code[0], static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::PushGlobalReference));
+    ASSERT_EQ(code[pushString], static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::PushString));
+    ASSERT_EQ(code[jump], static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::Jump));
+    ASSERT_EQ(code.back(), static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::Halt));
+
+    // An unknown opcode
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(replaceWord(data, codeOffset, pushString, static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::OpCodeCount)), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+
+    // A string constant index past the end of the pool, and a global reference turned into a nonexistent frame slot
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(replaceWord(data, codeOffset, pushString + 1, 1000), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(replaceWord(data, codeOffset, 0, static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::PushLocalSlot)), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+
+    // Jump targets past the end of the code and into the middle of an instruction
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(replaceWord(data, codeOffset, jump + 1, static_cast<TribalScript::BytecodeWord>(code.size())), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(replaceWord(data, codeOffset, jump + 1, pushString + 1), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+
+    // An instruction running past the end of the code
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(replaceWord(data, codeOffset, jump, static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::CallFunction)), sourceHash, interpreter.mConfig, interpreter.mStringTable));
+
+    // The last instruction must be Halt, not merely the last word
+    const std::string swallowedHalt = replaceWord(replaceWord(data, codeOffset, jump, static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::NOP)), codeOffset, jump + 1, static_cast<TribalScript::BytecodeWord>(TribalScript::OpCode::PushInteger));
+    ASSERT_FALSE(TribalScript::BytecodeSerializer::deserialize(swallowedHalt, sourceHash, interpreter.mConfig, interpreter.mStringTable));
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/nativefunction.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+#include <tribalscript/executionstate.hpp>
+
+static int getGlobalInteger(TribalScript::Interpreter& interpreter, const std::string& name)
+{
+    TribalScript::StoredValue* value = interpreter.getGlobal(name);
+    EXPECT_TRUE(value);
+    return value ? value->toInteger() : -1;
+}
+
+TEST(InterpreterTest, CallSiteCache)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+
+    TribalScript::ExecutionState state = TribalScript::ExecutionState(&interpreter);
+    interpreter.execute("cases/callSiteCache.cs", &state);
+
+    // The same call site must pick up every change to what it resolves to
+    ASSERT_EQ(getGlobalInteger(interpreter, "before"), 1);
+    ASSERT_EQ(getGlobalInteger(interpreter, "activated"), 11);
+    ASSERT_EQ(getGlobalInteger(interpreter, "deactivated"), 1);
+    ASSERT_EQ(getGlobalInteger(interpreter, "redefined"), 5);
+
+    ASSERT_EQ(getGlobalInteger(interpreter, "missingBefore"), 0);
+    ASSERT_EQ(getGlobalInteger(interpreter, "missingAfter"), 7);
+}
+
+static TribalScript::StoredValue RedefineRunningBuiltIn(TribalScript::ConsoleObject* thisObject, TribalScript::ExecutionState* state, const TribalScript::StoredValueSpan& parameters)
+{
+    state->mInterpreter->evaluate("function running(%value) { return 10; }");
+    return TribalScript::StoredValue(0);
+}
+
+TEST(InterpreterTest, RetiredFunctionsAreReleased)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+    interpreter.addFunction(std::shared_ptr<TribalScript::Function>(new TribalScript::NativeFunction(RedefineRunningBuiltIn, PACKAGE_EMPTY, NAMESPACE_EMPTY, "redefineRunning")));
+
+    // A function replaced outside of any execution is released right away
+    interpreter.evaluate("function replaced() { return 1; }");
+    std::weak_ptr<TribalScript::Function> replaced = interpreter.getFunction(NAMESPACE_EMPTY, "replaced");
+    ASSERT_FALSE(replaced.expired());
+
+    interpreter.evaluate("function replaced() { return 2; }");
+    ASSERT_TRUE(replaced.expired());
+
+    // A function replaced while it is running finishes with its own body and is released once execution ends
+    interpreter.evaluate("function running(%value) { redefineRunning(); %local = %value + 1; return %local; }");
+    std::weak_ptr<TribalScript::Function> running = interpreter.getFunction(NAMESPACE_EMPTY, "running");
+
+    interpreter.evaluate("$first = running(1); $second = running(1);");
+    ASSERT_EQ(getGlobalInteger(interpreter, "first"), 2);
+    ASSERT_EQ(getGlobalInteger(interpreter, "second"), 10);
+    ASSERT_TRUE(running.expired());
+
+    // Removing a package releases its functions as well
+    interpreter.evaluate("package released { function inPackage() { return 3; } }; activatePackage(released);");
+    std::weak_ptr<TribalScript::Function> inPackage = interpreter.getFunction(NAMESPACE_EMPTY, "inPackage");
+    ASSERT_FALSE(inPackage.expired());
+
+    interpreter.removeFunctionRegistry("released");
+    ASSERT_TRUE(inPackage.expired());
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/casefolding.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+#include <tribalscript/executionstate.hpp>
+
+static std::string foldWithCType(const std::string& value)
+{
+    std::string result = value;
+    for (char& character : result)
+    {
+        character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+    }
+    return result;
+}
+
+TEST(CaseFoldingTest, AllBytes)
+{
+    // Every byte value at every position within a word, including the tail that is folded past the last whole word
+    for (std::size_t length = 1; length <= 19; ++length)
+    {
+        for (std::size_t position = 0; position < length; ++position)
+        {
+            for (unsigned int byte = 0; byte < 256; ++byte)
+            {
+                std::string value(length, 'q');
+                value[position] = static_cast<char>(byte);
+
+                std::string folded(length, '\0');
+                TribalScript::foldCase(value.data(), value.size(), &folded[0]);
+
+                const std::string expected = foldWithCType(value);
+                ASSERT_EQ(folded, expected);
+
+                ASSERT_TRUE(TribalScript::equalsCaseInsensitive(value, expected));
+                ASSERT_EQ(TribalScript::hashCaseInsensitive(value.data(), value.size()), TribalScript::hashCaseInsensitive(expected.data(), expected.size()));
+            }
+        }
+    }
+}
+
+TEST(CaseFoldingTest, Comparison)
+{
+    const std::vector<std::string> values = {
+        "", "a", "A", "b", "@", "`", "[", "{", "Z", "z",
+        "ConsoleObject", "CONSOLEOBJECT", "consoleobject", "ConsoleObjecu", "ConsoleObjec",
+        "A longer name spanning several words", "a LONGER name SPANNING several WORDS", "a longer name spanning several wordz"
+    };
+
+    for (const std::string& lhs : values)
+    {
+        for (const std::string& rhs : values)
+        {
+            const bool expected = foldWithCType(lhs) == foldWithCType(rhs);
+            ASSERT_EQ(TribalScript::equalsCaseInsensitive(lhs, rhs), expected);
+            ASSERT_EQ(TribalScript::CaseInsensitiveEqual()(lhs, rhs), expected);
+
+            const int order = TribalScript::compareCaseInsensitive(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+            const int expectedOrder = foldWithCType(lhs).compare(foldWithCType(rhs));
+            ASSERT_EQ(order < 0, expectedOrder < 0);
+            ASSERT_EQ(order == 0, expectedOrder == 0);
+            ASSERT_EQ(TribalScript::CaseInsensitiveLess()(lhs, rhs), expectedOrder < 0);
+
+            if (expected)
+            {
+                ASSERT_EQ(TribalScript::CaseInsensitiveHash()(lhs), TribalScript::CaseInsensitiveHash()(rhs));
+            }
+        }
+    }
+
+    // Only letters are folded, so characters that differ by the case bit otherwise must not compare equal
+    ASSERT_FALSE(TribalScript::equalsCaseInsensitive("@", "`"));
+    ASSERT_FALSE(TribalScript::equalsCaseInsensitive("[", "{"));
+    ASSERT_TRUE(TribalScript::equalsCaseInsensitive(std::string("parent"), "PaReNt"));
+}
+
+TEST(CaseFoldingTest, Map)
+{
+    TribalScript::CaseInsensitiveMap<int> map;
+    map["FirstName"] = 1;
+    map["FIRSTNAME"] = 2;
+    map["secondName"] = 3;
+
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map.find("firstname")->second, 2);
+    ASSERT_EQ(map.find("firstname")->first, "FirstName");
+    ASSERT_EQ(map.find("SECONDNAME")->second, 3);
+    ASSERT_TRUE(map.find("thirdName") == map.end());
+}
+
+TEST(CaseFoldingTest, ConfigurableMap)
+{
+    TribalScript::ConfigurableCaseMap<int> insensitive(0, TribalScript::ConfigurableCaseHash(false), TribalScript::ConfigurableCaseEqual(false));
+    insensitive["ScriptObject"] = 1;
+    ASSERT_EQ(insensitive.find("SCRIPTOBJECT")->second, 1);
+    ASSERT_EQ(insensitive.find("scriptobject")->first, "ScriptObject");
+
+    TribalScript::ConfigurableCaseMap<int> sensitive(0, TribalScript::ConfigurableCaseHash(true), TribalScript::ConfigurableCaseEqual(true));
+    sensitive["ScriptObject"] = 1;
+    sensitive["SCRIPTOBJECT"] = 2;
+    ASSERT_EQ(sensitive.size(), 2);
+    ASSERT_EQ(sensitive.find("ScriptObject")->second, 1);
+    ASSERT_TRUE(sensitive.find("scriptobject") == sensitive.end());
+}
+
+TEST(CaseFoldingTest, Descriptors)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+
+    // Types are found in any case and keep the case they were registered with
+    TribalScript::ConsoleObjectDescriptor* descriptor = interpreter.lookupDescriptor("SCRIPTOBJECT");
+    ASSERT_TRUE(descriptor);
+    ASSERT_EQ(interpreter.lookupDescriptor("scriptobject"), descriptor);
+    ASSERT_EQ(descriptor->mName, "ScriptObject");
+
+    TribalScript::InterpreterConfiguration config;
+    config.mCaseSensitive = true;
+    TribalScript::Interpreter caseSensitive(config);
+    TribalScript::registerAllLibraries(&caseSensitive);
+
+    ASSERT_TRUE(caseSensitive.lookupDescriptor("ScriptObject"));
+    ASSERT_FALSE(caseSensitive.lookupDescriptor("SCRIPTOBJECT"));
+}
+
+TEST(CaseFoldingTest, Script)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+
+    TribalScript::ExecutionState state = TribalScript::ExecutionState(&interpreter);
+    interpreter.execute("cases/caseFolding.cs", &state);
+
+    TribalScript::StoredValue* before = interpreter.getGlobal("before");
+    ASSERT_TRUE(before);
+    ASSERT_EQ(before->toInteger(), 1);
+
+    TribalScript::StoredValue* afterActivate = interpreter.getGlobal("afterActivate");
+    ASSERT_TRUE(afterActivate);
+    ASSERT_EQ(afterActivate->toInteger(), 2);
+
+    TribalScript::StoredValue* afterDeactivate = interpreter.getGlobal("afterDeactivate");
+    ASSERT_TRUE(afterDeactivate);
+    ASSERT_EQ(afterDeactivate->toInteger(), 1);
+
+    TribalScript::StoredValue* field = interpreter.getGlobal("field");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->toInteger(), 6);
+
+    TribalScript::StoredValue* assignedField = interpreter.getGlobal("assignedField");
+    ASSERT_TRUE(assignedField);
+    ASSERT_EQ(assignedField->toInteger(), 7);
+
+    TribalScript::StoredValue* name = interpreter.getGlobal("name");
+    ASSERT_TRUE(name);
+    ASSERT_EQ(name->toString(), "foldedobject");
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
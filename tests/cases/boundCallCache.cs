@@ -0,0 +1,81 @@
+function ScriptObject::describe(%this)
+{
+    return 1;
+}
+
+function Animal::describe(%this)
+{
+    return 2;
+}
+
+function Bird::describe(%this)
+{
+    return 4;
+}
+
+function Fish::describe(%this)
+{
+    return 5;
+}
+
+function Snake::describe(%this)
+{
+    return 6;
+}
+
+function callDescribe(%object)
+{
+    return %object.describe();
+}
+
+package override
+{
+    function Animal::describe(%this)
+    {
+        return parent::describe(%this) + 10;
+    }
+};
+
+new ScriptObject(Plain);
+new ScriptObject(Dog)
+{
+    class = "Animal";
+};
+new ScriptObject(Cat)
+{
+    class = "Feline";
+};
+new ScriptObject(Crow)
+{
+    class = "Bird";
+};
+new ScriptObject(Trout)
+{
+    class = "Fish";
+};
+new ScriptObject(Viper)
+{
+    class = "Snake";
+};
+
+$plain = callDescribe(Plain);
+$dog = callDescribe(Dog);
+$cat = callDescribe(Cat);
+
+function Feline::describe(%this)
+{
+    return 3;
+}
+$catRedefined = callDescribe(Cat);
+
+activatePackage(override);
+$dogActivated = callDescribe(Dog);
+deactivatePackage(override);
+$dogDeactivated = callDescribe(Dog);
+
+// More receiver types than a call site caches
+$sum = 0;
+for (%iteration = 0; %iteration < 3; %iteration++)
+{
+    $sum = $sum + callDescribe(Plain) + callDescribe(Dog) + callDescribe(Cat) + callDescribe(Crow) + callDescribe(Trout) + callDescribe(Viper);
+}
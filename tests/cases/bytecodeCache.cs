@@ -0,0 +1,34 @@
+function sum(%a, %b)
+{
+    %result = %a + %b;
+    return %result;
+}
+
+function ScriptObject::describe(%this, %prefix)
+{
+    return %prefix @ %this.value;
+}
+
+package doubled
+{
+    function sum(%a, %b)
+    {
+        return parent::sum(%a, %b) * 2;
+    }
+};
+
+$sum = sum(2, 3);
+activatePackage(doubled);
+$packagedSum = sum(2, 3);
+deactivatePackage(doubled);
+
+$array[1] = "element";
+$arrayResult = $array[1];
+
+new ScriptObject(Cached)
+{
+    value = 42;
+};
+$described = Cached.describe("value: ");
+
+$tagged = 'tagged';
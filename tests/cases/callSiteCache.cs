@@ -0,0 +1,41 @@
+function getNumber()
+{
+    return 1;
+}
+
+function callGetNumber()
+{
+    return getNumber();
+}
+
+package override
+{
+    function getNumber()
+    {
+        return parent::getNumber() + 10;
+    }
+};
+
+function callMissing()
+{
+    return missingFunction();
+}
+
+$before = callGetNumber();
+activatePackage(override);
+$activated = callGetNumber();
+deactivatePackage(override);
+$deactivated = callGetNumber();
+
+function getNumber()
+{
+    return 5;
+}
+$redefined = callGetNumber();
+
+$missingBefore = callMissing();
+function missingFunction()
+{
+    return 7;
+}
+$missingAfter = callMissing();
@@ -0,0 +1,29 @@
+function MixedCase::getNumber()
+{
+    return 1;
+}
+
+package MixedPackage
+{
+    function mixedcase::getNumber()
+    {
+        return PARENT::getNumber() + 1;
+    }
+};
+
+$before = MIXEDCASE::GETNUMBER();
+activatePackage(mixedPACKAGE);
+$afterActivate = mixedCase::getnumber();
+DEACTIVATEPACKAGE(MixedPackage);
+$afterDeactivate = mixedcase::getNumber();
+
+new ScriptObject(FoldedObject)
+{
+    SomeField = 5;
+    someField = 6;
+};
+
+$field = foldedobject.SOMEFIELD;
+FOLDEDOBJECT.somefield = 7;
+$assignedField = FoldedObject.someField;
+$name = FoldedObject.GETNAME();
@@ -0,0 +1,19 @@
+// Branches of different lengths
+$ternaryTrue = (1 ? 1 + 2 + 3 : 7);
+$ternaryFalse = (0 ? 1 + 2 + 3 : 7);
+$ternaryLongFalse = (0 ? 7 : 1 + 2 + 3 + 4);
+
+// Continue must reevaluate the condition rather than resume within the body
+$continueSkipped = 0;
+$continueCounted = 0;
+%i = 0;
+while (%i < 6)
+{
+    %i++;
+    if (%i % 2 == 0)
+        continue;
+
+    $continueCounted = $continueCounted + 1;
+    $continueCounted = $continueCounted + 0;
+    $continueSkipped = $continueSkipped + %i;
+}
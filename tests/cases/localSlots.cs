@@ -0,0 +1,31 @@
+function fib(%n)
+{
+    if (%n < 2)
+    {
+        return %n;
+    }
+    return fib(%n - 1) + fib(%n - 2);
+}
+
+function arrayAlias(%value)
+{
+    %entry[1] = %value;
+    return %entry_1;
+}
+
+function missingParameter(%a, %b)
+{
+    return %b;
+}
+
+function localsReset()
+{
+    %counter = %counter + 1;
+    return %counter;
+}
+
+$fib = fib(10);
+$alias = arrayAlias(7);
+$missing = missingParameter(1);
+localsReset();
+$reset = localsReset();
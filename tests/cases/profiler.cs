@@ -0,0 +1,34 @@
+function leaf(%value)
+{
+    return %value * 2;
+}
+
+function outer()
+{
+    %result = 0;
+    for (%iteration = 0; %iteration < 10; %iteration++)
+    {
+        %result = %result + leaf(%iteration);
+    }
+    return %result;
+}
+
+function fib(%n)
+{
+    if (%n < 2)
+    {
+        return %n;
+    }
+    return fib(%n - 1) + fib(%n - 2);
+}
+
+function ScriptObject::method(%this)
+{
+    return leaf(1);
+}
+
+$outerResult = outer();
+$fibResult = fib(10);
+
+new ScriptObject(ProfiledObject);
+$methodResult = ProfiledObject.method();
@@ -0,0 +1,58 @@
+$calls = 0;
+function sideEffect(%value)
+{
+    $calls++;
+    return %value;
+}
+
+$zero = 0;
+$one = 1;
+
+$andFalse = $zero && sideEffect(1);
+$andFalseCalls = $calls;
+
+$orTrue = $one || sideEffect(0);
+$orTrueCalls = $calls;
+
+$andTrue = $one && sideEffect(5);
+$andTrueCalls = $calls;
+
+$orFalse = $zero || sideEffect("");
+$orFalseCalls = $calls;
+
+$nested = ($one && $zero) || (sideEffect(1) && sideEffect("abc"));
+$nestedCalls = $calls;
+
+$constant = 0 && sideEffect(1);
+$constantCalls = $calls;
+
+// Guards skip the expensive check when the object is missing
+function ScriptObject::expensiveCheck(%this)
+{
+    $checks++;
+    return true;
+}
+
+new ScriptObject(Guarded);
+$checks = 0;
+$guardTaken = 0;
+
+%missing = "";
+if ((%missing !$= "") && %missing.expensiveCheck())
+{
+    $guardTaken++;
+}
+
+%present = Guarded;
+if ((%present !$= "") && %present.expensiveCheck())
+{
+    $guardTaken++;
+}
+
+for (%i = 0; (%i < 10) && (%i < $one + 2); %i++)
+{
+    if ((%i == 0) || (sideEffect(%i) > 1))
+    {
+        $guardTaken++;
+    }
+}
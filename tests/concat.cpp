@@ -0,0 +1,91 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+TEST(ConcatTest, ResizeString)
+{
+    // Small strings move to the heap once they no longer fit inline
+    TribalScript::StoredValue value("abc");
+    char* characters = value.resizeString(20);
+    ASSERT_NE(characters, nullptr);
+    std::memcpy(characters + 3, "defghijklmnopqrst", 17);
+    ASSERT_EQ(value.toString(), "abcdefghijklmnopqrst");
+
+    // Unshared heap strings are grown in place once they have spare capacity
+    characters = value.resizeString(21);
+    characters[20] = 'u';
+    ASSERT_EQ(value.resizeString(22), characters);
+    characters[21] = 'v';
+    ASSERT_EQ(value.toString(), "abcdefghijklmnopqrstuv");
+
+    // Shared strings are copied, leaving every other value untouched
+    const TribalScript::StoredValue shared = value;
+    characters = value.resizeString(23);
+    characters[22] = 'w';
+    ASSERT_EQ(value.toString(), "abcdefghijklmnopqrstuvw");
+    ASSERT_EQ(shared.toString(), "abcdefghijklmnopqrstuv");
+
+    // The numeric interpretation is parsed again once the string changes
+    TribalScript::StoredValue number("                12");
+    ASSERT_EQ(number.toInteger(), 12);
+    characters = number.resizeString(19);
+    characters[18] = '3';
+    ASSERT_EQ(number.toInteger(), 123);
+
+    ASSERT_EQ(TribalScript::StoredValue(5).resizeString(10), nullptr);
+}
+
+TEST(ConcatTest, Chains)
+{
+    const std::string source = "function make(%suffix) { return \"a string long enough for the heap\" @ %suffix; }"
+                               "$local = \"value\"; $number = 2.5;"
+                               "$mixed = $local @ 1 SPC $number TAB -3 NL \"end\";"
+                               "$nested = \"a\" @ ($local SPC ($number @ \"b\")) @ \"c\";"
+                               "$temporary = make(1) @ make(2) SPC make(3);"
+                               "$same = $local @ $local @ $local;"
+                               "$long = \"\"; for ($i = 0; $i < 10000; $i++) { $long = $long @ \"word\" SPC $i; }";
+
+    for (unsigned int level = 0; level < 2; ++level)
+    {
+        TribalScript::InterpreterConfiguration config;
+        config.mOptimizationLevel = level;
+        TribalScript::Interpreter interpreter(config);
+        TribalScript::registerAllLibraries(&interpreter);
+        interpreter.evaluate(source);
+
+        ASSERT_EQ(interpreter.getGlobal("mixed")->toString(), "value1 2.5\t-3\nend");
+        ASSERT_EQ(interpreter.getGlobal("nested")->toString(), "avalue 2.5bc");
+        ASSERT_EQ(interpreter.getGlobal("temporary")->toString(), "a string long enough for the heap1a string long enough for the heap2 a string long enough for the heap3");
+        ASSERT_EQ(interpreter.getGlobal("same")->toString(), "valuevaluevalue");
+        ASSERT_EQ(interpreter.getGlobal("local")->toString(), "value");
+
+        const std::string built = interpreter.getGlobal("long")->toString();
+        ASSERT_EQ(built.substr(0, 12), "word 0word 1");
+        ASSERT_EQ(built.substr(built.size() - 9), "word 9999");
+    }
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
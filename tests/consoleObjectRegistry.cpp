@@ -0,0 +1,93 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/standardconsoleobjectregistry.hpp>
+
+class RegistryTestObject : public TribalScript::ConsoleObject
+{
+    public:
+        RegistryTestObject() : TribalScript::ConsoleObject(nullptr)
+        {
+
+        }
+
+        std::string getClassName() override
+        {
+            return "RegistryTestObject";
+        }
+};
+
+TEST(ConsoleObjectRegistry, IDs)
+{
+    TribalScript::StandardConsoleObjectRegistry registry;
+    RegistryTestObject first;
+    RegistryTestObject second;
+    RegistryTestObject third;
+
+    ASSERT_EQ(registry.addConsoleObject(nullptr, &first), 0);
+    ASSERT_EQ(registry.addConsoleObject(nullptr, &second), 1);
+
+    // Adding again must not allocate a new ID
+    ASSERT_EQ(registry.addConsoleObject(nullptr, &first), 0);
+    ASSERT_EQ(registry.getConsoleObjectID(nullptr, &second), 1);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, 1), &second);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, 2), nullptr);
+
+    // Released IDs are reused
+    registry.removeConsoleObject(nullptr, &first);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, 0), nullptr);
+    ASSERT_EQ(registry.addConsoleObject(nullptr, &third), 0);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, 0), &third);
+}
+
+TEST(ConsoleObjectRegistry, Names)
+{
+    TribalScript::StandardConsoleObjectRegistry registry;
+    RegistryTestObject first;
+    RegistryTestObject second;
+
+    registry.setConsoleObject(nullptr, "First", &first);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, "FIRST"), &first);
+    ASSERT_EQ(registry.getConsoleObjectName(nullptr, &first), "first");
+    ASSERT_EQ(registry.getConsoleObject(nullptr, registry.getConsoleObjectID(nullptr, &first)), &first);
+
+    // Renaming drops the old name
+    registry.setConsoleObject(nullptr, "Renamed", &first);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, "first"), nullptr);
+    ASSERT_EQ(registry.getConsoleObjectName(nullptr, &first), "renamed");
+
+    // Taking a name from another object leaves that object unnamed
+    registry.setConsoleObject(nullptr, "Renamed", &second);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, "renamed"), &second);
+    ASSERT_EQ(registry.getConsoleObjectName(nullptr, &first), "");
+
+    // Anonymous objects are not reachable by name
+    registry.setConsoleObject(nullptr, "", &first);
+    ASSERT_EQ(registry.getConsoleObject(nullptr, ""), nullptr);
+
+    registry.removeConsoleObject(nullptr, "RENAMED");
+    ASSERT_EQ(registry.getConsoleObject(nullptr, "renamed"), nullptr);
+    ASSERT_EQ(registry.getConsoleObjectName(nullptr, &second), "");
+    ASSERT_EQ(registry.getConsoleObject(nullptr, registry.getConsoleObjectID(nullptr, &second)), &second);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+#include <tribalscript/executionstate.hpp>
+
+static void expectGlobal(TribalScript::Interpreter& interpreter, const std::string& name, const std::string& expected)
+{
+    TribalScript::StoredValue* value = interpreter.getGlobal(name);
+    ASSERT_TRUE(value) << name;
+    EXPECT_EQ(value->toString(), expected) << name;
+}
+
+TEST(InterpreterTest, ControlFlow)
+{
+    for (unsigned int optimizationLevel = 0; optimizationLevel < 2; ++optimizationLevel)
+    {
+        TribalScript::InterpreterConfiguration config;
+        config.mOptimizationLevel = optimizationLevel;
+
+        TribalScript::Interpreter interpreter(config);
+        TribalScript::registerAllLibraries(&interpreter);
+
+        TribalScript::ExecutionState state = TribalScript::ExecutionState(&interpreter);
+        interpreter.execute("cases/controlFlow.cs", &state);
+
+        // Jumps over either branch of a ternary land after it regardless of the length of the other
+        expectGlobal(interpreter, "ternaryTrue", "6");
+        expectGlobal(interpreter, "ternaryFalse", "7");
+        expectGlobal(interpreter, "ternaryLongFalse", "10");
+
+        // Only odd iterations reach the end of the body
+        expectGlobal(interpreter, "continueCounted", "3");
+        expectGlobal(interpreter, "continueSkipped", "9");
+    }
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
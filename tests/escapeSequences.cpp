@@ -0,0 +1,209 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <regex>
+#include <random>
+#include <string>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/stringhelpers.hpp>
+
+/**
+ *  @brief The previous std::regex based implementation, kept as a reference for the escapes it supported.
+ */
+static std::string referenceExpandEscapeSequences(const std::string& in)
+{
+    std::regex colorRegex("\\\\c([0-9])");
+    std::regex hexRegex("\\\\x([0-9a-f]{1,2})");
+    std::regex otherSequences("\\\\([tn])");
+
+    std::string result = in;
+
+    // Handle hex escapes
+    std::smatch match;
+    while (std::regex_search(result, match, hexRegex))
+    {
+        const unsigned long hexValue = std::stoul(match[1], nullptr, 16);
+        std::string hexString(1, (const char)hexValue);
+
+        const std::string beginning = result.substr(0, match.position());
+        const std::string ending = result.substr(match.position() + match.length(), result.size());
+        result = beginning + hexString + ending;
+    }
+
+    // Handle color escapes - in T2 these are just aliases for an unprintable
+    while (std::regex_search(result, match, colorRegex))
+    {
+        const unsigned long integerValue = std::stoul(match[1], nullptr, 10);
+        std::string colorString = "";
+        switch (integerValue)
+        {
+            case 0:
+                colorString = "\x02";
+                break;
+            case 1:
+                colorString = "\x03";
+                break;
+            case 2:
+                colorString = "\x04";
+                break;
+            case 3:
+                colorString = "\x05";
+                break;
+            case 4:
+                colorString = "\x06";
+                break;
+            case 5:
+                colorString = "\x07";
+                break;
+            case 6:
+                colorString = "\x08";
+                break;
+            case 7:
+                colorString = "\x0B";
+                break;
+            case 8:
+                colorString = "\x0C";
+                break;
+            case 9:
+                colorString = "\x0E";
+                break;
+        }
+
+        const std::string beginning = result.substr(0, match.position());
+        const std::string ending = result.substr(match.position() + match.length(), result.size());
+        result = beginning + colorString + ending;
+    }
+
+    // Handle ie. tab and newline sequences
+    while (std::regex_search(result, match, otherSequences))
+    {
+        const std::string beginning = result.substr(0, match.position());
+        const std::string ending = result.substr(match.position() + match.length(), result.size());
+
+        if (match[1] == "n")
+        {
+            result = beginning + '\n' + ending;
+        }
+        else if (match[1] == "t")
+        {
+            result = beginning + '\t' + ending;
+        }
+        else
+        {
+            throw std::invalid_argument("Unexpected escape type!");
+        }
+    }
+
+    return result;
+}
+
+/**
+ *  @brief Generates a string mixing plain text with the escapes the reference implementation understands. Plain text
+ *  never contains backslashes or uppercase hex digits, and no hex escape expands to a backslash, which is where the
+ *  two implementations differ.
+ */
+static std::string generateEscapedString(std::mt19937& generator)
+{
+    static const char sPlainCharacters[] = "abcdefghijklmnopqrstuvwxyz0123456789 .,;:!?\"'{}|";
+    static const char sHexDigits[] = "0123456789abcdef";
+
+    std::uniform_int_distribution<int> lengthDistribution(0, 24);
+    std::uniform_int_distribution<int> kindDistribution(0, 5);
+    std::uniform_int_distribution<int> plainDistribution(0, sizeof(sPlainCharacters) - 2);
+    std::uniform_int_distribution<int> hexDistribution(0, 15);
+    std::uniform_int_distribution<int> digitDistribution(0, 9);
+
+    std::string result;
+    const int length = lengthDistribution(generator);
+    for (int iteration = 0; iteration < length; ++iteration)
+    {
+        switch (kindDistribution(generator))
+        {
+            case 0:
+                result += "\\n";
+                break;
+            case 1:
+                result += "\\t";
+                break;
+            case 2:
+                result += "\\c";
+                result += static_cast<char>('0' + digitDistribution(generator));
+                break;
+            case 3:
+            {
+                std::string digits(1, sHexDigits[hexDistribution(generator)]);
+                if (hexDistribution(generator) % 2 == 0)
+                {
+                    digits += sHexDigits[hexDistribution(generator)];
+                }
+                if (digits == "5c")
+                {
+                    digits = "5d";
+                }
+                result += "\\x" + digits;
+                break;
+            }
+            default:
+                result += sPlainCharacters[plainDistribution(generator)];
+                break;
+        }
+    }
+    return result;
+}
+
+TEST(EscapeSequences, MatchesReference)
+{
+    std::mt19937 generator(1337);
+    for (unsigned int iteration = 0; iteration < 5000; ++iteration)
+    {
+        const std::string input = generateEscapedString(generator);
+        ASSERT_EQ(TribalScript::expandEscapeSequences(input), referenceExpandEscapeSequences(input)) << input;
+    }
+}
+
+TEST(EscapeSequences, Sequences)
+{
+    ASSERT_EQ(TribalScript::expandEscapeSequences(""), "");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("No escapes at all"), "No escapes at all");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("a\\nb\\tc\\rd"), "a\nb\tc\rd");
+
+    // Quotes and backslashes
+    ASSERT_EQ(TribalScript::expandEscapeSequences("say \\\"hi\\\""), "say \"hi\"");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("it\\'s"), "it's");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("C:\\\\path"), "C:\\path");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\\\n"), "\\n");
+
+    // Hex escapes take at most two digits in either case, and the result is never expanded again
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\x41\\x4a\\x4A\\x9"), "AJJ\t");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\x414"), "A4");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\x5cn"), "\\n");
+    ASSERT_EQ(TribalScript::expandEscapeSequences(std::string("\\x0", 3)), std::string(1, '\0'));
+
+    // Color escapes
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\c0\\c9"), "\x02\x0E");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\cr\\cp\\co"), "\x0F\x10\x11");
+
+    // Anything else is kept as written
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\q\\xg\\cz\\"), "\\q\\xg\\cz\\");
+    ASSERT_EQ(TribalScript::expandEscapeSequences("\\{\\|\\}"), "\\{\\|\\}");
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/interpreter.hpp>
+
+static const char* sCaseScripts[] = {
+    "array", "boundCallCache", "breakFor", "breakWhile", "bytecodeCache", "callSiteCache", "caseFolding",
+    "caseSensitive", "chaining", "chains", "combined", "continueFor", "continueWhile", "controlFlow", "for",
+    "function", "if", "localSlots", "memoryReference", "nestedBreakFor", "nestedBreakWhile", "nestedContinueFor",
+    "nestedContinueWhile", "opOrder", "package", "profiler", "scriptObject", "shortCircuit", "simGroup", "switch",
+    "treeInitialization", "variables", "while"
+};
+
+/**
+ *  @brief Compiles the provided source with the given frontend and optimization level.
+ *  @return The disassembly of the compiled code, or an empty list if compilation failed.
+ */
+static std::vector<std::string> getDisassembly(const std::string& source, const TribalScript::ParserFrontend frontend, const unsigned int optimizationLevel)
+{
+    TribalScript::InterpreterConfiguration config;
+    config.mFrontend = frontend;
+    config.mOptimizationLevel = optimizationLevel;
+
+    TribalScript::Interpreter interpreter(config);
+    std::unique_ptr<TribalScript::CodeBlock> compiled(interpreter.compile(source));
+    if (!compiled)
+    {
+        return std::vector<std::string>();
+    }
+    return compiled->disassemble();
+}
+
+TEST(FrontendTest, IdenticalCode)
+{
+    for (const char* name : sCaseScripts)
+    {
+        std::ifstream input(std::string("cases/") + name + ".cs");
+        std::ostringstream buffer;
+        buffer << input.rdbuf();
+        const std::string source = buffer.str();
+        ASSERT_FALSE(source.empty()) << name;
+
+        // Both frontends build the same tree, so they must generate exactly the same code
+        for (unsigned int optimizationLevel = 0; optimizationLevel < 2; ++optimizationLevel)
+        {
+            const std::vector<std::string> antlrCode = getDisassembly(source, TribalScript::ParserFrontend::ANTLR, optimizationLevel);
+            const std::vector<std::string> handWrittenCode = getDisassembly(source, TribalScript::ParserFrontend::HandWritten, optimizationLevel);
+
+            ASSERT_FALSE(antlrCode.empty()) << name;
+            ASSERT_EQ(antlrCode, handWrittenCode) << name << " at optimization level " << optimizationLevel;
+        }
+    }
+}
+
+TEST(FrontendTest, Literals)
+{
+    const std::string source = "$a = 0x1F + 12 * 1.5e2 - 3.25;"
+                               "$b = \"quoted \\\"text\\\"\" @ 'tagged' SPC \"\" TAB name NL true;"
+                               "$c = -$a * !false;"
+                               "$d[1, $a] = Namespace::call(%x, %y.field[2].method());"
+                               "function Outer::inner(%first, %second::part) { return %first; }"
+                               "package Pack { function packed() { } };";
+
+    for (unsigned int optimizationLevel = 0; optimizationLevel < 2; ++optimizationLevel)
+    {
+        const std::vector<std::string> antlrCode = getDisassembly(source, TribalScript::ParserFrontend::ANTLR, optimizationLevel);
+        ASSERT_FALSE(antlrCode.empty());
+        ASSERT_EQ(antlrCode, getDisassembly(source, TribalScript::ParserFrontend::HandWritten, optimizationLevel));
+    }
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,56 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+#include <tribalscript/executionstate.hpp>
+
+TEST(InterpreterTest, LocalSlots)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+
+    TribalScript::ExecutionState state = TribalScript::ExecutionState(&interpreter);
+    interpreter.execute("cases/localSlots.cs", &state);
+
+    // Recursive calls must each receive their own locals
+    TribalScript::StoredValue* fib = interpreter.getGlobal("fib");
+    ASSERT_TRUE(fib);
+    ASSERT_EQ(fib->toInteger(), 55);
+
+    // Arrays are looked up by name at runtime and must resolve to the same local as %entry_1
+    TribalScript::StoredValue* alias = interpreter.getGlobal("alias");
+    ASSERT_TRUE(alias);
+    ASSERT_EQ(alias->toInteger(), 7);
+
+    TribalScript::StoredValue* missing = interpreter.getGlobal("missing");
+    ASSERT_TRUE(missing);
+    ASSERT_EQ(missing->toInteger(), 0);
+
+    // Locals must not carry over between calls
+    TribalScript::StoredValue* reset = interpreter.getGlobal("reset");
+    ASSERT_TRUE(reset);
+    ASSERT_EQ(reset->toInteger(), 1);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
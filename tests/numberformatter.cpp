@@ -0,0 +1,120 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <random>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/numberformatter.hpp>
+
+static std::string formatFloat(const float value)
+{
+    char buffer[TribalScript::FormattedFloatBufferSize];
+    const std::size_t length = TribalScript::formatFloat(value, buffer);
+    EXPECT_EQ(length, std::strlen(buffer));
+    return std::string(buffer, length);
+}
+
+static std::string referenceFloat(const float value)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(value));
+    return buffer;
+}
+
+TEST(NumberFormatterTest, KnownValues)
+{
+    ASSERT_EQ(formatFloat(0.0f), "0");
+    ASSERT_EQ(formatFloat(-0.0f), "-0");
+    ASSERT_EQ(formatFloat(1.5f), "1.5");
+    ASSERT_EQ(formatFloat(3.0f), "3");
+    ASSERT_EQ(formatFloat(-10.0f), "-10");
+    ASSERT_EQ(formatFloat(6.28f), "6.28");
+    ASSERT_EQ(formatFloat(0.1f), "0.1");
+    ASSERT_EQ(formatFloat(0.0001f), "0.0001");
+    ASSERT_EQ(formatFloat(123456.0f), "123456");
+    ASSERT_EQ(formatFloat(1234567.0f), "1.23457e+06");
+    ASSERT_EQ(formatFloat(999999.5f), "1e+06");
+    ASSERT_EQ(formatFloat(9.9999999f), "10");
+    ASSERT_EQ(formatFloat(0.00001f), "1e-05");
+}
+
+TEST(NumberFormatterTest, FuzzAgainstReference)
+{
+    std::mt19937 generator(1337);
+
+    // Arbitrary bit patterns cover every exponent, including infinities and NaN
+    std::uniform_int_distribution<std::uint32_t> bitsDistribution;
+    for (unsigned int iteration = 0; iteration < 200000; ++iteration)
+    {
+        const std::uint32_t bits = bitsDistribution(generator);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        ASSERT_EQ(formatFloat(value), referenceFloat(value)) << "bits " << bits;
+    }
+
+    // Values as typically seen in scripts, which take the fast path, including exact halfway cases
+    std::uniform_int_distribution<int> integerDistribution(-2000000, 2000000);
+    std::uniform_int_distribution<int> divisorDistribution(0, 7);
+    for (unsigned int iteration = 0; iteration < 200000; ++iteration)
+    {
+        const int integer = integerDistribution(generator);
+        const float value = static_cast<float>(integer) / static_cast<float>(1 << (divisorDistribution(generator) * 3));
+
+        ASSERT_EQ(formatFloat(value), referenceFloat(value)) << "value " << integer;
+    }
+}
+
+TEST(NumberFormatterTest, StoredValueStrings)
+{
+    ASSERT_EQ(TribalScript::StoredValue(5).toString(), "5");
+    ASSERT_EQ(TribalScript::StoredValue(2.5f).toString(), "2.5");
+
+    // Formatted floats are cached on the value and carried along by copies
+    TribalScript::StoredValue value(0.125f);
+    ASSERT_EQ(value.toString(), "0.125");
+    ASSERT_EQ(value.toString(), "0.125");
+    ASSERT_EQ(value.toFloat(), 0.125f);
+
+    TribalScript::StoredValue copy = value;
+    ASSERT_EQ(copy.toString(), "0.125");
+
+    // Reassigning the value must not keep the old cached form
+    value = TribalScript::StoredValue(7.75f);
+    ASSERT_EQ(value.toString(), "7.75");
+    value.setValue(1.0f);
+    ASSERT_EQ(value.toString(), "1");
+
+    // Forms too long to be cached are formatted every time
+    TribalScript::StoredValue small(-0.000123457f);
+    ASSERT_EQ(small.toString(), "-0.000123457");
+    ASSERT_EQ(small.toString(), "-0.000123457");
+
+    float location = 0.5f;
+    TribalScript::StoredValue reference(&location);
+    ASSERT_EQ(reference.toString(), "0.5");
+    location = 4.0f;
+    ASSERT_EQ(reference.toString(), "4");
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/numberparser.hpp>
+
+//! The behavior parseInteger replaced: std::strtol, with values outside of the range of an int being 0.
+static int referenceInteger(const char* value)
+{
+    const long result = std::strtol(value, nullptr, 10);
+    return result < INT_MIN || result > INT_MAX ? 0 : static_cast<int>(result);
+}
+
+static bool isSameFloat(const float lhs, const float rhs)
+{
+    if (std::isnan(lhs) || std::isnan(rhs))
+    {
+        return std::isnan(lhs) && std::isnan(rhs);
+    }
+    return std::memcmp(&lhs, &rhs, sizeof(float)) == 0;
+}
+
+static void expectMatchesReference(const std::string& value)
+{
+    EXPECT_EQ(TribalScript::parseInteger(value.c_str()), referenceInteger(value.c_str())) << "parseInteger(\"" << value << "\")";
+    EXPECT_TRUE(isSameFloat(TribalScript::parseFloat(value.c_str()), std::strtof(value.c_str(), nullptr))) << "parseFloat(\"" << value << "\")";
+}
+
+TEST(NumberParserTest, KnownValues)
+{
+    ASSERT_EQ(TribalScript::parseInteger(""), 0);
+    ASSERT_EQ(TribalScript::parseInteger("  \t42"), 42);
+    ASSERT_EQ(TribalScript::parseInteger("-17"), -17);
+    ASSERT_EQ(TribalScript::parseInteger("+8"), 8);
+    ASSERT_EQ(TribalScript::parseInteger("12abc"), 12);
+    ASSERT_EQ(TribalScript::parseInteger("3.9"), 3);
+    ASSERT_EQ(TribalScript::parseInteger("0x10"), 0);
+    ASSERT_EQ(TribalScript::parseInteger("abc"), 0);
+    ASSERT_EQ(TribalScript::parseInteger("2147483647"), INT_MAX);
+    ASSERT_EQ(TribalScript::parseInteger("-2147483648"), INT_MIN);
+    ASSERT_EQ(TribalScript::parseInteger("2147483648"), 0);
+    ASSERT_EQ(TribalScript::parseInteger("99999999999999999999999"), 0);
+
+    ASSERT_EQ(TribalScript::parseFloat(""), 0.0f);
+    ASSERT_EQ(TribalScript::parseFloat(" 1.5"), 1.5f);
+    ASSERT_EQ(TribalScript::parseFloat("-.25"), -0.25f);
+    ASSERT_EQ(TribalScript::parseFloat("6.28abc"), 6.28f);
+    ASSERT_EQ(TribalScript::parseFloat("1e3"), 1000.0f);
+    ASSERT_EQ(TribalScript::parseFloat("1e"), 1.0f);
+    ASSERT_EQ(TribalScript::parseFloat("0x10"), 16.0f);
+    ASSERT_EQ(TribalScript::parseFloat("Stepper"), 0.0f);
+    ASSERT_TRUE(std::isinf(TribalScript::parseFloat("inf")));
+    ASSERT_TRUE(std::isnan(TribalScript::parseFloat("nan")));
+    ASSERT_TRUE(std::signbit(TribalScript::parseFloat("-0")));
+}
+
+TEST(NumberParserTest, FuzzAgainstReference)
+{
+    std::mt19937 generator(1337);
+
+    // Random strings of characters that may appear in numbers, so the parsers are exercised on near misses
+    const char alphabet[] = " \t\n0123456789012345678901234567890123456789..--++eExXaAbBfFiInNyY";
+    std::uniform_int_distribution<std::size_t> lengthDistribution(0, 24);
+    std::uniform_int_distribution<std::size_t> characterDistribution(0, sizeof(alphabet) - 2);
+
+    for (unsigned int iteration = 0; iteration < 200000; ++iteration)
+    {
+        std::string value(lengthDistribution(generator), ' ');
+        for (char& character : value)
+        {
+            character = alphabet[characterDistribution(generator)];
+        }
+        expectMatchesReference(value);
+
+        if (HasFailure())
+        {
+            return;
+        }
+    }
+
+    // Well formed numbers of varying precision and magnitude, which take the fast paths
+    std::uniform_real_distribution<double> mantissaDistribution(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponentDistribution(-45, 40);
+    std::uniform_int_distribution<int> precisionDistribution(1, 12);
+    std::uniform_int_distribution<int> integerDistribution(INT_MIN, INT_MAX);
+
+    char buffer[64];
+    for (unsigned int iteration = 0; iteration < 200000; ++iteration)
+    {
+        const double number = mantissaDistribution(generator) * std::pow(10.0, exponentDistribution(generator));
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precisionDistribution(generator), number);
+        expectMatchesReference(buffer);
+
+        std::snprintf(buffer, sizeof(buffer), "%.*f", precisionDistribution(generator) % 7, number);
+        expectMatchesReference(buffer);
+
+        std::snprintf(buffer, sizeof(buffer), "%d", integerDistribution(generator) >> (iteration % 32));
+        expectMatchesReference(buffer);
+
+        if (HasFailure())
+        {
+            return;
+        }
+    }
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
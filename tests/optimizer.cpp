@@ -0,0 +1,228 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/executionstate.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+static TribalScript::InterpreterConfiguration getConfiguration(const unsigned int optimizationLevel)
+{
+    TribalScript::InterpreterConfiguration config;
+    config.mOptimizationLevel = optimizationLevel;
+    return config;
+}
+
+static std::string getDisassembly(const std::string& source, const unsigned int optimizationLevel)
+{
+    TribalScript::Interpreter interpreter(getConfiguration(optimizationLevel));
+    std::unique_ptr<TribalScript::CodeBlock> compiled(interpreter.compile(source));
+
+    std::string result;
+    for (const std::string& line : compiled->disassemble())
+    {
+        result += line + "\n";
+    }
+    return result;
+}
+
+/**
+ *  @brief Runs the provided source at both optimization levels, checking that each requested global ends up
+ *  with the same value.
+ *  @return The values of each global as computed with optimizations enabled.
+ */
+static std::vector<std::string> runAtBothLevels(const std::string& source, const std::vector<std::string>& globals)
+{
+    std::vector<std::string> results[2];
+    for (unsigned int level = 0; level < 2; ++level)
+    {
+        TribalScript::Interpreter interpreter(getConfiguration(level));
+        TribalScript::registerAllLibraries(&interpreter);
+        interpreter.evaluate(source);
+
+        for (const std::string& global : globals)
+        {
+            TribalScript::StoredValue* value = interpreter.getGlobal(global);
+            results[level].push_back(value ? value->toString() : "<unset>");
+        }
+    }
+
+    EXPECT_EQ(results[0], results[1]);
+    return results[1];
+}
+
+TEST(OptimizerTest, FoldArithmetic)
+{
+    const std::string source = "$a = 1 + 2 * 3; $b = (10 - 4) / 4; $c = 7 % 3; $d = -(2 - 5);";
+
+    const std::string optimized = getDisassembly(source, 1);
+    ASSERT_EQ(optimized.find("Add"), std::string::npos);
+    ASSERT_EQ(optimized.find("Multiply"), std::string::npos);
+    ASSERT_EQ(optimized.find("Divide"), std::string::npos);
+    ASSERT_EQ(optimized.find("Modulus"), std::string::npos);
+    ASSERT_EQ(optimized.find("Negate"), std::string::npos);
+    ASSERT_NE(getDisassembly(source, 0).find("Multiply"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "a", "b", "c", "d" });
+    ASSERT_EQ(std::stof(values[0]), 7.0f);
+    ASSERT_EQ(std::stof(values[1]), 1.5f);
+    ASSERT_EQ(values[2], "1");
+    ASSERT_EQ(std::stof(values[3]), 3.0f);
+}
+
+TEST(OptimizerTest, FoldComparisonsAndConcatenation)
+{
+    const std::string source = "$a = \"a\" @ \"b\" SPC 1.5 TAB 2; $b = !0; $c = 3 < 2; $d = \"abc\" $= \"ABC\"; $e = 1 == 1.0; $f = 2 * 3 @ \"x\";";
+
+    const std::string optimized = getDisassembly(source, 1);
+    ASSERT_EQ(optimized.find("Concat"), std::string::npos);
+    ASSERT_EQ(optimized.find("Not"), std::string::npos);
+    ASSERT_EQ(optimized.find("LessThan"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "a", "b", "c", "d", "e", "f" });
+    ASSERT_EQ(values[1], "1");
+    ASSERT_EQ(values[2], "0");
+    ASSERT_EQ(values[4], "1");
+}
+
+TEST(OptimizerTest, FoldConcatenationChainTails)
+{
+    const std::string source = "$g = \"start\"; $h = $g @ \"a\" SPC \"b\" TAB 3; $i = $g @ \"x\" @ $g @ \"y\" NL \"z\";";
+
+    const std::string optimized = getDisassembly(source, 1);
+    ASSERT_NE(optimized.find("ConcatList 4"), std::string::npos);
+    ASSERT_EQ(optimized.find("ConcatList 5"), std::string::npos);
+    ASSERT_NE(getDisassembly(source, 0).find("ConcatList 5"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "h", "i" });
+    ASSERT_EQ(values[0], "starta b\t3");
+    ASSERT_EQ(values[1], "startxstarty\nz");
+}
+
+TEST(OptimizerTest, RemoveConstantBranches)
+{
+    const std::string source = "if (0) { $a = 1; } else if (1) { $a = 2; } else { $a = 3; } $b = 1 ? \"yes\" : \"no\";";
+
+    const std::string optimized = getDisassembly(source, 1);
+    ASSERT_EQ(optimized.find("Jump"), std::string::npos);
+    ASSERT_EQ(optimized.find("NOP"), std::string::npos);
+    ASSERT_EQ(optimized.find("PushInteger 1"), std::string::npos);
+    ASSERT_EQ(optimized.find("PushInteger 3"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "a", "b" });
+    ASSERT_EQ(values[0], "2");
+    ASSERT_EQ(values[1], "yes");
+}
+
+TEST(OptimizerTest, ShortCircuitConditions)
+{
+    // Used as conditions, && and || branch straight to the body or past it
+    const std::string conditions = "$a = 0; $b = 3; if (($a < 1) && (($b > 2) || ($b < -2))) { $if = 1; } while (($a < 3) || ($b < 0)) { $a++; }";
+    ASSERT_EQ(getDisassembly(conditions, 1).find("OrPop"), std::string::npos);
+    ASSERT_NE(getDisassembly(conditions, 0).find("JumpTrueOrPop"), std::string::npos);
+
+    // Used as values, comparisons do not need to be converted to 0 or 1 again
+    const std::string optimizedValue = getDisassembly("$value = ($a == 3) && ($b > 2);", 1);
+    ASSERT_NE(optimizedValue.find("JumpFalseOrPop"), std::string::npos);
+    ASSERT_EQ(optimizedValue.find("JumpFalseOrPop"), optimizedValue.rfind("JumpFalseOrPop"));
+    ASSERT_EQ(optimizedValue.find("PushInteger 1"), std::string::npos);
+
+    ASSERT_EQ(getDisassembly("$constant = 1 && 0 || 1;", 1).find("Jump"), std::string::npos);
+
+    const std::string source = conditions + "$b = $a && !$b; $value = ($a == 3) && ($b > 2); $either = ($a $= \"x\") || !$b; $mixed = $a && \"abc\"; $constant = 1 && 0 || 1;"
+                               "switch (1) { case $a && $b: $switched = 1; default: $switched = 2; }";
+    const std::vector<std::string> values = runAtBothLevels(source, { "a", "b", "if", "value", "either", "mixed", "constant", "switched" });
+    ASSERT_EQ(values[0], "3");
+    ASSERT_EQ(values[1], "0");
+    ASSERT_EQ(values[2], "1");
+    ASSERT_EQ(values[3], "0");
+    ASSERT_EQ(values[4], "1");
+    ASSERT_EQ(values[5], "0");
+    ASSERT_EQ(values[6], "1");
+    ASSERT_EQ(values[7], "2");
+}
+
+TEST(OptimizerTest, StripNOPs)
+{
+    const std::string source = "$sum = 0;"
+                               "for (%i = 0; %i < 10; %i++) { if (%i == 3) { continue; } if (%i == 8) { break; } $sum = $sum + %i; }"
+                               "%j = 0; while (%j < 5) { %j++; if (%j == 2) continue; $count = $count + 1; }"
+                               "switch (%j) { case 1: $switched = 1; case 5: $switched = 5; default: $switched = -1; }"
+                               "$ternary = (%j == 5) ? 1 + 1 : 2 + 2;";
+
+    const std::string optimized = getDisassembly(source, 1);
+    ASSERT_EQ(optimized.find("NOP"), std::string::npos);
+    ASSERT_NE(getDisassembly(source, 0).find("NOP"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "sum", "count", "switched", "ternary" });
+    ASSERT_EQ(std::stof(values[0]), 25.0f);
+    ASSERT_EQ(std::stof(values[1]), 4.0f);
+    ASSERT_EQ(values[2], "5");
+    ASSERT_EQ(std::stof(values[3]), 2.0f);
+}
+
+TEST(OptimizerTest, FunctionBodies)
+{
+    const std::string source = "function optimized(%x) { if (1) { return %x * (2 + 3); } return 0; }"
+                               "function spin() { while (1) { return 7; } }"
+                               "$a = optimized(2); $b = spin();";
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "a", "b" });
+    ASSERT_EQ(std::stof(values[0]), 10.0f);
+    ASSERT_EQ(values[1], "7");
+}
+
+TEST(OptimizerTest, RuntimeOperationsPreserved)
+{
+    // Integer division by zero is left to runtime, as are operations on variables
+    const std::string optimized = getDisassembly("$x = 4; $a = $x + 1 * 2;", 1);
+    ASSERT_NE(optimized.find("Add"), std::string::npos);
+    ASSERT_EQ(optimized.find("Multiply"), std::string::npos);
+    ASSERT_NE(getDisassembly("$b = 5 % 0;", 1).find("Modulus"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels("$x = 4; $a = $x + 1 * 2;", { "a" });
+    ASSERT_EQ(std::stof(values[0]), 6.0f);
+}
+
+TEST(OptimizerTest, Superinstructions)
+{
+    const std::string source = "function loops() { %sum = 0; for (%i = 0; %i < 10; %i++) { if (%i == 3) { continue; } %sum = %sum + %i; }"
+                               "%j = 10; while (%j > 2.5) { %j = %j - 1; } %k = 0; while (%k != 4) { %k++; } return %sum + %j * 100 + %k * 1000; }"
+                               "function fields(%object) { %object.value = 5; return %object.value + %object.other; }"
+                               "$loops = loops(); $object = new ScriptObject() { other = 2; }; $fields = fields($object); $value = $object.value;";
+
+    const std::string optimized = getDisassembly(source, 1);
+    ASSERT_NE(optimized.find("IncrementLocalSlot"), std::string::npos);
+    ASSERT_NE(optimized.find("CompareLocalSlotJumpFalse"), std::string::npos);
+    ASSERT_NE(optimized.find("PushLocalSlotField"), std::string::npos);
+    ASSERT_EQ(getDisassembly(source, 0).find("IncrementLocalSlot"), std::string::npos);
+
+    const std::vector<std::string> values = runAtBothLevels(source, { "loops", "fields", "value" });
+    ASSERT_EQ(std::stof(values[0]), 42.0f + 200.0f + 4000.0f);
+    ASSERT_EQ(std::stof(values[1]), 7.0f);
+    ASSERT_EQ(values[2], "5");
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
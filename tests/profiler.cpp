@@ -0,0 +1,152 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/profiler.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/storedvalue.hpp>
+#include <tribalscript/executionstate.hpp>
+#include <tribalscript/libraries/libraries.hpp>
+
+static TribalScript::InterpreterConfiguration getProfilingConfiguration()
+{
+    TribalScript::InterpreterConfiguration config;
+    config.mProfile = true;
+    return config;
+}
+
+static const TribalScript::Profiler::FunctionStatistics* findFunction(TribalScript::Profiler* profiler, const std::string& name)
+{
+    for (auto&& function : profiler->getFunctionStatistics())
+    {
+        if (function.first->getDeclaredName() == name)
+        {
+            return &function.second;
+        }
+    }
+    return nullptr;
+}
+
+static bool hasLine(const std::string& text, const std::string& prefix)
+{
+    std::istringstream input(text);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (line.compare(0, prefix.size(), prefix) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(ProfilerTest, DisabledByDefault)
+{
+    TribalScript::Interpreter interpreter;
+    ASSERT_FALSE(interpreter.getProfiler());
+
+    TribalScript::ExecutionState state(&interpreter);
+    ASSERT_FALSE(state.mProfiler);
+}
+
+TEST(ProfilerTest, OpCodeCounts)
+{
+    TribalScript::Interpreter interpreter(getProfilingConfiguration());
+    TribalScript::Profiler* profiler = interpreter.getProfiler();
+    ASSERT_TRUE(profiler);
+
+    interpreter.evaluate("$x = 1; $a = $x + 2; $b = $a * 3;");
+    ASSERT_EQ(interpreter.getGlobal("b")->toInteger(), 9);
+
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::Add).mCount, 1);
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::Multiply).mCount, 1);
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::Assignment).mCount, 3);
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::PushGlobalReference).mCount, 5);
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::Halt).mCount, 1);
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::Divide).mCount, 0);
+
+    profiler->reset();
+    ASSERT_EQ(profiler->getOpCodeStatistics(TribalScript::OpCode::Add).mCount, 0);
+}
+
+TEST(ProfilerTest, Functions)
+{
+    TribalScript::Interpreter interpreter(getProfilingConfiguration());
+    TribalScript::registerAllLibraries(&interpreter);
+    TribalScript::Profiler* profiler = interpreter.getProfiler();
+
+    interpreter.execute("cases/profiler.cs", nullptr);
+
+    ASSERT_EQ(interpreter.getGlobal("outerResult")->toInteger(), 90);
+    ASSERT_EQ(interpreter.getGlobal("fibResult")->toInteger(), 55);
+    ASSERT_EQ(interpreter.getGlobal("methodResult")->toInteger(), 2);
+
+    const TribalScript::Profiler::FunctionStatistics* outer = findFunction(profiler, "outer");
+    const TribalScript::Profiler::FunctionStatistics* leaf = findFunction(profiler, "leaf");
+    const TribalScript::Profiler::FunctionStatistics* fib = findFunction(profiler, "fib");
+    const TribalScript::Profiler::FunctionStatistics* method = findFunction(profiler, "method");
+    ASSERT_TRUE(outer);
+    ASSERT_TRUE(leaf);
+    ASSERT_TRUE(fib);
+    ASSERT_TRUE(method);
+
+    ASSERT_EQ(outer->mCalls, 1);
+    ASSERT_EQ(leaf->mCalls, 11);
+    ASSERT_EQ(fib->mCalls, 177);
+    ASSERT_EQ(method->mCalls, 1);
+
+    ASSERT_GE(outer->mInclusiveTime, outer->mExclusiveTime);
+    ASSERT_GE(fib->mInclusiveTime, fib->mExclusiveTime);
+
+    // The call to leaf within outer, the one within the method and both recursive calls within fib are distinct sites
+    std::size_t leafSites = 0;
+    std::size_t fibSites = 0;
+    for (const TribalScript::Profiler::CallSiteStatistics& callSite : profiler->getCallSiteStatistics())
+    {
+        if (callSite.mCallee->getDeclaredName() == "leaf")
+        {
+            ++leafSites;
+            ASSERT_TRUE(callSite.mCaller);
+            ASSERT_EQ(callSite.mCalls, callSite.mCaller->getDeclaredName() == "outer" ? 10 : 1);
+        }
+        else if (callSite.mCallee->getDeclaredName() == "fib")
+        {
+            ++fibSites;
+        }
+    }
+    ASSERT_EQ(leafSites, 2);
+    ASSERT_EQ(fibSites, 3);
+
+    const std::string collapsed = profiler->getCollapsedStacks();
+    ASSERT_TRUE(hasLine(collapsed, "outer "));
+    ASSERT_TRUE(hasLine(collapsed, "outer;leaf "));
+    ASSERT_TRUE(hasLine(collapsed, "fib;fib;fib "));
+    ASSERT_TRUE(hasLine(collapsed, "ScriptObject::method;leaf "));
+    ASSERT_FALSE(hasLine(collapsed, "leaf "));
+
+    const std::string flat = profiler->getFlatProfile();
+    ASSERT_NE(flat.find("CallFunction"), std::string::npos);
+    ASSERT_NE(flat.find("ScriptObject::method"), std::string::npos);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
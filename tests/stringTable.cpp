@@ -0,0 +1,118 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/stringtable.hpp>
+
+TEST(StringTable, DenseEntries)
+{
+    TribalScript::StringTable table;
+
+    const TribalScript::StringTableEntry first = table.getOrAssign("first");
+    const TribalScript::StringTableEntry second = table.getOrAssign("second");
+
+    ASSERT_EQ(first, 0);
+    ASSERT_EQ(second, 1);
+    ASSERT_EQ(table.size(), 2);
+
+    // Looking a string up again must not assign a new entry
+    ASSERT_EQ(table.getOrAssign(std::string("first")), first);
+    ASSERT_EQ(table.getOrAssign("secondary", 6), second);
+    ASSERT_EQ(table.size(), 2);
+
+    ASSERT_EQ(table.getString(first), "first");
+    ASSERT_EQ(table.getString(second), "second");
+    ASSERT_THROW(table.getString(2), std::out_of_range);
+}
+
+TEST(StringTable, CaseFolding)
+{
+    TribalScript::StringTable table;
+
+    const TribalScript::StringTableEntry mixed = table.getOrAssign("MixedCase");
+    const TribalScript::StringTableEntry folded = table.getOrAssign("mixedcase");
+
+    // The original case is kept and both forms are stored once
+    ASSERT_NE(mixed, folded);
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_EQ(table.getString(mixed), "MixedCase");
+
+    ASSERT_EQ(table.getFolded(mixed), folded);
+    ASSERT_EQ(table.getFolded(folded), folded);
+    ASSERT_EQ(table.getOrAssignFolded("MIXEDCASE"), folded);
+    ASSERT_EQ(table.getOrAssignFolded("mixedcase"), folded);
+    ASSERT_EQ(table.size(), 3);
+}
+
+TEST(StringTable, FindWithoutAssigning)
+{
+    TribalScript::StringTable table;
+
+    const TribalScript::StringTableEntry mixed = table.getOrAssign("MixedCase");
+    const TribalScript::StringTableEntry folded = table.getFolded(mixed);
+    ASSERT_EQ(table.size(), 2);
+
+    TribalScript::StringTableEntry result;
+    ASSERT_TRUE(table.find("MixedCase", 9, result));
+    ASSERT_EQ(result, mixed);
+    ASSERT_FALSE(table.find("MIXEDCASE", 9, result));
+    ASSERT_FALSE(table.find("missing", 7, result));
+
+    // Folded lookups resolve any case, even one never assigned an entry of its own
+    ASSERT_TRUE(table.findFolded("MixedCase", 9, result));
+    ASSERT_EQ(result, folded);
+    ASSERT_TRUE(table.findFolded("MIXEDCASE", 9, result));
+    ASSERT_EQ(result, folded);
+    ASSERT_FALSE(table.findFolded("Missing", 7, result));
+
+    // Names longer than the folding buffer are folded in pieces
+    const std::string longName(100, 'x');
+    const TribalScript::StringTableEntry longEntry = table.getOrAssign(longName);
+    ASSERT_TRUE(table.findFolded(std::string(100, 'X').c_str(), 100, result));
+    ASSERT_EQ(result, longEntry);
+
+    // Nothing was assigned by any of the lookups
+    ASSERT_EQ(table.size(), 3);
+}
+
+TEST(StringTable, Growth)
+{
+    TribalScript::StringTable table;
+
+    // Enough strings to force the table to grow several times
+    for (unsigned int iteration = 0; iteration < 10000; ++iteration)
+    {
+        ASSERT_EQ(table.getOrAssign("entry" + std::to_string(iteration)), iteration);
+    }
+
+    const std::string& reference = table.getString(0);
+    for (unsigned int iteration = 0; iteration < 10000; ++iteration)
+    {
+        ASSERT_EQ(table.getOrAssign("entry" + std::to_string(iteration)), iteration);
+        ASSERT_EQ(table.getString(iteration), "entry" + std::to_string(iteration));
+    }
+
+    // Returned references remain valid as the table grows
+    table.getOrAssign("Another Entry");
+    ASSERT_EQ(reference, "entry0");
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
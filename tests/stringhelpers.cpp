@@ -13,10 +13,14 @@
  */
 
 #include <memory>
+#include <string>
+#include <cstring>
 
 #include "gtest/gtest.h"
 
+#include <tribalscript/interpreter.hpp>
 #include <tribalscript/stringhelpers.hpp>
+#include <tribalscript/libraries/libraries.hpp>
 
 TEST(StringHelpers, GetStringComponents)
 {
@@ -77,6 +81,77 @@ TEST(StringHelpers, SetStringComponents)
     ASSERT_EQ(result, "A^B^C^D^^^X^Y^Z");
 }
 
+TEST(StringHelpers, StringComponents)
+{
+    // Consecutive delineators delimit empty components while a trailing one is not counted
+    const TribalScript::StoredValue list("alpha  beta gamma ");
+    const TribalScript::StringComponents words(list, ' ');
+    ASSERT_EQ(words.getCount(), 4);
+    ASSERT_EQ(words.getComponents(0, 1).toString(), "alpha");
+    ASSERT_EQ(words.getComponents(1, 1).toString(), "");
+    ASSERT_EQ(words.getComponents(2, 1).toString(), "beta");
+    ASSERT_EQ(words.getComponents(3, 1).toString(), "gamma");
+    ASSERT_EQ(words.getComponents(4, 1).toString(), "");
+    ASSERT_EQ(words.getComponents(9, 1).toString(), "");
+    ASSERT_EQ(words.getComponents(2, 2).toString(), "beta gamma");
+    ASSERT_EQ(words.getComponents(2, 100).toString(), "beta gamma ");
+    ASSERT_EQ(words.setComponents(3, { "delta" }), "alpha  beta delta ");
+    ASSERT_EQ(words.setComponents(6, { "x", "y" }), "alpha  beta gamma   x y");
+
+    ASSERT_EQ(TribalScript::StringComponents(TribalScript::StoredValue(""), ' ').getCount(), 0);
+    ASSERT_EQ(TribalScript::StoredValue("unterminated", 0).toString(), "");
+    ASSERT_EQ(TribalScript::StringComponents(TribalScript::StoredValue(""), ' ').setComponents(1, { "x" }), " x");
+    ASSERT_EQ(TribalScript::StringComponents(TribalScript::StoredValue(12.5f), '.').getComponents(1, 1).toString(), "5");
+
+    // Heap strings keep their offsets cached, which must follow the string as it changes
+    TribalScript::StoredValue growing("one two three four five");
+    ASSERT_EQ(TribalScript::StringComponents(growing, ' ').getComponents(4, 1).toString(), "five");
+    ASSERT_EQ(TribalScript::StringComponents(growing, 'e').getComponents(1, 1).toString(), " two thr");
+    char* characters = growing.resizeString(27);
+    std::memcpy(characters + 23, " six", 4);
+    ASSERT_EQ(TribalScript::StringComponents(growing, ' ').getCount(), 6);
+    ASSERT_EQ(TribalScript::StringComponents(growing, ' ').getComponents(5, 1).toString(), "six");
+
+    // This time there is spare capacity, so the string is appended to in place
+    characters = growing.resizeString(31);
+    std::memcpy(characters + 27, " ten", 4);
+    ASSERT_EQ(TribalScript::StringComponents(growing, ' ').getCount(), 7);
+    ASSERT_EQ(TribalScript::StringComponents(growing, ' ').getComponents(6, 1).toString(), "ten");
+}
+
+TEST(StringHelpers, ComponentFunctions)
+{
+    TribalScript::Interpreter interpreter;
+    TribalScript::registerAllLibraries(&interpreter);
+    interpreter.evaluate("$list = \"\"; for ($i = 0; $i < 100; $i++) { $list = $list @ \"word\" @ $i @ \" \"; }"
+                         "$count = getWordCount($list); $joined = \"\"; for ($i = 0; $i < getWordCount($list); $i++) { $joined = $joined @ getWord($list, $i); }"
+                         "$words = getWords($list, 98, 5); $set = setWord(\"a b c\", 1, \"x\"); $appended = setWord(\"a b\", 3, \"x\");"
+                         "$fields = getFields(\"a\tb\tc\", 1, 2); $field = getField(\"a\tb\tc\", 2); $fieldCount = getFieldCount(\"a\tb\tc\");"
+                         "$setField = setField(\"a\tb\", 0, \"x\"); $negative = getWord(\"a b\", -1);"
+                         "$short = getWord(\"a b\"); $long = getWordCount(\"a b\", 1);");
+
+    std::string joined;
+    for (int iteration = 0; iteration < 100; ++iteration)
+    {
+        joined += "word" + std::to_string(iteration);
+    }
+
+    ASSERT_EQ(interpreter.getGlobal("count")->toInteger(), 100);
+    ASSERT_EQ(interpreter.getGlobal("joined")->toString(), joined);
+    ASSERT_EQ(interpreter.getGlobal("words")->toString(), "word98 word99 ");
+    ASSERT_EQ(interpreter.getGlobal("set")->toString(), "a x c");
+    ASSERT_EQ(interpreter.getGlobal("appended")->toString(), "a b  x");
+    ASSERT_EQ(interpreter.getGlobal("fields")->toString(), "b\tc");
+    ASSERT_EQ(interpreter.getGlobal("field")->toString(), "c");
+    ASSERT_EQ(interpreter.getGlobal("fieldCount")->toInteger(), 3);
+    ASSERT_EQ(interpreter.getGlobal("setField")->toString(), "x\tb");
+    ASSERT_EQ(interpreter.getGlobal("negative")->toString(), "");
+
+    // Calls with the wrong number of arguments never reach the native
+    ASSERT_EQ(interpreter.getGlobal("short")->toInteger(), 0);
+    ASSERT_EQ(interpreter.getGlobal("long")->toInteger(), 0);
+}
+
 TEST(StringHelpers, ResolveArrayName)
 {
     std::string result = TribalScript::resolveArrayName("result::Root", 1, 0);
@@ -0,0 +1,88 @@
+/**
+ *  Copyright 2021 Robert MacGregor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction,
+ *  including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ *  subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <tribalscript/codeblock.hpp>
+#include <tribalscript/interpreter.hpp>
+#include <tribalscript/platformcontext.hpp>
+
+/**
+ *  @brief Platform context recording every error logged to it.
+ */
+class ErrorRecordingPlatformContext : public TribalScript::PlatformContext
+{
+    public:
+        virtual void logError(const std::string& message) override
+        {
+            mErrors.push_back(message);
+        }
+
+        std::vector<std::string> mErrors;
+};
+
+static void checkSyntaxErrors(const TribalScript::ParserFrontend frontend)
+{
+    ErrorRecordingPlatformContext* platform = new ErrorRecordingPlatformContext();
+    TribalScript::InterpreterConfiguration config(platform);
+    config.mFrontend = frontend;
+    TribalScript::Interpreter interpreter(config);
+
+    // Valid programs exercising the expression and chain rules parse without reporting anything
+    std::unique_ptr<TribalScript::CodeBlock> valid(interpreter.compile("%a.b[1, 2].c = (%x + %y * 2 < 3 ? \"a\" : \"b\") @ %z.call(1).d;"
+                                                                       "$g = -%a - -1 + !%b;"));
+    ASSERT_TRUE(valid);
+    ASSERT_TRUE(platform->mErrors.empty());
+
+    // A program with a syntax error is reported, the same way every time it is compiled
+    ASSERT_EQ(interpreter.compile("function broken( { %a = ; }"), nullptr);
+    const std::vector<std::string> errors = platform->mErrors;
+    ASSERT_FALSE(errors.empty());
+
+    platform->mErrors.clear();
+    ASSERT_EQ(interpreter.compile("function broken( { %a = ; }"), nullptr);
+    ASSERT_EQ(platform->mErrors, errors);
+
+    // Unterminated strings and unknown characters are rejected by the lexer
+    platform->mErrors.clear();
+    ASSERT_EQ(interpreter.compile("$a = \"unterminated;"), nullptr);
+    ASSERT_EQ(interpreter.compile("$a = 1 # 2;"), nullptr);
+    ASSERT_FALSE(platform->mErrors.empty());
+
+    // A failed parse does not affect the next one
+    platform->mErrors.clear();
+    std::unique_ptr<TribalScript::CodeBlock> recovered(interpreter.compile("$recovered = 1 + 2;"));
+    ASSERT_TRUE(recovered);
+    ASSERT_TRUE(platform->mErrors.empty());
+}
+
+TEST(InterpreterTest, SyntaxErrors)
+{
+    checkSyntaxErrors(TribalScript::ParserFrontend::ANTLR);
+}
+
+TEST(InterpreterTest, SyntaxErrorsHandWritten)
+{
+    checkSyntaxErrors(TribalScript::ParserFrontend::HandWritten);
+}
+
+int main()
+{
+    testing::InitGoogleTest();
+    return RUN_ALL_TESTS();
+}
@@ -37,6 +37,14 @@ TEST(InterpreterTest, Variables)
 
     ASSERT_EQ(resultGlobal->toInteger(), 50);
     ASSERT_EQ(resultGlobalNameSpace->toInteger(), 123);
+
+    // Globals are found in any case, and looking up names that were never used does not intern them
+    ASSERT_EQ(interpreter.getGlobal("GLOBAL"), resultGlobal);
+
+    const std::size_t stringCount = interpreter.mStringTable.size();
+    ASSERT_EQ(interpreter.getGlobal("neverAssigned"), nullptr);
+    ASSERT_EQ(interpreter.getGlobal("NeverAssigned"), nullptr);
+    ASSERT_EQ(interpreter.mStringTable.size(), stringCount);
 }
 
 int main()